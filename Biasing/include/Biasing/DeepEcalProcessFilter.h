@@ -18,6 +18,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /*~~~~~~~~~~~~~~~*/
@@ -74,6 +75,14 @@ class DeepEcalProcessFilter : public simcore::UserAction {
   double ecal_min_Z_{400.};
   /// Require that the hard brem photon originates from the target
   bool require_photon_fromTarget_{false};
+  /// The processes in processes_
+  std::vector<simcore::NameRegistry::ProcessHandle> processHandles_;
+  /// The brem process
+  simcore::NameRegistry::ProcessHandle eBrem_;
+  /// The target volumes
+  simcore::NameRegistry::LogicalVolumeHandle target_;
+  /// The ecal volumes
+  simcore::NameRegistry::LogicalVolumeHandle ecal_;
   /// Enable logging
   enableLogging("DeepEcalProcessFilter")
       /// member used to help tag events where the photon comes from the target
@@ -23,6 +23,7 @@
 /*~~~~~~~~~~~~*/
 /*   SimCore  */
 /*~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 namespace biasing {
@@ -149,7 +150,12 @@ class EcalDarkBremFilter : public simcore::UserAction {
   /**
    * The volumes that the filter will be applied to.
    */
-  std::vector<G4LogicalVolume*> volumes_;
+  simcore::NameRegistry::LogicalVolumeHandle volumes_;
+
+  /**
+   * The dark brem process
+   */
+  simcore::NameRegistry::ProcessHandle darkBrem_;
 
   /**
    * Have we found the A' yet?
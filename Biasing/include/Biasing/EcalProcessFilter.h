@@ -9,6 +9,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /*~~~~~~~~~~~~~~~*/
@@ -64,6 +65,17 @@ class EcalProcessFilter : public simcore::UserAction {
   /// Process to filter
   std::string process_{""};
 
+  /// The processes whose name contains process_
+  simcore::NameRegistry::ProcessHandle processHandle_;
+
+  /// The calorimeter region
+  simcore::NameRegistry::RegionHandle calorimeter_{
+      simcore::NameRegistry::get().region("CalorimeterRegion")};
+
+  /// The hcal parent volume
+  simcore::NameRegistry::PhysicalVolumeHandle hcalPV_{
+      simcore::NameRegistry::get().physicalVolume("hcal_PV")};
+
   /// Enable logging
   enableLogging("EcalProcessFilter")
 
@@ -4,6 +4,7 @@
 /*~~~~~~~~~~~~*/
 /*   SimCore  */
 /*~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /// Forward declaration of virtual process class
@@ -136,6 +137,10 @@ class MidShowerDiMuonBkgdFilter : public simcore::UserAction {
    */
   double total_process_energy_{0.};
 
+  /// The calorimeter region
+  simcore::NameRegistry::RegionHandle calorimeter_{
+      simcore::NameRegistry::get().region("CalorimeterRegion")};
+
 };  // MidShowerDiMuonBkgdFilter
 }  // namespace biasing
 
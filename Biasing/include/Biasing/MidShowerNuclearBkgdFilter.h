@@ -4,6 +4,7 @@
 /*~~~~~~~~~~~~*/
 /*   SimCore  */
 /*~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /// Forward declaration of virtual process class
@@ -144,7 +145,7 @@ class MidShowerNuclearBkgdFilter : public simcore::UserAction {
   /**
    * Processes to look for
    */
-  std::vector<std::string> nuclear_processes_;
+  std::vector<simcore::NameRegistry::ProcessHandle> nuclear_processes_;
 
   /**
    * Total energy gone to the process in the current event
@@ -153,6 +154,10 @@ class MidShowerNuclearBkgdFilter : public simcore::UserAction {
    */
   double total_process_energy_{0.};
 
+  /// The calorimeter region
+  simcore::NameRegistry::RegionHandle calorimeter_{
+      simcore::NameRegistry::get().region("CalorimeterRegion")};
+
 };  // MidShowerNuclearBkgdFilter
 }  // namespace biasing
 
@@ -19,6 +19,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /*~~~~~~~~~~~~~~~*/
@@ -65,6 +66,10 @@ class NonFiducialFilter : public simcore::UserAction {
   double recoil_max_p_{1500};  // MeV
   /// If turned on, this aborts fiducial events.
   bool abort_fiducial_{true};
+  /// The ecal volumes
+  simcore::NameRegistry::LogicalVolumeHandle ecal_;
+  /// The recoil volume
+  simcore::NameRegistry::LogicalVolumeHandle recoil_;
   /// Enable logging
   enableLogging("NonFiducialFilter")
 
@@ -9,6 +9,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 // Forward declarations
@@ -58,6 +59,10 @@ class PrimaryToEcalFilter : public simcore::UserAction {
   /// Energy [MeV] below which a primary should be vetoed.
   double threshold_;
 
+  /// The calorimeter region
+  simcore::NameRegistry::RegionHandle calorimeter_{
+      simcore::NameRegistry::get().region("CalorimeterRegion")};
+
 };  // PrimaryToEcalFilter
 
 }  // namespace biasing
@@ -5,6 +5,7 @@
 #include <string>
 
 //~~ SimCore ~~//
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 //~~ Framework ~~//
@@ -61,6 +62,12 @@ class TaggerHitFilter : public simcore::UserAction {
   std::set<int> layer_count_;
   /// Total number of hits required to persist an event.
   int layers_hit_{8};
+  /// The tagger region
+  simcore::NameRegistry::RegionHandle tagger_{
+      simcore::NameRegistry::get().region("tagger")};
+  /// The tagger parent volume
+  simcore::NameRegistry::PhysicalVolumeHandle taggerPV_{
+      simcore::NameRegistry::get().physicalVolume("tagger_PV")};
   /// Enable logging
   enableLogging("TaggerHitFilter")
 
@@ -9,6 +9,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /*~~~~~~~~~~~~~~~*/
@@ -83,6 +84,10 @@ class TaggerVetoFilter : public simcore::UserAction {
   // entered the tagger region?
   bool reject_primaries_missing_tagger_{true};
 
+  /// The tagger region
+  simcore::NameRegistry::RegionHandle tagger_{
+      simcore::NameRegistry::get().region("tagger")};
+
 };  // TaggerVetoFilter
 
 }  // namespace biasing
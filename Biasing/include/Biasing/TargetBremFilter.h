@@ -9,6 +9,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /*~~~~~~~~~~~~~~~*/
@@ -70,6 +71,22 @@ class TargetBremFilter : public simcore::UserAction {
   /// Flag indicating if the recoil electron track should be killed
   bool killRecoil_{false};
 
+  /// The target region
+  simcore::NameRegistry::RegionHandle target_{
+      simcore::NameRegistry::get().region("target")};
+
+  /// The recoil parent volume
+  simcore::NameRegistry::PhysicalVolumeHandle recoilPV_{
+      simcore::NameRegistry::get().physicalVolume("recoil_PV")};
+
+  /// The world volume
+  simcore::NameRegistry::PhysicalVolumeHandle worldPV_{
+      simcore::NameRegistry::get().physicalVolume("World_PV")};
+
+  /// The (unbiased) brem process
+  simcore::NameRegistry::ProcessHandle eBrem_{
+      simcore::NameRegistry::get().process("eBrem", true)};
+
 };  // TargetBremFilter
 }  // namespace biasing
 
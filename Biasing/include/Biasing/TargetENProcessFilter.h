@@ -11,6 +11,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 // Forward Declarations
@@ -67,6 +68,14 @@ class TargetENProcessFilter : public simcore::UserAction {
   /// Process to filter on
   std::string process_{"electronNuclear"};
 
+  /// The target volume
+  simcore::NameRegistry::PhysicalVolumeHandle volume_{
+      simcore::NameRegistry::get().physicalVolume(volumeName_)};
+
+  /// The processes whose name contains process_
+  simcore::NameRegistry::ProcessHandle processHandle_{
+      simcore::NameRegistry::get().process(process_)};
+
 };  // TargetENProcessFilter
 
 }  // namespace biasing
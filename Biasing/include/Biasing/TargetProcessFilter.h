@@ -4,6 +4,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 /*~~~~~~~~~~~~~~~*/
@@ -67,6 +68,21 @@ class TargetProcessFilter : public simcore::UserAction {
 
   /// The process to bias
   std::string process_{""};
+
+  /// The processes whose name contains process_
+  simcore::NameRegistry::ProcessHandle processHandle_;
+
+  /// The target region
+  simcore::NameRegistry::RegionHandle target_{
+      simcore::NameRegistry::get().region("target")};
+
+  /// The recoil parent volume
+  simcore::NameRegistry::PhysicalVolumeHandle recoilPV_{
+      simcore::NameRegistry::get().physicalVolume("recoil_PV")};
+
+  /// The world volume
+  simcore::NameRegistry::PhysicalVolumeHandle worldPV_{
+      simcore::NameRegistry::get().physicalVolume("World_PV")};
 };
 
 }  // namespace biasing
@@ -9,6 +9,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 namespace biasing {
@@ -58,6 +59,9 @@ class TrackProcessFilter : public simcore::UserAction {
   /// The process to filter on.
   std::string process_{""};
 
+  /// The processes whose name contains process_
+  simcore::NameRegistry::ProcessHandle processHandle_;
+
 };  // TrackProcessFilter
 
 }  // namespace utility
@@ -25,6 +25,25 @@ DeepEcalProcessFilter::DeepEcalProcessFilter(
   ecal_min_Z_ = parameters.getParameter<double>("ecal_min_Z");
   require_photon_fromTarget_ =
       parameters.getParameter<bool>("require_photon_fromTarget");
+
+  auto& names{simcore::NameRegistry::get()};
+  for (const auto& process : processes_)
+    processHandles_.push_back(names.process(process));
+  eBrem_ = names.process("eBrem");
+  target_ = names.logicalVolumes(
+      [](const G4String& volume) { return volume.contains("target"); });
+  // isInEcal should be taken from
+  // simcore::logical_volume_tests::isInEcal(volume) but for now it's under
+  // its own namespace so I cannot reach it here, see issue
+  // https://github.com/LDMX-Software/ldmx-sw/issues/1286
+  ecal_ = names.logicalVolumes([](const G4String& volume) {
+    return ((volume.contains("Si") || volume.contains("W") ||
+             volume.contains("PCB") || volume.contains("strongback") ||
+             volume.contains("Glue") || volume.contains("CFMix") ||
+             volume.contains("Al") || volume.contains("C")) &&
+            volume.contains("volume")) ||
+           (volume.contains("nohole_motherboard"));
+  });
 }
 
 void DeepEcalProcessFilter::BeginOfEventAction(const G4Event* event) {
@@ -37,32 +56,30 @@ void DeepEcalProcessFilter::stepping(const G4Step* step) {
   auto track{step->GetTrack()};
 
   // Check the creation process and PDG ID of the particle
-  auto processName = track->GetCreatorProcess()
-                         ? track->GetCreatorProcess()->GetProcessName()
-                         : "unknown";
+  auto process{track->GetCreatorProcess()};
   auto PDGid = track->GetParticleDefinition()->GetPDGEncoding();
 
   // Skip the steps that are for the recoil electron
   // PrimaryToEcalFilter made sure there is a fiducial e-
-  if (processName.contains("unknown")) return;
+  if (not process) return;
 
   // Energy of the particle is below threshold, move to next step
   if (track->GetKineticEnergy() < bias_threshold_) {
     return;
   }
 
+  const auto& names{simcore::NameRegistry::get()};
+
   // Check in which volume the particle is currently
-  auto volume{track->GetVolume()->GetLogicalVolume()
-                  ? track->GetVolume()->GetLogicalVolume()->GetName()
-                  : "undefined"};
+  auto volume{track->GetVolume()->GetLogicalVolume()};
 
   auto trackInfo{simcore::UserTrackInformation::get(track)};
   // Tag the brem photon from the primary electron
-  if (processName.contains("eBrem") and (track->GetParentID() == 1)) {
+  if (names.matches(process, eBrem_) and (track->GetParentID() == 1)) {
     trackInfo->tagBremCandidate();
     getEventInfo()->incBremCandidateCount();
     trackInfo->setSaveFlag(true);
-    if (volume.contains("target")) {
+    if (names.matches(volume, target_)) {
       photonFromTarget_ = true;
     }
   }
@@ -75,10 +92,8 @@ void DeepEcalProcessFilter::stepping(const G4Step* step) {
 
   // Tag if the event has the processes we are looking for
   bool hasProcessNeeded{false};
-  for (auto& process : processes_) {
-    // ldmx_log(debug) << "Allowed processed " << process << " now we have " <<
-    // processName;
-    if (processName.contains(process)) {
+  for (const auto& handle : processHandles_) {
+    if (names.matches(process, handle)) {
       hasProcessNeeded = true;
       break;
     }
@@ -86,20 +101,9 @@ void DeepEcalProcessFilter::stepping(const G4Step* step) {
   // skip this step if it does not have any of the processes needed
   if (not hasProcessNeeded) return;
 
-  // isInEcal should be taken from
-  // simcore::logical_volume_tests::isInEcal(volume) but for now it's under
-  // its own namespace so I cannot reach it here, see issue
-  // https://github.com/LDMX-Software/ldmx-sw/issues/1286
-  auto isInEcal{((volume.contains("Si") || volume.contains("W") ||
-                  volume.contains("PCB") || volume.contains("strongback") ||
-                  volume.contains("Glue") || volume.contains("CFMix") ||
-                  volume.contains("Al") || volume.contains("C")) &&
-                 volume.contains("volume")) ||
-                (volume.contains("nohole_motherboard"))};
-
   // Skip this step if it does not have the processes needed
   // or if it's not in the ECAL
-  if (not isInEcal) return;
+  if (not names.matches(volume, ecal_)) return;
 
   // Check the z position of the particle, and
   // flag if it is deeper than the min Z we are considering (but in ECAL)
@@ -107,8 +111,9 @@ void DeepEcalProcessFilter::stepping(const G4Step* step) {
   // Printout for testing
   if (zPosition > (0.75 * ecal_min_Z_)) {
     ldmx_log(debug) << " Particle ID " << PDGid << " with energy "
-                    << track->GetKineticEnergy() << " on " << volume << " from "
-                    << processName << " at Z = " << zPosition;
+                    << track->GetKineticEnergy() << " on " << volume->GetName()
+                    << " from " << process->GetProcessName()
+                    << " at Z = " << zPosition;
     if (zPosition > ecal_min_Z_) {
       hasDeepEcalProcess_ = true;
     }
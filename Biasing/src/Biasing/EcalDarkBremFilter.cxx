@@ -26,21 +26,23 @@ EcalDarkBremFilter::EcalDarkBremFilter(
    *  - 'volume' is in the name AND
    *  - 'Si' OR 'W' OR 'CFMix' OR 'PCB' are in the name
    */
-  for (G4LogicalVolume* volume : *G4LogicalVolumeStore::GetInstance()) {
-    G4String volumeName = volume->GetName();
-    // looking for ecal volumes
-    if (volumeName.contains("volume") and
-        (volumeName.contains("Si") or volumeName.contains("W") or
-         volumeName.contains("CFMix") or volumeName.contains("PCB") or
-         volumeName.contains("Al"))) {
-      volumes_.push_back(volume);
-    }
-  }
+  auto is_ecal_volume = [](const G4String& volumeName) {
+    return volumeName.contains("volume") and
+           (volumeName.contains("Si") or volumeName.contains("W") or
+            volumeName.contains("CFMix") or volumeName.contains("PCB") or
+            volumeName.contains("Al"));
+  };
+  auto& names{simcore::NameRegistry::get()};
+  volumes_ = names.logicalVolumes(is_ecal_volume);
+  darkBrem_ = names.process(G4DarkBremsstrahlung::PROCESS_NAME);
 
   if (G4RunManager::GetRunManager()->GetVerboseLevel() > 0) {
     std::cout << "[ EcalDarkBremFilter ]: "
               << "Looking for A' in: ";
-    for (auto const& volume : volumes_) std::cout << volume->GetName() << ", ";
+    for (G4LogicalVolume* volume : *G4LogicalVolumeStore::GetInstance()) {
+      if (is_ecal_volume(volume->GetName()))
+        std::cout << volume->GetName() << ", ";
+    }
     std::cout << std::endl;
   }
 }
@@ -97,8 +99,7 @@ void EcalDarkBremFilter::PostUserTrackingAction(const G4Track* track) {
   */
 
   const G4VProcess* creator = track->GetCreatorProcess();
-  if (creator and
-      creator->GetProcessName().contains(G4DarkBremsstrahlung::PROCESS_NAME)) {
+  if (simcore::NameRegistry::get().matches(creator, darkBrem_)) {
     // make sure all secondaries of dark brem process are saved
     simcore::UserTrackInformation* userInfo =
         simcore::UserTrackInformation::get(track);
@@ -116,17 +117,9 @@ void EcalDarkBremFilter::PostUserTrackingAction(const G4Track* track) {
 }
 
 bool EcalDarkBremFilter::inDesiredVolume(const G4Track* track) const {
-  /**
-   * Comparing the pointers to logical volumes isn't very robust.
-   * TODO find a better way to do this
-   */
-
-  auto inVol = track->GetLogicalVolumeAtVertex();
-  for (auto const& volume : volumes_) {
-    if (inVol == volume) return true;
-  }
-
-  return false;
+  // the pointers to the volumes are resolved from their names each run
+  return simcore::NameRegistry::get().matches(
+      track->GetLogicalVolumeAtVertex(), volumes_);
 }
 
 void EcalDarkBremFilter::AbortEvent(const std::string& reason) const {
@@ -20,6 +20,7 @@ EcalProcessFilter::EcalProcessFilter(const std::string& name,
                                      framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   process_ = parameters.getParameter<std::string>("process");
+  processHandle_ = simcore::NameRegistry::get().process(process_);
 }
 
 EcalProcessFilter::~EcalProcessFilter() {}
@@ -60,11 +61,12 @@ void EcalProcessFilter::stepping(const G4Step* step) {
   // Get the particles daughters.
   auto secondaries{step->GetSecondary()};
 
+  const auto& names{simcore::NameRegistry::get()};
+
   // Get the region the particle is currently in.  Continue processing
   // the particle only if it's in the calorimeter region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("CalorimeterRegion") != 0) {
+  if (!names.matches(track->GetVolume()->GetLogicalVolume()->GetRegion(),
+                     calorimeter_)) {
     // If secondaries were produced outside of the volume of interest,
     // and there aren't additional brems to process, abort the
     // event.  Otherwise, suspend the track and move on to the next
@@ -107,8 +109,7 @@ void EcalProcessFilter::stepping(const G4Step* step) {
      * hcal parent volume and so it will break if the hcal parent volume
      * changes its name.
      */
-    if (auto volume{track->GetNextVolume()->GetName()};
-        volume.compareTo("hcal_PV") == 0) {
+    if (names.matches(track->GetNextVolume(), hcalPV_)) {
       /*
       std::cout << "[ EcalProcessFilter ]: "
             <<
@@ -137,10 +138,10 @@ void EcalProcessFilter::stepping(const G4Step* step) {
   } else {
     // If the brem gamma interacts and produces secondaries, get the
     // process used to create them.
-    auto processName{secondaries->at(0)->GetCreatorProcess()->GetProcessName()};
+    auto process{secondaries->at(0)->GetCreatorProcess()};
 
     // Only record the process that is being biased
-    if (!processName.contains(process_)) {
+    if (!names.matches(process, processHandle_)) {
       /*
       std::cout << "[ EcalProcessFilter ]: "
             <<
@@ -171,7 +172,8 @@ void EcalProcessFilter::stepping(const G4Step* step) {
                            ->GetConstCurrentEvent()
                            ->GetEventID()
                     << " Brem photon produced " << secondaries->size()
-                    << " particle via " << processName << " process.";
+                    << " particle via " << process->GetProcessName()
+                    << " process.";
     trackInfo->tagBremCandidate(false);
     trackInfo->setSaveFlag(true);
     trackInfo->tagPNGamma();
@@ -87,11 +87,10 @@ void MidShowerDiMuonBkgdFilter::NewStage() {
 bool MidShowerDiMuonBkgdFilter::isOutsideCalorimeterRegion(
     const G4Step* step) const {
   // the pointers in this chain are assumed to be always valid
+  //  a nullptr region (no region defined for current volume) is
+  //  never matched and so it is outside the CalorimeterRegion
   auto reg{step->GetTrack()->GetVolume()->GetLogicalVolume()->GetRegion()};
-  if (reg) return (reg->GetName() != "CalorimeterRegion");
-  // region is nullptr ==> no region defined for current volume
-  //  ==> outside CalorimeterRegion
-  return true;
+  return not simcore::NameRegistry::get().matches(reg, calorimeter_);
 }
 
 void MidShowerDiMuonBkgdFilter::save(const G4Track* track) const {
@@ -11,7 +11,9 @@ MidShowerNuclearBkgdFilter::MidShowerNuclearBkgdFilter(
     const std::string& name, framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   threshold_ = parameters.getParameter<double>("threshold");
-  nuclear_processes_ = {"photonNuclear", "electronNuclear"};
+  auto& names{simcore::NameRegistry::get()};
+  nuclear_processes_ = {names.process("photonNuclear"),
+                        names.process("electronNuclear")};
 }
 
 void MidShowerNuclearBkgdFilter::BeginOfEventAction(const G4Event*) {
@@ -74,21 +76,19 @@ void MidShowerNuclearBkgdFilter::NewStage() {
 bool MidShowerNuclearBkgdFilter::isOutsideCalorimeterRegion(
     const G4Step* step) const {
   // the pointers in this chain are assumed to be always valid
+  //  a nullptr region (no region defined for current volume) is
+  //  never matched and so it is outside the CalorimeterRegion
   auto reg{step->GetTrack()->GetVolume()->GetLogicalVolume()->GetRegion()};
-  if (reg) return (reg->GetName() != "CalorimeterRegion");
-  // region is nullptr ==> no region defined for current volume
-  //  ==> outside CalorimeterRegion
-  return true;
+  return not simcore::NameRegistry::get().matches(reg, calorimeter_);
 }
 
 bool MidShowerNuclearBkgdFilter::isNuclearProcess(
     const G4VProcess* proc) const {
-  if (proc) {
-    const G4String& proc_name{proc->GetProcessName()};
-    for (auto const& option : nuclear_processes_) {
-      if (proc_name.contains(option)) return true;
-    }  // loop over nuclear processes
-  }    // pointer exists
+  // a nullptr process is never matched
+  const auto& names{simcore::NameRegistry::get()};
+  for (auto const& option : nuclear_processes_) {
+    if (names.matches(proc, option)) return true;
+  }  // loop over nuclear processes
   return false;
 }
 
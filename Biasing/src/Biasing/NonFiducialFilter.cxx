@@ -24,6 +24,22 @@ NonFiducialFilter::NonFiducialFilter(const std::string& name,
     : simcore::UserAction(name, parameters) {
   recoil_max_p_ = parameters.getParameter<double>("recoil_max_p");
   abort_fiducial_ = parameters.getParameter<bool>("abort_fiducial");
+
+  auto& names{simcore::NameRegistry::get()};
+  // isInEcal should be taken from
+  // simcore::logical_volume_tests::isInEcal(volume) but for now it's under
+  // its own namespace so I cannot reach it here see issue
+  // https://github.com/LDMX-Software/ldmx-sw/issues/1286
+  ecal_ = names.logicalVolumes([](const G4String& volume) {
+    return ((volume.contains("Si") || volume.contains("W") ||
+             volume.contains("PCB") || volume.contains("strongback") ||
+             volume.contains("Glue") || volume.contains("CFMix") ||
+             volume.contains("Al") || volume.contains("C")) &&
+            volume.contains("volume")) ||
+           (volume.contains("nohole_motherboard"));
+  });
+  recoil_ = names.logicalVolumes(
+      [](const G4String& volume) { return volume.compareTo("recoil") == 0; });
 }
 
 void NonFiducialFilter::stepping(const G4Step* step) {
@@ -43,9 +59,8 @@ void NonFiducialFilter::stepping(const G4Step* step) {
   }
 
   // Check in which volume the electron is currently
-  auto volume{track->GetVolume()->GetLogicalVolume()
-                  ? track->GetVolume()->GetLogicalVolume()->GetName()
-                  : "undefined"};
+  auto volume{track->GetVolume()->GetLogicalVolume()};
+  const auto& names{simcore::NameRegistry::get()};
 
   // Check if the track is tagged.
   auto electronCheck{simcore::UserTrackInformation::get(track)};
@@ -60,18 +75,7 @@ void NonFiducialFilter::stepping(const G4Step* step) {
     }
     // Check if the track ever enters the ECal. If it does, kill the track and
     // abort the event.
-    auto isInEcal{((volume.contains("Si") || volume.contains("W") ||
-                    volume.contains("PCB") || volume.contains("strongback") ||
-                    volume.contains("Glue") || volume.contains("CFMix") ||
-                    volume.contains("Al") || volume.contains("C")) &&
-                   volume.contains("volume")) ||
-                  (volume.contains("nohole_motherboard"))};
-
-    // isInEcal should be taken from
-    // simcore::logical_volume_tests::isInEcal(volume) but for now it's under
-    // its own namespace so I cannot reach it here see issue
-    // https://github.com/LDMX-Software/ldmx-sw/issues/1286
-    if (abort_fiducial_ && isInEcal) {
+    if (abort_fiducial_ && names.matches(volume, ecal_)) {
       track->SetTrackStatus(fKillTrackAndSecondaries);
       G4RunManager::GetRunManager()->AbortEvent();
       ldmx_log(debug) << ">> This event is fiducial, exiting";
@@ -86,7 +90,7 @@ void NonFiducialFilter::stepping(const G4Step* step) {
     return;
   } else {
     // Check if the particle enters the recoil tracker.
-    if (volume.compareTo("recoil") == 0) {
+    if (names.matches(volume, recoil_)) {
       /* Tag the tracks that:
        1) Have a recoil electron
        2) Enter/Exit the Target */
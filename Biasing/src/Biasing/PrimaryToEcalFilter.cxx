@@ -25,12 +25,9 @@ void PrimaryToEcalFilter::stepping(const G4Step* step) {
 
   // Get the region the particle is currently in.  Continue processing
   // the particle only if it's NOT in the calorimeter region
-  if (auto region{step->GetTrack()
-                      ->GetVolume()
-                      ->GetLogicalVolume()
-                      ->GetRegion()
-                      ->GetName()};
-      region.compareTo("CalorimeterRegion") == 0)
+  if (simcore::NameRegistry::get().matches(
+          step->GetTrack()->GetVolume()->GetLogicalVolume()->GetRegion(),
+          calorimeter_))
     return;
 
   // If the energy of the particle fell below threshold, stop processing the
@@ -24,25 +24,22 @@ void TaggerHitFilter::stepping(const G4Step* step) {
     return;
   }
 
+  const auto& names{simcore::NameRegistry::get()};
+
   // Only electrons in the Tagger region are of interest.
   auto volume{track->GetVolume()};
-  if (auto region{volume->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("tagger") != 0)
-    return;
+  if (!names.matches(volume->GetLogicalVolume()->GetRegion(), tagger_)) return;
 
   // Check if we are exiting the tagger
-  if (auto nregion{
-          track->GetNextVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      (nregion.compareTo("tagger") != 0)) {
+  if (!names.matches(track->GetNextVolume()->GetLogicalVolume()->GetRegion(),
+                     tagger_)) {
     checkAbortEvent(track);
     return;
   }
 
   // A particle will only leave hits in the active silicon so other volumes can
   // be skipped for now.
-  if (auto volume_name{track->GetVolume()->GetName()};
-      volume_name.compareTo("tagger_PV") == 0)
-    return;
+  if (names.matches(volume, taggerPV_)) return;
 
   // The copy number is used to identify which layer energy was deposited into.
   int copy_number{0};
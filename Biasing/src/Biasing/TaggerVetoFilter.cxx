@@ -41,9 +41,8 @@ void TaggerVetoFilter::stepping(const G4Step *step) {
 
   // Get the region the particle is currently in.  Continue processing
   // the particle only if it's in the tagger region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("tagger") != 0)
+  if (!simcore::NameRegistry::get().matches(
+          track->GetVolume()->GetLogicalVolume()->GetRegion(), tagger_))
     return;
 
   primary_entered_tagger_region_ = true;
@@ -58,11 +58,12 @@ void TargetBremFilter::stepping(const G4Step* step) {
   if (auto pdgID{track->GetParticleDefinition()->GetPDGEncoding()}; pdgID != 11)
     return;
 
+  const auto& names{simcore::NameRegistry::get()};
+
   // Get the region the particle is currently in.  Continue processing
   // the particle only if it's in the target region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("target") != 0)
+  if (!names.matches(track->GetVolume()->GetLogicalVolume()->GetRegion(),
+                     target_))
     return;
 
   /*
@@ -84,8 +85,8 @@ void TargetBremFilter::stepping(const G4Step* step) {
    * We also check if the next volume is World_PV because in some geometries
    * (e.g. v14), there is a air-gap between the target region and the recoil.
    */
-  if (auto volume{track->GetNextVolume()->GetName()};
-      volume.compareTo("recoil_PV") == 0 or volume.compareTo("World_PV") == 0) {
+  if (auto volume{track->GetNextVolume()};
+      names.matches(volume, recoilPV_) or names.matches(volume, worldPV_)) {
     // If the recoil electron
     if (track->GetMomentum().mag() >= recoilMaxPThreshold_) {
       track->SetTrackStatus(fKillTrackAndSecondaries);
@@ -101,10 +102,7 @@ void TargetBremFilter::stepping(const G4Step* step) {
       return;
     } else {
       for (auto& secondary_track : *secondaries) {
-        G4String processName =
-            secondary_track->GetCreatorProcess()->GetProcessName();
-
-        if (processName.compareTo("eBrem") == 0 &&
+        if (names.matches(secondary_track->GetCreatorProcess(), eBrem_) &&
             secondary_track->GetKineticEnergy() > bremEnergyThreshold_) {
           auto trackInfo{simcore::UserTrackInformation::get(secondary_track)};
           trackInfo->tagBremCandidate();
@@ -37,12 +37,10 @@ void TargetENProcessFilter::stepping(const G4Step* step) {
   // Make sure that the particle being processed is an electron.
   if (pdgID != 11) return;  // Throw an exception
 
-  // Get the volume the particle is in.
-  G4VPhysicalVolume* volume = track->GetVolume();
-  G4String volumeName = volume->GetName();
+  const auto& names{simcore::NameRegistry::get()};
 
   // If the particle isn't in the target, don't continue with the processing.
-  if (volumeName.compareTo(volumeName_) != 0) return;
+  if (!names.matches(track->GetVolume(), volume_)) return;
 
   /*std::cout << "*******************************" << std::endl;
   std::cout << "*   Step " << track->GetCurrentStepNumber() << std::endl;
@@ -69,16 +67,15 @@ void TargetENProcessFilter::stepping(const G4Step* step) {
     G4RunManager::GetRunManager()->AbortEvent();
     return;
   } else {
-    G4String processName =
-        secondaries->at(0)->GetCreatorProcess()->GetProcessName();
+    const G4VProcess* process = secondaries->at(0)->GetCreatorProcess();
 
     /*std::cout << "[ TargetENProcessFilter ]: "
               << "Electron produced " << secondaries->size()
-              << " particle via " << processName << " process."
+              << " particle via " << process->GetProcessName() << " process."
               << std::endl;*/
 
     // Only record the process that is being biased
-    if (!processName.contains(process_)) {
+    if (!names.matches(process, processHandle_)) {
       /*std::cout << "[ TargetENProcessFilter ]: "
                 << "Process was not " << BiasingMessenger::getProcess() << "-->
          Killing all tracks!"
@@ -91,7 +88,8 @@ void TargetENProcessFilter::stepping(const G4Step* step) {
 
     std::cout << "[ TargetENProcessFilter ]: "
               << "Electronuclear reaction resulted in " << secondaries->size()
-              << " particles via " << processName << " process." << std::endl;
+              << " particles via " << process->GetProcessName() << " process."
+              << std::endl;
     // BiasingMessenger::setEventWeight(track->GetWeight());
     reactionOccurred_ = true;
   }
@@ -26,6 +26,7 @@ TargetProcessFilter::TargetProcessFilter(
     const std::string& name, framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   process_ = parameters.getParameter<std::string>("process");
+  processHandle_ = simcore::NameRegistry::get().process(process_);
 }
 
 G4ClassificationOfNewTrack TargetProcessFilter::ClassifyNewTrack(
@@ -58,11 +59,12 @@ void TargetProcessFilter::stepping(const G4Step* step) {
   // Get the particles daughters.
   auto secondaries{step->GetSecondary()};
 
+  const auto& names{simcore::NameRegistry::get()};
+
   // Get the region the particle is currently in. Continue processing
   // the particle only if it's in the target region.
-  if (auto region{
-          track->GetVolume()->GetLogicalVolume()->GetRegion()->GetName()};
-      region.compareTo("target") != 0) {
+  if (!names.matches(track->GetVolume()->GetLogicalVolume()->GetRegion(),
+                     target_)) {
     // If secondaries were produced outside of the volume of interest,
     // and there aren't additional brems to process, abort the event.
     // Otherwise, suspend the track and move on to the next brem.
@@ -97,9 +99,8 @@ void TargetProcessFilter::stepping(const G4Step* step) {
      * We also check for 'World_PV' because in later geometries, there is
      * an air gap between the target region and the recoil tracker.
      */
-    if (auto volume{track->GetNextVolume()->GetName()};
-        volume.compareTo("recoil_PV") == 0 or
-        volume.compareTo("World_PV") == 0) {
+    if (auto volume{track->GetNextVolume()};
+        names.matches(volume, recoilPV_) or names.matches(volume, worldPV_)) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         track->SetTrackStatus(fKillTrackAndSecondaries);
         G4RunManager::GetRunManager()->AbortEvent();
@@ -115,11 +116,10 @@ void TargetProcessFilter::stepping(const G4Step* step) {
   } else {
     // If the brem gamma interacts and produced secondaries, get the
     // process used to create them.
-    G4String processName =
-        secondaries->at(0)->GetCreatorProcess()->GetProcessName();
+    auto process{secondaries->at(0)->GetCreatorProcess()};
 
     // Only record the process that is being biased
-    if (!processName.contains(process_)) {
+    if (!names.matches(process, processHandle_)) {
       if (getEventInfo()->bremCandidateCount() == 1) {
         track->SetTrackStatus(fKillTrackAndSecondaries);
         G4RunManager::GetRunManager()->AbortEvent();
@@ -139,7 +139,8 @@ void TargetProcessFilter::stepping(const G4Step* step) {
                        ->GetConstCurrentEvent()
                        ->GetEventID()
                 << " Brem photon produced " << secondaries->size()
-                << " particle via " << processName << " process." << std::endl;
+                << " particle via " << process->GetProcessName() << " process."
+                << std::endl;
     }
     trackInfo->tagBremCandidate(false);
     trackInfo->setSaveFlag(true);
@@ -18,15 +18,16 @@ TrackProcessFilter::TrackProcessFilter(
     const std::string& name, framework::config::Parameters& parameters)
     : simcore::UserAction(name, parameters) {
   process_ = parameters.getParameter<std::string>("process");
+  processHandle_ = simcore::NameRegistry::get().process(process_);
 }
 
 TrackProcessFilter::~TrackProcessFilter() {}
 
 void TrackProcessFilter::PostUserTrackingAction(const G4Track* track) {
   if (const G4VProcess * process{track->GetCreatorProcess()}; process) {
-    auto name{process->GetProcessName()};
     auto trackInfo{simcore::UserTrackInformation::get(track)};
-    if (name.contains(process_)) trackInfo->setSaveFlag(true);
+    if (simcore::NameRegistry::get().matches(process, processHandle_))
+      trackInfo->setSaveFlag(true);
   }  // does this track have a creator process
 }
 
@@ -6,7 +6,9 @@
 #ifndef FRAMEWORK_SIMPLETABLECONDITION_H_
 #define FRAMEWORK_SIMPLETABLECONDITION_H_
 
+#include <cstdint>
 #include <ostream>
+#include <span>
 #include <vector>
 
 #include "Framework/ConditionsObject.h"
@@ -70,6 +72,16 @@ class BaseTableCondition : public framework::ConditionsObject {
    */
   const std::vector<std::string>& getColumnNames() const { return columns_; }
 
+  /**
+   * Get the row number for the given id
+   *
+   * The rows are numbered contiguously from zero, so this can be used
+   * as a compact index for the ids in the table.
+   *
+   * @returns the number of rows if the id is not in the table
+   */
+  std::size_t getRowNumber(unsigned int id) const { return findKey(id); }
+
   /**
    * Get the number of rows
    */
@@ -79,7 +91,10 @@ class BaseTableCondition : public framework::ConditionsObject {
    * Set an AND mask to be applied to the id.  Typically used to "flatten" a
    * table in some manner.
    */
-  void setIdMask(unsigned int mask) { idMask_ = mask; }
+  void setIdMask(unsigned int mask) {
+    idMask_ = mask;
+    clearIndex();
+  }
 
   /**
    * Get the AND mask to be applied to the id.  Typically used to "flatten" a
@@ -94,15 +109,76 @@ class BaseTableCondition : public framework::ConditionsObject {
     return s << keys_[irow];
   }
 
+  /**
+   * Build a dense index from ids to rows
+   *
+   * Detector ids are packed bit fields, so the ids in a table are
+   * clustered into a few ranges of the 32-bit space. We split the ids
+   * into pages of PAGE_SIZE consecutive values and store the row number
+   * of every id for each page that has at least one id in the table,
+   * so looking up the row of an id is two indexed loads instead of a
+   * binary search.
+   *
+   * This should be called once the table is completely filled, adding
+   * rows afterwards drops the index. If the ids are so sparse that the
+   * index would be much larger than the table itself, no index is built
+   * and lookups keep using the binary search.
+   */
+  virtual void buildIndex();
+
+  /**
+   * Check if a dense index from ids to rows has been built
+   */
+  bool hasIndex() const { return !pageTable_.empty(); }
+
  protected:
-  std::size_t findKey(unsigned int id) const;
+  /**
+   * Find the row for the input id
+   *
+   * Uses the dense index if it has been built.
+   *
+   * @returns the number of rows if the id is not in the table
+   */
+  std::size_t findKey(unsigned int id) const {
+    if (pageTable_.empty()) return searchKey(id);
+    unsigned int effid = id & idMask_;
+    // unsigned subtraction wraps ids below the first page out of range
+    std::size_t ipage = (effid >> PAGE_BITS) - firstPage_;
+    if (ipage >= pageTable_.size() || pageTable_[ipage] == NO_PAGE)
+      return keys_.size();
+    return rows_[(std::size_t(pageTable_[ipage]) << PAGE_BITS) |
+                 (effid & PAGE_MASK)];
+  }
+
+  /// binary search for the row of the input id
+  std::size_t searchKey(unsigned int id) const;
 
   std::size_t findKeyInsert(unsigned int id) const;
 
+  /// drop the dense index, done whenever the ids of the table change
+  virtual void clearIndex();
+
+  /// number of bits of the id within a page of the dense index
+  static const unsigned int PAGE_BITS{9};
+  /// number of ids in a page of the dense index
+  static const unsigned int PAGE_SIZE{1u << PAGE_BITS};
+  /// mask for the bits of the id within a page of the dense index
+  static const unsigned int PAGE_MASK{PAGE_SIZE - 1};
+  /// marker for a page of ids with no rows in the table
+  static const uint32_t NO_PAGE{0xFFFFFFFFu};
+
   std::vector<std::string> columns_;
   unsigned int columnCount_;
   std::vector<uint32_t> keys_;
   unsigned int idMask_;
+
+ private:
+  /// first page of ids in the dense index
+  uint32_t firstPage_{0};
+  /// index into rows_ for each page of ids from firstPage_, or NO_PAGE
+  std::vector<uint32_t> pageTable_;
+  /// row number for every id in the pages with rows in the table
+  std::vector<uint32_t> rows_;
 };
 
 template <class T>
@@ -120,6 +196,7 @@ class HomogenousTableCondition : public BaseTableCondition {
   void clear() {
     keys_.clear();
     values_.clear();
+    clearIndex();
   }
 
   /** Add an entry to the table */
@@ -139,6 +216,8 @@ class HomogenousTableCondition : public BaseTableCondition {
     }
     loc = findKeyInsert(id);  // where to put it
 
+    // row numbers are changing
+    clearIndex();
     // insert into the keys
     keys_.insert(keys_.begin() + loc, id);
     // insert into the values
@@ -174,6 +253,57 @@ class HomogenousTableCondition : public BaseTableCondition {
     return std::pair<unsigned int, std::vector<T> >(keys_[irow], rv);
   }
 
+  /**
+   * Build the dense index from ids to rows and the column views
+   *
+   * @see BaseTableCondition::buildIndex
+   * @see getColumnView
+   */
+  void buildIndex() override {
+    BaseTableCondition::buildIndex();
+    std::size_t nrows = getRowCount();
+    columnValues_.resize(values_.size());
+    for (std::size_t irow = 0; irow < nrows; irow++) {
+      for (std::size_t icol = 0; icol < columnCount_; icol++) {
+        columnValues_[icol * nrows + irow] =
+            values_[irow * columnCount_ + icol];
+      }
+    }
+    hasColumnViews_ = true;
+  }
+
+  /**
+   * Get the values of one column for all rows
+   *
+   * The values are contiguous and ordered by row, so they can be
+   * indexed by getRowNumber. Caching the view and the row number of
+   * a channel turns looking up its calibration into a single load.
+   * ```cpp
+   * auto pedestals{table.getColumnView(table.getColumnNumber("PEDESTAL"))};
+   * double pedestal = pedestals[table.getRowNumber(id)];
+   * ```
+   *
+   * @throws Exception if the column does not exist or the column views
+   * have not been built by buildIndex
+   *
+   * @param[in] col column number
+   * @returns view of the values in that column, one per row
+   */
+  std::span<const T> getColumnView(unsigned int col) const {
+    if (col >= columnCount_) {
+      EXCEPTION_RAISE("ConditionsException",
+                      "No such column " + std::to_string(col) + " in " +
+                          getName());
+    }
+    if (!hasColumnViews_) {
+      EXCEPTION_RAISE("ConditionsException",
+                      "Column views of " + getName() +
+                          " were requested before the index was built.");
+    }
+    std::size_t nrows = getRowCount();
+    return std::span<const T>(columnValues_.data() + col * nrows, nrows);
+  }
+
   /**
    * Get a column by DetectorId and name
    * Throws an exception when
@@ -199,7 +329,20 @@ class HomogenousTableCondition : public BaseTableCondition {
   }
 
  private:
+  /// drop the dense index and the column views
+  void clearIndex() override {
+    BaseTableCondition::clearIndex();
+    columnValues_.clear();
+    hasColumnViews_ = false;
+  }
+
   std::vector<T> values_;  // unrolled array
+
+  /// values transposed so that each column is contiguous
+  std::vector<T> columnValues_;
+
+  /// have the column views been built?
+  bool hasColumnViews_{false};
 };
 
 /**
@@ -20,7 +20,7 @@ std::ostream& operator<<(std::ostream& s,
 
 namespace conditions {
 
-std::size_t BaseTableCondition::findKey(unsigned int id) const {
+std::size_t BaseTableCondition::searchKey(unsigned int id) const {
   unsigned int effid = id & idMask_;
   std::vector<unsigned int>::const_iterator ptr =
       std::lower_bound(keys_.begin(), keys_.end(), effid);
@@ -37,4 +37,43 @@ std::size_t BaseTableCondition::findKeyInsert(unsigned int id) const {
   return std::distance(keys_.begin(), ptr);
 }
 
+void BaseTableCondition::buildIndex() {
+  clearIndex();
+  if (keys_.empty()) return;
+
+  // keys are sorted so the first and last pages are easy to find
+  uint32_t first_page = keys_.front() >> PAGE_BITS;
+  std::size_t num_pages = (keys_.back() >> PAGE_BITS) - first_page + 1;
+
+  // count the pages that have at least one key
+  std::size_t num_filled{0};
+  uint32_t last_page{NO_PAGE};
+  for (uint32_t key : keys_) {
+    if ((key >> PAGE_BITS) != last_page) {
+      last_page = key >> PAGE_BITS;
+      num_filled++;
+    }
+  }
+
+  // don't build an index that is much larger than the table itself
+  std::size_t limit = 64 * keys_.size() + PAGE_SIZE;
+  if (num_pages > limit || num_filled * PAGE_SIZE > limit) return;
+
+  firstPage_ = first_page;
+  pageTable_.assign(num_pages, NO_PAGE);
+  rows_.assign(num_filled * PAGE_SIZE, uint32_t(keys_.size()));
+  uint32_t next_page{0};
+  for (std::size_t irow{0}; irow < keys_.size(); irow++) {
+    uint32_t& page{pageTable_[(keys_[irow] >> PAGE_BITS) - firstPage_]};
+    if (page == NO_PAGE) page = next_page++;
+    rows_[(std::size_t(page) << PAGE_BITS) | (keys_[irow] & PAGE_MASK)] = irow;
+  }
+}
+
+void BaseTableCondition::clearIndex() {
+  firstPage_ = 0;
+  pageTable_.clear();
+  rows_.clear();
+}
+
 }  // namespace conditions
@@ -169,6 +169,7 @@ SimpleCSVTableProvider::getCondition(const ldmx::EventHeader& context) {
               new IntegerTableCondition(getConditionObjectName(), columns_);
           table->setIdMask(0);  // all ids are the same...
           table->add(0, tabledef.ivalues_);
+          table->buildIndex();
           return std::pair<const framework::ConditionsObject*,
                            framework::ConditionsIOV>(table, tabledef.iov_);
         } else if (objectType_ == OBJ_double) {
@@ -177,6 +178,7 @@ SimpleCSVTableProvider::getCondition(const ldmx::EventHeader& context) {
                                                    columns_);
           table->setIdMask(0);  // all ids are the same...
           table->add(0, tabledef.dvalues_);
+          table->buildIndex();
           return std::pair<const framework::ConditionsObject*,
                            framework::ConditionsIOV>(table, tabledef.iov_);
         }
@@ -188,6 +190,7 @@ SimpleCSVTableProvider::getCondition(const ldmx::EventHeader& context) {
               new IntegerTableCondition(getConditionObjectName(), columns_);
           conditions::utility::SimpleTableStreamerCSV::load(*table,
                                                             *(stream.get()));
+          table->buildIndex();
           return std::pair<const framework::ConditionsObject*,
                            framework::ConditionsIOV>(table, tabledef.iov_);
         } else if (objectType_ == OBJ_double) {
@@ -196,6 +199,7 @@ SimpleCSVTableProvider::getCondition(const ldmx::EventHeader& context) {
                                                    columns_);
           conditions::utility::SimpleTableStreamerCSV::load(*table,
                                                             *(stream.get()));
+          table->buildIndex();
           return std::pair<const framework::ConditionsObject*,
                            framework::ConditionsIOV>(table, tabledef.iov_);
         }
@@ -187,6 +187,57 @@ TEST_CASE("Conditions", "[Conditions]") {
         ContainsSubstring("Mismatched number of columns (3!=4) on line 3"));
   }
 
+  SECTION("Testing dense index") {
+    // add some ids in other modules and layers so there are several pages
+    for (int layer = 0; layer < 34; layer += 11) {
+      for (int cell = 0; cell < 432; cell += 7) {
+        ldmx::EcalID id(layer, 3, cell);
+        itable.add(id.raw(), {layer, cell, layer * cell});
+      }
+    }
+    std::vector<unsigned int> ids;
+    for (std::size_t irow = 0; irow < itable.getRowCount(); irow++)
+      ids.push_back(itable.getRowId(irow));
+
+    CHECK_FALSE(itable.hasIndex());
+    REQUIRE_THROWS_WITH(itable.getColumnView(0),
+                        ContainsSubstring("before the index was built"));
+    itable.buildIndex();
+    REQUIRE(itable.hasIndex());
+
+    auto q{itable.getColumnView(itable.getColumnNumber("Q"))};
+    REQUIRE(q.size() == itable.getRowCount());
+    for (std::size_t irow = 0; irow < ids.size(); irow++) {
+      CHECK(itable.getRowNumber(ids[irow]) == irow);
+      CHECK(q[itable.getRowNumber(ids[irow])] == itable.get(ids[irow], 1));
+    }
+
+    // ids that are not in the table, within and outside of the index
+    CHECK(itable.getRowNumber(ldmx::EcalID(1, 1, 11).raw()) ==
+          itable.getRowCount());
+    CHECK(itable.getRowNumber(ldmx::EcalID(40, 3, 0).raw()) ==
+          itable.getRowCount());
+    CHECK(itable.getRowNumber(0) == itable.getRowCount());
+    REQUIRE_THROWS_WITH(itable.get(ldmx::EcalID(1, 1, 11).raw(), 0),
+                        ContainsSubstring("No such column"));
+    REQUIRE_THROWS_WITH(itable.getColumnView(3),
+                        ContainsSubstring("No such column"));
+
+    // adding a row drops the index, but lookups still work
+    ldmx::EcalID id(1, 1, 11);
+    itable.add(id.raw(), {1, 2, 3});
+    CHECK_FALSE(itable.hasIndex());
+    CHECK(itable.get(id.raw(), 2) == 3);
+
+    // the flattened tables from python have a single row
+    IntegerTableCondition flat("Flat", columns);
+    flat.setIdMask(0);
+    flat.add(0, {10, 45, 129});
+    flat.buildIndex();
+    CHECK(flat.get(id.raw(), 1) == 45);
+    CHECK(flat.getColumnView(2)[flat.getRowNumber(id.raw())] == 129);
+  }
+
   SECTION("Testing python static") {
     const char* cfg =
         "#!/usr/bin/python3\n\nimport sys\n\nfrom LDMX.Framework import "
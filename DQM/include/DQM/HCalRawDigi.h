@@ -17,6 +17,7 @@
 #include "Framework/Configure/Parameters.h"
 #include "Framework/Event.h"
 #include "Framework/EventProcessor.h"
+#include "Recon/Event/HgcrocDigiCollection.h"
 #include "Tools/AnalysisUtils.h"
 
 namespace dqm {
@@ -49,6 +50,8 @@ class HCalRawDigi : public framework::Analyzer {
  private:
   std::string input_name_;
   std::string input_pass_;
+  /// buffer for the decoded digi samples, re-used each event
+  ldmx::HgcrocDigiCollection::DecodedSamples decoded_;
 };
 
 }  // namespace dqm
@@ -23,21 +23,21 @@ void HCalRawDigi::onProcessStart() {
 }
 
 void HCalRawDigi::analyze(const framework::Event& event) {
-  auto digis{
+  auto const& digis{
       event.getObject<ldmx::HgcrocDigiCollection>(input_name_, input_pass_)};
+  digis.decode(decoded_);
   /**
    * we can do this incrementing of channel indices because the decoder
    * uses a map which sorts by electronic ID and then adds the digis in
    * sequence, so the order from event to event is the same without zero supp
    */
-  unsigned int i_digi{1};
-  for (auto const& digi : digis) {
-    for (unsigned int i_sample{0}; i_sample < digis.getNumSamplesPerDigi();
+  for (std::size_t i_digi{0}; i_digi < decoded_.size(); i_digi++) {
+    for (unsigned int i_sample{0}; i_sample < decoded_.samples_per_digi;
          i_sample++) {
       histograms_.fill("adc_by_channel_sample" + std::to_string(i_sample),
-                       i_digi, digi.at(i_sample).adc_t());
+                       i_digi + 1,
+                       decoded_.adc_t[decoded_.index(i_digi, i_sample)]);
     }
-    i_digi++;
   }
 }
 
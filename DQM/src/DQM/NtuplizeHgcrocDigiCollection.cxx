@@ -18,6 +18,8 @@ class NtuplizeHgcrocDigiCollection : public framework::Analyzer {
   bool using_eid_, already_aligned_;
   bool good_link_;
   TTree* flat_tree_;
+  /// buffer for the decoded digi samples, re-used each event
+  ldmx::HgcrocDigiCollection::DecodedSamples decoded_;
 
  public:
   NtuplizeHgcrocDigiCollection(std::string const& n, framework::Process& p)
@@ -94,18 +96,19 @@ void NtuplizeHgcrocDigiCollection::analyze(const framework::Event& event) {
 
   auto const& digis{
       event.getObject<ldmx::HgcrocDigiCollection>(input_name_, input_pass_)};
-  for (std::size_t i_digi{0}; i_digi < digis.size(); i_digi++) {
-    auto d{digis.getDigi(i_digi)};
-    raw_id_ = static_cast<int>(d.id());
+  digis.decode(decoded_);
+  for (std::size_t i_digi{0}; i_digi < decoded_.size(); i_digi++) {
+    unsigned int id{decoded_.id[i_digi]};
+    raw_id_ = static_cast<int>(id);
     if (using_eid_) {
-      ldmx::HcalElectronicsID eid(d.id());
+      ldmx::HcalElectronicsID eid(id);
       fpga_ = eid.fiber();
       link_ = eid.elink();
       good_link_ = (good_bxheader.at(link_) and good_trailer.at(link_));
       channel_ = eid.channel();
       index_ = eid.index();
     } else {
-      ldmx::HcalDigiID detid(d.id());
+      ldmx::HcalDigiID detid(id);
       ldmx::HcalElectronicsID eid = detmap.get(detid);
       int link = eid.elink();
       good_link_ = (good_bxheader.at(link) and good_trailer.at(link));
@@ -115,14 +118,15 @@ void NtuplizeHgcrocDigiCollection::analyze(const framework::Event& event) {
       end_ = detid.end();
     }
 
-    for (i_sample_ = 0; i_sample_ < digis.getNumSamplesPerDigi(); i_sample_++) {
-      tot_prog_ = d.at(i_sample_).isTOTinProgress();
-      tot_comp_ = d.at(i_sample_).isTOTComplete();
-      tot_ = d.at(i_sample_).tot();
-      toa_ = d.at(i_sample_).toa();
-      int adc_t = d.at(i_sample_).adc_t();
-      raw_adc_ = adc_t;
-      adc_ = adc_t - pedestal_table.get(d.id(), 0);
+    int pedestal = pedestal_table.get(id, 0);
+    for (i_sample_ = 0; i_sample_ < decoded_.samples_per_digi; i_sample_++) {
+      std::size_t i{decoded_.index(i_digi, i_sample_)};
+      tot_prog_ = decoded_.tot_progress[i];
+      tot_comp_ = decoded_.tot_complete[i];
+      tot_ = decoded_.tot[i];
+      toa_ = decoded_.toa[i];
+      raw_adc_ = decoded_.adc_t[i];
+      adc_ = raw_adc_ - pedestal;
       flat_tree_->Fill();
     }
   }
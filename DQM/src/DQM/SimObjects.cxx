@@ -4,6 +4,7 @@
 #include "Framework/ProductTag.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
 #include "SimCore/Event/SimParticle.h"
+#include "SimCore/Event/SimParticleTable.h"
 #include "SimCore/Event/SimTrackerHit.h"
 
 namespace dqm {
@@ -147,46 +148,65 @@ void SimObjects::analyze(const framework::Event& event) {
     for (auto pt : track_colls) createTrackerHists(pt.name());
   }
 
-  auto const& particle_map{
-      event.getMap<int, ldmx::SimParticle>("SimParticles")};
-  for (auto const& [track_id, particle] : particle_map) {
-    auto const& momentum{particle.getMomentum()};
-    auto const& vertex{particle.getVertex()};
-    histograms_.fill("SimParticles.E", particle.getEnergy());
-    histograms_.fill("SimParticles.px", momentum.at(0));
-    histograms_.fill("SimParticles.py", momentum.at(1));
-    histograms_.fill("SimParticles.pz", momentum.at(2));
-    histograms_.fill("SimParticles.time", particle.getTime());
-    histograms_.fill("SimParticles.pdg", particle.getPdgID());
-    histograms_.fill("SimParticles.x", vertex.at(0));
-    histograms_.fill("SimParticles.y", vertex.at(1));
-    histograms_.fill("SimParticles.z", vertex.at(2));
-    histograms_.fill("SimParticles.process", particle.getProcessType());
+  // fill the particle histograms from either the table or the map
+  auto fill_particle = [this](int track_id, int pdg_id, int process_type,
+                              double energy, double time,
+                              const auto& momentum, const auto& vertex,
+                              const auto& parents, const auto& daughters) {
+    histograms_.fill("SimParticles.E", energy);
+    histograms_.fill("SimParticles.px", momentum[0]);
+    histograms_.fill("SimParticles.py", momentum[1]);
+    histograms_.fill("SimParticles.pz", momentum[2]);
+    histograms_.fill("SimParticles.time", time);
+    histograms_.fill("SimParticles.pdg", pdg_id);
+    histograms_.fill("SimParticles.x", vertex[0]);
+    histograms_.fill("SimParticles.y", vertex[1]);
+    histograms_.fill("SimParticles.z", vertex[2]);
+    histograms_.fill("SimParticles.process", process_type);
     histograms_.fill("SimParticles.track_id", track_id);
-    for (auto const& parent : particle.getParents())
+    for (auto const& parent : parents)
       histograms_.fill("SimParticles.parent", parent);
-    for (auto const& child : particle.getDaughters())
+    for (auto const& child : daughters)
       histograms_.fill("SimParticles.children", child);
 
     // PN particles are special
-    if (particle.getProcessType() ==
-        ldmx::SimParticle::ProcessType::photonNuclear) {
-      histograms_.fill("pn_child.E", particle.getEnergy());
-      histograms_.fill("pn_child.px", momentum.at(0));
-      histograms_.fill("pn_child.py", momentum.at(1));
-      histograms_.fill("pn_child.pz", momentum.at(2));
-      histograms_.fill("pn_child.time", particle.getTime());
-      histograms_.fill("pn_child.pdg", particle.getPdgID());
-      histograms_.fill("pn_child.x", vertex.at(0));
-      histograms_.fill("pn_child.y", vertex.at(1));
-      histograms_.fill("pn_child.z", vertex.at(2));
+    if (process_type == ldmx::SimParticle::ProcessType::photonNuclear) {
+      histograms_.fill("pn_child.E", energy);
+      histograms_.fill("pn_child.px", momentum[0]);
+      histograms_.fill("pn_child.py", momentum[1]);
+      histograms_.fill("pn_child.pz", momentum[2]);
+      histograms_.fill("pn_child.time", time);
+      histograms_.fill("pn_child.pdg", pdg_id);
+      histograms_.fill("pn_child.x", vertex[0]);
+      histograms_.fill("pn_child.y", vertex[1]);
+      histograms_.fill("pn_child.z", vertex[2]);
       histograms_.fill("pn_child.track_id", track_id);
-      for (auto const& parent : particle.getParents())
+      for (auto const& parent : parents)
         histograms_.fill("pn_child.parent", parent);
-      for (auto const& child : particle.getDaughters())
+      for (auto const& child : daughters)
         histograms_.fill("pn_child.children", child);
     }
-  }  // loop over sim particle map
+  };
+
+  // the table is read column by column without building the particles
+  if (event.exists("SimParticleTable", sim_pass_)) {
+    auto const& table{
+        event.getObject<ldmx::SimParticleTable>("SimParticleTable", sim_pass_)};
+    for (std::size_t i{0}; i < table.size(); i++) {
+      fill_particle(table.getTrackID(i), table.getPdgID(i),
+                    table.getProcessType(i), table.getEnergy(i),
+                    table.getTime(i), table.getMomentum(i), table.getVertex(i),
+                    table.getParents(i), table.getDaughters(i));
+    }  // loop over sim particle table
+  } else {
+    for (auto const& [track_id, particle] :
+         event.getMap<int, ldmx::SimParticle>("SimParticles")) {
+      fill_particle(track_id, particle.getPdgID(), particle.getProcessType(),
+                    particle.getEnergy(), particle.getTime(),
+                    particle.getMomentum(), particle.getVertex(),
+                    particle.getParents(), particle.getDaughters());
+    }  // loop over sim particle map
+  }
 
   for (auto const& pt : calo_colls) {
     auto const& coll{
@@ -0,0 +1,50 @@
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <iostream>
+#include <string>
+
+//-------------//
+//   ldmx-sw   //
+//-------------//
+#include "DetDescr/FieldMap.h"
+#include "Framework/Exception/Exception.h"
+
+/**
+ * @func printUsage
+ *
+ * Print how to use this executable to the terminal.
+ */
+void printUsage() {
+  std::cout << "usage: convert-field-map {text_map} [binary_map]" << std::endl;
+  std::cout << "  Convert a text magnetic field map into the binary format"
+            << std::endl;
+  std::cout << "  that can be memory mapped. If the binary map is not given,"
+            << std::endl;
+  std::cout << "  it is written next to the text map as {text_map}.bin"
+            << " where it is picked up automatically." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 or argc > 3) {
+    printUsage();
+    return 1;
+  }
+
+  std::string text_map{argv[1]};
+  if (text_map == "-h" or text_map == "--help") {
+    printUsage();
+    return 0;
+  }
+  std::string binary_map{argc > 2 ? argv[2] : text_map + ".bin"};
+
+  try {
+    ldmx::FieldMap::convert(text_map, binary_map);
+  } catch (const framework::exception::Exception& e) {
+    std::cerr << "[" << e.name() << "] : " << e.message() << std::endl;
+    return 127;
+  }
+
+  std::cout << "Wrote " << binary_map << std::endl;
+  return 0;
+}
@@ -22,7 +22,12 @@
 #include "Framework/Exception/Exception.h"
 
 // STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <vector>
 
 // ROOT
 #include "TH2Poly.h"
@@ -100,6 +105,101 @@ namespace ldmx {
  */
 class EcalGeometry : public framework::ConditionsObject {
  public:
+  /**
+   * List of the neighbors of a cell
+   *
+   * The neighbors are stored once for all layers with the layer set to
+   * zero, so this only points into the stored list and puts the layer of
+   * the cell the neighbors were requested for into the IDs as they are read.
+   * It is only valid as long as the geometry it came from.
+   */
+  class NeighborRange {
+   public:
+    /**
+     * Iterator over the neighbors, returning full IDs
+     */
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = EcalID;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = EcalID;
+
+      /// Constructor
+      iterator(const EcalID* flat, int layer) : flat_{flat}, layer_{layer} {}
+      /// @return the neighbor in the layer of the cell
+      EcalID operator*() const {
+        return EcalID(layer_, flat_->module(), flat_->cell());
+      }
+      /// go to the next neighbor
+      iterator& operator++() {
+        ++flat_;
+        return *this;
+      }
+      /// go to the next neighbor
+      iterator operator++(int) {
+        iterator before{*this};
+        ++flat_;
+        return before;
+      }
+      /// @return true if both point to the same neighbor
+      bool operator==(const iterator& other) const {
+        return flat_ == other.flat_;
+      }
+      /// @return true if they point to different neighbors
+      bool operator!=(const iterator& other) const {
+        return flat_ != other.flat_;
+      }
+
+     private:
+      /// current neighbor with layer set to zero
+      const EcalID* flat_;
+      /// layer to put into the IDs
+      int layer_;
+    };
+
+    /// Constructor
+    NeighborRange(const EcalID* begin, const EcalID* end, int layer)
+        : begin_{begin}, end_{end}, layer_{layer} {}
+
+    /// @return iterator to the first neighbor
+    iterator begin() const { return iterator(begin_, layer_); }
+    /// @return iterator past the last neighbor
+    iterator end() const { return iterator(end_, layer_); }
+    /// @return number of neighbors
+    std::size_t size() const { return end_ - begin_; }
+    /// @return true if there are no neighbors
+    bool empty() const { return begin_ == end_; }
+    /// @return i'th neighbor
+    EcalID operator[](std::size_t i) const {
+      return *iterator(begin_ + i, layer_);
+    }
+
+    /**
+     * Check if an ID is in this list
+     *
+     * The stored neighbors are sorted, so this is a binary search over
+     * a handful of IDs.
+     *
+     * @param[in] id ID to look for, including its layer
+     * @return true if id is one of the neighbors
+     */
+    bool contains(EcalID id) const {
+      return id.layer() == layer_ and
+             std::binary_search(begin_, end_,
+                                EcalID(0, id.module(), id.cell()));
+    }
+
+   private:
+    /// first neighbor with layer set to zero
+    const EcalID* begin_;
+    /// past the last neighbor with layer set to zero
+    const EcalID* end_;
+    /// layer of the cell the neighbors are of
+    int layer_;
+  };
+
   static constexpr const char* CONDITIONS_OBJECT_NAME{"EcalGeometry"};
 
   /**
@@ -175,6 +275,21 @@ class EcalGeometry : public framework::ConditionsObject {
   EcalID getID(double x, double y, int layer_id, int module_id,
                bool fallible = false) const;
 
+  /**
+   * Get a cell's ID from its x,y global position and layer number
+   * by looping over the modules and searching the TH2Poly of cells.
+   *
+   * This is how the IDs were found before the closed-form hexagonal
+   * lattice lookups in getID and is much slower. It is only kept to
+   * validate that getID gives the same IDs.
+   *
+   * @param[in] x global x position [mm]
+   * @param[in] y global y position [mm]
+   * @param[in] layer_id integer ID of the layer the hit is in
+   * @return EcalID of the cell (null-id if not in a cell)
+   */
+  EcalID getIDWithPoly(double x, double y, int layer_id) const;
+
   /**
    * Get a cell's position from its ID number
    *
@@ -238,11 +353,8 @@ class EcalGeometry : public framework::ConditionsObject {
    * @param id id to get
    * @return list of EcalID that are the inputs nearest neighbors
    */
-  std::vector<EcalID> getNN(EcalID id) const {
-    auto list = NNMap_.at(EcalID(0, id.module(), id.cell()));
-    for (auto& flat : list)
-      flat = EcalID(id.layer(), flat.module(), flat.cell());
-    return list;
+  NeighborRange getNN(EcalID id) const {
+    return neighbors(nn_offsets_, nn_cells_, id);
   }
 
   /**
@@ -253,10 +365,7 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return true if probe ID is a nearest neighbor of the centroid
    */
   bool isNN(EcalID centroid, EcalID probe) const {
-    for (auto& id : getNN(centroid)) {
-      if (id == probe) return true;
-    }
-    return false;
+    return getNN(centroid).contains(probe);
   }
 
   /**
@@ -265,11 +374,8 @@ class EcalGeometry : public framework::ConditionsObject {
    * @param id id to get
    * @return list of EcalID that are the inputs next-to-nearest neighbors
    */
-  std::vector<EcalID> getNNN(EcalID id) const {
-    auto list = NNNMap_.at(EcalID(0, id.module(), id.cell()));
-    for (auto& flat : list)
-      flat = EcalID(id.layer(), flat.module(), flat.cell());
-    return list;
+  NeighborRange getNNN(EcalID id) const {
+    return neighbors(nnn_offsets_, nnn_cells_, id);
   }
 
   /**
@@ -281,10 +387,7 @@ class EcalGeometry : public framework::ConditionsObject {
    * @return true if probe ID is a next-to-nearest neighbor of the centroid
    */
   bool isNNN(EcalID centroid, EcalID probe) const {
-    for (auto& id : getNNN(centroid)) {
-      if (id == probe) return true;
-    }
-    return false;
+    return getNNN(centroid).contains(probe);
   }
 
   /**
@@ -418,7 +521,7 @@ class EcalGeometry : public framework::ConditionsObject {
   void buildCellModuleMap();
 
   /**
-   * Construts NNMap and NNNMap
+   * Construts the nearest and next-to-nearest neighbor tables
    *
    * Since this only occurs once during processing, we can be wasteful.
    * We do a nested loop over the entire cellular position map and calculate
@@ -430,13 +533,25 @@ class EcalGeometry : public framework::ConditionsObject {
    *
    * @param[in] cellModulePostionMap_ map of cells to cell centers relative to
    * ecal
-   * @param[out] NNMap_ map of cell IDs to list of cell IDs that are its nearest
-   * neighbors
-   * @param[out] NNNMap_ map of cell IDs to list of cell IDs that are its
-   * next-to-nearest neighbors
+   * @param[out] nn_cells_ list of cell IDs that are the nearest neighbors
+   * of each cell
+   * @param[out] nnn_cells_ list of cell IDs that are the next-to-nearest
+   * neighbors of each cell
    */
   void buildNeighborMaps();
 
+  /**
+   * Get the neighbors of a cell from one of the neighbor tables
+   *
+   * @param[in] offsets start of the list for each cell in cells
+   * @param[in] cells neighbors of all the cells
+   * @param[in] id ID of the cell to get the neighbors of
+   * @return the neighbors of the cell in its layer
+   * @throws Exception if the module or cell of the id does not exist
+   */
+  NeighborRange neighbors(const std::vector<std::size_t>& offsets,
+                          const std::vector<EcalID>& cells, EcalID id) const;
+
   /**
    * Distance to module edge, and whether cell is on edge of module.
    *
@@ -476,6 +591,35 @@ class EcalGeometry : public framework::ConditionsObject {
    */
   bool isInside(double normX, double normY) const;
 
+  /**
+   * Builds the lookup tables from positions to modules and cells
+   * on their hexagonal lattices.
+   *
+   * The modules are the central seven sites of a lattice whose spacing is
+   * the distance between module centers. Since the modules are smaller than
+   * the lattice hexagons, only the module on the lattice site nearest to a
+   * position could contain it.
+   *
+   * The cells are the hexagons of the honeycomb they were cut from in
+   * buildCellMap. For each site on this honeycomb we store the cells that
+   * could contain a position rounded to that site: usually just the one
+   * regular cell at that site, but the cells cut by the edge of the module
+   * have their own polygons which we check explicitly.
+   */
+  void buildLatticeMaps();
+
+  /**
+   * Find the cell containing a position relative to the module center
+   *
+   * Gives the same result as the TH2Poly of cells, that is the first cell
+   * whose polygon contains the position.
+   *
+   * @param[in] p position along p axis relative to module center [mm]
+   * @param[in] q position along q axis relative to module center [mm]
+   * @return cell ID, negative if not inside any cell
+   */
+  int findCell(double p, double q) const;
+
  private:
   /// Gap between module flat sides [mm]
   double gap_;
@@ -596,18 +740,34 @@ class EcalGeometry : public framework::ConditionsObject {
   std::map<EcalID, std::tuple<double, double, double>> cell_global_pos_;
 
   /**
-   * Map of cell ID to neighboring cells
+   * Start of the list of nearest neighbors of each cell in nn_cells_
+   * (with one extra entry for the end of the last list)
    *
-   * The EcalID's in this map all have layer ID set to zero.
+   * Indexed by module*(number of cells per module)+cell.
    */
-  std::map<EcalID, std::vector<EcalID>> NNMap_;
+  std::vector<std::size_t> nn_offsets_;
 
   /**
-   * Map of cell ID to neighbors of neighbor cells
+   * Nearest neighbors of all the cells, each list in increasing order
    *
-   * The EcalID's in this map all have layer ID set to zero.
+   * The EcalID's in this list all have layer ID set to zero.
    */
-  std::map<EcalID, std::vector<EcalID>> NNNMap_;
+  std::vector<EcalID> nn_cells_;
+
+  /**
+   * Start of the list of next-to-nearest neighbors of each cell in
+   * nnn_cells_ (with one extra entry for the end of the last list)
+   *
+   * Indexed by module*(number of cells per module)+cell.
+   */
+  std::vector<std::size_t> nnn_offsets_;
+
+  /**
+   * Next-to-nearest neighbors of all the cells, each list in increasing order
+   *
+   * The EcalID's in this list all have layer ID set to zero.
+   */
+  std::vector<EcalID> nnn_cells_;
 
   /**
    * Honeycomb Binning from ROOT
@@ -618,6 +778,58 @@ class EcalGeometry : public framework::ConditionsObject {
    * the module in p,q space.
    */
   mutable TH2Poly cell_id_in_module_;
+
+  /**
+   * Layer z positions sorted by z paired with their layer IDs
+   */
+  std::vector<std::pair<double, int>> layer_by_z_;
+
+  /**
+   * Module IDs on the module lattice
+   *
+   * Indexed by the axial lattice coordinates (a,b) of the module centers
+   * as 3*(b+1)+(a+1), -1 for sites without a module.
+   */
+  std::array<int, 9> module_lattice_;
+
+  /// Center-to-corner radius of the module lattice hexagons [mm]
+  double module_lattice_R_{0};
+
+  /**
+   * Polygon of each cell in p,q space relative to the module center
+   *
+   * These are the same polygons as in cell_id_in_module_, indexed by cell ID.
+   */
+  std::vector<std::vector<std::pair<double, double>>> cell_polygons_;
+
+  /// center of the first hexagon of the honeycomb in p,q space [mm]
+  std::pair<double, double> cell_lattice_origin_;
+
+  /// offset (column,row) of the first site in the cell lattice tables
+  std::pair<int, int> cell_lattice_first_;
+
+  /// number of columns and rows in the cell lattice tables
+  std::pair<int, int> cell_lattice_size_;
+
+  /**
+   * The regular cell covering each lattice site if there are no other
+   * cells that could contain positions well inside of that site,
+   * -1 otherwise
+   */
+  std::vector<int> cell_lattice_;
+
+  /**
+   * Start of the list of cells that could contain positions at each
+   * lattice site in cell_lattice_candidates_ (with one extra entry
+   * for the end of the last list)
+   */
+  std::vector<std::size_t> cell_lattice_offsets_;
+
+  /**
+   * Cells that could contain positions at each lattice site
+   * in order of increasing cell ID
+   */
+  std::vector<int> cell_lattice_candidates_;
 };
 
 }  // namespace ldmx
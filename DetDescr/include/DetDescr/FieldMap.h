@@ -0,0 +1,189 @@
+/**
+ * @file FieldMap.h
+ * @brief Grid of magnetic field values shared within a process
+ */
+
+#ifndef DETDESCR_FIELDMAP_H_
+#define DETDESCR_FIELDMAP_H_
+
+// STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ldmx {
+
+/**
+ * @class FieldMap
+ * @brief A 3D grid of magnetic field values stored in one flat array
+ *
+ * The field map is used by the Geant4 field in the simulation and by
+ * the interpolated field in the tracking. Both of these used to parse
+ * the (large) text file of the map themselves, and the tracking did it
+ * again for every processor that needed the field. Instead, they all
+ * get the map through FieldMap::load which shares one copy of each map
+ * between all of its users in the process. The map is freed once the
+ * last user lets go of it, so users that only need the map once (like
+ * the tracking, which copies it into its own grid) should keep their
+ * own reference if they may ask for it again.
+ *
+ * Two formats are supported.
+ *
+ * #### Text
+ * The format described in simcore::MagneticFieldMap3D: a blank line,
+ * the number of grid points along x, y and z, more header lines until
+ * one whose second character is '0', and then one line per grid point
+ * with "x y z Bx By Bz" where z changes the fastest.
+ *
+ * #### Binary
+ * A header (see Header) followed by the field values as native doubles
+ * in the same order as the text file (Bx, By, Bz for each grid point).
+ * These files are memory mapped, so loading them is nearly instant and
+ * the pages are shared between processes reading the same map.
+ * The `convert-field-map` executable writes the binary file for a text
+ * file. If a converted file named `<text file>.bin` exists next to the
+ * text file, load uses it instead of parsing the text.
+ *
+ * The values are kept in the units of the file, the users of the map
+ * apply their own units.
+ */
+class FieldMap {
+ public:
+  /// header at the start of a binary field map file
+  struct Header {
+    /// identifies the file as a binary field map
+    char magic[8];
+    /// version of the binary format
+    uint32_t version;
+    /// number of grid points along x, y and z
+    uint32_t size[3];
+    /// coordinates of the first grid point in the file
+    double first[3];
+    /// coordinates of the last grid point in the file
+    double last[3];
+  };
+
+  /// value of Header::magic for binary field maps
+  static const char MAGIC[8];
+
+  /// current version of the binary format
+  static const uint32_t VERSION;
+
+  /**
+   * Load a field map, sharing it with any other users in this process
+   *
+   * If the file was already loaded and the map is still in use,
+   * we return the same map instead of reading the file again.
+   *
+   * @throws Exception if the file does not exist or is malformed
+   *
+   * @param[in] filename path to text or binary field map
+   * @returns shared handle to the field map
+   */
+  static std::shared_ptr<const FieldMap> load(const std::string &filename);
+
+  /**
+   * Convert a text field map into a binary one
+   *
+   * @param[in] text_file path to text field map to read
+   * @param[in] binary_file path to write binary field map to
+   */
+  static void convert(const std::string &text_file,
+                      const std::string &binary_file);
+
+  /// unmap the file if we mapped one
+  ~FieldMap();
+
+  /// not copyable since we may own a mapping
+  FieldMap(const FieldMap &) = delete;
+  /// not copyable since we may own a mapping
+  FieldMap &operator=(const FieldMap &) = delete;
+
+  /**
+   * Write this map in the binary format
+   *
+   * @param[in] filename path to file to write
+   */
+  void write(const std::string &filename) const;
+
+  /// number of grid points along x
+  std::size_t nx() const { return header_.size[0]; }
+
+  /// number of grid points along y
+  std::size_t ny() const { return header_.size[1]; }
+
+  /// number of grid points along z
+  std::size_t nz() const { return header_.size[2]; }
+
+  /// coordinates of the first grid point in the file
+  const double *first() const { return header_.first; }
+
+  /// coordinates of the last grid point in the file
+  const double *last() const { return header_.last; }
+
+  /**
+   * Get the field at a grid point
+   *
+   * @param[in] ix index of grid point along x
+   * @param[in] iy index of grid point along y
+   * @param[in] iz index of grid point along z
+   * @returns pointer to Bx, By, Bz at that grid point
+   */
+  const double *at(std::size_t ix, std::size_t iy, std::size_t iz) const {
+    return values_ + 3 * ((ix * ny() + iy) * nz() + iz);
+  }
+
+  /// all field values, Bx, By, Bz for each grid point in file order
+  const double *values() const { return values_; }
+
+  /// was this map memory mapped from a binary file?
+  bool isMapped() const { return mapping_ != nullptr; }
+
+  /// path to file this map was loaded from
+  const std::string &getFilename() const { return filename_; }
+
+ private:
+  /// only load can create maps
+  FieldMap() = default;
+
+  /**
+   * Parse a text field map
+   *
+   * @param[in] filename path to text field map
+   * @returns new field map
+   */
+  static std::unique_ptr<FieldMap> readText(const std::string &filename);
+
+  /**
+   * Memory map a binary field map
+   *
+   * @param[in] filename path to binary field map
+   * @returns new field map
+   */
+  static std::unique_ptr<FieldMap> mapBinary(const std::string &filename);
+
+  /// path this map was loaded from
+  std::string filename_;
+
+  /// dimensions and extent of the grid
+  Header header_;
+
+  /// field values, either into storage_ or into the mapped file
+  const double *values_{nullptr};
+
+  /// field values read from a text file
+  std::vector<double> storage_;
+
+  /// start of the mapped file (nullptr if not mapped)
+  void *mapping_{nullptr};
+
+  /// size of the mapped file
+  std::size_t mapping_size_{0};
+};
+
+}  // namespace ldmx
+
+#endif  // DETDESCR_FIELDMAP_H_
@@ -195,6 +195,16 @@ class HcalGeometry : public framework::ConditionsObject {
   std::vector<double> rotateGlobalToLocalBarPosition(
       const std::vector<double> &globalPosition, const ldmx::HcalID &id) const;
 
+  /**
+   * Make a geometry outside of the provider, only meant for tests
+   *
+   * @param ps Parameters to configure the HcalGeometry
+   * @return pointer to new geometry, owned by the caller
+   */
+  static HcalGeometry *debugMake(const framework::config::Parameters &ps) {
+    return new HcalGeometry(ps);
+  }
+
  private:
   /**
    * Class constructor, for use only by the provider
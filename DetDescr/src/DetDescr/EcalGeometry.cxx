@@ -2,6 +2,9 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -48,6 +51,68 @@ static void unrotate(double& p, double& q) {
   q = -tmp;
 }
 
+/**
+ * Round a position to the nearest site of a hexagonal lattice
+ *
+ * The lattice has a site at the origin and neighboring sites along the
+ * first axis, i.e. its hexagons are corner-side up. Since the lattice
+ * hexagons tile the plane, the nearest site is the one whose hexagon
+ * contains the position.
+ *
+ * @param[in] u position along first axis relative to site at origin
+ * @param[in] v position along second axis relative to site at origin
+ * @param[in] R center-to-corner radius of lattice hexagons
+ * @return axial coordinates (a,b) of the nearest site, which is
+ * at (sqrt(3)*R*(a+b/2), 1.5*R*b)
+ */
+static std::pair<int, int> round_to_lattice(double u, double v, double R) {
+  double fa = (u / sqrt(3.) - v / 3.) / R;
+  double fb = (2. / 3.) * v / R;
+  double fc = -fa - fb;
+  double a = std::round(fa), b = std::round(fb), c = std::round(fc);
+  // correct the coordinate that was rounded the furthest
+  double da = std::abs(a - fa), db = std::abs(b - fb), dc = std::abs(c - fc);
+  if (da > db and da > dc) {
+    a = -b - c;
+  } else if (db > dc) {
+    b = -a - c;
+  }
+  return {static_cast<int>(a), static_cast<int>(b)};
+}
+
+/**
+ * Determine if a point is inside of a polygon
+ *
+ * This is the same even-odd rule as TMath::IsInside so that points on the
+ * boundary between cells end up in the same cell as with the TH2Poly.
+ *
+ * @param[in] p position along p axis
+ * @param[in] q position along q axis
+ * @param[in] polygon vertices of polygon
+ * @return true if (p,q) is inside of the polygon
+ */
+static bool is_inside_polygon(
+    double p, double q,
+    const std::vector<std::pair<double, double>>& polygon) {
+  bool odd_nodes{false};
+  for (std::size_t i{0}, j{polygon.size() - 1}; i < polygon.size(); j = i++) {
+    const auto& [pi, qi] = polygon[i];
+    const auto& [pj, qj] = polygon[j];
+    if ((qi < q and qj >= q) or (qj < q and qi >= q)) {
+      if (pi + (q - qi) / (qj - qi) * (pj - pi) < p) odd_nodes = !odd_nodes;
+    }
+  }
+  return odd_nodes;
+}
+
+/**
+ * Tolerance on positions for the lattice lookups [mm]
+ *
+ * Much larger than the rounding errors in the polygon vertices
+ * and much smaller than the cells.
+ */
+static const double LATTICE_TOLERANCE = 1e-6;
+
 EcalGeometry::EcalGeometry(const framework::config::Parameters& ps)
     : framework::ConditionsObject(EcalGeometry::CONDITIONS_OBJECT_NAME) {
   layerZPositions_ = ps.getParameter<std::vector<double>>("layerZPositions");
@@ -86,6 +151,7 @@ EcalGeometry::EcalGeometry(const framework::config::Parameters& ps)
   buildCellMap();
   buildCellModuleMap();
   buildNeighborMaps();
+  buildLatticeMaps();
 
   if (verbose_ > 0)
     std::cout << "[EcalGeometry] : fully constructed" << std::endl;
@@ -94,10 +160,13 @@ EcalGeometry::EcalGeometry(const framework::config::Parameters& ps)
 EcalID EcalGeometry::getID(double x, double y, double z, bool fallible) const {
   static const double tolerance = 0.3;  // thickness of Si
   int layer_id{-1};
-  for (const auto& [lid, layer_xyz] : layer_pos_xy_) {
-    if (abs(std::get<2>(layer_xyz) - z) < tolerance) {
-      layer_id = lid;
-      break;
+  // only the layers within tolerance of z need to be checked
+  for (auto it = std::lower_bound(layer_by_z_.begin(), layer_by_z_.end(),
+                                  std::make_pair(z - tolerance, INT_MIN));
+       it != layer_by_z_.end() and it->first < z + tolerance; ++it) {
+    if (std::abs(it->first - z) < tolerance and
+        (layer_id < 0 or it->second < layer_id)) {
+      layer_id = it->second;
     }
   }
   if (layer_id < 0) {
@@ -121,16 +190,21 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id,
       q{y - std::get<1>(layer_pos_xy_.at(layer_id))};
 
   // deduce module ID
-  //    there are only 7 modules so we just loop through them
-  //    all and pick out the module ID that we are inside of
+  //    the modules are smaller than the hexagons of the lattice their
+  //    centers are on, so we only need to check the module on the
+  //    lattice site nearest to us
 
   int module_id{-1};
-  for (auto const& [mid, module_xy] : module_pos_xy_) {
-    double probe_x{p - module_xy.first}, probe_y{q - module_xy.second};
-    if (cornersSideUp_) rotate(probe_x, probe_y);
-    if (isInside(probe_x / moduleR_, probe_y / moduleR_)) {
-      module_id = mid;
-      break;
+  double u{p}, v{q};
+  if (not cornersSideUp_) unrotate(u, v);
+  auto [a, b] = round_to_lattice(u, v, module_lattice_R_);
+  if (std::abs(a) <= 1 and std::abs(b) <= 1) {
+    int mid = module_lattice_[3 * (b + 1) + (a + 1)];
+    if (mid >= 0) {
+      const auto& module_xy{module_pos_xy_.at(mid)};
+      double probe_x{p - module_xy.first}, probe_y{q - module_xy.second};
+      if (cornersSideUp_) rotate(probe_x, probe_y);
+      if (isInside(probe_x / moduleR_, probe_y / moduleR_)) module_id = mid;
     }
   }
 
@@ -165,7 +239,7 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id, int module_id,
   if (cornersSideUp_) rotate(p, q);
 
   // deduce cell ID
-  int cell_id = cell_id_in_module_.FindBin(p, q) - 1;
+  int cell_id = findCell(p, q);
 
   if (cell_id < 0) {
     if (fallible) {
@@ -185,6 +259,56 @@ EcalID EcalGeometry::getID(double x, double y, int layer_id, int module_id,
   return EcalID(layer_id, module_id, cell_id);
 }
 
+EcalID EcalGeometry::getIDWithPoly(double x, double y, int layer_id) const {
+  double p{x - std::get<0>(layer_pos_xy_.at(layer_id))},
+      q{y - std::get<1>(layer_pos_xy_.at(layer_id))};
+
+  for (auto const& [module_id, module_xy] : module_pos_xy_) {
+    double probe_p{p - module_xy.first}, probe_q{q - module_xy.second};
+    if (cornersSideUp_) rotate(probe_p, probe_q);
+    if (isInside(probe_p / moduleR_, probe_q / moduleR_)) {
+      int cell_id = cell_id_in_module_.FindBin(probe_p, probe_q) - 1;
+      if (cell_id < 0) return ldmx::EcalID(0);
+      return EcalID(layer_id, module_id, cell_id);
+    }
+  }
+
+  return ldmx::EcalID(0);
+}
+
+int EcalGeometry::findCell(double p, double q) const {
+  const auto& [origin_p, origin_q] = cell_lattice_origin_;
+  auto [a, b] = round_to_lattice(p - origin_p, q - origin_q, cellR_);
+  // the honeycomb rows alternate being shifted by half a cell
+  int col = a + (b - (b & 1)) / 2 - cell_lattice_first_.first;
+  int row = b - cell_lattice_first_.second;
+  if (col < 0 or row < 0 or col >= cell_lattice_size_.first or
+      row >= cell_lattice_size_.second) {
+    return -1;
+  }
+  std::size_t site = row * cell_lattice_size_.first + col;
+
+  int cell_id = cell_lattice_[site];
+  if (cell_id >= 0) {
+    // a regular cell covers this site, only positions near its edge
+    // could be inside of one of its neighbors instead
+    double dp = std::abs(p - origin_p - sqrt(3.) * cellR_ * (a + 0.5 * b));
+    double dq = std::abs(q - origin_q - 1.5 * cellR_ * b);
+    if (dp < cellr_ - LATTICE_TOLERANCE and
+        dp / sqrt(3.) + dq < cellR_ - LATTICE_TOLERANCE) {
+      return cell_id;
+    }
+  }
+
+  for (std::size_t i{cell_lattice_offsets_[site]};
+       i < cell_lattice_offsets_[site + 1]; i++) {
+    int candidate = cell_lattice_candidates_[i];
+    if (is_inside_polygon(p, q, cell_polygons_[candidate])) return candidate;
+  }
+
+  return -1;
+}
+
 std::tuple<double, double, double> EcalGeometry::getPosition(EcalID id) const {
   return cell_global_pos_.at(id);
 }
@@ -231,7 +355,9 @@ void EcalGeometry::buildLayerMap() {
                 << y << ", " << z << ") mm" << std::endl;
     }
     layer_pos_xy_[i_layer] = std::make_tuple(x, y, z);
+    layer_by_z_.emplace_back(z, i_layer);
   }
+  std::sort(layer_by_z_.begin(), layer_by_z_.end());
 }
 
 void EcalGeometry::buildModuleMap() {
@@ -316,6 +442,7 @@ void EcalGeometry::buildCellMap() {
   numQCells *= 2;
 
   gridMap.Honeycomb(gridMinP, gridMinQ, cellR_, numPCells, numQCells);
+  cell_lattice_origin_ = std::make_pair(gridMinP + cellr_, gridMinQ + cellR_);
 
   if (verbose_ > 0) {
     std::cout << std::setprecision(2)
@@ -472,6 +599,9 @@ void EcalGeometry::buildCellMap() {
       //  because the polygon that was copied over from gridMap is deleted at
       //  the end of this function
       cell_id_in_module_.AddBin(num_vertices, actual_p, actual_q);
+      auto& polygon{cell_polygons_.emplace_back()};
+      for (int i = 0; i < num_vertices; i++)
+        polygon.emplace_back(actual_p[i], actual_q[i]);
 
       /**
        * TODO is this needed?
@@ -551,23 +681,41 @@ void EcalGeometry::buildNeighborMaps() {
     std::cout << "[EcalGeometry::buildNeighborMaps] : "
               << "Building Nearest and Next-Nearest Neighbor maps" << std::endl;
 
-  NNMap_.clear();
-  NNNMap_.clear();
+  const std::size_t num_cells{cell_pos_in_module_.size()};
+  std::vector<std::vector<EcalID>> nn(getNumModulesPerLayer() * num_cells),
+      nnn(getNumModulesPerLayer() * num_cells);
   for (auto const& [center_id, center_xyz] : cell_pos_in_layer_) {
+    std::size_t center{center_id.module() * num_cells + center_id.cell()};
+    // the probes are visited in order of increasing ID,
+    //  so each list of neighbors is sorted
     for (auto const& [probe_id, probe_xyz] : cell_pos_in_layer_) {
       /// do distance calculation
       double dist = distance(probe_xyz, center_xyz);
       if (dist > 1 * cellr_ && dist <= 3. * cellr_) {
-        NNMap_[center_id].push_back(probe_id);
+        nn[center].push_back(probe_id);
       } else if (dist > 3. * cellr_ && dist <= 4.5 * cellr_) {
-        NNNMap_[center_id].push_back(probe_id);
+        nnn[center].push_back(probe_id);
       }
     }
     if (verbose_ > 1)
-      std::cout << "  Found " << NNMap_[center_id].size() << " NN and "
-                << NNNMap_[center_id].size() << " NNN for cell " << center_id
+      std::cout << "  Found " << nn[center].size() << " NN and "
+                << nnn[center].size() << " NNN for cell " << center_id
                 << std::endl;
   }
+
+  // flatten the lists so that looking up neighbors doesn't allocate
+  auto flatten = [](const std::vector<std::vector<EcalID>>& lists,
+                    std::vector<std::size_t>& offsets,
+                    std::vector<EcalID>& cells) {
+    offsets.assign(1, 0);
+    cells.clear();
+    for (const auto& list : lists) {
+      cells.insert(cells.end(), list.begin(), list.end());
+      offsets.push_back(cells.size());
+    }
+  };
+  flatten(nn, nn_offsets_, nn_cells_);
+  flatten(nnn, nnn_offsets_, nnn_cells_);
   /*
    * DEBUG CHECK HERE
    *  this is double checking that NN and NNN can cross modules
@@ -580,14 +728,14 @@ void EcalGeometry::buildNeighborMaps() {
     std::cout << "The neighbors of the bin in the upper-right corner of the "
                  "center module, with cellModuleID "
               << specialCellModuleID << " include " << std::endl;
-    for (auto centerNN : NNMap_.at(specialCellModuleID)) {
+    for (auto centerNN : getNN(specialCellModuleID)) {
       std::cout << " NN " << centerNN
                 << TString::Format(" (x,y) (%.2f, %.2f)",
                                    getCellCenterAbsolute(centerNN).first,
                                    getCellCenterAbsolute(centerNN).second)
                 << std::endl;
     }
-    for (auto centerNNN : NNNMap_.at(specialCellModuleID)) {
+    for (auto centerNNN : getNNN(specialCellModuleID)) {
       std::cout << " NNN " << centerNNN
                 << TString::Format(" (x,y) (%.2f, %.2f)",
                                    getCellCenterAbsolute(centerNNN).first,
@@ -605,6 +753,122 @@ void EcalGeometry::buildNeighborMaps() {
   return;
 }
 
+EcalGeometry::NeighborRange EcalGeometry::neighbors(
+    const std::vector<std::size_t>& offsets, const std::vector<EcalID>& cells,
+    EcalID id) const {
+  const std::size_t num_cells{cell_pos_in_module_.size()};
+  if (id.module() >= getNumModulesPerLayer() or
+      std::size_t(id.cell()) >= num_cells) {
+    EXCEPTION_RAISE("BadID", "Cell " + std::to_string(id.cell()) +
+                                 " in module " + std::to_string(id.module()) +
+                                 " does not exist.");
+  }
+  std::size_t i{id.module() * num_cells + id.cell()};
+  return NeighborRange(cells.data() + offsets[i], cells.data() + offsets[i + 1],
+                       id.layer());
+}
+
+void EcalGeometry::buildLatticeMaps() {
+  if (verbose_ > 0)
+    std::cout << "[EcalGeometry::buildLatticeMaps] : "
+              << "Building module and cell lattice lookup tables" << std::endl;
+
+  // module centers are on a lattice spaced by the module width and gap
+  module_lattice_R_ = (2. * moduler_ + gap_) / sqrt(3.);
+  module_lattice_.fill(-1);
+  for (auto const& [module_id, module_xy] : module_pos_xy_) {
+    double u{module_xy.first}, v{module_xy.second};
+    if (not cornersSideUp_) unrotate(u, v);
+    auto [a, b] = round_to_lattice(u, v, module_lattice_R_);
+    if (std::abs(a) > 1 or std::abs(b) > 1 or std::abs(a + b) > 1) {
+      EXCEPTION_RAISE("BadConf", "Module " + std::to_string(module_id) +
+                                     " is not next to the center module.");
+    }
+    module_lattice_[3 * (b + 1) + (a + 1)] = module_id;
+  }
+
+  // the cells are on the honeycomb lattice, find the range of sites
+  // they cover with some padding for the polygons extending past the
+  // hexagons at the module edge
+  const auto& [origin_p, origin_q] = cell_lattice_origin_;
+  std::vector<std::pair<int, int>> cell_sites;
+  int min_col{INT_MAX}, max_col{INT_MIN}, min_row{INT_MAX}, max_row{INT_MIN};
+  for (auto const& [cell_id, cell_pq] : cell_pos_in_module_) {
+    auto [a, b] = round_to_lattice(cell_pq.first - origin_p,
+                                   cell_pq.second - origin_q, cellR_);
+    int col = a + (b - (b & 1)) / 2;
+    cell_sites.emplace_back(col, b);
+    min_col = std::min(min_col, col);
+    max_col = std::max(max_col, col);
+    min_row = std::min(min_row, b);
+    max_row = std::max(max_row, b);
+  }
+  static const int padding{2};
+  cell_lattice_first_ = std::make_pair(min_col - padding, min_row - padding);
+  cell_lattice_size_ = std::make_pair(max_col - min_col + 1 + 2 * padding,
+                                      max_row - min_row + 1 + 2 * padding);
+
+  // bounding boxes of the cell polygons
+  std::vector<std::array<double, 4>> cell_boxes;
+  for (const auto& polygon : cell_polygons_) {
+    std::array<double, 4> box{polygon[0].first, polygon[0].first,
+                              polygon[0].second, polygon[0].second};
+    for (const auto& [p, q] : polygon) {
+      box[0] = std::min(box[0], p);
+      box[1] = std::max(box[1], p);
+      box[2] = std::min(box[2], q);
+      box[3] = std::max(box[3], q);
+    }
+    cell_boxes.push_back(box);
+  }
+
+  std::size_t num_sites = cell_lattice_size_.first * cell_lattice_size_.second;
+  cell_lattice_.assign(num_sites, -1);
+  std::vector<bool> regular_sites(num_sites, false);
+  cell_lattice_offsets_.assign(1, 0);
+  cell_lattice_candidates_.clear();
+  for (int row{0}; row < cell_lattice_size_.second; row++) {
+    for (int col{0}; col < cell_lattice_size_.first; col++) {
+      int b = row + cell_lattice_first_.second;
+      int a = col + cell_lattice_first_.first - (b - (b & 1)) / 2;
+      double site_p = origin_p + sqrt(3.) * cellR_ * (a + 0.5 * b);
+      double site_q = origin_q + 1.5 * cellR_ * b;
+
+      // any cell that overlaps the site could contain positions rounded to it
+      bool all_regular{true};
+      for (int cell_id{0}; cell_id < int(cell_polygons_.size()); cell_id++) {
+        const auto& box{cell_boxes[cell_id]};
+        if (box[0] > site_p + cellr_ + LATTICE_TOLERANCE or
+            box[1] < site_p - cellr_ - LATTICE_TOLERANCE or
+            box[2] > site_q + cellR_ + LATTICE_TOLERANCE or
+            box[3] < site_q - cellR_ - LATTICE_TOLERANCE) {
+          continue;
+        }
+        cell_lattice_candidates_.push_back(cell_id);
+        if (cell_polygons_[cell_id].size() != 6) all_regular = false;
+      }
+      cell_lattice_offsets_.push_back(cell_lattice_candidates_.size());
+
+      regular_sites[row * cell_lattice_size_.first + col] = all_regular;
+    }
+  }
+
+  // sites that only overlap regular cells can skip the polygon checks
+  // for positions well inside of the cell at that site
+  for (int cell_id{0}; cell_id < int(cell_sites.size()); cell_id++) {
+    std::size_t site =
+        (cell_sites[cell_id].second - cell_lattice_first_.second) *
+            cell_lattice_size_.first +
+        (cell_sites[cell_id].first - cell_lattice_first_.first);
+    if (regular_sites[site]) cell_lattice_[site] = cell_id;
+  }
+
+  if (verbose_ > 0)
+    std::cout << "  " << num_sites << " cell lattice sites with "
+              << cell_lattice_candidates_.size() << " candidate cells"
+              << std::endl;
+}
+
 double EcalGeometry::distanceToEdge(EcalID id) const {
   // https://math.stackexchange.com/questions/1210572/find-the-distance-to-the-edge-of-a-hexagon
   std::pair<double, double> cellLocation = cell_pos_in_module_.at(id.cell());
@@ -0,0 +1,204 @@
+#include "DetDescr/FieldMap.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include "Framework/Exception/Exception.h"
+
+namespace ldmx {
+
+const char FieldMap::MAGIC[8] = {'L', 'D', 'M', 'X', 'B', 'M', 'A', 'P'};
+
+const uint32_t FieldMap::VERSION = 1;
+
+/**
+ * Check if the input file starts with the binary field map magic
+ *
+ * @param[in] filename path to file to check
+ * @returns true if the file is a binary field map
+ */
+static bool is_binary(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  char magic[sizeof(FieldMap::MAGIC)];
+  if (!file.read(magic, sizeof(magic))) return false;
+  return std::memcmp(magic, FieldMap::MAGIC, sizeof(magic)) == 0;
+}
+
+std::shared_ptr<const FieldMap> FieldMap::load(const std::string& filename) {
+  namespace fs = std::filesystem;
+  if (!fs::exists(filename)) {
+    EXCEPTION_RAISE("FileDNE",
+                    "The field map file '" + filename + "' does not exist!");
+  }
+
+  static std::mutex cache_mutex;
+  static std::map<std::string, std::weak_ptr<const FieldMap>> cache;
+
+  std::string key{fs::weakly_canonical(filename).string()};
+  std::lock_guard<std::mutex> lock{cache_mutex};
+  if (auto cached = cache[key].lock()) return cached;
+
+  std::unique_ptr<FieldMap> map;
+  if (is_binary(key)) {
+    map = mapBinary(key);
+  } else {
+    // use a converted copy of the text file if there is an up-to-date one
+    std::string converted{key + ".bin"};
+    std::error_code ec;
+    if (fs::exists(converted) and is_binary(converted) and
+        fs::last_write_time(converted, ec) >= fs::last_write_time(key, ec)) {
+      map = mapBinary(converted);
+    } else {
+      map = readText(key);
+    }
+  }
+
+  std::shared_ptr<const FieldMap> shared{std::move(map)};
+  cache[key] = shared;
+  return shared;
+}
+
+void FieldMap::convert(const std::string& text_file,
+                       const std::string& binary_file) {
+  readText(text_file)->write(binary_file);
+}
+
+FieldMap::~FieldMap() {
+  if (mapping_) munmap(mapping_, mapping_size_);
+}
+
+void FieldMap::write(const std::string& filename) const {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    EXCEPTION_RAISE("FileError", "Unable to open '" + filename +
+                                     "' to write the field map.");
+  }
+  file.write(reinterpret_cast<const char*>(&header_), sizeof(Header));
+  file.write(reinterpret_cast<const char*>(values_),
+             3 * nx() * ny() * nz() * sizeof(double));
+  if (!file) {
+    EXCEPTION_RAISE("FileError",
+                    "Failed to write the field map to '" + filename + "'.");
+  }
+}
+
+std::unique_ptr<FieldMap> FieldMap::readText(const std::string& filename) {
+  std::ifstream file(filename);
+  if (!file.good()) {
+    EXCEPTION_RAISE("FileDNE",
+                    "The field map file '" + filename + "' does not exist!");
+  }
+
+  std::unique_ptr<FieldMap> map{new FieldMap};
+  map->filename_ = filename;
+  std::memcpy(map->header_.magic, MAGIC, sizeof(MAGIC));
+  map->header_.version = VERSION;
+
+  // Ignore first blank line
+  std::string line;
+  std::getline(file, line);
+
+  // Read table dimensions
+  if (!(file >> map->header_.size[0] >> map->header_.size[1] >>
+        map->header_.size[2])) {
+    EXCEPTION_RAISE("BadFieldMap", "Unable to read the dimensions of the " +
+                                       filename + " field map.");
+  }
+
+  // Ignore other header information
+  // The first line whose second character is '0' is considered to
+  // be the last line of the header.
+  do {
+    if (!std::getline(file, line)) {
+      EXCEPTION_RAISE("BadFieldMap",
+                      "No end of header found in " + filename + " field map.");
+    }
+  } while (line.size() < 2 or line[1] != '0');
+
+  // Read in the data, parsing the rest of the file in one buffer since
+  // stream extraction is very slow for the millions of values in a map
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string data{buffer.str()};
+
+  std::size_t num_points = map->nx() * map->ny() * map->nz();
+  map->storage_.resize(3 * num_points);
+  const char* pos = data.c_str();
+  double point[6];
+  for (std::size_t ipoint = 0; ipoint < num_points; ipoint++) {
+    for (double& val : point) {
+      char* end;
+      val = std::strtod(pos, &end);
+      if (end == pos) {
+        EXCEPTION_RAISE("BadFieldMap",
+                        "Field map " + filename + " only has " +
+                            std::to_string(ipoint) + " of " +
+                            std::to_string(num_points) + " grid points.");
+      }
+      pos = end;
+    }
+    if (ipoint == 0) std::memcpy(map->header_.first, point, 3 * sizeof(double));
+    std::memcpy(map->storage_.data() + 3 * ipoint, point + 3,
+                3 * sizeof(double));
+  }
+  std::memcpy(map->header_.last, point, 3 * sizeof(double));
+
+  map->values_ = map->storage_.data();
+  return map;
+}
+
+std::unique_ptr<FieldMap> FieldMap::mapBinary(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    EXCEPTION_RAISE("FileDNE",
+                    "Unable to open the field map file '" + filename + "'.");
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 or std::size_t(info.st_size) < sizeof(Header)) {
+    close(fd);
+    EXCEPTION_RAISE("BadFieldMap",
+                    "Field map " + filename + " is too small to be a map.");
+  }
+  std::size_t size = info.st_size;
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the file is closed
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    EXCEPTION_RAISE("BadFieldMap", "Unable to map field map " + filename);
+  }
+
+  std::unique_ptr<FieldMap> map{new FieldMap};
+  map->filename_ = filename;
+  map->mapping_ = mapping;
+  map->mapping_size_ = size;
+  std::memcpy(&map->header_, mapping, sizeof(Header));
+
+  if (std::memcmp(map->header_.magic, MAGIC, sizeof(MAGIC)) != 0 or
+      map->header_.version != VERSION) {
+    EXCEPTION_RAISE("BadFieldMap", "Field map " + filename +
+                                       " is not a version " +
+                                       std::to_string(VERSION) +
+                                       " binary map.");
+  }
+  std::size_t num_values = 3 * map->nx() * map->ny() * map->nz();
+  if (size != sizeof(Header) + num_values * sizeof(double)) {
+    EXCEPTION_RAISE("BadFieldMap", "Field map " + filename +
+                                       " does not match the size of its grid.");
+  }
+
+  map->values_ = reinterpret_cast<const double*>(
+      static_cast<const char*>(mapping) + sizeof(Header));
+  return map;
+}
+
+}  // namespace ldmx
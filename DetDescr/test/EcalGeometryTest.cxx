@@ -0,0 +1,141 @@
+/**
+ * @file EcalGeometryTest.cxx
+ * @brief Test the cell ID lookups and neighbor tables of EcalGeometry
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+#include "DetDescr/EcalGeometry.h"
+#include "Framework/Configure/Parameters.h"
+
+namespace ldmx {
+namespace test {
+
+/**
+ * Make the parameters of the v12 or v14 geometries
+ *
+ * These are copied from the python configuration.
+ *
+ * @param[in] v14 true for v14 (corners side up and shifted layers)
+ * @return parameters to build the geometry with
+ */
+static framework::config::Parameters geometry_parameters(bool v14) {
+  framework::config::Parameters params;
+  params.addParameter("layerZPositions",
+                      std::vector<double>{7.850, 13.300, 26.400, 33.500});
+  params.addParameter("ecalFrontZ", 240.5);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", 35.3);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", v14);
+  params.addParameter("layer_shift_x", v14 ? 2 * 85.0 / 35.3 : 0.);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", v14);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  return params;
+}
+
+/**
+ * Count the positions on a grid where getID and getIDWithPoly disagree
+ *
+ * @param[in] geometry geometry to test
+ * @param[in] layer layer to look in
+ * @param[in] x0 lower x edge of grid [mm]
+ * @param[in] y0 lower y edge of grid [mm]
+ * @param[in] width width of square grid [mm]
+ * @param[in] step distance between grid points [mm]
+ * @return number of mismatched positions
+ */
+static int count_mismatches(const EcalGeometry& geometry, int layer, double x0,
+                            double y0, double width, double step) {
+  int mismatches{0};
+  int n = width / step;
+  for (int i{0}; i <= n; i++) {
+    for (int j{0}; j <= n; j++) {
+      double x{x0 + i * step}, y{y0 + j * step};
+      if (geometry.getID(x, y, layer, true) !=
+          geometry.getIDWithPoly(x, y, layer))
+        mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+}  // namespace test
+}  // namespace ldmx
+
+/**
+ * Test the closed-form hexagonal lattice lookups
+ *
+ * We sweep over grids of positions and check that the IDs are the same
+ * as the ones we get by searching the TH2Poly of cells. The coarse grid
+ * covers the entire layer while the fine grids are on the corner between
+ * modules and on the cells at the edge of a module where the cells are
+ * not regular hexagons.
+ */
+TEST_CASE("EcalGeometry", "[DetDescr][EcalGeometry]") {
+  using namespace ldmx::test;
+  for (bool v14 : {false, true}) {
+    std::unique_ptr<ldmx::EcalGeometry> geometry{
+        ldmx::EcalGeometry::debugMake(geometry_parameters(v14))};
+
+    for (int layer{0}; layer < 2; layer++) {
+      CHECK(count_mismatches(*geometry, layer, -300., -300., 600., 0.4) == 0);
+      // corner between modules
+      CHECK(count_mismatches(*geometry, layer, 83., 47., 4., 0.005) == 0);
+      // cell vertex at the center of the module
+      CHECK(count_mismatches(*geometry, layer, -1., -1., 2., 0.001) == 0);
+      // edge of the center module
+      CHECK(count_mismatches(*geometry, layer, 40., 82., 8., 0.01) == 0);
+      CHECK(count_mismatches(*geometry, layer, 82., 40., 8., 0.01) == 0);
+    }
+
+    // looking up the layer by z gives the same IDs
+    for (int layer{0}; layer < geometry->getNumLayers(); layer++) {
+      double z{geometry->getZPosition(layer)};
+      for (double x{-250.}; x < 250.; x += 10.) {
+        for (double y{-250.}; y < 250.; y += 10.) {
+          CHECK(geometry->getID(x, y, z + 0.1, true) ==
+                geometry->getID(x, y, layer, true));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Test the nearest and next-to-nearest neighbor tables
+ *
+ * The neighbors are stored without the layer, so we check that they come
+ * back in the layer of the cell we asked for and that the tables are
+ * symmetric, which they are since they are built from the cell distances.
+ */
+TEST_CASE("EcalGeometryNeighbors", "[DetDescr][EcalGeometry]") {
+  using namespace ldmx::test;
+  std::unique_ptr<ldmx::EcalGeometry> geometry{
+      ldmx::EcalGeometry::debugMake(geometry_parameters(true))};
+
+  const int layer{3};
+  for (int module{0}; module < geometry->getNumModulesPerLayer(); module++) {
+    for (int cell{0}; cell < geometry->getNumCellsPerModule(); cell++) {
+      ldmx::EcalID id(layer, module, cell);
+      auto nn{geometry->getNN(id)};
+      CHECK(nn.size() > 0);
+      for (ldmx::EcalID neighbor : nn) {
+        CHECK(neighbor.layer() == layer);
+        CHECK(geometry->isNN(id, neighbor));
+        CHECK(geometry->isNN(neighbor, id));
+        CHECK_FALSE(geometry->isNNN(id, neighbor));
+        // same cell in another layer is not a neighbor
+        CHECK_FALSE(geometry->isNN(
+            id, ldmx::EcalID(layer + 1, neighbor.module(), neighbor.cell())));
+      }
+      for (ldmx::EcalID neighbor : geometry->getNNN(id)) {
+        CHECK(neighbor.layer() == layer);
+        CHECK(geometry->isNNN(neighbor, id));
+      }
+      CHECK_FALSE(geometry->isNN(id, id));
+    }
+  }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file FieldMapTest.cxx
+ * @brief Test loading, sharing and converting field maps
+ */
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+
+#include "DetDescr/FieldMap.h"
+
+/**
+ * Test for FieldMap
+ *
+ * We write a small text map in the format of the full field maps,
+ * check that it is read correctly and shared between loads, and then
+ * check that the binary conversion maps the same values.
+ */
+TEST_CASE("FieldMap", "[DetDescr][FieldMap]") {
+  using namespace ldmx;
+  const std::string text_file{"field_map_test.dat"};
+  const std::string binary_file{"field_map_test.dat.bin"};
+  std::remove(binary_file.c_str());
+
+  const std::size_t nx{3}, ny{2}, nz{4};
+  auto field = [](std::size_t ix, std::size_t iy, std::size_t iz, int c) {
+    return 0.5 * ix - 1.25 * iy + 0.125 * iz + 10. * c;
+  };
+  {
+    std::ofstream f{text_file};
+    f << "\n " << nx << " " << ny << " " << nz << "\n"
+      << " 1 X [MILLIMETRE]\n 2 Y [MILLIMETRE]\n 3 Z [MILLIMETRE]\n"
+      << " 4 BX [TESLA]\n 5 BY [TESLA]\n 6 BZ [TESLA]\n"
+      << " 0 [Header]\n";
+    for (std::size_t ix{0}; ix < nx; ix++)
+      for (std::size_t iy{0}; iy < ny; iy++)
+        for (std::size_t iz{0}; iz < nz; iz++)
+          f << -100. + 50. * ix << " " << 20. * iy << " " << 300. - 25. * iz
+            << " " << field(ix, iy, iz, 0) << " " << field(ix, iy, iz, 1)
+            << " " << field(ix, iy, iz, 2) << "\n";
+  }
+
+  auto check_map = [&](const FieldMap& map) {
+    CHECK(map.nx() == nx);
+    CHECK(map.ny() == ny);
+    CHECK(map.nz() == nz);
+    CHECK(map.first()[0] == -100.);
+    CHECK(map.first()[1] == 0.);
+    CHECK(map.first()[2] == 300.);
+    CHECK(map.last()[0] == 0.);
+    CHECK(map.last()[1] == 20.);
+    CHECK(map.last()[2] == 225.);
+    for (std::size_t ix{0}; ix < nx; ix++)
+      for (std::size_t iy{0}; iy < ny; iy++)
+        for (std::size_t iz{0}; iz < nz; iz++)
+          for (int c{0}; c < 3; c++)
+            CHECK(map.at(ix, iy, iz)[c] == field(ix, iy, iz, c));
+  };
+
+  auto text_map = FieldMap::load(text_file);
+  CHECK_FALSE(text_map->isMapped());
+  check_map(*text_map);
+  CHECK(FieldMap::load(text_file) == text_map);
+
+  FieldMap::convert(text_file, binary_file);
+  auto binary_map = FieldMap::load(binary_file);
+  CHECK(binary_map->isMapped());
+  check_map(*binary_map);
+
+  // the text map is still in use so we get the same copy
+  CHECK(FieldMap::load(text_file) == text_map);
+  text_map.reset();
+  // now that we have a converted map next to it, that is used instead
+  auto reloaded = FieldMap::load(text_file);
+  CHECK(reloaded->isMapped());
+  check_map(*reloaded);
+
+  CHECK_THROWS(FieldMap::load("does_not_exist.dat"));
+
+  reloaded.reset();
+  binary_map.reset();
+  std::remove(text_file.c_str());
+  std::remove(binary_file.c_str());
+}
@@ -14,7 +14,7 @@
 #include "Ecal/Event/EcalVetoResult.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
-#include "Tools/ONNXRuntime.h"
+#include "Tools/InferenceService.h"
 
 namespace ecal {
 
@@ -29,6 +29,8 @@ class DNNEcalVetoProcessor : public framework::Producer {
   virtual ~DNNEcalVetoProcessor() {}
   void configure(framework::config::Parameters& parameters) override;
   void produce(framework::Event& event) override;
+  /// the DNN is shared between the streams through the InferenceService
+  bool isClonable() const override { return true; }
 
  private:
   /**
@@ -59,8 +61,10 @@ class DNNEcalVetoProcessor : public framework::Producer {
   const static std::vector<unsigned int> input_sizes_;
 
   float disc_cut_ = -99;
-  std::vector<std::vector<float>> data_;
-  std::unique_ptr<ldmx::Ort::ONNXRuntime> rt_;
+  /// service running the DNN, shared with the other streams
+  std::shared_ptr<ldmx::Ort::InferenceService> dnn_;
+  /// input and output arrays of the DNN for this stream
+  ldmx::Ort::InferenceService::Request request_;
 
   /** Name of the collection which will containt the results. */
   std::string collectionName_{"DNNEcalVeto"};
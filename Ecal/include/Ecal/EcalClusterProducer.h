@@ -57,6 +57,9 @@ class EcalClusterProducer : public framework::Producer {
 
   virtual void produce(framework::Event& event) override;
 
+  /// the clusters are built from scratch for each event
+  bool isClonable() const override { return true; }
+
  private:
   double seedThreshold_{0};
   double cutoff_{0};
@@ -20,6 +20,7 @@
 #include "DetDescr/DetectorID.h"
 #include "DetDescr/EcalID.h"
 #include "Framework/EventProcessor.h"
+#include "Recon/Event/HgcrocDigiCollection.h"
 
 namespace ecal {
 
@@ -57,6 +58,9 @@ class EcalRecProducer : public framework::Producer {
    */
   virtual void produce(framework::Event& event);
 
+  /// each hit is reconstructed from its digi and the conditions alone
+  bool isClonable() const override { return true; }
+
  private:
   /** Digi Collection Name to use as input */
   std::string digiCollName_;
@@ -101,6 +105,9 @@ class EcalRecProducer : public framework::Producer {
    * of a calibration number.
    */
   double secondOrderEnergyCorrection_;
+
+  /// Buffer for the decoded digi samples, re-used each event
+  ldmx::HgcrocDigiCollection::DecodedSamples decoded_;
 };
 }  // namespace ecal
 
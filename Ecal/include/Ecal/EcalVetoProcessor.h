@@ -14,14 +14,16 @@
 #include "Ecal/Event/EcalVetoResult.h"
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
-#include "Tools/ONNXRuntime.h"
+#include "Tools/InferenceService.h"
 
 // ROOT (MIP tracking)
 #include "TVector3.h"
 
 // C++
+#include <array>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace ecal {
 
@@ -49,6 +51,54 @@ class EcalVetoProcessor : public framework::Producer {
 
   void produce(framework::Event& event) override;
 
+  /**
+   * Configure the computation of the features
+   *
+   * This is the part of the configuration that does not load the BDT,
+   * so that the features can be computed on their own.
+   *
+   * @param[in] roc_range_values for each bin of the recoil electron, the
+   * range of its angle and momentum followed by the radius of containment
+   * in each layer
+   * @param[in] nEcalLayers number of layers in the Ecal
+   * @param[in] beamEnergyMeV energy of the beam [MeV]
+   */
+  void configureFeatures(
+      const std::vector<std::vector<double>>& roc_range_values,
+      int nEcalLayers, double beamEnergyMeV);
+
+  /**
+   * Compute the features of the Ecal hits of an event
+   *
+   * Everything in the result except for the BDT output and the veto
+   * decision is set.
+   *
+   * @param[in] ecalRecHits reconstructed hits of the event
+   * @param[in] geometry geometry of the Ecal
+   * @param[in] recoilP momentum of the recoil electron at the Ecal scoring
+   * plane, empty if it was not found
+   * @param[in] recoilPos position of the recoil electron at the Ecal scoring
+   * plane
+   * @param[in] recoilPAtTarget momentum of the recoil electron at the target
+   * scoring plane, empty if it was not found
+   * @param[in] recoilPosAtTarget position of the recoil electron at the
+   * target scoring plane
+   * @param[out] result features of the event
+   */
+  void computeFeatures(const std::vector<ldmx::EcalHit>& ecalRecHits,
+                       const ldmx::EcalGeometry& geometry,
+                       const std::vector<double>& recoilP,
+                       const std::vector<float>& recoilPos,
+                       const std::vector<double>& recoilPAtTarget,
+                       const std::vector<float>& recoilPosAtTarget,
+                       ldmx::EcalVetoResult& result);
+
+  /**
+   * The features are computed from scratch for each event and the BDT is
+   * shared between the streams through the InferenceService.
+   */
+  bool isClonable() const override { return true; }
+
   // MIP tracking:  Class for storing hit information for tracking in a
   // convenient way
   struct HitData {
@@ -56,28 +106,32 @@ class EcalVetoProcessor : public framework::Producer {
     TVector3 pos;
   };
 
- private:
-  void clearProcessor();
-
-  /* Function to calculate the energy weighted shower centroid */
-  ldmx::EcalID GetShowerCentroidIDAndRMS(
-      const std::vector<ldmx::EcalHit>& ecalRecHits, double& showerRMS);
-
-  /* Function to load up empty vector of hit maps */
-  void fillHitMap(const std::vector<ldmx::EcalHit>& ecalRecHits,
-                  std::map<ldmx::EcalID, float>& cellMap_);
-
-  /* Function to take loaded hit maps and find isolated hits in them */
-  void fillIsolatedHitMap(const std::vector<ldmx::EcalHit>& ecalRecHits,
-                          ldmx::EcalID globalCentroid,
-                          std::map<ldmx::EcalID, float>& cellMap,
-                          std::map<ldmx::EcalID, float>& cellMapIso,
-                          bool doTight = false);
-
-  std::vector<XYCoords> getTrajectory(std::vector<double> momentum,
-                                      std::vector<float> position);
-
-  void buildBDTFeatureVector(const ldmx::EcalVetoResult& result);
+  /**
+   * MIP tracking: Find the straight tracks in the hits
+   *
+   * Starting from each hit, tracks are extended by the first hit in the list
+   * that is one or two layers in front of the current hit and within half a
+   * cell width in x and y. Since v14 the odd layers are offset, so we allow
+   * half a cellWidth deviation. The tracks that are near the photon trajectory
+   * and away from the electron trajectory are kept, and their hits are not
+   * used for any other track.
+   *
+   * The hits are binned by layer and position so that extending a track only
+   * looks at the hits around the current one.
+   *
+   * @param[in,out] trackingHitList hits sorted by decreasing layer, the hits
+   * on the found tracks are removed
+   * @param[in] cellWidth width of a cell [mm]
+   * @param[in] e_traj_start start of the projected electron trajectory
+   * @param[in] e_traj_end end of the projected electron trajectory
+   * @param[in] p_traj_start start of the projected photon trajectory
+   * @param[in] p_traj_end end of the projected photon trajectory
+   * @return hits on each of the found tracks, in order of decreasing layer
+   */
+  static std::vector<std::vector<HitData>> findStraightTracks(
+      std::vector<HitData>& trackingHitList, float cellWidth,
+      const TVector3& e_traj_start, const TVector3& e_traj_end,
+      const TVector3& p_traj_start, const TVector3& p_traj_end);
 
   // MIP tracking
   /**
@@ -90,7 +144,8 @@ class EcalVetoProcessor : public framework::Producer {
    * @param[in] w2 A second, distinct point on line w
    * @returns Closest distance of approach of lines u and v
    */
-  float distTwoLines(TVector3 v1, TVector3 v2, TVector3 w1, TVector3 w2);
+  static float distTwoLines(TVector3 v1, TVector3 v2, TVector3 w1,
+                            TVector3 w2);
   /**
    * Return the minimum distance between the point h1 and the line passing
    * through points p1 and p2.
@@ -100,11 +155,148 @@ class EcalVetoProcessor : public framework::Producer {
    * @param[in] p2 A second, distinct point on the line
    * @returns Minimum distance between h1 and the line
    */
-  float distPtToLine(TVector3 h1, TVector3 p1, TVector3 p2);
+  static float distPtToLine(TVector3 h1, TVector3 p1, TVector3 p2);
 
  private:
-  std::map<ldmx::EcalID, float> cellMap_;
-  std::map<ldmx::EcalID, float> cellMapTightIso_;
+  /// Number of containment regions around the projected trajectories
+  static constexpr unsigned int nRegions{5};
+
+  /// First layer of each longitudinal segment, and one past the last one
+  static constexpr std::array<int, 4> segLayers{0, 6, 17, 34};
+
+  /// Number of longitudinal segments
+  static constexpr unsigned int nSegments{segLayers.size() - 1};
+
+  /// Sums for each containment region
+  template <typename T>
+  using RegionArray = std::array<T, nRegions>;
+
+  /// Sums for each containment region and longitudinal segment
+  template <typename T>
+  using RegionSegmentArray = std::array<std::array<T, nSegments>, nRegions>;
+
+  /**
+   * The hits of the current event as structure of arrays
+   *
+   * The hits are converted once per event so that the feature loops read
+   * contiguous arrays instead of looking up the position of each hit again.
+   * The buffers are kept between events.
+   */
+  struct HitArrays {
+    /// ID of each hit
+    std::vector<ldmx::EcalID> id;
+    /// x position of each hit [mm]
+    std::vector<double> x;
+    /// y position of each hit [mm]
+    std::vector<double> y;
+    /// layer of each hit
+    std::vector<int> layer;
+    /// energy of each hit [MeV]
+    std::vector<float> energy;
+    /// time of each hit [ns]
+    std::vector<float> time;
+    /// dense index of the cell of each hit in cellState_
+    std::vector<std::size_t> cell;
+    /// distance to the projected electron trajectory [mm], -1 if there is none
+    std::vector<float> eleDist;
+    /// distance to the projected photon trajectory [mm], -1 if there is none
+    std::vector<float> photonDist;
+
+    /// Remove all of the hits
+    void clear();
+
+    /// @return number of hits
+    std::size_t size() const { return id.size(); }
+  };
+
+  /// State of a cell in the current event in cellState_
+  enum CellState : unsigned char {
+    /// no hit in the cell
+    NoHit = 0,
+    /// the cell has a hit
+    Hit,
+    /// the cell has a hit that has been counted as isolated
+    IsolatedHit
+  };
+
+  /**
+   * Longitudinal segment of a layer
+   *
+   * @param[in] layer layer to find the segment of
+   * @return index of segment, -1 if the layer is behind the last segment
+   */
+  static int segment(int layer) {
+    for (unsigned int iseg = 0; iseg < nSegments; iseg++) {
+      if (layer >= segLayers[iseg] && layer < segLayers[iseg + 1]) return iseg;
+    }
+    return -1;
+  }
+
+  void clearProcessor();
+
+  /**
+   * Convert the hits into hits_ and mark their cells in cellState_
+   *
+   * @param[in] ecalRecHits hits of the event
+   */
+  void fillHitArrays(const std::vector<ldmx::EcalHit>& ecalRecHits);
+
+  /**
+   * Dense index of a cell over all layers
+   *
+   * @param[in] id ID of cell
+   * @return index of cell in cellState_
+   */
+  std::size_t cellIndex(ldmx::EcalID id) const {
+    return (id.layer() * geometry_->getNumModulesPerLayer() + id.module()) *
+               numCellsPerModule_ +
+           id.cell();
+  }
+
+  /* Function to calculate the energy weighted shower centroid */
+  ldmx::EcalID GetShowerCentroidIDAndRMS(double& showerRMS);
+
+  /**
+   * Sum the energy of the isolated hits, hits without a hit in any of
+   * the nearest neighbor cells
+   *
+   * @param[in] globalCentroid cell of the shower centroid (layer zero)
+   * @param[in] doTight skip the centroid cell and its nearest neighbors
+   * @return summed energy of isolated hits [MeV]
+   */
+  double sumIsolatedHits(ldmx::EcalID globalCentroid, bool doTight = false);
+
+  /**
+   * Project a trajectory onto the layers
+   *
+   * @param[in] momentum momentum at the scoring plane
+   * @param[in] position position at the scoring plane
+   * @param[out] positions x,y positions in each layer
+   */
+  void getTrajectory(const std::vector<double>& momentum,
+                     const std::vector<float>& position,
+                     std::vector<XYCoords>& positions);
+
+  void buildBDTFeatureVector(const ldmx::EcalVetoResult& result);
+
+ private:
+  /// The hits of the current event
+  HitArrays hits_;
+
+  /// State of each cell in the current event, indexed by cellIndex
+  std::vector<CellState> cellState_;
+
+  /// Number of cells in each module of the current geometry
+  std::size_t numCellsPerModule_{0};
+
+  /// Projected electron trajectory in each layer, empty if there is none
+  std::vector<XYCoords> eleTrajectory_;
+
+  /// Projected photon trajectory in each layer, empty if there is none
+  std::vector<XYCoords> photonTrajectory_;
+
+  /// MIP tracking: hits considered for tracking in the current event
+  std::vector<HitData> trackingHitList_;
 
   std::vector<float> ecalLayerEdepRaw_;
   std::vector<float> ecalLayerEdepReadout_;
@@ -162,7 +354,10 @@ class EcalVetoProcessor : public framework::Producer {
   /** Name of the collection which will containt the results. */
   std::string collectionName_{"EcalVeto"};
 
-  std::unique_ptr<ldmx::Ort::ONNXRuntime> rt_;
+  /// service running the BDT, shared with the other streams
+  std::shared_ptr<ldmx::Ort::InferenceService> bdt_;
+  /// input and output arrays of the BDT for this stream
+  ldmx::Ort::InferenceService::Request bdtRequest_;
 
   /// handle to current geometry (to share with member functions)
   const ldmx::EcalGeometry* geometry_;
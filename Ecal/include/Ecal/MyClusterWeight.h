@@ -2,6 +2,8 @@
 #ifndef ECAL_MYCLUSTERWEIGHT_H_
 #define ECAL_MYCLUSTERWEIGHT_H_
 
+#include <array>
+#include <cmath>
 #include <iostream>
 
 #include "Ecal/WorkingCluster.h"
@@ -10,15 +12,31 @@ namespace ecal {
 
 class MyClusterWeight {
  public:
+  // Moliere radius of detector, roughly. In mm
+  static constexpr double rmol = 10.00;
+  // Characteristic cluster longitudinal variable TO BE DETERMINED! in mm
+  static constexpr double dzchar = 100.0;
+
+  /**
+   * Largest transverse and longitudinal distance between the centroids of
+   * two clusters with a weight below the cutoff
+   *
+   * This is padded so that the rounding in the weight never puts a pair
+   * outside of it.
+   *
+   * @param[in] cutoff weight cutoff
+   * @return transverse and longitudinal distance in mm
+   */
+  std::array<double, 2> reach(double cutoff) const {
+    return {1.001 * rmol * std::sqrt(std::log1p(cutoff)) + 0.01,
+            1.001 * dzchar * std::log1p(cutoff) + 1.};
+  }
+
   double operator()(
       const WorkingCluster& a,
       const WorkingCluster& b) {  // returns weighting function, where smallest
                                   // weights will be combined first
 
-    double rmol = 10.00;    // Moliere radius of detector, roughly. In mm
-    double dzchar = 100.0;  // Characteristic cluster longitudinal variable TO
-                            // BE DETERMINED! in mm
-
     double aE = a.centroid().E();
     double aX = a.centroid().Px();
     double aY = a.centroid().Py();
@@ -25,7 +25,7 @@ class WorkingCluster {
 
   const TLorentzVector& centroid() const { return centroid_; }
 
-  std::vector<const ldmx::EcalHit*> getHits() const { return hits_; }
+  const std::vector<const ldmx::EcalHit*>& getHits() const { return hits_; }
 
   bool empty() const { return hits_.empty(); }
 
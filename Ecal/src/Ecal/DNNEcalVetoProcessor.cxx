@@ -14,17 +14,25 @@ const std::vector<unsigned int> DNNEcalVetoProcessor::input_sizes_{
 
 DNNEcalVetoProcessor::DNNEcalVetoProcessor(const std::string& name,
                                            framework::Process& process)
-    : Producer(name, process) {
-  for (const auto& s : input_sizes_) {
-    data_.emplace_back(s, 0);
-  }
-}
+    : Producer(name, process) {}
 
 void DNNEcalVetoProcessor::configure(
     framework::config::Parameters& parameters) {
   disc_cut_ = parameters.getParameter<double>("disc_cut");
-  rt_ = std::make_unique<ldmx::Ort::ONNXRuntime>(
-      parameters.getParameter<std::string>("model_path"));
+  auto model_path{parameters.getParameter<std::string>("model_path")};
+  dnn_ = ldmx::Ort::InferenceService::get(
+      model_path, input_names_, {},
+      ldmx::Ort::InferenceService::Options::fromParameters(
+          parameters.getParameter<framework::config::Parameters>("inference",
+                                                                 {})));
+  request_ = dnn_->makeRequest();
+  for (unsigned iname = 0; iname < input_names_.size(); ++iname) {
+    if (request_.input(iname).size() != input_sizes_[iname]) {
+      EXCEPTION_RAISE("DNNEcalVetoProcessor",
+                      "The input " + input_names_[iname] + " of the model " +
+                          model_path + " does not have the expected size.");
+    }
+  }
 
   // debug mode
   debug_ = parameters.getParameter<bool>("debug");
@@ -50,8 +58,8 @@ void DNNEcalVetoProcessor::produce(framework::Event& event) {
     // make inputs
     make_inputs(ecal_geometry, ecalRecHits);
     // run the DNN
-    auto outputs = rt_->run(input_names_, data_)[0];
-    result.setDiscValue(outputs.at(1));
+    dnn_->run(request_);
+    result.setDiscValue(request_.output(0)[1]);
   } else {
     result.setDiscValue(-99);
   }
@@ -76,9 +84,10 @@ void DNNEcalVetoProcessor::make_inputs(
     const ldmx::EcalGeometry& geom,
     const std::vector<ldmx::EcalHit>& ecalRecHits) {
   // clear data
-  for (auto& v : data_) {
-    std::fill(v.begin(), v.end(), 0);
-  }
+  auto coordinates{request_.input(0)};
+  auto features{request_.input(1)};
+  std::fill(coordinates.begin(), coordinates.end(), 0);
+  std::fill(features.begin(), features.end(), 0);
 
   unsigned idx = 0;
   for (const auto& hit : ecalRecHits) {
@@ -86,15 +95,15 @@ void DNNEcalVetoProcessor::make_inputs(
     ldmx::EcalID id(hit.getID());
     auto [x, y, z] = geom.getPosition(id);
 
-    data_[0].at(coordinate_x_offset_ + idx) = x;
-    data_[0].at(coordinate_y_offset_ + idx) = y;
-    data_[0].at(coordinate_z_offset_ + idx) = z;
+    coordinates[coordinate_x_offset_ + idx] = x;
+    coordinates[coordinate_y_offset_ + idx] = y;
+    coordinates[coordinate_z_offset_ + idx] = z;
 
-    data_[1].at(feature_x_offset_ + idx) = x;
-    data_[1].at(feature_y_offset_ + idx) = y;
-    data_[1].at(feature_z_offset_ + idx) = z;
-    data_[1].at(feature_layerid_offset_ + idx) = id.layer();
-    data_[1].at(feature_energy_offset_ + idx) = std::log(hit.getEnergy());
+    features[feature_x_offset_ + idx] = x;
+    features[feature_y_offset_ + idx] = y;
+    features[feature_z_offset_ + idx] = z;
+    features[feature_layerid_offset_ + idx] = id.layer();
+    features[feature_energy_offset_ + idx] = std::log(hit.getEnergy());
 
     ++idx;
   }
@@ -103,7 +112,7 @@ void DNNEcalVetoProcessor::make_inputs(
     for (unsigned iname = 0; iname < input_names_.size(); ++iname) {
       std::cout << "=== " << input_names_[iname] << " ===" << std::endl;
       for (unsigned i = 0; i < input_sizes_[iname]; ++i) {
-        std::cout << data_[iname].at(i) << ", ";
+        std::cout << request_.input(iname)[i] << ", ";
         if ((i + 1) % max_num_hits_ == 0) {
           std::cout << std::endl;
         }
@@ -49,9 +49,9 @@ void EcalClusterProducer::produce(framework::Event& event) {
   }
 
   cf.cluster(seedThreshold_, cutoff_);
-  std::vector<WorkingCluster> wcVec = cf.getClusters();
+  const std::vector<WorkingCluster>& wcVec = cf.getClusters();
 
-  std::map<int, double> cWeights = cf.getWeights();
+  const std::map<int, double>& cWeights = cf.getWeights();
 
   ldmx::ClusterAlgoResult algoResult;
   algoResult.set(algoName_, 3, cWeights.rbegin()->first);
@@ -59,7 +59,7 @@ void EcalClusterProducer::produce(framework::Event& event) {
   algoResult.setAlgoVar(1, seedThreshold_);
   algoResult.setAlgoVar(2, cf.getNSeeds());
 
-  std::map<int, double>::iterator it = cWeights.begin();
+  std::map<int, double>::const_iterator it = cWeights.begin();
   for (it = cWeights.begin(); it != cWeights.end(); it++) {
     algoResult.setWeight(it->first, it->second / 100);
   }
@@ -78,7 +78,7 @@ void EcalClusterProducer::produce(framework::Event& event) {
     ecalClusters.push_back(cluster);
   }
 
-  event.add(clusterCollName_, ecalClusters);
+  event.add(clusterCollName_, std::move(ecalClusters));
   event.add(algoCollName_, algoResult);
 }
 }  // namespace ecal
@@ -83,7 +83,8 @@ void EcalDigiProducer::produce(framework::Event& event) {
   }
 
   hgcroc_->condition(
-      getCondition<conditions::DoubleTableCondition>("EcalHgcrocConditions"));
+      getCondition<conditions::DoubleTableCondition>("EcalHgcrocConditions"),
+      getConditionIOV("EcalHgcrocConditions"));
 
   // Empty collection to be filled
   ldmx::HgcrocDigiCollection ecalDigis;
@@ -188,9 +189,8 @@ void EcalDigiProducer::produce(framework::Event& event) {
 
         // noise generator gives the amplitude above the readout threshold
         //  we need to convert it to the amplitude above the pedestal
-        noiseHit +=
-            hgcroc_->gain(noiseID) *
-            (hgcroc_->readoutThreshold(noiseID) - hgcroc_->pedestal(noiseID));
+        const auto& conds{hgcroc_->channelConditions(noiseID)};
+        noiseHit += conds.gain * (conds.readoutThreshold - conds.pedestal);
 
         // create a digi as put it into the collection
         ecalDigis.addDigi(noiseID, hgcroc_->noiseDigi(noiseID, noiseHit));
@@ -212,7 +212,7 @@ void EcalDigiProducer::produce(framework::Event& event) {
     }        // yes or no zero suppression
   }          // if we should do the noise
 
-  event.add(digiCollName_, ecalDigis);
+  event.add(digiCollName_, std::move(ecalDigis));
 
   return;
 }  // produce
@@ -341,7 +341,7 @@ void EcalRawDecoder::produce(framework::Event& event) {
 
   // std::cout << "adding " << digis.getNumDigis() << " digis each with " <<
   // digis.getNumSamplesPerDigi() << " samples to event bus" << std::endl;
-  event.add(output_name_, digis);
+  event.add(output_name_, std::move(digis));
   return;
 }  // produce
 
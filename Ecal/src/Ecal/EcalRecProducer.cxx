@@ -48,20 +48,23 @@ void EcalRecProducer::produce(framework::Event& event) {
           EcalReconConditions::CONDITIONS_NAME));
 
   std::vector<ldmx::EcalHit> ecalRecHits;
-  auto ecalDigis =
+  const auto& ecalDigis =
       event.getObject<ldmx::HgcrocDigiCollection>(digiCollName_, digiPassName_);
+  ecalDigis.decode(decoded_);
+  ecalRecHits.reserve(decoded_.size());
   // loop through digis
-  for (auto digi : ecalDigis) {
+  for (std::size_t i_digi{0}; i_digi < decoded_.size(); i_digi++) {
     // ID from first digi sample
     //  assuming rest of samples have same ID
-    ldmx::EcalID id(digi.id());
+    ldmx::EcalID id(decoded_.id[i_digi]);
+    std::size_t i_soi{decoded_.soi(i_digi)};
 
     // ID to real space position
     auto [x, y, z] = geometry.getPosition(id);
 
     // TOA is the time of arrival with respect to the 25ns clock window
     //  TODO what to do if hit NOT in first clock cycle?
-    double timeRelClock25 = digi.soi().toa() * (clock_cycle_ / 1024);  // ns
+    double timeRelClock25 = decoded_.toa[i_soi] * (clock_cycle_ / 1024);  // ns
     double hitTime = timeRelClock25;
 
     // get the estimated charge deposited from digi samples
@@ -72,7 +75,7 @@ void EcalRecProducer::produce(framework::Event& event) {
         << "ID: " << id << ", "
         << "TOA: " << hitTime << "ns } ";
         */
-    if (digi.isTOT()) {
+    if (decoded_.isTOT(i_digi)) {
       // TOT - number of clock ticks that pulse was over threshold
       //  this is related to the amplitude of the pulse approximately through a
       //  linear drain rate the amplitude of the pulse is related to the energy
@@ -81,7 +84,7 @@ void EcalRecProducer::produce(framework::Event& event) {
       // convert the time over threshold into a total energy deposited in the
       // silicon
       //  (time over threshold [ns] - pedestal) * gain
-      charge = (digi.tot() - the_conditions.totPedestal(id)) *
+      charge = (decoded_.digiTOT(i_digi) - the_conditions.totPedestal(id)) *
                the_conditions.totGain(id);
 
       /* debug printout
@@ -104,7 +107,7 @@ void EcalRecProducer::produce(framework::Event& event) {
       // available. For now, we simply take the measurement of the SOI as the
       // peak amplitude.
 
-      charge = (digi.soi().adc_t() - the_conditions.adcPedestal(id)) *
+      charge = (decoded_.adc_t[i_soi] - the_conditions.adcPedestal(id)) *
                the_conditions.adcGain(id);
 
       /* debug printout
@@ -168,7 +171,7 @@ void EcalRecProducer::produce(framework::Event& event) {
   }
 
   // add collection to event bus
-  event.add(recHitCollName_, ecalRecHits);
+  event.add(recHitCollName_, std::move(ecalRecHits));
 }
 
 }  // namespace ecal
@@ -27,6 +27,41 @@
 
 namespace ecal {
 
+namespace {
+
+/// square of a value, computed in double precision
+double square(double v) { return v * v; }
+
+/// copy the sums of each region into a vector
+template <typename T, std::size_t N>
+std::vector<T> toVector(const std::array<T, N> &sums) {
+  return std::vector<T>(sums.begin(), sums.end());
+}
+
+/// copy the sums of each region and segment into vectors
+template <typename T, std::size_t N, std::size_t M>
+std::vector<std::vector<T>> toVector(
+    const std::array<std::array<T, M>, N> &sums) {
+  std::vector<std::vector<T>> copy;
+  copy.reserve(N);
+  for (const auto &row : sums) copy.push_back(toVector(row));
+  return copy;
+}
+
+}  // namespace
+
+void EcalVetoProcessor::HitArrays::clear() {
+  id.clear();
+  x.clear();
+  y.clear();
+  layer.clear();
+  energy.clear();
+  time.clear();
+  cell.clear();
+  eleDist.clear();
+  photonDist.clear();
+}
+
 void EcalVetoProcessor::buildBDTFeatureVector(
     const ldmx::EcalVetoResult &result) {
   // Base variables
@@ -89,12 +124,18 @@ void EcalVetoProcessor::configure(framework::config::Parameters &parameters) {
   verbose_ = parameters.getParameter<bool>("verbose");
   featureListName_ = parameters.getParameter<std::string>("feature_list_name");
   // Load BDT ONNX file
-  rt_ = std::make_unique<ldmx::Ort::ONNXRuntime>(
-      parameters.getParameter<std::string>("bdt_file"));
+  bdt_ = ldmx::Ort::InferenceService::get(
+      parameters.getParameter<std::string>("bdt_file"), {featureListName_},
+      {"probabilities"},
+      ldmx::Ort::InferenceService::Options::fromParameters(
+          parameters.getParameter<framework::config::Parameters>("inference",
+                                                                 {})));
+  bdtRequest_ = bdt_->makeRequest();
 
   // Read in arrays holding 68% containment radius per layer
   // for different bins in momentum/angle
   rocFileName_ = parameters.getParameter<std::string>("roc_file");
+  std::vector<std::vector<double>> roc_range_values;
   if (!std::ifstream(rocFileName_).good()) {
     EXCEPTION_RAISE(
         "EcalVetoProcessor",
@@ -115,18 +156,15 @@ void EcalVetoProcessor::configure(framework::config::Parameters &parameters) {
         double f_value = (value != "") ? std::stof(value) : -1.0;
         values.push_back(f_value);
       }
-      roc_range_values_.push_back(values);
+      roc_range_values.push_back(values);
     }
   }
 
-  nEcalLayers_ = parameters.getParameter<int>("num_ecal_layers");
+  configureFeatures(roc_range_values,
+                    parameters.getParameter<int>("num_ecal_layers"),
+                    parameters.getParameter<double>("beam_energy"));
 
   bdtCutVal_ = parameters.getParameter<double>("disc_cut");
-  ecalLayerEdepRaw_.resize(nEcalLayers_, 0);
-  ecalLayerEdepReadout_.resize(nEcalLayers_, 0);
-  ecalLayerTime_.resize(nEcalLayers_, 0);
-
-  beamEnergyMeV_ = parameters.getParameter<double>("beam_energy");
 
   // Set the collection name as defined in the configuration
   collectionName_ = parameters.getParameter<std::string>("collection_name");
@@ -134,9 +172,21 @@ void EcalVetoProcessor::configure(framework::config::Parameters &parameters) {
   rec_coll_name_ = parameters.getParameter<std::string>("rec_coll_name");
 }
 
+void EcalVetoProcessor::configureFeatures(
+    const std::vector<std::vector<double>> &roc_range_values, int nEcalLayers,
+    double beamEnergyMeV) {
+  roc_range_values_ = roc_range_values;
+  nEcalLayers_ = nEcalLayers;
+  ecalLayerEdepRaw_.assign(nEcalLayers_, 0);
+  ecalLayerEdepReadout_.assign(nEcalLayers_, 0);
+  ecalLayerTime_.assign(nEcalLayers_, 0);
+  beamEnergyMeV_ = beamEnergyMeV;
+}
+
 void EcalVetoProcessor::clearProcessor() {
-  cellMap_.clear();
-  cellMapTightIso_.clear();
+  // only reset the cells that were hit in the last event
+  for (std::size_t cell : hits_.cell) cellState_[cell] = NoHit;
+  hits_.clear();
   bdtFeatures_.clear();
 
   nReadoutHits_ = 0;
@@ -166,14 +216,8 @@ void EcalVetoProcessor::clearProcessor() {
 }
 
 void EcalVetoProcessor::produce(framework::Event &event) {
-  // Get the Ecal Geometry
-  geometry_ = &getCondition<ldmx::EcalGeometry>(
-      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME);
-
   ldmx::EcalVetoResult result;
 
-  clearProcessor();
-
   // Get the collection of Ecal scoring plane hits. If it doesn't exist,
   // don't bother adding any truth tracking information.
 
@@ -242,21 +286,73 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     }
   }
 
+  // Get the collection of digitized Ecal hits from the event.
+  const auto &ecalRecHits{
+      event.getCollection<ldmx::EcalHit>(rec_coll_name_, rec_pass_name_)};
+
+  computeFeatures(ecalRecHits,
+                  getCondition<ldmx::EcalGeometry>(
+                      ldmx::EcalGeometry::CONDITIONS_OBJECT_NAME),
+                  recoilP, recoilPos, recoilPAtTarget, recoilPosAtTarget,
+                  result);
+
+  buildBDTFeatureVector(result);
+  auto bdtInput{bdtRequest_.input(0)};
+  if (bdtFeatures_.size() != bdtInput.size()) {
+    EXCEPTION_RAISE("EcalVetoProcessor",
+                    "The BDT takes " + std::to_string(bdtInput.size()) +
+                        " features but " +
+                        std::to_string(bdtFeatures_.size()) + " were built.");
+  }
+  std::copy(bdtFeatures_.begin(), bdtFeatures_.end(), bdtInput.begin());
+  bdt_->run(bdtRequest_);
+  float pred = bdtRequest_.output(0)[1];
+  // Other considerations were (nLinregTracks_ == 0)  && (firstNearPhLayer_ >=
+  // 6)
+  // && (epAng_ > 3.0 && epAng_ < 900 || epSep_ > 10.0 && epSep_ < 900)
+  bool passesTrackingVeto = (nStraightTracks_ < 3);
+  result.setVetoResult(pred > bdtCutVal_ && passesTrackingVeto);
+  result.setDiscValue(pred);
+  ldmx_log(debug) << "  The pred > bdtCutVal = " << (pred > bdtCutVal_);
+
+  // If the event passes the veto, keep it. Otherwise,
+  // drop the event.
+  if (result.passesVeto()) {
+    setStorageHint(framework::hint_shouldKeep);
+  } else {
+    setStorageHint(framework::hint_shouldDrop);
+  }
+
+  event.add(collectionName_, result);
+}
+
+void EcalVetoProcessor::computeFeatures(
+    const std::vector<ldmx::EcalHit> &ecalRecHits,
+    const ldmx::EcalGeometry &geometry, const std::vector<double> &recoilP,
+    const std::vector<float> &recoilPos,
+    const std::vector<double> &recoilPAtTarget,
+    const std::vector<float> &recoilPosAtTarget,
+    ldmx::EcalVetoResult &result) {
+  geometry_ = &geometry;
+
+  clearProcessor();
+
   if (verbose_) {
     ldmx_log(debug) << "   Get projected trajectories for electron and photon";
   }
   // Get projected trajectories for electron and photon
-  std::vector<XYCoords> ele_trajectory, photon_trajectory;
+  eleTrajectory_.clear();
+  photonTrajectory_.clear();
   if (recoilP.size() > 0) {
-    ele_trajectory = getTrajectory(recoilP, recoilPos);
+    getTrajectory(recoilP, recoilPos, eleTrajectory_);
     std::vector<double> pvec = recoilPAtTarget.size()
                                    ? recoilPAtTarget
                                    : std::vector<double>{0.0, 0.0, 0.0};
     std::vector<float> posvec = recoilPosAtTarget.size()
                                     ? recoilPosAtTarget
                                     : std::vector<float>{0.0, 0.0, 0.0};
-    photon_trajectory =
-        getTrajectory({-pvec[0], -pvec[1], beamEnergyMeV_ - pvec[2]}, posvec);
+    getTrajectory({-pvec[0], -pvec[1], beamEnergyMeV_ - pvec[2]}, posvec,
+                  photonTrajectory_);
   }
 
   float recoilPMag =
@@ -269,18 +365,17 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   if (verbose_) {
     ldmx_log(debug) << "   Build Radii of containment (ROC)";
   }
-  // Use the appropriate containment radii for the recoil electron
-  std::vector<double> roc_values_bin0(roc_range_values_[0].begin() + 4,
-                                      roc_range_values_[0].end());
-  std::vector<double> ele_radii = roc_values_bin0;
+  // Use the appropriate containment radii for the recoil electron,
+  //  the radii of each bin start after its theta and momentum range
+  const double *ele_radii = roc_range_values_[0].data() + 4;
   double theta_min, theta_max, p_min, p_max;
   bool inrange;
 
-  for (int i = 0; i < roc_range_values_.size(); i++) {
-    theta_min = roc_range_values_[i][0];
-    theta_max = roc_range_values_[i][1];
-    p_min = roc_range_values_[i][2];
-    p_max = roc_range_values_[i][3];
+  for (const auto &roc_bin : roc_range_values_) {
+    theta_min = roc_bin[0];
+    theta_max = roc_bin[1];
+    p_min = roc_bin[2];
+    p_max = roc_bin[3];
     inrange = true;
 
     if (theta_min != -1.0) {
@@ -296,26 +391,19 @@ void EcalVetoProcessor::produce(framework::Event &event) {
       inrange = inrange && (recoilPMag < p_max);
     }
     if (inrange) {
-      std::vector<double> roc_values_bini(roc_range_values_[i].begin() + 4,
-                                          roc_range_values_[i].end());
-      ele_radii = roc_values_bini;
+      ele_radii = roc_bin.data() + 4;
     }
   }
   // Use default RoC bin for photon
-  std::vector<double> photon_radii = roc_values_bin0;
+  const double *photon_radii = roc_range_values_[0].data() + 4;
 
-  // Get the collection of digitized Ecal hits from the event.
-  const std::vector<ldmx::EcalHit> ecalRecHits =
-      event.getCollection<ldmx::EcalHit>(rec_coll_name_, rec_pass_name_);
+  /* ~~ Convert the hits and fill the cell map ~~ O(n)  */
+  fillHitArrays(ecalRecHits);
 
-  ldmx::EcalID globalCentroid =
-      GetShowerCentroidIDAndRMS(ecalRecHits, showerRMS_);
-  /* ~~ Fill the hit map ~~ O(n)  */
-  fillHitMap(ecalRecHits, cellMap_);
+  ldmx::EcalID globalCentroid = GetShowerCentroidIDAndRMS(showerRMS_);
   bool doTight = true;
-  /* ~~ Fill the isolated hit maps ~~ O(n)  */
-  fillIsolatedHitMap(ecalRecHits, globalCentroid, cellMap_, cellMapTightIso_,
-                     doTight);
+  /* ~~ Sum the isolated hits ~~ O(n)  */
+  summedTightIso_ = sumIsolatedHits(globalCentroid, doTight);
 
   // Loop over the hits from the event to calculate the rest of the important
   // quantities
@@ -325,174 +413,134 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   float yMean = 0;
 
   // Containment variables
-  unsigned int nregions = 5;
-  std::vector<float> electronContainmentEnergy(nregions, 0.0);
-  std::vector<float> photonContainmentEnergy(nregions, 0.0);
-  std::vector<float> outsideContainmentEnergy(nregions, 0.0);
-  std::vector<int> outsideContainmentNHits(nregions, 0);
-  std::vector<float> outsideContainmentXmean(nregions, 0.0);
-  std::vector<float> outsideContainmentYmean(nregions, 0.0);
-  std::vector<float> outsideContainmentXstd(nregions, 0.0);
-  std::vector<float> outsideContainmentYstd(nregions, 0.0);
+  RegionArray<float> electronContainmentEnergy{};
+  RegionArray<float> photonContainmentEnergy{};
+  RegionArray<float> outsideContainmentEnergy{};
+  RegionArray<int> outsideContainmentNHits{};
+  RegionArray<float> outsideContainmentXmean{};
+  RegionArray<float> outsideContainmentYmean{};
+  RegionArray<float> outsideContainmentXstd{};
+  RegionArray<float> outsideContainmentYstd{};
   // Longitudinal segmentation
-  std::vector<int> segLayers = {0, 6, 17, 34};
-  unsigned int nsegments = segLayers.size() - 1;
-  std::vector<float> energySeg(nsegments, 0.0);
-  std::vector<float> xMeanSeg(nsegments, 0.0);
-  std::vector<float> xStdSeg(nsegments, 0.0);
-  std::vector<float> yMeanSeg(nsegments, 0.0);
-  std::vector<float> yStdSeg(nsegments, 0.0);
-  std::vector<float> layerMeanSeg(nsegments, 0.0);
-  std::vector<float> layerStdSeg(nsegments, 0.0);
-  std::vector<std::vector<float>> eContEnergy(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> eContXMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> eContYMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> gContEnergy(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<int>> gContNHits(nregions,
-                                           std::vector<int>(nsegments, 0));
-  std::vector<std::vector<float>> gContXMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> gContYMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> oContEnergy(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<int>> oContNHits(nregions,
-                                           std::vector<int>(nsegments, 0));
-  std::vector<std::vector<float>> oContXMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> oContYMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> oContXStd(nregions,
-                                            std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> oContYStd(nregions,
-                                            std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> oContLayerMean(
-      nregions, std::vector<float>(nsegments, 0.0));
-  std::vector<std::vector<float>> oContLayerStd(
-      nregions, std::vector<float>(nsegments, 0.0));
+  std::array<float, nSegments> energySeg{};
+  std::array<float, nSegments> xMeanSeg{};
+  std::array<float, nSegments> xStdSeg{};
+  std::array<float, nSegments> yMeanSeg{};
+  std::array<float, nSegments> yStdSeg{};
+  std::array<float, nSegments> layerMeanSeg{};
+  std::array<float, nSegments> layerStdSeg{};
+  RegionSegmentArray<float> eContEnergy{};
+  RegionSegmentArray<float> eContXMean{};
+  RegionSegmentArray<float> eContYMean{};
+  RegionSegmentArray<float> gContEnergy{};
+  RegionSegmentArray<int> gContNHits{};
+  RegionSegmentArray<float> gContXMean{};
+  RegionSegmentArray<float> gContYMean{};
+  RegionSegmentArray<float> oContEnergy{};
+  RegionSegmentArray<int> oContNHits{};
+  RegionSegmentArray<float> oContXMean{};
+  RegionSegmentArray<float> oContYMean{};
+  RegionSegmentArray<float> oContXStd{};
+  RegionSegmentArray<float> oContYStd{};
+  RegionSegmentArray<float> oContLayerMean{};
+  RegionSegmentArray<float> oContLayerStd{};
 
   // MIP tracking:  vector of hits to be used in the MIP tracking algorithm. All
   // hits inside the electron ROC (or all hits in the ECal if the event is
   // missing an electron) will be included.
-  std::vector<HitData> trackingHitList;
+  std::vector<HitData> &trackingHitList{trackingHitList_};
+  trackingHitList.clear();
 
   if (verbose_) {
     ldmx_log(debug)
         << "   Loop over the hits from the event to calculate the BDT features";
   }
 
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
+  for (std::size_t iHit = 0; iHit < hits_.size(); iHit++) {
     // Layer-wise quantities
-    ldmx::EcalID id(hit.getID());
-    ecalLayerEdepRaw_[id.layer()] =
-        ecalLayerEdepRaw_[id.layer()] + hit.getEnergy();
-    if (id.layer() >= 20) ecalBackEnergy_ += hit.getEnergy();
-    if (maxCellDep_ < hit.getEnergy()) maxCellDep_ = hit.getEnergy();
-    if (hit.getEnergy() > 0) {
-      nReadoutHits_++;
-      ecalLayerEdepReadout_[id.layer()] += hit.getEnergy();
-      ecalLayerTime_[id.layer()] += (hit.getEnergy()) * hit.getTime();
-      auto [x, y, z] = geometry_->getPosition(id);
-      xMean += x * hit.getEnergy();
-      yMean += y * hit.getEnergy();
-      avgLayerHit_ += id.layer();
-      wavgLayerHit += id.layer() * hit.getEnergy();
-      if (deepestLayerHit_ < id.layer()) {
-        deepestLayerHit_ = id.layer();
+    const int layer{hits_.layer[iHit]};
+    const float energy{hits_.energy[iHit]};
+    ecalLayerEdepRaw_[layer] = ecalLayerEdepRaw_[layer] + energy;
+    if (layer >= 20) ecalBackEnergy_ += energy;
+    if (maxCellDep_ < energy) maxCellDep_ = energy;
+    if (energy <= 0) continue;
+
+    nReadoutHits_++;
+    ecalLayerEdepReadout_[layer] += energy;
+    ecalLayerTime_[layer] += energy * hits_.time[iHit];
+    const double x{hits_.x[iHit]}, y{hits_.y[iHit]};
+    xMean += x * energy;
+    yMean += y * energy;
+    avgLayerHit_ += layer;
+    wavgLayerHit += layer * energy;
+    if (deepestLayerHit_ < layer) {
+      deepestLayerHit_ = layer;
+    }
+    const XYCoords xy_pair(x, y);
+    const float distance_ele_trajectory{hits_.eleDist[iHit]};
+    const float distance_photon_trajectory{hits_.photonDist[iHit]};
+    const double ele_radius{ele_radii[layer]};
+    const double photon_radius{photon_radii[layer]};
+
+    // Decide which longitudinal segment the hit is in and add to sums
+    const int iseg{segment(layer)};
+    if (iseg >= 0) {
+      energySeg[iseg] += energy;
+      xMeanSeg[iseg] += xy_pair.first * energy;
+      yMeanSeg[iseg] += xy_pair.second * energy;
+      layerMeanSeg[iseg] += layer * energy;
+    }
+
+    // Decide which containment region the hit is in and add to sums
+    for (unsigned int ireg = 0; ireg < nRegions; ireg++) {
+      const bool inEle{distance_ele_trajectory >= ireg * ele_radius &&
+                       distance_ele_trajectory < (ireg + 1) * ele_radius};
+      const bool inPhoton{
+          distance_photon_trajectory >= ireg * photon_radius &&
+          distance_photon_trajectory < (ireg + 1) * photon_radius};
+      const bool outside{distance_ele_trajectory > (ireg + 1) * ele_radius &&
+                         distance_photon_trajectory >
+                             (ireg + 1) * photon_radius};
+      if (inEle) electronContainmentEnergy[ireg] += energy;
+      if (inPhoton) photonContainmentEnergy[ireg] += energy;
+      if (outside) {
+        outsideContainmentEnergy[ireg] += energy;
+        outsideContainmentNHits[ireg] += 1;
+        outsideContainmentXmean[ireg] += xy_pair.first * energy;
+        outsideContainmentYmean[ireg] += xy_pair.second * energy;
       }
-      XYCoords xy_pair = std::make_pair(x, y);
-      float distance_ele_trajectory =
-          ele_trajectory.size()
-              ? sqrt(
-                    pow((xy_pair.first - ele_trajectory[id.layer()].first), 2) +
-                    pow((xy_pair.second - ele_trajectory[id.layer()].second),
-                        2))
-              : -1.0;
-      float distance_photon_trajectory =
-          photon_trajectory.size()
-              ? sqrt(
-                    pow((xy_pair.first - photon_trajectory[id.layer()].first),
-                        2) +
-                    pow((xy_pair.second - photon_trajectory[id.layer()].second),
-                        2))
-              : -1.0;
-
-      // Decide which longitudinal segment the hit is in and add to sums
-      for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
-        if (id.layer() >= segLayers[iseg] &&
-            id.layer() <= segLayers[iseg + 1] - 1) {
-          energySeg[iseg] += hit.getEnergy();
-          xMeanSeg[iseg] += xy_pair.first * hit.getEnergy();
-          yMeanSeg[iseg] += xy_pair.second * hit.getEnergy();
-          layerMeanSeg[iseg] += id.layer() * hit.getEnergy();
-
-          // Decide which containment region the hit is in and add to sums
-          for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-            if (distance_ele_trajectory >= ireg * ele_radii[id.layer()] &&
-                distance_ele_trajectory < (ireg + 1) * ele_radii[id.layer()]) {
-              eContEnergy[ireg][iseg] += hit.getEnergy();
-              eContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
-              eContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
-            }
-            if (distance_photon_trajectory >= ireg * photon_radii[id.layer()] &&
-                distance_photon_trajectory <
-                    (ireg + 1) * photon_radii[id.layer()]) {
-              gContEnergy[ireg][iseg] += hit.getEnergy();
-              gContNHits[ireg][iseg] += 1;
-              gContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
-              gContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
-            }
-            if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-                distance_photon_trajectory >
-                    (ireg + 1) * photon_radii[id.layer()]) {
-              oContEnergy[ireg][iseg] += hit.getEnergy();
-              oContNHits[ireg][iseg] += 1;
-              oContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
-              oContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
-              oContLayerMean[ireg][iseg] += id.layer() * hit.getEnergy();
-            }
-          }
-        }
+      if (iseg < 0) continue;
+      if (inEle) {
+        eContEnergy[ireg][iseg] += energy;
+        eContXMean[ireg][iseg] += xy_pair.first * energy;
+        eContYMean[ireg][iseg] += xy_pair.second * energy;
       }
-
-      // Decide which containment region the hit is in and add to sums
-      for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-        if (distance_ele_trajectory >= ireg * ele_radii[id.layer()] &&
-            distance_ele_trajectory < (ireg + 1) * ele_radii[id.layer()])
-          electronContainmentEnergy[ireg] += hit.getEnergy();
-        if (distance_photon_trajectory >= ireg * photon_radii[id.layer()] &&
-            distance_photon_trajectory < (ireg + 1) * photon_radii[id.layer()])
-          photonContainmentEnergy[ireg] += hit.getEnergy();
-        if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-            distance_photon_trajectory >
-                (ireg + 1) * photon_radii[id.layer()]) {
-          outsideContainmentEnergy[ireg] += hit.getEnergy();
-          outsideContainmentNHits[ireg] += 1;
-          outsideContainmentXmean[ireg] += xy_pair.first * hit.getEnergy();
-          outsideContainmentYmean[ireg] += xy_pair.second * hit.getEnergy();
-        }
+      if (inPhoton) {
+        gContEnergy[ireg][iseg] += energy;
+        gContNHits[ireg][iseg] += 1;
+        gContXMean[ireg][iseg] += xy_pair.first * energy;
+        gContYMean[ireg][iseg] += xy_pair.second * energy;
       }
-
-      // MIP tracking:  Decide whether hit should be added to trackingHitList
-      // If inside e- RoC or if etraj is missing, use the hit for tracking:
-      if (distance_ele_trajectory >= ele_radii[id.layer()] ||
-          distance_ele_trajectory == -1.0) {
-        HitData hd;
-        hd.pos = TVector3(xy_pair.first, xy_pair.second,
-                          geometry_->getZPosition(id.layer()));
-        hd.layer = id.layer();
-        trackingHitList.push_back(hd);
+      if (outside) {
+        oContEnergy[ireg][iseg] += energy;
+        oContNHits[ireg][iseg] += 1;
+        oContXMean[ireg][iseg] += xy_pair.first * energy;
+        oContYMean[ireg][iseg] += xy_pair.second * energy;
+        oContLayerMean[ireg][iseg] += layer * energy;
       }
     }
-  }  // end loop over rechits
 
-  for (const auto &[id, energy] : cellMapTightIso_) {
-    if (energy > 0) summedTightIso_ += energy;
-  }
+    // MIP tracking:  Decide whether hit should be added to trackingHitList
+    // If inside e- RoC or if etraj is missing, use the hit for tracking:
+    if (distance_ele_trajectory >= ele_radius ||
+        distance_ele_trajectory == -1.0) {
+      HitData hd;
+      hd.pos = TVector3(xy_pair.first, xy_pair.second,
+                        geometry_->getZPosition(layer));
+      hd.layer = layer;
+      trackingHitList.push_back(hd);
+    }
+  }  // end loop over rechits
 
   for (int iLayer = 0; iLayer < ecalLayerEdepReadout_.size(); iLayer++) {
     ecalLayerTime_[iLayer] =
@@ -513,13 +561,13 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   }
 
   // If necessary, quotient out the total energy from the means
-  for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+  for (unsigned int iseg = 0; iseg < nSegments; iseg++) {
     if (energySeg[iseg] > 0) {
       xMeanSeg[iseg] /= energySeg[iseg];
       yMeanSeg[iseg] /= energySeg[iseg];
       layerMeanSeg[iseg] /= energySeg[iseg];
     }
-    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+    for (unsigned int ireg = 0; ireg < nRegions; ireg++) {
       if (eContEnergy[ireg][iseg] > 0) {
         eContXMean[ireg][iseg] /= eContEnergy[ireg][iseg];
         eContYMean[ireg][iseg] /= eContEnergy[ireg][iseg];
@@ -536,7 +584,7 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     }
   }
 
-  for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+  for (unsigned int ireg = 0; ireg < nRegions; ireg++) {
     if (outsideContainmentEnergy[ireg] > 0) {
       outsideContainmentXmean[ireg] /= outsideContainmentEnergy[ireg];
       outsideContainmentYmean[ireg] /= outsideContainmentEnergy[ireg];
@@ -544,65 +592,44 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   }
 
   // Loop over hits a second time to find the standard deviations.
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
-    ldmx::EcalID id(hit.getID());
-    auto [x, y, z] = geometry_->getPosition(id);
-    if (hit.getEnergy() > 0) {
-      xStd_ += pow((x - xMean), 2) * hit.getEnergy();
-      yStd_ += pow((y - yMean), 2) * hit.getEnergy();
-      stdLayerHit_ += pow((id.layer() - wavgLayerHit), 2) * hit.getEnergy();
+  //  The spreads are summed around the means like the BDT was trained with,
+  //  but everything this needs was stored in the first loop.
+  for (std::size_t iHit = 0; iHit < hits_.size(); iHit++) {
+    const int layer{hits_.layer[iHit]};
+    const float energy{hits_.energy[iHit]};
+    const double x{hits_.x[iHit]}, y{hits_.y[iHit]};
+    if (energy > 0) {
+      xStd_ += square(x - xMean) * energy;
+      yStd_ += square(y - yMean) * energy;
+      stdLayerHit_ += square(layer - wavgLayerHit) * energy;
     }
-    XYCoords xy_pair = std::make_pair(x, y);
-    float distance_ele_trajectory =
-        ele_trajectory.size()
-            ? sqrt(pow((xy_pair.first - ele_trajectory[id.layer()].first), 2) +
-                   pow((xy_pair.second - ele_trajectory[id.layer()].second), 2))
-            : -1.0;
-    float distance_photon_trajectory =
-        photon_trajectory.size()
-            ? sqrt(pow((xy_pair.first - photon_trajectory[id.layer()].first),
-                       2) +
-                   pow((xy_pair.second - photon_trajectory[id.layer()].second),
-                       2))
-            : -1.0;
-
-    for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
-      if (id.layer() >= segLayers[iseg] &&
-          id.layer() <= segLayers[iseg + 1] - 1) {
-        xStdSeg[iseg] +=
-            pow((xy_pair.first - xMeanSeg[iseg]), 2) * hit.getEnergy();
-        yStdSeg[iseg] +=
-            pow((xy_pair.second - yMeanSeg[iseg]), 2) * hit.getEnergy();
-        layerStdSeg[iseg] +=
-            pow((id.layer() - layerMeanSeg[iseg]), 2) * hit.getEnergy();
-
-        for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-          if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-              distance_photon_trajectory >
-                  (ireg + 1) * photon_radii[id.layer()]) {
-            oContXStd[ireg][iseg] +=
-                pow((xy_pair.first - oContXMean[ireg][iseg]), 2) *
-                hit.getEnergy();
-            oContYStd[ireg][iseg] +=
-                pow((xy_pair.second - oContYMean[ireg][iseg]), 2) *
-                hit.getEnergy();
-            oContLayerStd[ireg][iseg] +=
-                pow((id.layer() - oContLayerMean[ireg][iseg]), 2) *
-                hit.getEnergy();
-          }
-        }
-      }
+    const XYCoords xy_pair(x, y);
+    const float distance_ele_trajectory{hits_.eleDist[iHit]};
+    const float distance_photon_trajectory{hits_.photonDist[iHit]};
+    const double ele_radius{ele_radii[layer]};
+    const double photon_radius{photon_radii[layer]};
+
+    const int iseg{segment(layer)};
+    if (iseg >= 0) {
+      xStdSeg[iseg] += square(xy_pair.first - xMeanSeg[iseg]) * energy;
+      yStdSeg[iseg] += square(xy_pair.second - yMeanSeg[iseg]) * energy;
+      layerStdSeg[iseg] += square(layer - layerMeanSeg[iseg]) * energy;
     }
 
-    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
-      if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
-          distance_photon_trajectory > (ireg + 1) * photon_radii[id.layer()]) {
+    for (unsigned int ireg = 0; ireg < nRegions; ireg++) {
+      if (distance_ele_trajectory > (ireg + 1) * ele_radius &&
+          distance_photon_trajectory > (ireg + 1) * photon_radius) {
         outsideContainmentXstd[ireg] +=
-            pow((xy_pair.first - outsideContainmentXmean[ireg]), 2) *
-            hit.getEnergy();
+            square(xy_pair.first - outsideContainmentXmean[ireg]) * energy;
         outsideContainmentYstd[ireg] +=
-            pow((xy_pair.second - outsideContainmentYmean[ireg]), 2) *
-            hit.getEnergy();
+            square(xy_pair.second - outsideContainmentYmean[ireg]) * energy;
+        if (iseg < 0) continue;
+        oContXStd[ireg][iseg] +=
+            square(xy_pair.first - oContXMean[ireg][iseg]) * energy;
+        oContYStd[ireg][iseg] +=
+            square(xy_pair.second - oContYMean[ireg][iseg]) * energy;
+        oContLayerStd[ireg][iseg] +=
+            square(layer - oContLayerMean[ireg][iseg]) * energy;
       }
     }
   }  // end loop over rechits (2nd time)
@@ -619,13 +646,13 @@ void EcalVetoProcessor::produce(framework::Event &event) {
 
   // Quotient out the total energies from the standard deviations if possible
   // and take root
-  for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+  for (unsigned int iseg = 0; iseg < nSegments; iseg++) {
     if (energySeg[iseg] > 0) {
       xStdSeg[iseg] = sqrt(xStdSeg[iseg] / energySeg[iseg]);
       yStdSeg[iseg] = sqrt(yStdSeg[iseg] / energySeg[iseg]);
       layerStdSeg[iseg] = sqrt(layerStdSeg[iseg] / energySeg[iseg]);
     }
-    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+    for (unsigned int ireg = 0; ireg < nRegions; ireg++) {
       if (oContEnergy[ireg][iseg] > 0) {
         oContXStd[ireg][iseg] =
             sqrt(oContXStd[ireg][iseg] / oContEnergy[ireg][iseg]);
@@ -637,7 +664,7 @@ void EcalVetoProcessor::produce(framework::Event &event) {
     }
   }
 
-  for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+  for (unsigned int ireg = 0; ireg < nRegions; ireg++) {
     if (outsideContainmentEnergy[ireg] > 0) {
       outsideContainmentXstd[ireg] =
           sqrt(outsideContainmentXstd[ireg] / outsideContainmentEnergy[ireg]);
@@ -696,18 +723,18 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   TVector3 e_traj_end;
   TVector3 p_traj_start;
   TVector3 p_traj_end;
-  if (ele_trajectory.size() > 0 && photon_trajectory.size() > 0) {
+  if (eleTrajectory_.size() > 0 && photonTrajectory_.size() > 0) {
     // Create TVector3s marking the start and endpoints of each projected
     // trajectory
-    e_traj_start.SetXYZ(ele_trajectory[0].first, ele_trajectory[0].second,
+    e_traj_start.SetXYZ(eleTrajectory_[0].first, eleTrajectory_[0].second,
                         geometry_->getZPosition(0));
-    e_traj_end.SetXYZ(ele_trajectory[(nEcalLayers_ - 1)].first,
-                      ele_trajectory[(nEcalLayers_ - 1)].second,
+    e_traj_end.SetXYZ(eleTrajectory_[(nEcalLayers_ - 1)].first,
+                      eleTrajectory_[(nEcalLayers_ - 1)].second,
                       geometry_->getZPosition((nEcalLayers_ - 1)));
-    p_traj_start.SetXYZ(photon_trajectory[0].first, photon_trajectory[0].second,
+    p_traj_start.SetXYZ(photonTrajectory_[0].first, photonTrajectory_[0].second,
                         geometry_->getZPosition(0));
-    p_traj_end.SetXYZ(photon_trajectory[(nEcalLayers_ - 1)].first,
-                      photon_trajectory[(nEcalLayers_ - 1)].second,
+    p_traj_end.SetXYZ(photonTrajectory_[(nEcalLayers_ - 1)].first,
+                      photonTrajectory_[(nEcalLayers_ - 1)].second,
                       geometry_->getZPosition((nEcalLayers_ - 1)));
 
     TVector3 evec = e_traj_end - e_traj_start;
@@ -740,13 +767,13 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   // segmipBDT
   firstNearPhLayer_ = nEcalLayers_ - 1;
 
-  if (photon_trajectory.size() !=
+  if (photonTrajectory_.size() !=
       0) {  // If no photon trajectory, leave this at the default (ECal back)
     for (std::vector<HitData>::iterator it = trackingHitList.begin();
          it != trackingHitList.end(); ++it) {
       float ehDist =
-          sqrt(pow((*it).pos.X() - photon_trajectory[(*it).layer].first, 2) +
-               pow((*it).pos.Y() - photon_trajectory[(*it).layer].second, 2));
+          sqrt(pow((*it).pos.X() - photonTrajectory_[(*it).layer].first, 2) +
+               pow((*it).pos.Y() - photonTrajectory_[(*it).layer].second, 2));
       if (ehDist < 8.7) {
         nNearPhHits_++;
         if ((*it).layer < firstNearPhLayer_) {
@@ -759,7 +786,7 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   // Territories limited to trackingHitList
   TVector3 gToe = (e_traj_start - p_traj_start).Unit();
   TVector3 origin = p_traj_start + 0.5 * 8.7 * gToe;
-  if (ele_trajectory.size() > 0) {
+  if (eleTrajectory_.size() > 0) {
     for (auto &hitData : trackingHitList) {
       TVector3 hitPos = hitData.pos;
       TVector3 hitPrime = hitPos - origin;
@@ -776,11 +803,6 @@ void EcalVetoProcessor::produce(framework::Event &event) {
 
   std::sort(trackingHitList.begin(), trackingHitList.end(),
             [](HitData ha, HitData hb) { return ha.layer > hb.layer; });
-  // For merging tracks:  Need to keep track of existing tracks
-  // Candidate tracks to merge in will always be in front of the current track
-  // (lower z), so only store the last hit 3-layer vector:  each track = vector
-  // of 3-tuples (xy+layer).
-  std::vector<std::vector<HitData>> track_list;
 
   // print trackingHitList
   if (verbose_) {
@@ -798,89 +820,25 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   // in v14 minR is 4.17 mm
   // while maxR is 4.81 mm
   float cellWidth = 2 * geometry_->getCellMaxR();
-  for (int iHit = 0; iHit < trackingHitList.size(); iHit++) {
-    // list of hit numbers in track (34 = maximum theoretical length)
-    int track[34];
-    int currenthit{iHit};
-    int trackLen{1};
-
-    track[0] = iHit;
-
-    // Search for hits to add to the track:
-    // repeatedly find hits in the front two layers with same x & y positions
-    // but since v14 the odd layers are offset, so we allow half a cellWidth
-    // deviation and then add to track until no more hits are found
-    int jHit = iHit;
-    while (jHit < trackingHitList.size()) {
-      if ((trackingHitList[jHit].layer ==
-               trackingHitList[currenthit].layer - 1 ||
-           trackingHitList[jHit].layer ==
-               trackingHitList[currenthit].layer - 2) &&
-          abs(trackingHitList[jHit].pos.X() -
-              trackingHitList[currenthit].pos.X()) <= 0.5 * cellWidth &&
-          abs(trackingHitList[jHit].pos.Y() -
-              trackingHitList[currenthit].pos.Y()) <= 0.5 * cellWidth) {
-        track[trackLen] = jHit;
-        trackLen++;
-        currenthit = jHit;
-      }
-      jHit++;
-    }
-
-    // Confirm that the track is valid:
-    if (trackLen < 2) continue;  // Track must contain at least 2 hits
-    float closest_e = distTwoLines(trackingHitList[track[0]].pos,
-                                   trackingHitList[track[trackLen - 1]].pos,
-                                   e_traj_start, e_traj_end);
-    float closest_p = distTwoLines(trackingHitList[track[0]].pos,
-                                   trackingHitList[track[trackLen - 1]].pos,
-                                   p_traj_start, p_traj_end);
-    // Make sure that the track is near the photon trajectory and away from the
-    // electron trajectory Details of these constraints may be revised
-    if (closest_p > cellWidth and closest_e < 2 * cellWidth) continue;
-    if (trackLen < 4 and closest_e > closest_p) continue;
-    if (verbose_) {
-      ldmx_log(debug) << "====== After rejection for MIP tracking ======";
-      ldmx_log(debug) << "current hit: [" << trackingHitList[iHit].pos.X()
-                      << ", " << trackingHitList[iHit].pos.Y() << ", "
-                      << trackingHitList[iHit].layer << "]";
-
-      for (int k = 0; k < trackLen; k++) {
-        ldmx_log(debug) << "track[" << k << "] position = ["
-                        << trackingHitList[track[k]].pos.X() << ", "
-                        << trackingHitList[track[k]].pos.Y() << ", "
-                        << trackingHitList[track[k]].layer << "]";
-      }
-    }
-
-    // if track found, increment nStraightTracks and remove all hits in track
-    // from future consideration
-    if (trackLen >= 2) {
-      std::vector<HitData> temp_track_list;
-      int n_remove = 0;
-      for (int kHit = 0; kHit < trackLen; kHit++) {
-        temp_track_list.push_back(trackingHitList[track[kHit] - n_remove]);
-        trackingHitList.erase(trackingHitList.begin() + track[kHit] - n_remove);
-        n_remove++;
-      }
-      // print trackingHitList
-      if (verbose_) {
-        ldmx_log(debug) << "====== Tracking hit list (after erase) length "
-                        << trackingHitList.size() << " ======";
-        for (int i = 0; i < trackingHitList.size(); i++) {
-          std::cout << "[" << trackingHitList[i].pos.X() << ", "
-                    << trackingHitList[i].pos.Y() << ", "
-                    << trackingHitList[i].layer << "] ";
-        }
-        std::cout << std::endl;
-        ldmx_log(debug) << "====== END OF Tracking hit list ======";
-      }
+  // For merging tracks:  Need to keep track of existing tracks
+  // Candidate tracks to merge in will always be in front of the current track
+  // (lower z), so only store the last hit 3-layer vector:  each track = vector
+  // of 3-tuples (xy+layer).
+  std::vector<std::vector<HitData>> track_list =
+      findStraightTracks(trackingHitList, cellWidth, e_traj_start, e_traj_end,
+                         p_traj_start, p_traj_end);
 
-      track_list.push_back(temp_track_list);
-      // The *current* hit will have been removed, so iHit is currently pointing
-      // to the next hit. Decrement iHit so no hits will get skipped by iHit++
-      iHit--;
+  // print trackingHitList
+  if (verbose_) {
+    ldmx_log(debug) << "====== Tracking hit list (after straight tracks) "
+                    << "length " << trackingHitList.size() << " ======";
+    for (int i = 0; i < trackingHitList.size(); i++) {
+      std::cout << "[" << trackingHitList[i].pos.X() << ", "
+                << trackingHitList[i].pos.Y() << ", "
+                << trackingHitList[i].layer << "] ";
     }
+    std::cout << std::endl;
+    ldmx_log(debug) << "====== END OF Tracking hit list ======";
   }
 
   ldmx_log(debug) << "Straight tracks found (before merge): "
@@ -907,12 +865,12 @@ void EcalVetoProcessor::produce(framework::Event &event) {
   for (int track_i = 0; track_i < track_list.size(); track_i++) {
     // for each track, check the remainder of the track list for compatible
     // tracks
-    std::vector<HitData> base_track = track_list[track_i];
+    std::vector<HitData> &base_track = track_list[track_i];
     HitData tail_hitdata = base_track.back();  // xylayer of last hit in track
     if (verbose_) ldmx_log(debug) << "  Considering track " << track_i;
     for (int track_j = track_i + 1; track_j < track_list.size(); track_j++) {
-      std::vector<HitData> checking_track = track_list[track_j];
-      HitData head_hitdata = checking_track.front();
+      const std::vector<HitData> &checking_track = track_list[track_j];
+      const HitData &head_hitdata = checking_track.front();
       // if 1-2 layers behind, and xy within one cell...
       if ((head_hitdata.layer == tail_hitdata.layer + 1 ||
            head_hitdata.layer == tail_hitdata.layer + 2) &&
@@ -932,10 +890,8 @@ void EcalVetoProcessor::produce(framework::Event &event) {
                           << "," << tail_hitdata.pos.Y() << ","
                           << tail_hitdata.layer;
         }
-        for (int hit_k = 0; hit_k < checking_track.size(); hit_k++) {
-          base_track.push_back(track_list[track_j][hit_k]);
-        }
-        track_list[track_i] = base_track;
+        base_track.insert(base_track.end(), checking_track.begin(),
+                          checking_track.end());
         track_list.erase(track_list.begin() + track_j);
         break;
       }
@@ -1093,58 +1049,70 @@ void EcalVetoProcessor::produce(framework::Event &event) {
       nReadoutHits_, deepestLayerHit_, summedDet_, summedTightIso_, maxCellDep_,
       showerRMS_, xStd_, yStd_, avgLayerHit_, stdLayerHit_, ecalBackEnergy_,
       nStraightTracks_, nLinregTracks_, firstNearPhLayer_, nNearPhHits_,
-      photonTerritoryHits_, epAng_, epSep_, epDot_, electronContainmentEnergy,
-      photonContainmentEnergy, outsideContainmentEnergy,
-      outsideContainmentNHits, outsideContainmentXstd, outsideContainmentYstd,
-      energySeg, xMeanSeg, yMeanSeg, xStdSeg, yStdSeg, layerMeanSeg,
-      layerStdSeg, eContEnergy, eContXMean, eContYMean, gContEnergy, gContNHits,
-      gContXMean, gContYMean, oContEnergy, oContNHits, oContXMean, oContYMean,
-      oContXStd, oContYStd, oContLayerMean, oContLayerStd,
-      ecalLayerEdepReadout_, recoilP, recoilPos);
-
-  buildBDTFeatureVector(result);
-  ldmx::Ort::FloatArrays inputs({bdtFeatures_});
-  float pred = rt_->run({featureListName_}, inputs, {"probabilities"})[0].at(1);
-  // Other considerations were (nLinregTracks_ == 0)  && (firstNearPhLayer_ >=
-  // 6)
-  // && (epAng_ > 3.0 && epAng_ < 900 || epSep_ > 10.0 && epSep_ < 900)
-  bool passesTrackingVeto = (nStraightTracks_ < 3);
-  result.setVetoResult(pred > bdtCutVal_ && passesTrackingVeto);
-  result.setDiscValue(pred);
-  ldmx_log(debug) << "  The pred > bdtCutVal = " << (pred > bdtCutVal_);
+      photonTerritoryHits_, epAng_, epSep_, epDot_,
+      toVector(electronContainmentEnergy), toVector(photonContainmentEnergy),
+      toVector(outsideContainmentEnergy), toVector(outsideContainmentNHits),
+      toVector(outsideContainmentXstd), toVector(outsideContainmentYstd),
+      toVector(energySeg), toVector(xMeanSeg), toVector(yMeanSeg),
+      toVector(xStdSeg), toVector(yStdSeg), toVector(layerMeanSeg),
+      toVector(layerStdSeg), toVector(eContEnergy), toVector(eContXMean),
+      toVector(eContYMean), toVector(gContEnergy), toVector(gContNHits),
+      toVector(gContXMean), toVector(gContYMean), toVector(oContEnergy),
+      toVector(oContNHits), toVector(oContXMean), toVector(oContYMean),
+      toVector(oContXStd), toVector(oContYStd), toVector(oContLayerMean),
+      toVector(oContLayerStd), ecalLayerEdepReadout_, recoilP, recoilPos);
 
   // Persist in the event if the recoil ele is fiducial
   result.setFiducial(inside);
+}
 
-  // If the event passes the veto, keep it. Otherwise,
-  // drop the event.
-  if (result.passesVeto()) {
-    setStorageHint(framework::hint_shouldKeep);
-  } else {
-    setStorageHint(framework::hint_shouldDrop);
-  }
+void EcalVetoProcessor::fillHitArrays(
+    const std::vector<ldmx::EcalHit> &ecalRecHits) {
+  numCellsPerModule_ = geometry_->getNumCellsPerModule();
+  const std::size_t numCells{geometry_->getNumLayers() *
+                             geometry_->getNumModulesPerLayer() *
+                             numCellsPerModule_};
+  if (cellState_.size() != numCells) cellState_.assign(numCells, NoHit);
 
-  event.add(collectionName_, result);
+  for (const ldmx::EcalHit &hit : ecalRecHits) {
+    ldmx::EcalID id(hit.getID());
+    auto [x, y, z] = geometry_->getPosition(id);
+    hits_.id.push_back(id);
+    hits_.x.push_back(x);
+    hits_.y.push_back(y);
+    hits_.layer.push_back(id.layer());
+    hits_.energy.push_back(hit.getEnergy());
+    hits_.time.push_back(hit.getTime());
+    hits_.cell.push_back(cellIndex(id));
+    cellState_[hits_.cell.back()] = Hit;
+
+    // the trajectories are in single precision
+    const XYCoords xy_pair(x, y);
+    auto distance = [&](const std::vector<XYCoords> &trajectory) -> float {
+      if (trajectory.empty()) return -1.0;
+      const XYCoords &traj_xy{trajectory[id.layer()]};
+      return std::sqrt(square(xy_pair.first - traj_xy.first) +
+                       square(xy_pair.second - traj_xy.second));
+    };
+    hits_.eleDist.push_back(distance(eleTrajectory_));
+    hits_.photonDist.push_back(distance(photonTrajectory_));
+  }
 }
 
 /* Function to calculate the energy weighted shower centroid */
-ldmx::EcalID EcalVetoProcessor::GetShowerCentroidIDAndRMS(
-    const std::vector<ldmx::EcalHit> &ecalRecHits, double &showerRMS) {
+ldmx::EcalID EcalVetoProcessor::GetShowerCentroidIDAndRMS(double &showerRMS) {
   auto wgtCentroidCoords = std::make_pair<float, float>(0., 0.);
   float sumEdep = 0;
   ldmx::EcalID returnCellId;
 
   // Calculate Energy Weighted Centroid
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
-    ldmx::EcalID id(hit.getID());
-    CellEnergyPair cell_energy_pair = std::make_pair(id, hit.getEnergy());
-    auto [x, y, z] = geometry_->getPosition(id);
-    XYCoords centroidCoords = std::make_pair(x, y);
-    wgtCentroidCoords.first = wgtCentroidCoords.first +
-                              centroidCoords.first * cell_energy_pair.second;
-    wgtCentroidCoords.second = wgtCentroidCoords.second +
-                               centroidCoords.second * cell_energy_pair.second;
-    sumEdep += cell_energy_pair.second;
+  for (std::size_t iHit = 0; iHit < hits_.size(); iHit++) {
+    XYCoords centroidCoords(hits_.x[iHit], hits_.y[iHit]);
+    wgtCentroidCoords.first =
+        wgtCentroidCoords.first + centroidCoords.first * hits_.energy[iHit];
+    wgtCentroidCoords.second =
+        wgtCentroidCoords.second + centroidCoords.second * hits_.energy[iHit];
+    sumEdep += hits_.energy[iHit];
   }
   wgtCentroidCoords.first = (sumEdep > 1E-6) ? wgtCentroidCoords.first / sumEdep
                                              : wgtCentroidCoords.first;
@@ -1153,18 +1121,16 @@ ldmx::EcalID EcalVetoProcessor::GetShowerCentroidIDAndRMS(
                                  : wgtCentroidCoords.second;
   // Find Nearest Cell to Centroid
   float maxDist = 1e6;
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
-    auto [x, y, z] = geometry_->getPosition(hit.getID());
-    XYCoords centroidCoords = std::make_pair(x, y);
+  for (std::size_t iHit = 0; iHit < hits_.size(); iHit++) {
+    XYCoords centroidCoords(hits_.x[iHit], hits_.y[iHit]);
 
     float deltaR =
-        pow(pow((centroidCoords.first - wgtCentroidCoords.first), 2) +
-                pow((centroidCoords.second - wgtCentroidCoords.second), 2),
-            .5);
-    showerRMS += deltaR * hit.getEnergy();
+        std::sqrt(square(centroidCoords.first - wgtCentroidCoords.first) +
+                  square(centroidCoords.second - wgtCentroidCoords.second));
+    showerRMS += deltaR * hits_.energy[iHit];
     if (deltaR < maxDist) {
       maxDist = deltaR;
-      returnCellId = ldmx::EcalID(hit.getID());
+      returnCellId = hits_.id[iHit];
     }
   }
   if (sumEdep > 0) showerRMS = showerRMS / sumEdep;
@@ -1172,25 +1138,13 @@ ldmx::EcalID EcalVetoProcessor::GetShowerCentroidIDAndRMS(
   return ldmx::EcalID(0, returnCellId.module(), returnCellId.cell());
 }
 
-/**
- * Function to load up empty vector of hit maps
- */
-void EcalVetoProcessor::fillHitMap(
-    const std::vector<ldmx::EcalHit> &ecalRecHits,
-    std::map<ldmx::EcalID, float> &cellMap) {
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
-    ldmx::EcalID id(hit.getID());
-    cellMap.emplace(id, hit.getEnergy());
-  }
-}
-
-void EcalVetoProcessor::fillIsolatedHitMap(
-    const std::vector<ldmx::EcalHit> &ecalRecHits, ldmx::EcalID globalCentroid,
-    std::map<ldmx::EcalID, float> &cellMap,
-    std::map<ldmx::EcalID, float> &cellMapIso, bool doTight) {
-  for (const ldmx::EcalHit &hit : ecalRecHits) {
-    auto isolatedHit = std::make_pair(true, ldmx::EcalID());
-    ldmx::EcalID id(hit.getID());
+double EcalVetoProcessor::sumIsolatedHits(ldmx::EcalID globalCentroid,
+                                          bool doTight) {
+  double summedIso{0};
+  for (std::size_t iHit = 0; iHit < hits_.size(); iHit++) {
+    ldmx::EcalID id(hits_.id[iHit]);
+    // only count the first hit in each cell
+    if (cellState_[hits_.cell[iHit]] == IsolatedHit) continue;
     if (doTight) {
       // Disregard hits that are on the centroid.
       if (id == globalCentroid) continue;
@@ -1202,34 +1156,32 @@ void EcalVetoProcessor::fillIsolatedHitMap(
     }
 
     // Skip hits that have a readout neighbor
-    // Get neighboring cell id's and try to look them up in the full cell map
+    // Get neighboring cell id's and try to look them up in the cell states
     // (constant speed algo.)
-    //  these ideas are only cell/module (must ignore layer)
-    std::vector<ldmx::EcalID> cellNbrIds = geometry_->getNN(id);
-
-    for (int k = 0; k < cellNbrIds.size(); k++) {
-      // update neighbor ID to the current layer
-      cellNbrIds[k] = ldmx::EcalID(id.layer(), cellNbrIds[k].module(),
-                                   cellNbrIds[k].cell());
-      // look in cell hit map to see if it is there
-      if (cellMap.find(cellNbrIds[k]) != cellMap.end()) {
-        isolatedHit = std::make_pair(false, cellNbrIds[k]);
+    //  the neighbor IDs are already in the layer of the hit
+    bool isolated{true};
+    for (ldmx::EcalID nbrId : geometry_->getNN(id)) {
+      if (cellState_[cellIndex(nbrId)] != NoHit) {
+        isolated = false;
         break;
       }
     }
-    if (!isolatedHit.first) {
+    if (!isolated) {
       continue;
     }
-    // Insert isolated hit
-    cellMapIso.emplace(id, hit.getEnergy());
+    // Count isolated hit
+    cellState_[hits_.cell[iHit]] = IsolatedHit;
+    if (hits_.energy[iHit] > 0) summedIso += hits_.energy[iHit];
   }
+  return summedIso;
 }
 
 /* Calculate where trajectory intersects ECAL layers using position and momentum
  * at scoring plane */
-std::vector<std::pair<float, float>> EcalVetoProcessor::getTrajectory(
-    std::vector<double> momentum, std::vector<float> position) {
-  std::vector<XYCoords> positions;
+void EcalVetoProcessor::getTrajectory(const std::vector<double> &momentum,
+                                      const std::vector<float> &position,
+                                      std::vector<XYCoords> &positions) {
+  positions.clear();
   for (int iLayer = 0; iLayer < nEcalLayers_; iLayer++) {
     float posX =
         position[0] + (momentum[0] / momentum[2]) *
@@ -1239,11 +1191,122 @@ std::vector<std::pair<float, float>> EcalVetoProcessor::getTrajectory(
                           (geometry_->getZPosition(iLayer) - position[2]);
     positions.push_back(std::make_pair(posX, posY));
   }
-  return positions;
 }
 
 // MIP tracking functions:
 
+std::vector<std::vector<EcalVetoProcessor::HitData>>
+EcalVetoProcessor::findStraightTracks(std::vector<HitData> &trackingHitList,
+                                      float cellWidth,
+                                      const TVector3 &e_traj_start,
+                                      const TVector3 &e_traj_end,
+                                      const TVector3 &p_traj_start,
+                                      const TVector3 &p_traj_end) {
+  const std::size_t nHits{trackingHitList.size()};
+
+  // Bin the hits by layer and position on a grid one cell width wide.
+  // The hits within half a cell width of a position are in the 3x3 bins
+  // around the bin of that position.
+  auto bin = [cellWidth](double v) -> long {
+    return static_cast<long>(std::floor(v / cellWidth));
+  };
+  auto key = [](long layer, long xbin, long ybin) -> long long {
+    // the bins cover +-2^20 cell widths, far more than the Ecal
+    return (layer << 42) | ((xbin + (1L << 20)) << 21) | (ybin + (1L << 20));
+  };
+  // bin key and position in the list of each hit, sorted by key then position
+  std::vector<std::pair<long long, std::size_t>> index;
+  index.reserve(nHits);
+  for (std::size_t iHit = 0; iHit < nHits; iHit++) {
+    const HitData &hit{trackingHitList[iHit]};
+    index.emplace_back(key(hit.layer, bin(hit.pos.X()), bin(hit.pos.Y())),
+                       iHit);
+  }
+  std::sort(index.begin(), index.end());
+
+  // hits that are already on a track, instead of removing them from the list
+  std::vector<bool> used(nHits, false);
+  std::vector<std::vector<HitData>> track_list;
+  // list of hit numbers in current track
+  std::vector<std::size_t> track;
+  for (std::size_t iHit = 0; iHit < nHits; iHit++) {
+    if (used[iHit]) continue;
+    track.clear();
+    track.push_back(iHit);
+    std::size_t currenthit{iHit};
+
+    // Search for hits to add to the track:
+    // repeatedly find the first hit in the list in the front two layers with
+    // the same x & y position (within half a cell width) and add it to the
+    // track until no more hits are found.
+    // The hits in front of the current one are all after it in the list, so
+    // the first one in the list is the one with the lowest position.
+    while (true) {
+      const HitData &current{trackingHitList[currenthit]};
+      const long xbin{bin(current.pos.X())}, ybin{bin(current.pos.Y())};
+      std::size_t next{nHits};
+      for (int layer : {current.layer - 1, current.layer - 2}) {
+        for (long xb = xbin - 1; xb <= xbin + 1; xb++) {
+          for (long yb = ybin - 1; yb <= ybin + 1; yb++) {
+            for (auto it = std::lower_bound(index.begin(), index.end(),
+                                            std::make_pair(key(layer, xb, yb),
+                                                           std::size_t(0)));
+                 it != index.end() && it->first == key(layer, xb, yb) &&
+                 it->second < next;
+                 ++it) {
+              const HitData &probe{trackingHitList[it->second]};
+              if (!used[it->second] &&
+                  std::abs(probe.pos.X() - current.pos.X()) <=
+                      0.5 * cellWidth &&
+                  std::abs(probe.pos.Y() - current.pos.Y()) <=
+                      0.5 * cellWidth) {
+                next = it->second;
+                break;
+              }
+            }
+          }
+        }
+      }
+      if (next == nHits) break;
+      track.push_back(next);
+      currenthit = next;
+    }
+
+    // Confirm that the track is valid:
+    int trackLen = track.size();
+    if (trackLen < 2) continue;  // Track must contain at least 2 hits
+    float closest_e =
+        distTwoLines(trackingHitList[track[0]].pos,
+                     trackingHitList[track[trackLen - 1]].pos, e_traj_start,
+                     e_traj_end);
+    float closest_p =
+        distTwoLines(trackingHitList[track[0]].pos,
+                     trackingHitList[track[trackLen - 1]].pos, p_traj_start,
+                     p_traj_end);
+    // Make sure that the track is near the photon trajectory and away from the
+    // electron trajectory Details of these constraints may be revised
+    if (closest_p > cellWidth and closest_e < 2 * cellWidth) continue;
+    if (trackLen < 4 and closest_e > closest_p) continue;
+
+    // if track found, store it and remove all hits in track from future
+    // consideration
+    std::vector<HitData> &found{track_list.emplace_back()};
+    for (std::size_t kHit : track) {
+      used[kHit] = true;
+      found.push_back(trackingHitList[kHit]);
+    }
+  }
+
+  // remove the hits on tracks from the list, keeping the order of the others
+  std::size_t nKept{0};
+  for (std::size_t iHit = 0; iHit < nHits; iHit++) {
+    if (!used[iHit]) trackingHitList[nKept++] = trackingHitList[iHit];
+  }
+  trackingHitList.resize(nKept);
+
+  return track_list;
+}
+
 float EcalVetoProcessor::distTwoLines(TVector3 v1, TVector3 v2, TVector3 w1,
                                       TVector3 w2) {
   TVector3 e1 = v1 - v2;
@@ -46,7 +46,7 @@ void WorkingCluster::add(const WorkingCluster& wc) {
 
   centroid_.SetPxPyPzE(newCentroidX, newCentroidY, newCentroidZ, newE);
 
-  std::vector<const ldmx::EcalHit*> clusterHits = wc.getHits();
+  const std::vector<const ldmx::EcalHit*>& clusterHits = wc.getHits();
 
   for (size_t i = 0; i < clusterHits.size(); i++) {
     hits_.push_back(clusterHits[i]);
@@ -0,0 +1,1103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "DetDescr/EcalGeometry.h"
+#include "Ecal/EcalVetoProcessor.h"
+#include "Ecal/Event/EcalHit.h"
+#include "Ecal/Event/EcalVetoResult.h"
+#include "Framework/Configure/Parameters.h"
+#include "Framework/Process.h"
+
+// ROOT (MIP tracking)
+#include "TDecompSVD.h"
+#include "TMatrixD.h"
+#include "TVector3.h"
+
+namespace ecal {
+namespace test {
+
+using HitData = EcalVetoProcessor::HitData;
+
+/// number of layers in the v14 Ecal
+static const int N_LAYERS{34};
+
+/// energy of the beam [MeV]
+static const double BEAM_ENERGY{8000.};
+
+/**
+ * Make the parameters of the v14 geometry
+ *
+ * These are copied from the python configuration.
+ */
+static framework::config::Parameters geometryParameters() {
+  framework::config::Parameters params;
+  params.addParameter(
+      "layerZPositions",
+      std::vector<double>{7.932,   14.532,  32.146,  40.746,  58.110,
+                          67.710,  86.574,  96.774,  115.638, 125.838,
+                          144.702, 154.902, 173.766, 183.966, 202.830,
+                          213.030, 231.894, 242.094, 260.958, 271.158,
+                          290.022, 300.222, 319.086, 329.286, 351.650,
+                          365.250, 387.614, 401.214, 423.578, 437.178,
+                          459.542, 473.142, 495.506, 509.106});
+  params.addParameter("ecalFrontZ", 240.0);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", 35.3);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", true);
+  params.addParameter("layer_shift_x", 2 * 85.0 / 35.3);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", true);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  return params;
+}
+
+/**
+ * Make a table of radii of containment
+ *
+ * The first bin is the default, the others are split by the angle and
+ * momentum of the recoil electron like the ones in the data files.
+ * The radii are a few cells wide and grow with the layer.
+ */
+static std::vector<std::vector<double>> rocRangeValues() {
+  std::vector<std::vector<double>> bins{{-1., -1., -1., -1.},
+                                        {0., 10., -1., -1.},
+                                        {10., -1., 0., 2000.},
+                                        {10., -1., 2000., -1.}};
+  for (std::size_t ibin = 0; ibin < bins.size(); ibin++) {
+    for (int layer = 0; layer < N_LAYERS; layer++) {
+      bins[ibin].push_back(3. + ibin + 0.4 * layer);
+    }
+  }
+  return bins;
+}
+
+/**
+ * The features as they were computed before the hits were converted
+ * into arrays, looking up the position of each hit in every loop and
+ * keeping the hits in maps of the cells.
+ *
+ * This is the reference the processor has to reproduce exactly.
+ * Only the nearest neighbors are taken from the current geometry which
+ * now returns them as a range.
+ */
+class ReferenceFeatures {
+ public:
+  typedef std::pair<ldmx::EcalID, float> CellEnergyPair;
+
+  typedef std::pair<float, float> XYCoords;
+
+  ReferenceFeatures(const ldmx::EcalGeometry &geometry)
+      : geometry_{&geometry},
+        roc_range_values_{rocRangeValues()},
+        nEcalLayers_{N_LAYERS},
+        beamEnergyMeV_{BEAM_ENERGY},
+        ecalLayerEdepRaw_(N_LAYERS, 0),
+        ecalLayerEdepReadout_(N_LAYERS, 0),
+        ecalLayerTime_(N_LAYERS, 0) {}
+
+  ldmx::EcalVetoResult compute(const std::vector<ldmx::EcalHit> &ecalRecHits,
+                               std::vector<double> recoilP,
+                               std::vector<float> recoilPos,
+                               std::vector<double> recoilPAtTarget,
+                               std::vector<float> recoilPosAtTarget) {
+    ldmx::EcalVetoResult result;
+    std::vector<XYCoords> ele_trajectory, photon_trajectory;
+    if (recoilP.size() > 0) {
+      ele_trajectory = getTrajectory(recoilP, recoilPos);
+      std::vector<double> pvec = recoilPAtTarget.size()
+                                     ? recoilPAtTarget
+                                     : std::vector<double>{0.0, 0.0, 0.0};
+      std::vector<float> posvec = recoilPosAtTarget.size()
+                                      ? recoilPosAtTarget
+                                      : std::vector<float>{0.0, 0.0, 0.0};
+      photon_trajectory =
+          getTrajectory({-pvec[0], -pvec[1], beamEnergyMeV_ - pvec[2]}, posvec);
+    }
+
+    float recoilPMag =
+        recoilP.size()
+            ? sqrt(pow(recoilP[0], 2) + pow(recoilP[1], 2) + pow(recoilP[2], 2))
+            : -1.0;
+    float recoilTheta =
+        recoilPMag > 0 ? acos(recoilP[2] / recoilPMag) * 180.0 / M_PI : -1.0;
+
+    std::vector<double> roc_values_bin0(roc_range_values_[0].begin() + 4,
+                                        roc_range_values_[0].end());
+    std::vector<double> ele_radii = roc_values_bin0;
+    double theta_min, theta_max, p_min, p_max;
+    bool inrange;
+
+    for (int i = 0; i < roc_range_values_.size(); i++) {
+      theta_min = roc_range_values_[i][0];
+      theta_max = roc_range_values_[i][1];
+      p_min = roc_range_values_[i][2];
+      p_max = roc_range_values_[i][3];
+      inrange = true;
+
+      if (theta_min != -1.0) {
+        inrange = inrange && (recoilTheta >= theta_min);
+      }
+      if (theta_max != -1.0) {
+        inrange = inrange && (recoilTheta < theta_max);
+      }
+      if (p_min != -1.0) {
+        inrange = inrange && (recoilPMag >= p_min);
+      }
+      if (p_max != -1.0) {
+        inrange = inrange && (recoilPMag < p_max);
+      }
+      if (inrange) {
+        std::vector<double> roc_values_bini(roc_range_values_[i].begin() + 4,
+                                            roc_range_values_[i].end());
+        ele_radii = roc_values_bini;
+      }
+    }
+    std::vector<double> photon_radii = roc_values_bin0;
+
+    ldmx::EcalID globalCentroid =
+        GetShowerCentroidIDAndRMS(ecalRecHits, showerRMS_);
+    fillHitMap(ecalRecHits, cellMap_);
+    bool doTight = true;
+    fillIsolatedHitMap(ecalRecHits, globalCentroid, cellMap_, cellMapTightIso_,
+                       doTight);
+
+    float wavgLayerHit = 0;
+    float xMean = 0;
+    float yMean = 0;
+
+    unsigned int nregions = 5;
+    std::vector<float> electronContainmentEnergy(nregions, 0.0);
+    std::vector<float> photonContainmentEnergy(nregions, 0.0);
+    std::vector<float> outsideContainmentEnergy(nregions, 0.0);
+    std::vector<int> outsideContainmentNHits(nregions, 0);
+    std::vector<float> outsideContainmentXmean(nregions, 0.0);
+    std::vector<float> outsideContainmentYmean(nregions, 0.0);
+    std::vector<float> outsideContainmentXstd(nregions, 0.0);
+    std::vector<float> outsideContainmentYstd(nregions, 0.0);
+    std::vector<int> segLayers = {0, 6, 17, 34};
+    unsigned int nsegments = segLayers.size() - 1;
+    std::vector<float> energySeg(nsegments, 0.0);
+    std::vector<float> xMeanSeg(nsegments, 0.0);
+    std::vector<float> xStdSeg(nsegments, 0.0);
+    std::vector<float> yMeanSeg(nsegments, 0.0);
+    std::vector<float> yStdSeg(nsegments, 0.0);
+    std::vector<float> layerMeanSeg(nsegments, 0.0);
+    std::vector<float> layerStdSeg(nsegments, 0.0);
+    std::vector<std::vector<float>> eContEnergy(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> eContXMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> eContYMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> gContEnergy(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<int>> gContNHits(nregions,
+                                             std::vector<int>(nsegments, 0));
+    std::vector<std::vector<float>> gContXMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> gContYMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> oContEnergy(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<int>> oContNHits(nregions,
+                                             std::vector<int>(nsegments, 0));
+    std::vector<std::vector<float>> oContXMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> oContYMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> oContXStd(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> oContYStd(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> oContLayerMean(
+        nregions, std::vector<float>(nsegments, 0.0));
+    std::vector<std::vector<float>> oContLayerStd(
+        nregions, std::vector<float>(nsegments, 0.0));
+
+    std::vector<HitData> trackingHitList;
+
+    for (const ldmx::EcalHit &hit : ecalRecHits) {
+      ldmx::EcalID id(hit.getID());
+      ecalLayerEdepRaw_[id.layer()] =
+          ecalLayerEdepRaw_[id.layer()] + hit.getEnergy();
+      if (id.layer() >= 20) ecalBackEnergy_ += hit.getEnergy();
+      if (maxCellDep_ < hit.getEnergy()) maxCellDep_ = hit.getEnergy();
+      if (hit.getEnergy() > 0) {
+        nReadoutHits_++;
+        ecalLayerEdepReadout_[id.layer()] += hit.getEnergy();
+        ecalLayerTime_[id.layer()] += (hit.getEnergy()) * hit.getTime();
+        auto [x, y, z] = geometry_->getPosition(id);
+        xMean += x * hit.getEnergy();
+        yMean += y * hit.getEnergy();
+        avgLayerHit_ += id.layer();
+        wavgLayerHit += id.layer() * hit.getEnergy();
+        if (deepestLayerHit_ < id.layer()) {
+          deepestLayerHit_ = id.layer();
+        }
+        XYCoords xy_pair = std::make_pair(x, y);
+        float distance_ele_trajectory =
+            ele_trajectory.size()
+                ? sqrt(pow((xy_pair.first - ele_trajectory[id.layer()].first),
+                           2) +
+                       pow((xy_pair.second -
+                            ele_trajectory[id.layer()].second),
+                           2))
+                : -1.0;
+        float distance_photon_trajectory =
+            photon_trajectory.size()
+                ? sqrt(pow((xy_pair.first -
+                            photon_trajectory[id.layer()].first),
+                           2) +
+                       pow((xy_pair.second -
+                            photon_trajectory[id.layer()].second),
+                           2))
+                : -1.0;
+
+        for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+          if (id.layer() >= segLayers[iseg] &&
+              id.layer() <= segLayers[iseg + 1] - 1) {
+            energySeg[iseg] += hit.getEnergy();
+            xMeanSeg[iseg] += xy_pair.first * hit.getEnergy();
+            yMeanSeg[iseg] += xy_pair.second * hit.getEnergy();
+            layerMeanSeg[iseg] += id.layer() * hit.getEnergy();
+
+            for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+              if (distance_ele_trajectory >= ireg * ele_radii[id.layer()] &&
+                  distance_ele_trajectory <
+                      (ireg + 1) * ele_radii[id.layer()]) {
+                eContEnergy[ireg][iseg] += hit.getEnergy();
+                eContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
+                eContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
+              }
+              if (distance_photon_trajectory >=
+                      ireg * photon_radii[id.layer()] &&
+                  distance_photon_trajectory <
+                      (ireg + 1) * photon_radii[id.layer()]) {
+                gContEnergy[ireg][iseg] += hit.getEnergy();
+                gContNHits[ireg][iseg] += 1;
+                gContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
+                gContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
+              }
+              if (distance_ele_trajectory >
+                      (ireg + 1) * ele_radii[id.layer()] &&
+                  distance_photon_trajectory >
+                      (ireg + 1) * photon_radii[id.layer()]) {
+                oContEnergy[ireg][iseg] += hit.getEnergy();
+                oContNHits[ireg][iseg] += 1;
+                oContXMean[ireg][iseg] += xy_pair.first * hit.getEnergy();
+                oContYMean[ireg][iseg] += xy_pair.second * hit.getEnergy();
+                oContLayerMean[ireg][iseg] += id.layer() * hit.getEnergy();
+              }
+            }
+          }
+        }
+
+        for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+          if (distance_ele_trajectory >= ireg * ele_radii[id.layer()] &&
+              distance_ele_trajectory < (ireg + 1) * ele_radii[id.layer()])
+            electronContainmentEnergy[ireg] += hit.getEnergy();
+          if (distance_photon_trajectory >= ireg * photon_radii[id.layer()] &&
+              distance_photon_trajectory <
+                  (ireg + 1) * photon_radii[id.layer()])
+            photonContainmentEnergy[ireg] += hit.getEnergy();
+          if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
+              distance_photon_trajectory >
+                  (ireg + 1) * photon_radii[id.layer()]) {
+            outsideContainmentEnergy[ireg] += hit.getEnergy();
+            outsideContainmentNHits[ireg] += 1;
+            outsideContainmentXmean[ireg] += xy_pair.first * hit.getEnergy();
+            outsideContainmentYmean[ireg] += xy_pair.second * hit.getEnergy();
+          }
+        }
+
+        if (distance_ele_trajectory >= ele_radii[id.layer()] ||
+            distance_ele_trajectory == -1.0) {
+          HitData hd;
+          hd.pos = TVector3(xy_pair.first, xy_pair.second,
+                            geometry_->getZPosition(id.layer()));
+          hd.layer = id.layer();
+          trackingHitList.push_back(hd);
+        }
+      }
+    }
+
+    for (const auto &[id, energy] : cellMapTightIso_) {
+      if (energy > 0) summedTightIso_ += energy;
+    }
+
+    for (int iLayer = 0; iLayer < ecalLayerEdepReadout_.size(); iLayer++) {
+      ecalLayerTime_[iLayer] =
+          ecalLayerTime_[iLayer] / ecalLayerEdepReadout_[iLayer];
+      summedDet_ += ecalLayerEdepReadout_[iLayer];
+    }
+
+    if (nReadoutHits_ > 0) {
+      avgLayerHit_ /= nReadoutHits_;
+      wavgLayerHit /= summedDet_;
+      xMean /= summedDet_;
+      yMean /= summedDet_;
+    } else {
+      wavgLayerHit = 0;
+      avgLayerHit_ = 0;
+      xMean = 0;
+      yMean = 0;
+    }
+
+    for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+      if (energySeg[iseg] > 0) {
+        xMeanSeg[iseg] /= energySeg[iseg];
+        yMeanSeg[iseg] /= energySeg[iseg];
+        layerMeanSeg[iseg] /= energySeg[iseg];
+      }
+      for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+        if (eContEnergy[ireg][iseg] > 0) {
+          eContXMean[ireg][iseg] /= eContEnergy[ireg][iseg];
+          eContYMean[ireg][iseg] /= eContEnergy[ireg][iseg];
+        }
+        if (gContEnergy[ireg][iseg] > 0) {
+          gContXMean[ireg][iseg] /= gContEnergy[ireg][iseg];
+          gContYMean[ireg][iseg] /= gContEnergy[ireg][iseg];
+        }
+        if (oContEnergy[ireg][iseg] > 0) {
+          oContXMean[ireg][iseg] /= oContEnergy[ireg][iseg];
+          oContYMean[ireg][iseg] /= oContEnergy[ireg][iseg];
+          oContLayerMean[ireg][iseg] /= oContEnergy[ireg][iseg];
+        }
+      }
+    }
+
+    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+      if (outsideContainmentEnergy[ireg] > 0) {
+        outsideContainmentXmean[ireg] /= outsideContainmentEnergy[ireg];
+        outsideContainmentYmean[ireg] /= outsideContainmentEnergy[ireg];
+      }
+    }
+
+    for (const ldmx::EcalHit &hit : ecalRecHits) {
+      ldmx::EcalID id(hit.getID());
+      auto [x, y, z] = geometry_->getPosition(id);
+      if (hit.getEnergy() > 0) {
+        xStd_ += pow((x - xMean), 2) * hit.getEnergy();
+        yStd_ += pow((y - yMean), 2) * hit.getEnergy();
+        stdLayerHit_ += pow((id.layer() - wavgLayerHit), 2) * hit.getEnergy();
+      }
+      XYCoords xy_pair = std::make_pair(x, y);
+      float distance_ele_trajectory =
+          ele_trajectory.size()
+              ? sqrt(
+                    pow((xy_pair.first - ele_trajectory[id.layer()].first), 2) +
+                    pow((xy_pair.second - ele_trajectory[id.layer()].second),
+                        2))
+              : -1.0;
+      float distance_photon_trajectory =
+          photon_trajectory.size()
+              ? sqrt(
+                    pow((xy_pair.first - photon_trajectory[id.layer()].first),
+                        2) +
+                    pow((xy_pair.second - photon_trajectory[id.layer()].second),
+                        2))
+              : -1.0;
+
+      for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+        if (id.layer() >= segLayers[iseg] &&
+            id.layer() <= segLayers[iseg + 1] - 1) {
+          xStdSeg[iseg] +=
+              pow((xy_pair.first - xMeanSeg[iseg]), 2) * hit.getEnergy();
+          yStdSeg[iseg] +=
+              pow((xy_pair.second - yMeanSeg[iseg]), 2) * hit.getEnergy();
+          layerStdSeg[iseg] +=
+              pow((id.layer() - layerMeanSeg[iseg]), 2) * hit.getEnergy();
+
+          for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+            if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
+                distance_photon_trajectory >
+                    (ireg + 1) * photon_radii[id.layer()]) {
+              oContXStd[ireg][iseg] +=
+                  pow((xy_pair.first - oContXMean[ireg][iseg]), 2) *
+                  hit.getEnergy();
+              oContYStd[ireg][iseg] +=
+                  pow((xy_pair.second - oContYMean[ireg][iseg]), 2) *
+                  hit.getEnergy();
+              oContLayerStd[ireg][iseg] +=
+                  pow((id.layer() - oContLayerMean[ireg][iseg]), 2) *
+                  hit.getEnergy();
+            }
+          }
+        }
+      }
+
+      for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+        if (distance_ele_trajectory > (ireg + 1) * ele_radii[id.layer()] &&
+            distance_photon_trajectory >
+                (ireg + 1) * photon_radii[id.layer()]) {
+          outsideContainmentXstd[ireg] +=
+              pow((xy_pair.first - outsideContainmentXmean[ireg]), 2) *
+              hit.getEnergy();
+          outsideContainmentYstd[ireg] +=
+              pow((xy_pair.second - outsideContainmentYmean[ireg]), 2) *
+              hit.getEnergy();
+        }
+      }
+    }
+
+    if (nReadoutHits_ > 0) {
+      xStd_ = sqrt(xStd_ / summedDet_);
+      yStd_ = sqrt(yStd_ / summedDet_);
+      stdLayerHit_ = sqrt(stdLayerHit_ / summedDet_);
+    } else {
+      xStd_ = 0;
+      yStd_ = 0;
+      stdLayerHit_ = 0;
+    }
+
+    for (unsigned int iseg = 0; iseg < nsegments; iseg++) {
+      if (energySeg[iseg] > 0) {
+        xStdSeg[iseg] = sqrt(xStdSeg[iseg] / energySeg[iseg]);
+        yStdSeg[iseg] = sqrt(yStdSeg[iseg] / energySeg[iseg]);
+        layerStdSeg[iseg] = sqrt(layerStdSeg[iseg] / energySeg[iseg]);
+      }
+      for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+        if (oContEnergy[ireg][iseg] > 0) {
+          oContXStd[ireg][iseg] =
+              sqrt(oContXStd[ireg][iseg] / oContEnergy[ireg][iseg]);
+          oContYStd[ireg][iseg] =
+              sqrt(oContYStd[ireg][iseg] / oContEnergy[ireg][iseg]);
+          oContLayerStd[ireg][iseg] =
+              sqrt(oContLayerStd[ireg][iseg] / oContEnergy[ireg][iseg]);
+        }
+      }
+    }
+
+    for (unsigned int ireg = 0; ireg < nregions; ireg++) {
+      if (outsideContainmentEnergy[ireg] > 0) {
+        outsideContainmentXstd[ireg] =
+            sqrt(outsideContainmentXstd[ireg] / outsideContainmentEnergy[ireg]);
+        outsideContainmentYstd[ireg] =
+            sqrt(outsideContainmentYstd[ireg] / outsideContainmentEnergy[ireg]);
+      }
+    }
+
+    const float dz_from_face{7.932};
+    float drifted_recoil_x{-9999.};
+    float drifted_recoil_y{-9999.};
+    if (recoilP.size() > 0) {
+      drifted_recoil_x =
+          (dz_from_face * (recoilP[0] / recoilP[2])) + recoilPos[0];
+      drifted_recoil_y =
+          (dz_from_face * (recoilP[1] / recoilP[2])) + recoilPos[1];
+    }
+    const int recoil_layer_index = 0;
+
+    bool inside{false};
+    const auto ecalID = geometry_->getID(drifted_recoil_x, drifted_recoil_y,
+                                         recoil_layer_index, true);
+    if (!ecalID.null()) {
+      const auto cellID =
+          geometry_->getID(drifted_recoil_x, drifted_recoil_y,
+                           recoil_layer_index, ecalID.getModuleID(), true);
+      if (!cellID.null()) {
+        inside = true;
+      }
+    }
+
+    TVector3 e_traj_start;
+    TVector3 e_traj_end;
+    TVector3 p_traj_start;
+    TVector3 p_traj_end;
+    if (ele_trajectory.size() > 0 && photon_trajectory.size() > 0) {
+      e_traj_start.SetXYZ(ele_trajectory[0].first, ele_trajectory[0].second,
+                          geometry_->getZPosition(0));
+      e_traj_end.SetXYZ(ele_trajectory[(nEcalLayers_ - 1)].first,
+                        ele_trajectory[(nEcalLayers_ - 1)].second,
+                        geometry_->getZPosition((nEcalLayers_ - 1)));
+      p_traj_start.SetXYZ(photon_trajectory[0].first,
+                          photon_trajectory[0].second,
+                          geometry_->getZPosition(0));
+      p_traj_end.SetXYZ(photon_trajectory[(nEcalLayers_ - 1)].first,
+                        photon_trajectory[(nEcalLayers_ - 1)].second,
+                        geometry_->getZPosition((nEcalLayers_ - 1)));
+
+      TVector3 evec = e_traj_end - e_traj_start;
+      TVector3 e_norm = evec.Unit();
+      TVector3 pvec = p_traj_end - p_traj_start;
+      TVector3 p_norm = pvec.Unit();
+      epDot_ = e_norm.Dot(p_norm);
+      epAng_ = acos(epDot_) * 180.0 / M_PI;
+      epSep_ = sqrt(pow(e_traj_start.X() - p_traj_start.X(), 2) +
+                    pow(e_traj_start.Y() - p_traj_start.Y(), 2));
+    } else {
+      e_traj_start = TVector3(999, 999, geometry_->getZPosition(0));
+      e_traj_end =
+          TVector3(999, 999, geometry_->getZPosition((nEcalLayers_ - 1)));
+      p_traj_start = TVector3(1000, 1000, geometry_->getZPosition(0));
+      p_traj_end =
+          TVector3(1000, 1000, geometry_->getZPosition((nEcalLayers_ - 1)));
+      epAng_ = 999.;
+      epSep_ = 999.;
+      epDot_ = 999.;
+    }
+
+    firstNearPhLayer_ = nEcalLayers_ - 1;
+
+    if (photon_trajectory.size() != 0) {
+      for (std::vector<HitData>::iterator it = trackingHitList.begin();
+           it != trackingHitList.end(); ++it) {
+        float ehDist =
+            sqrt(pow((*it).pos.X() - photon_trajectory[(*it).layer].first, 2) +
+                 pow((*it).pos.Y() - photon_trajectory[(*it).layer].second, 2));
+        if (ehDist < 8.7) {
+          nNearPhHits_++;
+          if ((*it).layer < firstNearPhLayer_) {
+            firstNearPhLayer_ = (*it).layer;
+          }
+        }
+      }
+    }
+
+    TVector3 gToe = (e_traj_start - p_traj_start).Unit();
+    TVector3 origin = p_traj_start + 0.5 * 8.7 * gToe;
+    if (ele_trajectory.size() > 0) {
+      for (auto &hitData : trackingHitList) {
+        TVector3 hitPos = hitData.pos;
+        TVector3 hitPrime = hitPos - origin;
+        if (hitPrime.Dot(gToe) <= 0) {
+          photonTerritoryHits_++;
+        }
+      }
+    } else {
+      photonTerritoryHits_ = nReadoutHits_;
+    }
+
+    std::sort(trackingHitList.begin(), trackingHitList.end(),
+              [](HitData ha, HitData hb) { return ha.layer > hb.layer; });
+    std::vector<std::vector<HitData>> track_list;
+
+    float cellWidth = 2 * geometry_->getCellMaxR();
+    for (int iHit = 0; iHit < trackingHitList.size(); iHit++) {
+      int track[34];
+      int currenthit{iHit};
+      int trackLen{1};
+
+      track[0] = iHit;
+
+      int jHit = iHit;
+      while (jHit < trackingHitList.size()) {
+        if ((trackingHitList[jHit].layer ==
+                 trackingHitList[currenthit].layer - 1 ||
+             trackingHitList[jHit].layer ==
+                 trackingHitList[currenthit].layer - 2) &&
+            abs(trackingHitList[jHit].pos.X() -
+                trackingHitList[currenthit].pos.X()) <= 0.5 * cellWidth &&
+            abs(trackingHitList[jHit].pos.Y() -
+                trackingHitList[currenthit].pos.Y()) <= 0.5 * cellWidth) {
+          track[trackLen] = jHit;
+          trackLen++;
+          currenthit = jHit;
+        }
+        jHit++;
+      }
+
+      if (trackLen < 2) continue;
+      float closest_e = EcalVetoProcessor::distTwoLines(
+          trackingHitList[track[0]].pos,
+          trackingHitList[track[trackLen - 1]].pos, e_traj_start, e_traj_end);
+      float closest_p = EcalVetoProcessor::distTwoLines(
+          trackingHitList[track[0]].pos,
+          trackingHitList[track[trackLen - 1]].pos, p_traj_start, p_traj_end);
+      if (closest_p > cellWidth and closest_e < 2 * cellWidth) continue;
+      if (trackLen < 4 and closest_e > closest_p) continue;
+
+      if (trackLen >= 2) {
+        std::vector<HitData> temp_track_list;
+        int n_remove = 0;
+        for (int kHit = 0; kHit < trackLen; kHit++) {
+          temp_track_list.push_back(trackingHitList[track[kHit] - n_remove]);
+          trackingHitList.erase(trackingHitList.begin() + track[kHit] -
+                                n_remove);
+          n_remove++;
+        }
+        track_list.push_back(temp_track_list);
+        iHit--;
+      }
+    }
+
+    for (int track_i = 0; track_i < track_list.size(); track_i++) {
+      std::vector<HitData> base_track = track_list[track_i];
+      HitData tail_hitdata = base_track.back();
+      for (int track_j = track_i + 1; track_j < track_list.size(); track_j++) {
+        std::vector<HitData> checking_track = track_list[track_j];
+        HitData head_hitdata = checking_track.front();
+        if ((head_hitdata.layer == tail_hitdata.layer + 1 ||
+             head_hitdata.layer == tail_hitdata.layer + 2) &&
+            pow(pow(head_hitdata.pos.X() - tail_hitdata.pos.X(), 2) +
+                    pow(head_hitdata.pos.Y() - tail_hitdata.pos.Y(), 2),
+                0.5) <= cellWidth) {
+          for (int hit_k = 0; hit_k < checking_track.size(); hit_k++) {
+            base_track.push_back(track_list[track_j][hit_k]);
+          }
+          track_list[track_i] = base_track;
+          track_list.erase(track_list.begin() + track_j);
+          break;
+        }
+      }
+    }
+    nStraightTracks_ = track_list.size();
+
+    for (int iHit = 0; iHit < trackingHitList.size(); iHit++) {
+      int track[34];
+      int trackLen{0};
+      int nHitsInRegion{1};
+      TMatrixD Vm(3, 3);
+      TMatrixD hdt(3, 3);
+      TVector3 slopeVec;
+      TVector3 hmean;
+      TVector3 hpoint;
+      float r_corr_best{0.0};
+      int hitNums[3];
+
+      for (int jHit = 0; jHit < trackingHitList.size(); jHit++) {
+        if (trackingHitList[iHit].pos(2) == trackingHitList[jHit].pos(2)) {
+          continue;
+        }
+        float dstToHit =
+            (trackingHitList[iHit].pos - trackingHitList[jHit].pos).Mag();
+        if (dstToHit <= 2 * cellWidth) {
+          nHitsInRegion++;
+        }
+      }
+
+      hitNums[0] = iHit;
+      for (int jHit = 1; jHit < nHitsInRegion - 1; jHit++) {
+        if (trackingHitList.size() < 3) break;
+        hitNums[1] = jHit;
+        for (int kHit = jHit + 1; kHit < nHitsInRegion; kHit++) {
+          hitNums[2] = kHit;
+          for (int hInd = 0; hInd < 3; hInd++) {
+            hmean(hInd) = (trackingHitList[hitNums[0]].pos(hInd) +
+                           trackingHitList[hitNums[1]].pos(hInd) +
+                           trackingHitList[hitNums[2]].pos(hInd)) /
+                          3.0;
+          }
+          for (int hInd = 0; hInd < 3; hInd++) {
+            for (int lInd = 0; lInd < 3; lInd++) {
+              hdt(hInd, lInd) =
+                  trackingHitList[hitNums[hInd]].pos(lInd) - hmean(lInd);
+            }
+          }
+
+          double determinant =
+              hdt(0, 0) * (hdt(1, 1) * hdt(2, 2) - hdt(1, 2) * hdt(2, 1)) -
+              hdt(0, 1) * (hdt(1, 0) * hdt(2, 2) - hdt(1, 2) * hdt(2, 0)) +
+              hdt(0, 2) * (hdt(1, 0) * hdt(2, 1) - hdt(1, 1) * hdt(2, 0));
+          if (determinant == 0) continue;
+          TDecompSVD svdObj(hdt);
+          bool decomposed = svdObj.Decompose();
+          if (!decomposed) continue;
+
+          Vm = svdObj.GetV();
+          for (int hInd = 0; hInd < 3; hInd++) {
+            slopeVec(hInd) = Vm[0][hInd];
+          }
+          hpoint = slopeVec + hmean;
+          float closest_e = EcalVetoProcessor::distTwoLines(
+              hmean, hpoint, e_traj_start, e_traj_end);
+          float closest_p = EcalVetoProcessor::distTwoLines(
+              hmean, hpoint, p_traj_start, p_traj_end);
+          if (closest_p > cellWidth or closest_e < 1.5 * cellWidth) continue;
+          float vrnc = (trackingHitList[hitNums[0]].pos - hmean).Mag() +
+                       (trackingHitList[hitNums[1]].pos - hmean).Mag() +
+                       (trackingHitList[hitNums[2]].pos - hmean).Mag();
+          float sumerr = EcalVetoProcessor::distPtToLine(
+                             trackingHitList[hitNums[0]].pos, hmean, hpoint) +
+                         EcalVetoProcessor::distPtToLine(
+                             trackingHitList[hitNums[1]].pos, hmean, hpoint) +
+                         EcalVetoProcessor::distPtToLine(
+                             trackingHitList[hitNums[2]].pos, hmean, hpoint);
+          float r_corr = 1 - sumerr / vrnc;
+          if (r_corr > r_corr_best and r_corr > .6) {
+            r_corr_best = r_corr;
+            trackLen = 0;
+            for (int k = 0; k < 3; k++) {
+              track[k] = hitNums[k];
+              trackLen++;
+            }
+          }
+        }
+      }
+
+      if (trackLen == 0) continue;
+
+      if (trackLen >= 2) {
+        nLinregTracks_++;
+        for (int kHit = 0; kHit < trackLen; kHit++) {
+          trackingHitList.erase(trackingHitList.begin() + track[kHit]);
+        }
+        iHit--;
+      }
+    }
+
+    result.setVariables(
+        nReadoutHits_, deepestLayerHit_, summedDet_, summedTightIso_,
+        maxCellDep_, showerRMS_, xStd_, yStd_, avgLayerHit_, stdLayerHit_,
+        ecalBackEnergy_, nStraightTracks_, nLinregTracks_, firstNearPhLayer_,
+        nNearPhHits_, photonTerritoryHits_, epAng_, epSep_, epDot_,
+        electronContainmentEnergy, photonContainmentEnergy,
+        outsideContainmentEnergy, outsideContainmentNHits,
+        outsideContainmentXstd, outsideContainmentYstd, energySeg, xMeanSeg,
+        yMeanSeg, xStdSeg, yStdSeg, layerMeanSeg, layerStdSeg, eContEnergy,
+        eContXMean, eContYMean, gContEnergy, gContNHits, gContXMean,
+        gContYMean, oContEnergy, oContNHits, oContXMean, oContYMean, oContXStd,
+        oContYStd, oContLayerMean, oContLayerStd, ecalLayerEdepReadout_,
+        recoilP, recoilPos);
+    result.setFiducial(inside);
+    return result;
+  }
+
+ private:
+  ldmx::EcalID GetShowerCentroidIDAndRMS(
+      const std::vector<ldmx::EcalHit> &ecalRecHits, double &showerRMS) {
+    auto wgtCentroidCoords = std::make_pair<float, float>(0., 0.);
+    float sumEdep = 0;
+    ldmx::EcalID returnCellId;
+
+    for (const ldmx::EcalHit &hit : ecalRecHits) {
+      ldmx::EcalID id(hit.getID());
+      CellEnergyPair cell_energy_pair = std::make_pair(id, hit.getEnergy());
+      auto [x, y, z] = geometry_->getPosition(id);
+      XYCoords centroidCoords = std::make_pair(x, y);
+      wgtCentroidCoords.first = wgtCentroidCoords.first +
+                                centroidCoords.first * cell_energy_pair.second;
+      wgtCentroidCoords.second =
+          wgtCentroidCoords.second +
+          centroidCoords.second * cell_energy_pair.second;
+      sumEdep += cell_energy_pair.second;
+    }
+    wgtCentroidCoords.first = (sumEdep > 1E-6)
+                                  ? wgtCentroidCoords.first / sumEdep
+                                  : wgtCentroidCoords.first;
+    wgtCentroidCoords.second = (sumEdep > 1E-6)
+                                   ? wgtCentroidCoords.second / sumEdep
+                                   : wgtCentroidCoords.second;
+    float maxDist = 1e6;
+    for (const ldmx::EcalHit &hit : ecalRecHits) {
+      auto [x, y, z] = geometry_->getPosition(hit.getID());
+      XYCoords centroidCoords = std::make_pair(x, y);
+
+      float deltaR =
+          pow(pow((centroidCoords.first - wgtCentroidCoords.first), 2) +
+                  pow((centroidCoords.second - wgtCentroidCoords.second), 2),
+              .5);
+      showerRMS += deltaR * hit.getEnergy();
+      if (deltaR < maxDist) {
+        maxDist = deltaR;
+        returnCellId = ldmx::EcalID(hit.getID());
+      }
+    }
+    if (sumEdep > 0) showerRMS = showerRMS / sumEdep;
+    return ldmx::EcalID(0, returnCellId.module(), returnCellId.cell());
+  }
+
+  void fillHitMap(const std::vector<ldmx::EcalHit> &ecalRecHits,
+                  std::map<ldmx::EcalID, float> &cellMap) {
+    for (const ldmx::EcalHit &hit : ecalRecHits) {
+      ldmx::EcalID id(hit.getID());
+      cellMap.emplace(id, hit.getEnergy());
+    }
+  }
+
+  void fillIsolatedHitMap(const std::vector<ldmx::EcalHit> &ecalRecHits,
+                          ldmx::EcalID globalCentroid,
+                          std::map<ldmx::EcalID, float> &cellMap,
+                          std::map<ldmx::EcalID, float> &cellMapIso,
+                          bool doTight) {
+    for (const ldmx::EcalHit &hit : ecalRecHits) {
+      auto isolatedHit = std::make_pair(true, ldmx::EcalID());
+      ldmx::EcalID id(hit.getID());
+      if (doTight) {
+        if (id == globalCentroid) continue;
+
+        if (geometry_->isNN(globalCentroid, id)) {
+          continue;
+        }
+      }
+
+      for (ldmx::EcalID cellNbrId : geometry_->getNN(id)) {
+        cellNbrId =
+            ldmx::EcalID(id.layer(), cellNbrId.module(), cellNbrId.cell());
+        if (cellMap.find(cellNbrId) != cellMap.end()) {
+          isolatedHit = std::make_pair(false, cellNbrId);
+          break;
+        }
+      }
+      if (!isolatedHit.first) {
+        continue;
+      }
+      cellMapIso.emplace(id, hit.getEnergy());
+    }
+  }
+
+  std::vector<std::pair<float, float>> getTrajectory(
+      std::vector<double> momentum, std::vector<float> position) {
+    std::vector<XYCoords> positions;
+    for (int iLayer = 0; iLayer < nEcalLayers_; iLayer++) {
+      float posX =
+          position[0] + (momentum[0] / momentum[2]) *
+                            (geometry_->getZPosition(iLayer) - position[2]);
+      float posY =
+          position[1] + (momentum[1] / momentum[2]) *
+                            (geometry_->getZPosition(iLayer) - position[2]);
+      positions.push_back(std::make_pair(posX, posY));
+    }
+    return positions;
+  }
+
+  const ldmx::EcalGeometry *geometry_;
+  std::vector<std::vector<double>> roc_range_values_;
+  int nEcalLayers_;
+  double beamEnergyMeV_;
+
+  std::map<ldmx::EcalID, float> cellMap_;
+  std::map<ldmx::EcalID, float> cellMapTightIso_;
+
+  std::vector<float> ecalLayerEdepRaw_;
+  std::vector<float> ecalLayerEdepReadout_;
+  std::vector<float> ecalLayerTime_;
+
+  int nReadoutHits_{0};
+  int deepestLayerHit_{0};
+  double summedDet_{0};
+  double summedTightIso_{0};
+  double maxCellDep_{0};
+  double showerRMS_{0};
+  double xStd_{0};
+  double yStd_{0};
+  double avgLayerHit_{0};
+  double stdLayerHit_{0};
+  double ecalBackEnergy_{0};
+  int nStraightTracks_{0};
+  int nLinregTracks_{0};
+  int firstNearPhLayer_{0};
+  int nNearPhHits_{0};
+  float epAng_{0};
+  float epSep_{0};
+  float epDot_{0};
+  int photonTerritoryHits_{0};
+};
+
+/// recoil electron at the scoring planes, empty if it was not found
+struct Recoil {
+  std::vector<double> p;
+  std::vector<float> pos;
+  std::vector<double> pAtTarget;
+  std::vector<float> posAtTarget;
+};
+
+/**
+ * Make the recoil electron of a fake event
+ *
+ * The events alternate between no recoil electron, one only found at the
+ * Ecal, and ones found at the target too whose trajectory is inside or
+ * outside of the Ecal.
+ *
+ * @param[in] seed seed for the random numbers of the event
+ * @return recoil electron of the event
+ */
+static Recoil makeRecoil(unsigned int seed) {
+  std::mt19937 rng{seed};
+  std::uniform_real_distribution<double> uniform(-1., 1.);
+  Recoil recoil;
+  int kind = seed % 4;
+  if (kind > 0) {
+    recoil.p = {300 * uniform(rng), 300 * uniform(rng),
+                2500 + 2000 * uniform(rng)};
+    recoil.pos = {float(kind == 3 ? 500 : 100 * uniform(rng)),
+                  float(100 * uniform(rng)), 240.f};
+  }
+  if (kind > 1) {
+    recoil.pAtTarget = {recoil.p[0] * 0.9, recoil.p[1] * 0.9,
+                        recoil.p[2] * 1.1};
+    recoil.posAtTarget = {float(10 * uniform(rng)), float(10 * uniform(rng)),
+                          0.f};
+  }
+  return recoil;
+}
+
+/**
+ * Make the hits of a fake event
+ *
+ * A few showers of hits on neighboring cells are put on top of isolated
+ * noise hits. The showers follow the electron or photon trajectory if
+ * there is one so that the hits fill all of the containment regions.
+ * Some of the hits have no energy and some cells are hit twice with
+ * different energies.
+ *
+ * @param[in] seed seed for the random numbers of the event
+ * @param[in] recoil recoil electron of the event
+ * @param[in] geometry geometry to find the cells in
+ * @return hits of the event
+ */
+static std::vector<ldmx::EcalHit> makeHits(unsigned int seed,
+                                           const Recoil &recoil,
+                                           const ldmx::EcalGeometry &geometry) {
+  std::mt19937 rng{seed};
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::normal_distribution<double> normal(0., 1.);
+
+  std::vector<ldmx::EcalHit> hits;
+  auto addHit = [&](double x, double y, int layer) {
+    ldmx::EcalID id{geometry.getID(x, y, layer, true)};
+    if (id.null()) return;
+    ldmx::EcalHit hit;
+    hit.setID(id.raw());
+    // energies far above and below a MIP, and no energy at all
+    hit.setEnergy(rng() % 5 == 0 ? 0. : 0.05 * (1 + rng() % 2000));
+    hit.setTime(20. * uniform(rng));
+    hits.push_back(hit);
+  };
+
+  int nShowers = rng() % 4;
+  for (int iShower = 0; iShower < nShowers; iShower++) {
+    // start and direction of the shower
+    double x0 = -100 + 200 * uniform(rng), y0 = -100 + 200 * uniform(rng);
+    double z0 = 0, dxdz = 0, dydz = 0;
+    int follow = rng() % 3;
+    if (follow == 1 && !recoil.p.empty()) {
+      x0 = recoil.pos[0];
+      y0 = recoil.pos[1];
+      z0 = recoil.pos[2];
+      dxdz = recoil.p[0] / recoil.p[2];
+      dydz = recoil.p[1] / recoil.p[2];
+    } else if (follow == 2 && !recoil.pAtTarget.empty()) {
+      x0 = recoil.posAtTarget[0];
+      y0 = recoil.posAtTarget[1];
+      dxdz = -recoil.pAtTarget[0] / (BEAM_ENERGY - recoil.pAtTarget[2]);
+      dydz = -recoil.pAtTarget[1] / (BEAM_ENERGY - recoil.pAtTarget[2]);
+    }
+    double width = 2 + 20 * uniform(rng);
+    int nHits = 10 + rng() % 80;
+    for (int iHit = 0; iHit < nHits; iHit++) {
+      int layer = rng() % N_LAYERS;
+      double dz = geometry.getZPosition(layer) - z0;
+      addHit(x0 + dxdz * dz + width * normal(rng),
+             y0 + dydz * dz + width * normal(rng), layer);
+    }
+  }
+  int nNoise = rng() % 60;
+  for (int iNoise = 0; iNoise < nNoise; iNoise++) {
+    addHit(-300 + 600 * uniform(rng), -300 + 600 * uniform(rng),
+           rng() % N_LAYERS);
+  }
+
+  // hit some of the cells a second time
+  std::size_t nHits = hits.size();
+  for (std::size_t iHit = 0; iHit < nHits; iHit++) {
+    if (rng() % 10 != 0) continue;
+    ldmx::EcalHit hit{hits[iHit]};
+    hit.setEnergy(rng() % 3 == 0 ? 0. : 0.05 * (1 + rng() % 2000));
+    hits.push_back(hit);
+  }
+  return hits;
+}
+
+/// check that all the features of the results are the same
+static void checkSameFeatures(const ldmx::EcalVetoResult &a,
+                              const ldmx::EcalVetoResult &b) {
+  CHECK(a.getFiducial() == b.getFiducial());
+  CHECK(a.getNReadoutHits() == b.getNReadoutHits());
+  CHECK(a.getDeepestLayerHit() == b.getDeepestLayerHit());
+  CHECK(a.getSummedDet() == b.getSummedDet());
+  CHECK(a.getSummedTightIso() == b.getSummedTightIso());
+  CHECK(a.getMaxCellDep() == b.getMaxCellDep());
+  CHECK(a.getShowerRMS() == b.getShowerRMS());
+  CHECK(a.getXStd() == b.getXStd());
+  CHECK(a.getYStd() == b.getYStd());
+  CHECK(a.getAvgLayerHit() == b.getAvgLayerHit());
+  CHECK(a.getStdLayerHit() == b.getStdLayerHit());
+  CHECK(a.getEcalBackEnergy() == b.getEcalBackEnergy());
+  CHECK(a.getNStraightTracks() == b.getNStraightTracks());
+  CHECK(a.getNLinRegTracks() == b.getNLinRegTracks());
+  CHECK(a.getFirstNearPhLayer() == b.getFirstNearPhLayer());
+  CHECK(a.getNNearPhHits() == b.getNNearPhHits());
+  CHECK(a.getPhotonTerritoryHits() == b.getPhotonTerritoryHits());
+  CHECK(a.getEPAng() == b.getEPAng());
+  CHECK(a.getEPSep() == b.getEPSep());
+  CHECK(a.getEPDot() == b.getEPDot());
+  CHECK(a.getElectronContainmentEnergy() == b.getElectronContainmentEnergy());
+  CHECK(a.getPhotonContainmentEnergy() == b.getPhotonContainmentEnergy());
+  CHECK(a.getOutsideContainmentEnergy() == b.getOutsideContainmentEnergy());
+  CHECK(a.getOutsideContainmentNHits() == b.getOutsideContainmentNHits());
+  CHECK(a.getOutsideContainmentXStd() == b.getOutsideContainmentXStd());
+  CHECK(a.getOutsideContainmentYStd() == b.getOutsideContainmentYStd());
+  CHECK(a.getEcalLayerEdepReadout() == b.getEcalLayerEdepReadout());
+  CHECK(a.getEnergySeg() == b.getEnergySeg());
+  CHECK(a.getXMeanSeg() == b.getXMeanSeg());
+  CHECK(a.getYMeanSeg() == b.getYMeanSeg());
+  CHECK(a.getXStdSeg() == b.getXStdSeg());
+  CHECK(a.getYStdSeg() == b.getYStdSeg());
+  CHECK(a.getLayerMeanSeg() == b.getLayerMeanSeg());
+  CHECK(a.getLayerStdSeg() == b.getLayerStdSeg());
+  CHECK(a.getEleContEnergy() == b.getEleContEnergy());
+  CHECK(a.getEleContXMean() == b.getEleContXMean());
+  CHECK(a.getEleContYMean() == b.getEleContYMean());
+  CHECK(a.getPhContEnergy() == b.getPhContEnergy());
+  CHECK(a.getPhContNHits() == b.getPhContNHits());
+  CHECK(a.getPhContXMean() == b.getPhContXMean());
+  CHECK(a.getPhContYMean() == b.getPhContYMean());
+  CHECK(a.getOutContEnergy() == b.getOutContEnergy());
+  CHECK(a.getOutContNHits() == b.getOutContNHits());
+  CHECK(a.getOutContXMean() == b.getOutContXMean());
+  CHECK(a.getOutContYMean() == b.getOutContYMean());
+  CHECK(a.getOutContXStd() == b.getOutContXStd());
+  CHECK(a.getOutContYStd() == b.getOutContYStd());
+  CHECK(a.getOutContLayerMean() == b.getOutContLayerMean());
+  CHECK(a.getOutContLayerStd() == b.getOutContLayerStd());
+  CHECK(a.getRecoilMomentum() == b.getRecoilMomentum());
+  CHECK(a.getRecoilX() == b.getRecoilX());
+  CHECK(a.getRecoilY() == b.getRecoilY());
+}
+
+}  // namespace test
+}  // namespace ecal
+
+/**
+ * The features computed from the arrays of hits have to be exactly the
+ * same as the ones computed by looking up each hit again.
+ *
+ * What does this test?
+ *  - events with and without showers, with hits without energy and with
+ *    cells that are hit twice
+ *  - events without a recoil electron, with the recoil electron only at
+ *    the Ecal, and with it at the target too (inside and outside of the
+ *    Ecal)
+ *  - the buffers of the processor are cleared between events
+ */
+TEST_CASE("EcalVetoFeatures", "[Ecal][functionality]") {
+  using namespace ecal::test;
+  std::unique_ptr<ldmx::EcalGeometry> geometry{
+      ldmx::EcalGeometry::debugMake(geometryParameters())};
+
+  framework::Process process{framework::Process::getDummy()};
+  ecal::EcalVetoProcessor veto("EcalVeto", process);
+  veto.configureFeatures(rocRangeValues(), N_LAYERS, BEAM_ENERGY);
+
+  for (unsigned int seed = 1; seed <= 200; seed++) {
+    Recoil recoil{makeRecoil(seed)};
+    std::vector<ldmx::EcalHit> hits{makeHits(seed, recoil, *geometry)};
+
+    ldmx::EcalVetoResult result;
+    veto.computeFeatures(hits, *geometry, recoil.p, recoil.pos,
+                         recoil.pAtTarget, recoil.posAtTarget, result);
+    ReferenceFeatures reference(*geometry);
+    ldmx::EcalVetoResult expected = reference.compute(
+        hits, recoil.p, recoil.pos, recoil.pAtTarget, recoil.posAtTarget);
+    checkSameFeatures(result, expected);
+  }
+}
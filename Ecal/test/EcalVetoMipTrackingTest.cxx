@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Ecal/EcalVetoProcessor.h"
+
+namespace ecal {
+namespace test {
+
+using HitData = EcalVetoProcessor::HitData;
+
+/**
+ * Width of a cell [mm], twice the max radius of the hexagonal cells
+ */
+static const float CELL_WIDTH = 2 * 4.81;
+
+/**
+ * The straight track finding as it was done before the hits were
+ * binned, scanning the whole list of hits for each hit on a track.
+ *
+ * This is the reference the binned version has to reproduce exactly.
+ */
+std::vector<std::vector<HitData>> findStraightTracksByScan(
+    std::vector<HitData> &trackingHitList, float cellWidth,
+    const TVector3 &e_traj_start, const TVector3 &e_traj_end,
+    const TVector3 &p_traj_start, const TVector3 &p_traj_end) {
+  std::vector<std::vector<HitData>> track_list;
+  for (int iHit = 0; iHit < int(trackingHitList.size()); iHit++) {
+    std::vector<int> track{iHit};
+    int currenthit{iHit};
+    for (int jHit = iHit; jHit < int(trackingHitList.size()); jHit++) {
+      if ((trackingHitList[jHit].layer ==
+               trackingHitList[currenthit].layer - 1 ||
+           trackingHitList[jHit].layer ==
+               trackingHitList[currenthit].layer - 2) &&
+          std::abs(trackingHitList[jHit].pos.X() -
+                   trackingHitList[currenthit].pos.X()) <= 0.5 * cellWidth &&
+          std::abs(trackingHitList[jHit].pos.Y() -
+                   trackingHitList[currenthit].pos.Y()) <= 0.5 * cellWidth) {
+        track.push_back(jHit);
+        currenthit = jHit;
+      }
+    }
+
+    int trackLen = track.size();
+    if (trackLen < 2) continue;
+    float closest_e = EcalVetoProcessor::distTwoLines(
+        trackingHitList[track[0]].pos, trackingHitList[track[trackLen - 1]].pos,
+        e_traj_start, e_traj_end);
+    float closest_p = EcalVetoProcessor::distTwoLines(
+        trackingHitList[track[0]].pos, trackingHitList[track[trackLen - 1]].pos,
+        p_traj_start, p_traj_end);
+    if (closest_p > cellWidth and closest_e < 2 * cellWidth) continue;
+    if (trackLen < 4 and closest_e > closest_p) continue;
+
+    std::vector<HitData> temp_track_list;
+    int n_remove = 0;
+    for (int kHit = 0; kHit < trackLen; kHit++) {
+      temp_track_list.push_back(trackingHitList[track[kHit] - n_remove]);
+      trackingHitList.erase(trackingHitList.begin() + track[kHit] - n_remove);
+      n_remove++;
+    }
+    track_list.push_back(temp_track_list);
+    iHit--;
+  }
+  return track_list;
+}
+
+/**
+ * Generate the tracking hits of a fake event
+ *
+ * A few straight MIP-like tracks are put on top of noise hits.
+ * All positions are snapped to a grid of half cells so that many hits
+ * sit exactly on the edge of the search window, and the hits are
+ * sorted by decreasing layer like in the processor.
+ *
+ * @param[in] seed seed for the random numbers of the event
+ * @param[in] photon start and end of the photon trajectory the tracks follow
+ * @return hits of the event
+ */
+std::vector<HitData> generateEvent(unsigned int seed,
+                                   const std::vector<TVector3> &photon) {
+  std::mt19937 rng{seed};
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  auto snap = [](double v) {
+    return std::round(v / (0.5 * CELL_WIDTH)) * 0.5 * CELL_WIDTH;
+  };
+  auto layerZ = [](int layer) { return 240. + 8. * layer; };
+
+  std::vector<HitData> hits;
+  int nTracks = 1 + rng() % 4;
+  for (int iTrack = 0; iTrack < nTracks; iTrack++) {
+    // tracks near the photon trajectory or anywhere in the calorimeter
+    TVector3 start{photon[0]};
+    if (uniform(rng) < 0.5) start.SetXYZ(-200 + 400 * uniform(rng), 0, 0);
+    double x0 = start.X() + 20 * (uniform(rng) - 0.5);
+    double y0 = start.Y() + 20 * (uniform(rng) - 0.5);
+    double dx = 2 * (uniform(rng) - 0.5), dy = 2 * (uniform(rng) - 0.5);
+    int first = rng() % 20, last = first + 3 + rng() % 15;
+    for (int layer = first; layer <= std::min(last, 33); layer++) {
+      // MIPs miss some layers
+      if (uniform(rng) < 0.2) continue;
+      int step = layer - first;
+      hits.push_back({layer, TVector3(snap(x0 + dx * step),
+                                      snap(y0 + dy * step), layerZ(layer))});
+    }
+  }
+  int nNoise = rng() % 150;
+  for (int iNoise = 0; iNoise < nNoise; iNoise++) {
+    int layer = rng() % 34;
+    hits.push_back({layer, TVector3(snap(-60 + 120 * uniform(rng)),
+                                    snap(-60 + 120 * uniform(rng)),
+                                    layerZ(layer))});
+  }
+  std::stable_sort(hits.begin(), hits.end(),
+                   [](HitData ha, HitData hb) { return ha.layer > hb.layer; });
+  return hits;
+}
+
+/// check that two lists of hits are exactly the same
+void checkSameHits(const std::vector<HitData> &a,
+                   const std::vector<HitData> &b) {
+  REQUIRE(a.size() == b.size());
+  for (std::size_t i = 0; i < a.size(); i++) {
+    CHECK(a[i].layer == b[i].layer);
+    CHECK(a[i].pos.X() == b[i].pos.X());
+    CHECK(a[i].pos.Y() == b[i].pos.Y());
+    CHECK(a[i].pos.Z() == b[i].pos.Z());
+  }
+}
+
+/**
+ * The binned straight track finding has to find the same tracks and
+ * leave the same hits for the linear-regression tracking as the scan
+ * over all the hits did.
+ */
+TEST_CASE("EcalVetoStraightTracks", "[Ecal][functionality]") {
+  // photon trajectory through the middle of the calorimeter
+  const std::vector<TVector3> photon{TVector3(5, -3, 240.),
+                                     TVector3(25, 10, 540.)};
+  // electron trajectory away from the photon, and the placeholder used
+  // when the electron trajectory is missing
+  const std::vector<std::vector<TVector3>> electrons{
+      {TVector3(-40, 0, 240.), TVector3(-150, 20, 540.)},
+      {TVector3(999, 999, 0), TVector3(1000, 1000, 0)}};
+
+  for (unsigned int seed = 1; seed <= 400; seed++) {
+    const std::vector<TVector3> &electron{electrons[seed % 2]};
+    std::vector<HitData> scanned{generateEvent(seed, photon)};
+    std::vector<HitData> binned{scanned};
+
+    auto expected = findStraightTracksByScan(scanned, CELL_WIDTH, electron[0],
+                                             electron[1], photon[0], photon[1]);
+    auto found = EcalVetoProcessor::findStraightTracks(
+        binned, CELL_WIDTH, electron[0], electron[1], photon[0], photon[1]);
+
+    REQUIRE(found.size() == expected.size());
+    for (std::size_t iTrack = 0; iTrack < found.size(); iTrack++) {
+      checkSameHits(found[iTrack], expected[iTrack]);
+    }
+    checkSameHits(binned, scanned);
+  }
+}
+
+}  // namespace test
+}  // namespace ecal
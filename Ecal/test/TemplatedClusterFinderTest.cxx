@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "DetDescr/EcalGeometry.h"
+#include "Ecal/MyClusterWeight.h"
+#include "Ecal/TemplatedClusterFinder.h"
+#include "Framework/Configure/Parameters.h"
+
+namespace ecal {
+namespace test {
+
+/**
+ * Make the parameters of the v14 geometry
+ *
+ * These are copied from the python configuration.
+ */
+static framework::config::Parameters geometryParameters() {
+  framework::config::Parameters params;
+  params.addParameter("layerZPositions",
+                      std::vector<double>{7.850, 13.300, 26.400, 33.500});
+  params.addParameter("ecalFrontZ", 240.5);
+  params.addParameter("moduleMinR", 85.0);
+  params.addParameter("nCellRHeight", 35.3);
+  params.addParameter("gap", 1.5);
+  params.addParameter("cornersSideUp", true);
+  params.addParameter("layer_shift_x", 2 * 85.0 / 35.3);
+  params.addParameter("layer_shift_y", 0.);
+  params.addParameter("layer_shift_odd", true);
+  params.addParameter("layer_shift_odd_bilayer", false);
+  params.addParameter("verbose", 0);
+  return params;
+}
+
+/**
+ * The clustering as it was done before the weights were queued,
+ * weighing every pair of clusters for every merge.
+ *
+ * This is the reference the queued version has to reproduce exactly.
+ */
+class ScanClusterFinder {
+ public:
+  void add(const ldmx::EcalHit* eh, const ldmx::EcalGeometry& hex) {
+    clusters_.push_back(WorkingCluster(eh, hex));
+  }
+
+  void cluster(double seed_threshold, double cutoff) {
+    int ncluster = clusters_.size();
+    double minwgt = cutoff;
+
+    std::sort(clusters_.begin(), clusters_.end(),
+              TemplatedClusterFinder<MyClusterWeight>::compClusters);
+    do {
+      bool any = false;
+      size_t mi(0), mj(0);
+
+      int nseeds = 0;
+
+      for (size_t i = 0; i < clusters_.size(); i++) {
+        if (clusters_[i].empty()) continue;
+
+        bool iseed = (clusters_[i].centroid().E() >= seed_threshold);
+        if (iseed) {
+          nseeds++;
+        } else {
+          break;
+        }
+
+        for (size_t j = i + 1; j < clusters_.size(); j++) {
+          if (clusters_[j].empty() ||
+              (!iseed && clusters_[j].centroid().E() < seed_threshold))
+            continue;
+          double wgt = wgt_(clusters_[i], clusters_[j]);
+          if (!any || wgt < minwgt) {
+            any = true;
+            minwgt = wgt;
+            mi = i;
+            mj = j;
+          }
+        }
+      }
+
+      nseeds_ = nseeds;
+      transitionWeights_.insert(std::pair<int, double>(ncluster, minwgt));
+
+      if (any && minwgt < cutoff) {
+        if (clusters_[mi].centroid().E() < clusters_[mj].centroid().E()) {
+          std::swap(mi, mj);
+        }
+        clusters_[mi].add(clusters_[mj]);
+        clusters_[mj].clear();
+        ncluster--;
+      }
+
+    } while (minwgt < cutoff && ncluster > 1);
+    finalwgt_ = minwgt;
+  }
+
+  MyClusterWeight wgt_;
+  double finalwgt_;
+  int nseeds_;
+  std::map<int, double> transitionWeights_;
+  std::vector<WorkingCluster> clusters_;
+};
+
+/**
+ * Make the hits of a fake event
+ *
+ * A few showers are spread around the layers with noise hits
+ * everywhere. Energies are drawn from a few values so that some
+ * clusters have exactly the same energy and weight.
+ */
+static std::vector<ldmx::EcalHit> makeHits(unsigned int seed,
+                                           const ldmx::EcalGeometry& geom) {
+  std::mt19937 rng{seed};
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::normal_distribution<double> spread(0., 12.);
+  std::vector<ldmx::EcalHit> hits;
+  auto addHit = [&](double x, double y, int layer, double energy) {
+    ldmx::EcalID id{geom.getID(x, y, layer, true)};
+    if (id.null()) return;
+    ldmx::EcalHit hit;
+    hit.setID(id.raw());
+    hit.setEnergy(energy);
+    hits.push_back(hit);
+  };
+  int nShowers = 1 + rng() % 4;
+  for (int iShower = 0; iShower < nShowers; iShower++) {
+    double x0 = -200 + 400 * uniform(rng), y0 = -200 + 400 * uniform(rng);
+    int nHits = 5 + rng() % 60;
+    for (int iHit = 0; iHit < nHits; iHit++) {
+      addHit(x0 + spread(rng), y0 + spread(rng), rng() % 4,
+             (1 + rng() % 8) * 25.);
+    }
+  }
+  int nNoise = rng() % 40;
+  for (int iNoise = 0; iNoise < nNoise; iNoise++) {
+    addHit(-250 + 500 * uniform(rng), -250 + 500 * uniform(rng), rng() % 4,
+           (1 + rng() % 4) * 10.);
+  }
+  return hits;
+}
+
+}  // namespace test
+}  // namespace ecal
+
+/**
+ * The queued clustering has to make the same clusters and record the
+ * same weights as weighing all the pairs for every merge did.
+ */
+TEST_CASE("TemplatedClusterFinder", "[Ecal][functionality]") {
+  using namespace ecal::test;
+  std::unique_ptr<ldmx::EcalGeometry> geometry{
+      ldmx::EcalGeometry::debugMake(geometryParameters())};
+
+  // cutoffs from the python configuration and with more and fewer merges
+  for (double cutoff : {10., 0.5, 100.}) {
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+      std::vector<ldmx::EcalHit> hits{makeHits(seed, *geometry)};
+
+      ecal::TemplatedClusterFinder<ecal::MyClusterWeight> finder;
+      ScanClusterFinder reference;
+      for (const auto& hit : hits) {
+        finder.add(&hit, *geometry);
+        reference.add(&hit, *geometry);
+      }
+      finder.cluster(100., cutoff);
+      reference.cluster(100., cutoff);
+
+      CHECK(finder.getNSeeds() == reference.nseeds_);
+      CHECK(finder.getYMax() == reference.finalwgt_);
+      CHECK(finder.getWeights() == reference.transitionWeights_);
+      const auto& clusters{finder.getClusters()};
+      REQUIRE(clusters.size() == reference.clusters_.size());
+      for (std::size_t i = 0; i < clusters.size(); i++) {
+        CHECK(clusters[i].getHits() == reference.clusters_[i].getHits());
+        CHECK(clusters[i].centroid() == reference.clusters_[i].centroid());
+      }
+    }
+  }
+}
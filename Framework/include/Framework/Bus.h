@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -84,6 +85,51 @@ class Bus {
     getRef<BaggageType>(name).update(obj);
   }
 
+  /**
+   * Update the object a passenger is carrying by moving the input into it
+   *
+   * This avoids copying the contents of large objects (e.g. collections
+   * of hits) into the passenger when the caller is done with them.
+   * The input object is left in a valid but unspecified state.
+   *
+   * @see Passenger::update(BaggageType&&) for how we update a passenger
+   * @throws std::bad_cast if BaggageType does not match type of object
+   * passenger is carrying
+   *
+   * @tparam[in] BaggageType type of object carried by passenger
+   * @param[in] name name of passenger (corresponds to branch name)
+   * @param[in] obj update object to move into the passenger
+   */
+  template <typename BaggageType,
+            std::enable_if_t<!std::is_reference_v<BaggageType>, int> = 0>
+  void update(const std::string& name, BaggageType&& obj) {
+    getRef<BaggageType>(name).update(std::move(obj));
+  }
+
+  /**
+   * Move the object a passenger on another bus is carrying onto this bus
+   *
+   * If there isn't a passenger with the input name on this bus yet,
+   * we board a new one carrying the same type of object as the
+   * passenger on the other bus. The passenger on the other bus is
+   * left carrying an object in a valid but unspecified state, so it
+   * should be cleared before it is used again.
+   *
+   * @see Passenger::transfer for how we move the baggage
+   * @throws std::bad_cast if the passenger already on this bus is
+   * carrying a different type than the one on the other bus
+   *
+   * @param[in] name name of passenger (corresponds to branch name)
+   * @param[in] other bus to move the passenger's baggage from
+   */
+  void transfer(const std::string& name, Bus& other) {
+    Seat& other_seat{*other.passengers_.at(name)};
+    if (not isOnBoard(name)) {
+      passengers_[name] = other_seat.board();
+    }
+    passengers_[name]->transfer(other_seat);
+  }
+
   /**
    * Attach the input tree to the object a passenger is carrying
    *
@@ -215,6 +261,26 @@ class Bus {
      */
     virtual void clear() = 0;
 
+    /**
+     * Create a new, empty passenger carrying the same type of object
+     *
+     * This allows us to board a passenger onto another bus without
+     * knowing the type of object this passenger is carrying.
+     *
+     * @return handle to a new passenger in a cleared state
+     */
+    virtual std::unique_ptr<Seat> board() const = 0;
+
+    /**
+     * Move the baggage of another passenger into this passenger
+     *
+     * @throws std::bad_cast if the other passenger is carrying
+     * a different type of object
+     *
+     * @param[in] other passenger to move the baggage from
+     */
+    virtual void transfer(Seat& other) = 0;
+
     /**
      * Define how we should stream the object to the input stream.
      *
@@ -367,6 +433,21 @@ class Bus {
       post_update(the_type<BaggageType>());
     }
 
+    /**
+     * Update this passenger's baggage by moving the input into it.
+     *
+     * The address of our baggage does not change, so any TTree
+     * attached to it is still looking at the right object.
+     *
+     * @see post_update
+     *
+     * @param[in] updated_obj BaggageType to move into our object
+     */
+    void update(BaggageType&& updated_obj) {
+      *baggage_ = std::move(updated_obj);
+      post_update(the_type<BaggageType>());
+    }
+
     /**
      * Reset the object we are carrying to an undefined state.
      *
@@ -376,6 +457,35 @@ class Bus {
      */
     virtual void clear() { clear(the_type<BaggageType>{}); }
 
+    /**
+     * Create a new passenger carrying our type of baggage
+     *
+     * The new passenger is cleared so its 'default' state is
+     * well defined.
+     *
+     * @return handle to the new passenger
+     */
+    virtual std::unique_ptr<Seat> board() const {
+      auto seat{std::make_unique<Passenger<BaggageType>>()};
+      seat->clear();
+      return seat;
+    }
+
+    /**
+     * Move the baggage from another passenger into ours
+     *
+     * @see update(BaggageType&&) for how the baggage is updated
+     *
+     * @throws std::bad_cast if the other passenger is not carrying
+     * the same type of baggage as us
+     *
+     * @param[in] other passenger to move the baggage of
+     */
+    virtual void transfer(Seat& other) {
+      auto& other_passenger{dynamic_cast<Passenger<BaggageType>&>(other)};
+      update(std::move(*other_passenger.baggage_));
+    }
+
     /**
      * Stream the passenger's object to the input ostream
      *
@@ -59,6 +59,10 @@ class Conditions {
    * or is out of date, the ConditionsObjectProvider::getCondition method
    * will be called to provide the object.
    *
+   * Each event stream has its own cache checked against the event it is
+   * processing, so the object stays valid until the same stream asks for
+   * it again for an event outside of its IOV.
+   *
    * @throws Exception if condition object or provider for that object is not
    * found.
    *
@@ -85,7 +89,8 @@ class Conditions {
   }
 
   /**
-   * Access the IOV for the given condition
+   * Access the IOV for the given condition in the cache of the
+   * calling event stream
    *
    * @param[in] condition_name name of condition to get IOV for
    * @returns Interval Of Validity for the input condition name
@@ -133,8 +138,14 @@ class Conditions {
     const ConditionsObject* obj;
   };
 
-  /** Conditions cache */
-  std::map<std::string, CacheEntry> cache_;
+  /**
+   * Conditions cache of each event stream
+   *
+   * The streams are told apart by the header of the event they
+   * are processing, which is also the context for the IOVs.
+   */
+  std::map<const ldmx::EventHeader*, std::map<std::string, CacheEntry>>
+      cache_;
 };
 
 }  // namespace framework
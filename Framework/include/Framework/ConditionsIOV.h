@@ -67,6 +67,16 @@ class ConditionsIOV {
   /** Checks to see if this IOV overlaps with the given IOV */
   bool overlaps(const ConditionsIOV& iov) const;
 
+  /** Checks to see if this IOV is the same as the given IOV */
+  bool operator==(const ConditionsIOV& iov) const {
+    return firstRun_ == iov.firstRun_ and lastRun_ == iov.lastRun_ and
+           validForData_ == iov.validForData_ and
+           validForMC_ == iov.validForMC_;
+  }
+
+  /** Checks to see if this IOV is different from the given IOV */
+  bool operator!=(const ConditionsIOV& iov) const { return !(*this == iov); }
+
   /**
    * Print the object to std::cout
    */
@@ -21,11 +21,14 @@
 #include <regex.h>
 
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 
 namespace framework {
 
@@ -92,6 +95,11 @@ class Event {
    * the full string or any substring within it. One can require the pattern
    * to match the full string by changing that parameter.
    *
+   * Full string matches of plain names (without any regex special
+   * characters) are looked up in an index of the products by name and
+   * the compiled regular expressions are cached, so repeated searches
+   * are cheap.
+   *
    * @param namematch Regular expression to compare with the product name
    * @param passmatch Regular expression to compare with the pass name
    * @param typematch Regular expression to compare with the type name
@@ -171,60 +179,44 @@ class Event {
    */
   template <typename T>
   void add(const std::string &collectionName, T &obj) {
-    if (collectionName.find('_') != std::string::npos) {
-      EXCEPTION_RAISE("IllegalName",
-                      "The product name '" + collectionName +
-                          "' is illegal as it contains an underscore.");
-    }
-
-    // determine the branch name
-    std::string branchName;
-    if (collectionName == ldmx::EventHeader::BRANCH)
-      branchName = collectionName;
-    else
-      branchName = makeBranchName(collectionName);
+    std::string branchName{prepareProduct<T>(collectionName)};
 
-    if (branchesFilled_.find(branchName) != branchesFilled_.end()) {
-      EXCEPTION_RAISE("ProductExists",
-                      "A product named '" + collectionName +
-                          "' already exists in the event (has been loaded by a "
-                          "previous producer in this process).");
+    // copy input contents into bus passenger
+    try {
+      bus_.update(branchName, obj);
+    } catch (const std::bad_cast &) {
+      EXCEPTION_RAISE("TypeMismatch",
+                      "Attempting to add an object whose type '" +
+                          std::string(typeid(obj).name()) +
+                          "' doesn't match the type stored in the collection.");
     }
-    branchesFilled_.insert(branchName);
-    // MEMORY add is leaking memory when given a vector (possible upon
-    // destruction of Event?) MEMORY add is 'conditional jump or move depends on
-    // uninitialised values' for all types of objects
-    //  TTree::BranchImpRef or TTree::BronchExec
-    if (not bus_.isOnBoard(branchName)) {
-      // create a new branch for this collection
 
-      // have type T board bus under name 'branchName'
-      bus_.board<T>(branchName);
-
-      // type name (want to use branch element if possible)
-      std::string tname = typeid(obj).name();
-
-      if (outputTree_ and not shouldDrop(branchName)) {
-        // we are writing this branch to an output file, so let's
-        //  attach this passenger to the output tree
-        TBranch *outBranch = bus_.attach(outputTree_, branchName, true);
-        // get type name from branch if possible,
-        //  otherwise use compiler level type name (above)
-        std::string class_name{outBranch->GetClassName()};
-        if (not class_name.empty()) tname = class_name;
-      }  // output tree exists or not
-
-      // check for cache entry to remove
-      auto it_known{knownLookups_.find(collectionName)};
-      if (it_known != knownLookups_.end()) knownLookups_.erase(it_known);
+    return;
+  }
 
-      // add us to list of products
-      products_.emplace_back(collectionName, passName_, tname);
-    }
+  /**
+   * Adds an object to the event bus by moving it into the bus
+   *
+   * This is the same as add(const std::string&, T&) except that the
+   * contents of the input object are moved into the bus passenger instead
+   * of copied. Producers creating large collections should use this
+   * (e.g. `event.add("MyHits", std::move(hits))`) when they are done
+   * with the object. The input object is left in a valid but unspecified
+   * state.
+   *
+   * @see add(const std::string&, T&) for the checks that are done
+   *
+   * @param collectionName
+   * @param obj in ROOT dictionary to move into the bus
+   */
+  template <typename T,
+            std::enable_if_t<!std::is_lvalue_reference_v<T>, int> = 0>
+  void add(const std::string &collectionName, T &&obj) {
+    std::string branchName{prepareProduct<T>(collectionName)};
 
-    // copy input contents into bus passenger
+    // move input contents into bus passenger
     try {
-      bus_.update(branchName, obj);
+      bus_.update(branchName, std::move(obj));
     } catch (const std::bad_cast &) {
       EXCEPTION_RAISE("TypeMismatch",
                       "Attempting to add an object whose type '" +
@@ -350,7 +342,11 @@ class Event {
                             std::to_string(ientry) +
                             " when attempting to get '" + branchName + "'.");
       }
+      auto start{std::chrono::steady_clock::now()};
       branch->GetEntry(ientry);
+      lazyReadTime_ += std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
     } else if (not already_on_board) {
       // not found in loaded branches and there is no inputTree,
       // so no hope of finding an unloaded object
@@ -447,6 +443,26 @@ class Event {
    */
   void beforeFill();
 
+  /**
+   * Move the products added to another event into this one
+   *
+   * This is how the products created in separate event streams are
+   * handed to the event that is attached to the output tree. The
+   * event header is copied over as well so that any changes made to it
+   * (e.g. the weight) are kept.
+   *
+   * The products are moved rather than copied so that large collections
+   * are not duplicated. The other event should be cleared before it is
+   * used again.
+   *
+   * @see Bus::transfer for how the passengers are moved across buses
+   * @throws Exception if a product added to the other event has already
+   * been added to this event
+   *
+   * @param[in] other event whose products we should take
+   */
+  void merge(Event &other);
+
   /**
    * Clear this object's data (including passengers).
    */
@@ -471,6 +487,31 @@ class Event {
    */
   std::string getPassName() { return passName_; }
 
+  /**
+   * Get the time spent loading branches from the input tree on demand
+   *
+   * Branches that are not active when the entry is read by the EventFile
+   * are loaded the first time they are requested with getObject.
+   * This is reset at the end of each input file.
+   *
+   * @return time in seconds
+   */
+  double getLazyReadTime() const { return lazyReadTime_; }
+
+  /**
+   * Get the generation of the event bus
+   *
+   * This is incremented whenever the bus is rebuilt (e.g. when a new
+   * input file is opened) or a new product is put onto the bus, so that
+   * cached references to objects on the bus can check if they need
+   * to be looked up again.
+   *
+   * @see ProductHandle for where this is used
+   *
+   * @return generation of the bus
+   */
+  std::size_t getBusGeneration() const { return busGeneration_; }
+
   /** @return The beam electron count. */
   int getElectronCount() const { return electronCount_; }
 
@@ -484,6 +525,121 @@ class Event {
   }
 
  private:
+  /**
+   * Prepare the bus for a new product to be added
+   *
+   * We make sure the product name is allowed and that the product
+   * hasn't already been added this event. If the branch is not on the
+   * bus yet, we board the bus and check if we need to attach the object
+   * to an output tree.
+   *
+   * @see add for where this is used
+   *
+   * @throws Exception if there is an underscore in the collection name.
+   * @throws Exception if there already has been a branch filled with
+   * the constructed name.
+   *
+   * @tparam T type of object being added
+   * @param collectionName name of product being added
+   * @return name of the branch the product should be put into
+   */
+  template <typename T>
+  std::string prepareProduct(const std::string &collectionName) {
+    if (collectionName.find('_') != std::string::npos) {
+      EXCEPTION_RAISE("IllegalName",
+                      "The product name '" + collectionName +
+                          "' is illegal as it contains an underscore.");
+    }
+
+    // determine the branch name
+    std::string branchName;
+    if (collectionName == ldmx::EventHeader::BRANCH)
+      branchName = collectionName;
+    else
+      branchName = makeBranchName(collectionName);
+
+    if (branchesFilled_.find(branchName) != branchesFilled_.end()) {
+      EXCEPTION_RAISE("ProductExists",
+                      "A product named '" + collectionName +
+                          "' already exists in the event (has been loaded by a "
+                          "previous producer in this process).");
+    }
+    branchesFilled_.insert(branchName);
+    // MEMORY add is leaking memory when given a vector (possible upon
+    // destruction of Event?) MEMORY add is 'conditional jump or move depends on
+    // uninitialised values' for all types of objects
+    //  TTree::BranchImpRef or TTree::BronchExec
+    if (not bus_.isOnBoard(branchName)) {
+      // create a new branch for this collection
+
+      // have type T board bus under name 'branchName'
+      bus_.board<T>(branchName);
+
+      // type name (want to use branch element if possible)
+      std::string tname = typeid(T).name();
+
+      if (outputTree_ and not shouldDrop(branchName)) {
+        // we are writing this branch to an output file, so let's
+        //  attach this passenger to the output tree
+        TBranch *outBranch = bus_.attach(outputTree_, branchName, true);
+        // get type name from branch if possible,
+        //  otherwise use compiler level type name (above)
+        std::string class_name{outBranch->GetClassName()};
+        if (not class_name.empty()) tname = class_name;
+      }  // output tree exists or not
+
+      // check for cache entry to remove
+      auto it_known{knownLookups_.find(collectionName)};
+      if (it_known != knownLookups_.end()) knownLookups_.erase(it_known);
+
+      // add us to list of products
+      addProduct(collectionName, passName_, tname);
+      busGeneration_++;
+    }
+
+    return branchName;
+  }
+
+  /**
+   * Add a product to the list of products and index it by name
+   *
+   * @param name name of product
+   * @param pass pass name of product
+   * @param type type name of product
+   */
+  void addProduct(const std::string &name, const std::string &pass,
+                  const std::string &type);
+
+  /**
+   * Find the indices of the products matching the input patterns
+   *
+   * If the name is a plain string (no regex special characters) and we
+   * require a full string match, we can look up the candidates in the
+   * name index instead of checking each product.
+   *
+   * @see searchProducts for the meaning of the parameters
+   * @return indices into products_ of the matching products, in order
+   */
+  std::vector<std::size_t> matchProducts(const std::string &namematch,
+                                         const std::string &passmatch,
+                                         const std::string &typematch,
+                                         bool full_string_match) const;
+
+  /**
+   * Check if the input value matches the input pattern
+   *
+   * Empty patterns match everything and plain-string patterns
+   * requiring a full string match are compared without regex.
+   * Otherwise, the compiled regex is retrieved from the cache.
+   *
+   * @param pattern regex pattern to match
+   * @param value string to check
+   * @param full_string_match require pattern to match the full string
+   * @return true if value matches pattern
+   */
+  bool matches(const std::string &pattern, const std::string &value,
+               bool full_string_match) const;
+
   /**
    * Check if collection should be dropped.
    *
@@ -534,6 +690,12 @@ class Event {
   /// The total number of electrons in the event
   int electronCount_{1};
 
+  /// Time in seconds spent loading branches on demand from the input tree
+  mutable double lazyReadTime_{0.};
+
+  /// Number of times the bus has been rebuilt or new products boarded
+  std::size_t busGeneration_{0};
+
   /**
    * The Bus
    *
@@ -568,6 +730,37 @@ class Event {
    * List of all the event products
    */
   std::vector<ProductTag> products_;
+
+  /**
+   * Hash of a string ignoring the case of its letters
+   */
+  struct CaseInsensitiveHash {
+    std::size_t operator()(const std::string &str) const;
+  };
+
+  /**
+   * Comparison of two strings ignoring the case of their letters
+   */
+  struct CaseInsensitiveEqual {
+    bool operator()(const std::string &lhs, const std::string &rhs) const;
+  };
+
+  /**
+   * Index of event products by their name
+   *
+   * Each name maps to the indices of the products in products_
+   * with that name. The names are hashed and compared ignoring
+   * their case since product searches are case-insensitive, so
+   * a name can be looked up without making a lower-case copy.
+   */
+  std::unordered_map<std::string, std::vector<std::size_t>,
+                     CaseInsensitiveHash, CaseInsensitiveEqual>
+      productIndex_;
+
+  /**
+   * Cache of compiled search regex keyed by their pattern
+   */
+  mutable std::unordered_map<std::string, regex_t> searchRegex_;
 };
 }  // namespace framework
 
@@ -3,6 +3,7 @@
 
 //---< C++ >---//
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -211,12 +212,61 @@ class EventFile {
    */
   bool nextEvent(bool storeCurrentEvent = true);
 
+  /**
+   * Get the number of entries in the file
+   *
+   * For input files, this is the number of entries in the event tree.
+   * For output files, this is the number of events that have been
+   * prepared so far.
+   *
+   * @return number of entries
+   */
+  long int getNumEntries() const { return entries_; }
+
+  /**
+   * Get the time spent waiting on the input tree to read entries
+   *
+   * This is the time the processing thread was stalled reading and
+   * decompressing entries in nextEvent. It does not include branches
+   * that are loaded lazily by the Event.
+   *
+   * @return time in seconds
+   */
+  double getReadTime() const { return readTime_; }
+
   /**
    * Skip events using an offset. Used in pileup overlay.
    * @return New event number if read successfully, else -1.
    */
   int skipToEvent(int offset);
 
+  /**
+   * Find the entries of the input tree holding an event
+   *
+   * The first call builds an index of the events in the file by reading
+   * only the EventHeader branch, so it must be called before the event
+   * bus starts reading from this file (e.g. in onFileOpen).
+   *
+   * @param[in] event event number to look for
+   * @param[in] run run number of the event, any run if not given
+   * @return entries holding the event in ascending order (may be empty)
+   * @throw Exception if this is not an input file or it is being read
+   */
+  std::vector<Long64_t> findEntries(int event,
+                                    std::optional<int> run = std::nullopt);
+
+  /**
+   * Only read the given entries of the input tree
+   *
+   * nextEvent goes directly from one selected entry to the next,
+   * skipping all of the others, and stops after the last one.
+   * Output files following this file as their parent only see the
+   * selected entries as well.
+   *
+   * @param[in] entries entries of the input tree to read
+   */
+  void selectEntries(std::vector<Long64_t> entries);
+
   /**
    * Write the run header into the run map
    *
@@ -276,13 +326,46 @@ class EventFile {
    */
   void importRunHeaders();
 
+  /**
+   * Build the index of events in the input tree
+   *
+   * Only the EventHeader branch is read and its address is reset
+   * afterwards so the event bus can attach to it as usual.
+   */
+  void buildEventIndex();
+
  private:
+  /// Location of an event in the input tree
+  struct EventLocation {
+    /// event number
+    int event;
+    /// run number
+    int run;
+    /// entry in the tree
+    Long64_t entry;
+  };
+
   /// The number of entries in the tree.
   Long64_t entries_{-1};
 
   /// The current entry in the tree.
   Long64_t ientry_{-1};
 
+  /// Time in seconds spent reading entries from the input tree.
+  double readTime_{0.};
+
+  /// Events in the input tree sorted by event number, run and entry
+  std::vector<EventLocation> eventIndex_;
+
+  /// Have we built the event index yet?
+  bool indexed_{false};
+
+  /// Sorted entries to read if only some are selected
+  std::optional<std::vector<Long64_t>> selectedEntries_;
+
+  /// Index of the next selected entry to read
+  std::size_t iselected_{0};
+
   /// The file name.
   std::string fileName_;
 
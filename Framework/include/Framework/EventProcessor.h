@@ -134,6 +134,25 @@ class EventProcessor {
    */
   virtual void onProcessEnd() {}
 
+  /**
+   * Can more than one instance of this processor run concurrently?
+   *
+   * When the Process is configured with more than one thread, each
+   * event stream constructs and configures its own instance of every
+   * processor in the sequence. A processor should only declare itself
+   * clonable if it does not carry any state from one event to the next,
+   * does not create histograms or fill ntuples, and only uses shared
+   * resources (e.g. conditions) in a read-only way.
+   *
+   * @note Instances in different streams are given the same name, so
+   * a processor seeding a random number generator from its name in
+   * the RandomNumberSeedService would produce the same sequence in
+   * each stream and should not declare itself clonable.
+   *
+   * @return true if this processor can be cloned into separate streams
+   */
+  virtual bool isClonable() const { return false; }
+
   /**
    * Access a conditions object for the current event
    */
@@ -142,6 +161,20 @@ class EventProcessor {
     return getConditions().getCondition<T>(condition_name);
   }
 
+  /**
+   * Access the interval of validity of a conditions object
+   *
+   * This is the IOV of the object returned by the last call to
+   * getCondition, so processors can use it to check if they need
+   * to update anything they derived from that object.
+   *
+   * @param[in] condition_name name of condition to get IOV for
+   * @returns Interval Of Validity for the input condition name
+   */
+  ConditionsIOV getConditionIOV(const std::string &condition_name) const {
+    return getConditions().getConditionIOV(condition_name);
+  }
+
   /**
    * Access/create a directory in the histogram file for this event
    * processor to create histograms and analysis tuples.
@@ -182,6 +215,20 @@ class EventProcessor {
    */
   int getRunNumber() const;
 
+  /**
+   * Get the index of the try being processed from the process
+   * @see Process::getTryNumber
+   * @return int index of try within the run
+   */
+  int getTryNumber() const;
+
+  /**
+   * Get the number of completed events to generate from the process
+   * @see Process::getEventLimit
+   * @return int event limit (negative if there is no limit)
+   */
+  int getEventLimit() const;
+
   /**
    * Get the processor name
    */
@@ -0,0 +1,324 @@
+#ifndef FRAMEWORK_PERFORMANCE_PROFILER
+#define FRAMEWORK_PERFORMANCE_PROFILER
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TDirectory.h"
+
+namespace framework::performance {
+
+/**
+ * Record nested, named regions of code on each thread
+ *
+ * The Tracker uses this to record each processor callback and processors
+ * can use ScopedTimer to record named sub-regions of their own callbacks.
+ * Each region records the wall time it was open. Optionally, it also
+ * records the CPU time used by the thread and the number of minor page
+ * faults the thread triggered (a cheap proxy for how much new memory was
+ * allocated) while it was open. These cost two system calls per region,
+ * so they are only measured when asked for.
+ *
+ * The names of the regions are interned into integer identifiers, so
+ * opening and closing a region does not copy or compare any strings.
+ * Each thread records into its own buffer, so that opening and closing
+ * regions does not need any locking. The buffers are only combined when
+ * the results are written out, either as a summary TTree, a Chrome trace
+ * (viewable in `chrome://tracing` or https://ui.perfetto.dev) or as
+ * folded stacks for flame graph tools (e.g. `flamegraph.pl` or
+ * https://www.speedscope.app).
+ *
+ * Nothing is recorded unless the profiler has been enabled, which
+ * the Tracker does when performance logging is requested.
+ */
+class Profiler {
+ public:
+  /// Identifier of an interned region name
+  using RegionId = std::size_t;
+
+  /// A single closed region of code on one thread
+  struct Region {
+    /// name of region
+    RegionId id;
+    /// time stamp for when region was opened in nanoseconds since UNIX epoch
+    long int start;
+    /// wall time spent within region in nanoseconds
+    long int wall;
+    /// CPU time spent by this thread within region in nanoseconds
+    long int cpu;
+    /// number of minor page faults triggered within region
+    long int faults;
+  };
+
+  /// get the profiler shared by the whole process
+  static Profiler &get();
+
+  /**
+   * Start recording regions
+   *
+   * @param[in] trace keep every region for the Chrome trace
+   * @param[in] usage measure the CPU time and minor page faults of
+   * each region along with its wall time
+   * @param[in] max_trace_regions maximum number of regions kept for the
+   * trace of each thread, zero for no limit
+   */
+  void enable(bool trace = false, bool usage = false,
+              std::size_t max_trace_regions = 0);
+
+  /// are we recording regions?
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Get the identifier for a region name
+   *
+   * The same name always gets the same identifier. This locks, so
+   * names used often should be interned once ahead of time.
+   *
+   * @param[in] name name of region
+   * @return identifier of name
+   */
+  RegionId intern(const std::string &name);
+
+  /**
+   * Get the name of an interned region
+   *
+   * @param[in] id identifier of region
+   * @return name of region
+   */
+  std::string name(RegionId id) const;
+
+  /**
+   * Open a new region on the current thread
+   *
+   * The region is nested within any region that is still open on
+   * this thread.
+   *
+   * @param[in] id identifier of the region's name
+   */
+  void begin(RegionId id);
+
+  /**
+   * Open a new region on the current thread by its name
+   *
+   * The name is only interned the first time each thread opens a region
+   * with it, the identifier is found from the address of the name
+   * afterwards. The name should therefore be a string literal (or some
+   * other string that does not change for the rest of the process).
+   *
+   * @param[in] name name of region
+   */
+  void begin(const char *name);
+
+  /**
+   * Close the last region opened on the current thread
+   *
+   * Does nothing if there is no open region.
+   */
+  void end();
+
+  /**
+   * Forget all of the regions that have been recorded
+   *
+   * The interned names are kept. This should not be called while
+   * any thread has an open region.
+   */
+  void reset();
+
+  /**
+   * Write a summary of the regions into a TTree named "by_region"
+   *
+   * Regions with the same stack of names are combined into one
+   * entry with the number of calls and the total wall time, CPU time
+   * and minor page faults.
+   *
+   * @param[in] location directory to write the summary into
+   */
+  void writeSummary(TDirectory *location) const;
+
+  /**
+   * Write the regions kept for the trace as Chrome trace event JSON
+   *
+   * The number of regions that were not kept because of the limit
+   * on the trace is put into the "otherData" of the trace.
+   *
+   * @param[in] out stream to write to
+   */
+  void writeChromeTrace(std::ostream &out) const;
+
+  /**
+   * Write the Chrome trace into a file
+   *
+   * @param[in] filename name of file to write
+   */
+  void writeChromeTrace(const std::string &filename) const;
+
+  /**
+   * Write the regions as folded stacks for flame graph tools
+   *
+   * Each line is the semicolon-separated stack of region names followed
+   * by the time in microseconds spent in that region and not within
+   * any of its sub-regions.
+   *
+   * @param[in] out stream to write to
+   */
+  void writeFoldedStacks(std::ostream &out) const;
+
+  /**
+   * Write the folded stacks into a file
+   *
+   * @param[in] filename name of file to write
+   */
+  void writeFoldedStacks(const std::string &filename) const;
+
+ private:
+  /// the totals for all regions with the same stack
+  struct Total {
+    /// number of times the region was closed
+    long int calls{0};
+    /// total wall time in nanoseconds
+    long int wall{0};
+    /// total CPU time in nanoseconds
+    long int cpu{0};
+    /// total minor page faults
+    long int faults{0};
+    /// wall time not within any sub-region in nanoseconds
+    long int self{0};
+  };
+
+  /// a region in the tree of regions nested within each other
+  struct Node {
+    /// name of region
+    RegionId id;
+    /// index of the region this one is nested in (npos if none)
+    std::size_t parent;
+    /// indices of the regions nested in this one
+    std::vector<std::size_t> children;
+    /// totals for this region
+    Total total;
+  };
+
+  /// a region that hasn't been closed yet
+  struct Open {
+    /// index of region in the tree
+    std::size_t node;
+    /// index of region in the trace (npos if not kept)
+    std::size_t index;
+    /// time stamp when region was opened in nanoseconds
+    long int start;
+    /// CPU time of thread when region was opened in nanoseconds
+    long int cpu;
+    /// minor page faults of thread when region was opened
+    long int faults;
+  };
+
+  /// the regions recorded by one thread
+  struct Buffer {
+    /// integer identifying thread
+    int thread;
+    /// regions kept for the trace in the order they were opened
+    std::deque<Region> regions;
+    /// number of regions not kept for the trace
+    long int dropped{0};
+    /// stack of regions that have been opened but not closed
+    std::vector<Open> open;
+    /// tree of regions with their totals
+    std::vector<Node> nodes;
+    /// indices of the regions not nested in any other
+    std::vector<std::size_t> roots;
+  };
+
+  /// create the profiler, only done by get
+  Profiler() = default;
+
+  /// get the buffer of the current thread, creating it if necessary
+  Buffer &buffer();
+
+  /**
+   * Combine the totals from all of the threads
+   *
+   * @note Should be called while holding the mutex
+   *
+   * @return totals for each semicolon-separated stack of region names
+   */
+  std::map<std::string, Total> combine() const;
+
+  /// are we recording regions?
+  std::atomic<bool> enabled_{false};
+  /// keep the regions for the trace? set before recording
+  bool trace_{false};
+  /// measure CPU time and page faults? set before recording
+  bool usage_{false};
+  /// maximum number of regions in the trace of each thread, zero for all
+  std::size_t max_trace_regions_{0};
+  /// protect the names and list of buffers
+  mutable std::mutex mutex_;
+  /// interned region names
+  std::vector<std::string> names_;
+  /// identifiers of the interned region names
+  std::unordered_map<std::string, RegionId> ids_;
+  /// buffers for all of the threads that have recorded regions
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+/**
+ * Record the region of code while this object is in scope
+ *
+ * Processors can use this to see how long specific parts of their
+ * callbacks take. The regions are nested within the region for
+ * the callback they are in so they show up alongside the callback
+ * timing in the output of the Profiler.
+ *
+ * ```cpp
+ * void MyProducer::produce(framework::Event &event) {
+ *   framework::performance::ScopedTimer timer{"setup"};
+ *   // ... setup ...
+ *   timer.next("fit");
+ *   // ... fitting ...
+ * }  // "fit" region closed here
+ * ```
+ *
+ * Nothing is done if the Profiler is not enabled.
+ *
+ * @see Profiler::begin for why the names should be string literals
+ */
+class ScopedTimer {
+ public:
+  /**
+   * Open a region with the input name
+   * @param[in] name name of region
+   */
+  ScopedTimer(const char *name);
+
+  /// close our region
+  ~ScopedTimer();
+
+  /**
+   * Close our region and open a new one with the input name
+   *
+   * Helpful for timing a sequence of steps without introducing
+   * a new scope for each of them.
+   *
+   * @param[in] name name of new region
+   */
+  void next(const char *name);
+
+  /// not copyable since we would close the region twice
+  ScopedTimer(const ScopedTimer &) = delete;
+  /// not copyable since we would close the region twice
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+ private:
+  /// did we open a region?
+  bool active_;
+};
+
+}  // namespace framework::performance
+
+#endif
@@ -7,6 +7,7 @@
 #include <map>
 
 #include "Framework/Performance/Callback.h"
+#include "Framework/Performance/Profiler.h"
 #include "Framework/Performance/Timer.h"
 
 namespace framework::performance {
@@ -16,16 +17,32 @@ namespace framework::performance {
  * that can eventually be written into the output histogram file.
  *
  * @see Timer for the data format of timing measurements
+ * @see Profiler for the per-region measurements that are written
+ * alongside the timers
  */
 class Tracker {
  public:
   /**
    * Create the tracker with a specific destination for writing information
    *
+   * The Profiler is enabled so that the callbacks and any ScopedTimer
+   * within the processors are recorded. The optional files are where
+   * we export the recorded regions when closing. The regions are only
+   * kept for the trace if a trace file is requested.
+   *
    * @param[in] storage_directory directory in-which to write data when closing
    * @param[in] names sequence of processor names we will be tracking
+   * @param[in] trace_file Chrome trace file to write (empty to not write)
+   * @param[in] folded_file folded stack file to write (empty to not write)
+   * @param[in] thread_usage measure the CPU time and page faults of each
+   * region as well
+   * @param[in] max_trace_regions maximum number of regions in the trace
+   * of each thread, zero for no limit
    */
-  Tracker(TDirectory *storage_directory, const std::vector<std::string> &names);
+  Tracker(TDirectory *storage_directory, const std::vector<std::string> &names,
+          const std::string &trace_file = "",
+          const std::string &folded_file = "", bool thread_usage = false,
+          std::size_t max_trace_regions = 0);
   /**
    * Close up tracking and write all of the data collected to the storage
    * directory
@@ -72,6 +89,14 @@ class Tracker {
   std::vector<std::vector<Timer>> processor_timers_;
   /// names of the processors in the sequence for serialization
   std::vector<std::string> names_;
+  /// profiler region for the whole run
+  Profiler::RegionId run_region_;
+  /// profiler regions for each callback and each processor
+  std::vector<std::vector<Profiler::RegionId>> regions_;
+  /// name of Chrome trace file to write
+  std::string trace_file_;
+  /// name of folded stack file to write
+  std::string folded_file_;
 };
 }  // namespace framework::performance
 
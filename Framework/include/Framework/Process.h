@@ -64,8 +64,30 @@ class Process {
 
   /**
    * Get the pointer to the current event header, if defined
+   *
+   * When called from within an event stream, this is the header
+   * of the event that stream is processing.
+   */
+  const ldmx::EventHeader *getEventHeader() const;
+
+  /**
+   * Get the index of the try currently being processed
+   *
+   * When generating events, every try at an event counts (including the
+   * ones that are aborted or filtered out) and the first try of the run
+   * has index zero. When reading input files, each entry is one try.
+   *
+   * The tries are numbered in the order that they are merged into the
+   * output, so this index does not depend on the number of threads.
+   * Processors that need randomness can seed their engines with
+   * RandomNumberSeedService::getSeed(name, try) at the start of each
+   * event so that the same try gets the same random numbers no matter
+   * which thread (or event stream) ends up processing it.
+   *
+   * When called from within an event stream, this is the try that
+   * stream is processing.
    */
-  const ldmx::EventHeader *getEventHeader() const { return eventHeader_; }
+  int getTryNumber() const;
 
   /**
    * Get the pointer to the current run header, if defined
@@ -83,6 +105,17 @@ class Process {
    */
   int getLogFrequency() const { return logFrequency_; }
 
+  /**
+   * Get the number of completed events to generate
+   *
+   * This is totalEvents if it was set and maxEvents otherwise.
+   *
+   * @return integer event limit (negative if there is no limit)
+   */
+  int getEventLimit() const {
+    return totalEvents_ > 0 ? totalEvents_ : eventLimit_;
+  }
+
   /**
    * Run the process.
    */
@@ -103,10 +136,19 @@ class Process {
    */
   TDirectory *openHistoFile();
 
+  /**
+   * Get the number of event streams we are processing concurrently
+   * @return integer number of threads (1 if running serially)
+   */
+  int getNumThreads() const { return numThreads_; }
+
   /**
    * Access the storage control unit for this process
+   *
+   * When called from within an event stream, this is the storage
+   * control unit of that stream.
    */
-  StorageControl &getStorageController() { return storageController_; }
+  StorageControl &getStorageController();
 
   /**
    * Set the pointer to the current event header, used only for tests
@@ -146,10 +188,64 @@ class Process {
    */
   bool process(int n, int n_tries, Event &event) const;
 
+  /**
+   * Process the input event through the input sequence of processors
+   *
+   * @see process(int, int, Event&) for how the processors are called
+   *
+   * @param[in] n counter for number of events processed
+   * @param[in] n_tries counter for number of tries on current event
+   * @param[in,out] event reference to event we are going to process
+   * @param[in] sequence the processors to run on the event
+   * @returns true if event was full processed (false if aborted)
+   */
+  bool process(int n, int n_tries, Event &event,
+               const std::vector<EventProcessor *> &sequence) const;
+
+  /**
+   * Run the processors in each of the event streams concurrently
+   *
+   * The first n_streams streams are each given to a separate thread
+   * which processes the event that stream is holding. We wait for all
+   * of the threads to finish before returning so that the caller can
+   * merge the results in order.
+   *
+   * Any exception thrown by a processor is re-thrown here on the main
+   * thread after all of the threads have finished.
+   *
+   * @param[in] n counter for number of events processed before these
+   * @param[in] n_tries counter for number of tries before these
+   * @param[in] n_streams number of streams holding an event to process
+   */
+  void processStreams(int n, int n_tries, std::size_t n_streams);
+
+  /**
+   * Run the process with more than one event stream
+   *
+   * Each stream has its own Event and clones of the processors in
+   * the sequence. Events are dispatched to the streams in batches,
+   * processed concurrently, and then merged in order into the event
+   * that is attached to the output file so that the output is
+   * independent of the order the threads finish in.
+   *
+   * When generating events, the event number of each try depends on
+   * whether the tries before it complete. The streams are numbered
+   * assuming the tries end like the last merged one did, and a try that
+   * turns out to have the wrong number is attempted again in the next
+   * batch along with the ones after it.
+   *
+   * @param[in] theEvent event attached to the output file (if any)
+   */
+  void runStreams(Event &theEvent);
+
   /**
    * Run through the processors and let them know
    * that we are starting a new run.
    *
+   * Only the Producers in the primary sequence are given the chance to
+   * modify the run header; all processors (including the clones in any
+   * extra event streams) are then notified of the new run.
+   *
    * @param[in] header RunHeader for the new run
    */
   void newRun(ldmx::RunHeader &header);
@@ -196,6 +292,34 @@ class Process {
   /** Ordered list of EventProcessors to execute. */
   std::vector<EventProcessor *> sequence_;
 
+  /** Number of events streams to process concurrently */
+  int numThreads_{1};
+
+  /**
+   * An independent stream of events
+   *
+   * Defined in the implementation file since it is only
+   * used internally while running.
+   */
+  struct Stream;
+
+  /**
+   * The event streams when running with more than one thread
+   *
+   * The first stream uses the primary sequence while the others
+   * own clones of each processor in the sequence.
+   */
+  std::vector<Stream *> streams_;
+
+  /**
+   * The stream being processed on the current thread
+   *
+   * This is null on the main thread and is used to direct calls
+   * from the processors (e.g. for the event header or storage hints)
+   * to the stream they belong to.
+   */
+  static thread_local Stream *current_stream_;
+
   /** Set of ConditionsProviders */
   Conditions conditions_;
 
@@ -227,6 +351,9 @@ class Process {
   /** Pointer to the current EventHeader, used for Conditions information */
   const ldmx::EventHeader *eventHeader_{0};
 
+  /** Index of the try being processed outside of the event streams */
+  int tryNumber_{0};
+
   /** Pointer to the current RunHeader, used for Conditions information */
   ldmx::RunHeader *runHeader_{0};
 
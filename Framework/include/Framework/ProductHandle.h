@@ -0,0 +1,129 @@
+#ifndef FRAMEWORK_PRODUCTHANDLE_H
+#define FRAMEWORK_PRODUCTHANDLE_H
+
+#include <string>
+
+#include "Framework/Event.h"
+
+namespace framework {
+
+/**
+ * A typed handle to a product on the event bus
+ *
+ * Event::getObject has to construct the branch name, look through the
+ * cached lookups and the bus and then cast the passenger to the
+ * requested type every time it is called. A ProductHandle does this
+ * full lookup once and then keeps a pointer directly to the object
+ * carried by the passenger on the bus. The passengers keep the same
+ * object for as long as they are on the bus, so later events only
+ * need to check that the bus has not been rebuilt since the handle was
+ * resolved before dereferencing the pointer.
+ *
+ * The bus is rebuilt when a new input file is opened or when a new
+ * product is added to the event, and the handle re-resolves itself
+ * using Event::getObject when that happens.
+ *
+ * Processors should keep the handle as a member, set the name it
+ * refers to during configuration, and then use it in their
+ * produce/analyze functions.
+ *
+ * ```cpp
+ * // in configure
+ * hits_ = framework::ProductHandle<std::vector<ldmx::EcalHit>>(
+ *     parameters.getParameter<std::string>("hits_coll_name"),
+ *     parameters.getParameter<std::string>("hits_pass_name"));
+ * // in produce
+ * const auto& hits{hits_.get(event)};
+ * ```
+ *
+ * @tparam T type of object on the bus
+ */
+template <typename T>
+class ProductHandle {
+ public:
+  /**
+   * Default constructor, this handle does not refer to a product
+   */
+  ProductHandle() = default;
+
+  /**
+   * Define the product this handle refers to
+   *
+   * @param[in] collectionName name of product we want
+   * @param[in] passName name of specific pass we want, optional
+   */
+  ProductHandle(const std::string &collectionName,
+                const std::string &passName = "")
+      : collectionName_{collectionName}, passName_{passName} {}
+
+  /**
+   * Get the object this handle refers to
+   *
+   * If the handle has not been resolved for this event's bus yet,
+   * we look up the object with Event::getObject and cache a pointer
+   * to it. Otherwise, we simply return the cached object.
+   *
+   * @see Event::getObject for the exceptions that can be thrown
+   *
+   * @param[in] event current event to get the object from
+   * @returns const reference to object on the bus
+   */
+  const T &get(const Event &event) {
+    if (not isResolved(event)) resolve(event);
+    return *obj_;
+  }
+
+  /**
+   * Check if this handle points to the object on the input event's bus
+   *
+   * @param[in] event current event
+   * @returns true if the cached pointer can be used for this event
+   */
+  bool isResolved(const Event &event) const {
+    return obj_ != nullptr and event_ == &event and
+           generation_ == event.getBusGeneration();
+  }
+
+  /**
+   * Get the name of the product this handle refers to
+   * @returns name of product
+   */
+  const std::string &getCollectionName() const { return collectionName_; }
+
+  /**
+   * Get the pass name of the product this handle refers to
+   * @returns pass name of product (may be empty)
+   */
+  const std::string &getPassName() const { return passName_; }
+
+ private:
+  /**
+   * Do the full lookup of the object on the bus and cache it
+   *
+   * @param[in] event current event to get the object from
+   */
+  void resolve(const Event &event) {
+    obj_ = &event.getObject<T>(collectionName_, passName_);
+    event_ = &event;
+    generation_ = event.getBusGeneration();
+  }
+
+  /// name of product this handle refers to
+  std::string collectionName_;
+
+  /// pass name of product this handle refers to
+  std::string passName_;
+
+  /// event whose bus we resolved the object on
+  const Event *event_{nullptr};
+
+  /// generation of the event bus when we resolved the object
+  std::size_t generation_{0};
+
+  /// object carried by passenger on the bus
+  const T *obj_{nullptr};
+};
+
+}  // namespace framework
+
+#endif  // FRAMEWORK_PRODUCTHANDLE_H
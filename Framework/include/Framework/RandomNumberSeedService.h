@@ -7,6 +7,11 @@
 #ifndef FRAMEWORK_RANDOMNUMBERSEEDSERVICE_H_
 #define FRAMEWORK_RANDOMNUMBERSEEDSERVICE_H_
 
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <mutex>
+
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
 /*~~~~~~~~~~~~~~~*/
@@ -29,6 +34,11 @@ namespace framework {
  * Individual seeds are then constructed using the master seed and a simple hash
  * based on the name of the seed. Seeds can also be specified in the python
  * file, in which case no autoseeding will be performed.
+ *
+ * Each named seed can be split into independent substreams, e.g. one for
+ * each try at an event (see Process::getTryNumber). Seeding an engine from
+ * the substream of the try being processed makes the random numbers of each
+ * try independent of the other tries and of the thread processing it.
  */
 class RandomNumberSeedService : public ConditionsObject,
                                 public ConditionsObjectProvider {
@@ -78,6 +88,20 @@ class RandomNumberSeedService : public ConditionsObject,
    */
   uint64_t getSeed(const std::string& name) const;
 
+  /**
+   * Access a substream of a given seed by name
+   *
+   * The seed of the substream is the named seed scrambled together
+   * with the index of the substream, so nearby indices give unrelated
+   * seeds. This does not touch the cache, so it can be called for every
+   * event without the cache growing.
+   *
+   * @param[in] name Name of seed
+   * @param[in] substream index of the substream (e.g. the try number)
+   * @return seed derived from the named seed and the substream index
+   */
+  uint64_t getSeed(const std::string& name, uint64_t substream) const;
+
   /**
    * Get a list of all the known seeds
    *
@@ -147,6 +171,9 @@ class RandomNumberSeedService : public ConditionsObject,
 
   /// cache of seeds by name
   mutable std::map<std::string, uint64_t> seeds_;
+
+  /// guard for the cache since seeds can be requested by several streams
+  mutable std::mutex seeds_mutex_;
 };
 
 }  // namespace framework
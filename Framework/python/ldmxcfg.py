@@ -546,6 +546,18 @@ class Process:
         List of skimming rules for which processors the process should listen to when deciding whether to keep an event
     logFrequency : int
         Print the event number whenever its modulus with this frequency is zero
+    prefetchDepth : int
+        Number of entries to read ahead into the cache of each input file
+        A value of zero leaves ROOT's default caching in place.
+    unzipThreads : int
+        Number of background threads ROOT may use to decompress the
+        prefetched entries (zero disables parallel decompression)
+    numThreads : int
+        Number of event streams to process concurrently
+        Every processor in the sequence must declare itself clonable in C++
+        to run with more than one thread. When generating events, each stream
+        speculatively tries the next event and the tries are kept in order,
+        so processors should seed from their try number to be reproducible.
     logger : Logger
         configuration for logging system in ldmx-sw
     conditionsGlobalTag : str
@@ -580,6 +592,9 @@ class Process:
         self.skimDefaultIsKeep=True
         self.skimRules=[]
         self.logFrequency=-1
+        self.numThreads=1
+        self.prefetchDepth=0
+        self.unzipThreads=0
         self.logger = Logger()
         self.compressionSetting=9
         self.histogramFile=''
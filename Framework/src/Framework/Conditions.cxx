@@ -1,5 +1,6 @@
 #include "Framework/Conditions.h"
 
+#include <mutex>
 #include <sstream>
 
 #include "Framework/PluginFactory.h"
@@ -7,6 +8,17 @@
 
 namespace framework {
 
+/**
+ * Guard for the conditions cache and the providers
+ *
+ * When running with several event streams, the processors in
+ * each stream may request conditions at the same time, so we
+ * only let one of them check and update the cache at a time.
+ * Providers may request their parent conditions while the
+ * guard is held, so the same thread can lock it again.
+ */
+static std::recursive_mutex cache_mutex;
+
 Conditions::Conditions(Process& p) : process_{p} {}
 
 void Conditions::createConditionsObjectProvider(
@@ -45,8 +57,11 @@ void Conditions::onNewRun(ldmx::RunHeader& rh) {
 
 ConditionsIOV Conditions::getConditionIOV(
     const std::string& condition_name) const {
-  auto cacheptr = cache_.find(condition_name);
-  if (cacheptr == cache_.end())
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+  auto stream_cache = cache_.find(process_.getEventHeader());
+  if (stream_cache == cache_.end()) return ConditionsIOV();
+  auto cacheptr = stream_cache->second.find(condition_name);
+  if (cacheptr == stream_cache->second.end())
     return ConditionsIOV();
   else
     return cacheptr->second.iov;
@@ -54,10 +69,16 @@ ConditionsIOV Conditions::getConditionIOV(
 
 const ConditionsObject* Conditions::getConditionPtr(
     const std::string& condition_name) {
-  const ldmx::EventHeader& context = *(process_.getEventHeader());
-  auto cacheptr = cache_.find(condition_name);
-
-  if (cacheptr == cache_.end()) {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex);
+  // the header of the event the calling stream is processing
+  const ldmx::EventHeader* header = process_.getEventHeader();
+  const ldmx::EventHeader& context = *header;
+  // each stream only replaces the objects it got itself, so an object
+  //  is not released while another stream is still using it
+  auto& cache = cache_[header];
+  auto cacheptr = cache.find(condition_name);
+
+  if (cacheptr == cache.end()) {
     auto copptr = providerMap_.find(condition_name);
 
     if (copptr == providerMap_.end()) {
@@ -79,7 +100,7 @@ const ConditionsObject* Conditions::getConditionPtr(
     ce.iov = cond.second;
     ce.obj = cond.first;
     ce.provider = copptr->second;
-    cache_[condition_name] = ce;
+    cache[condition_name] = ce;
     return ce.obj;
   } else {
     /// if still valid, we return what we have
@@ -1,5 +1,7 @@
 #include "Framework/Event.h"
 
+#include <cctype>
+
 #include "TBranchElement.h"
 
 namespace framework {
@@ -10,6 +12,9 @@ Event::~Event() {
   for (regex_t& reg : regexDropCollections_) {
     regfree(&reg);
   }
+  for (auto& [pattern, reg] : searchRegex_) {
+    regfree(&reg);
+  }
 }
 
 void Event::Print() const {
@@ -29,7 +34,8 @@ void Event::addDrop(const std::string& exp) {
 }
 
 /**
- * Construct an actual regex from the pass pattern (and full-string flag)
+ * Construct the actual regex pattern from the pass pattern (and full-string
+ * flag)
  *
  * If the pattern is the empty string, then we generate the match-all regex
  * `.*`.
@@ -41,26 +47,42 @@ void Event::addDrop(const std::string& exp) {
  * @param[in] pattern a regex pattern string
  * @param[in] full_string_match flag if we want full-string matches only (true)
  * or if we can include sub-strings (false)
- * @return generated regex structure, expecting user to call regfree on it when
- * done
+ * @return pattern to compile into a regex
  */
-static regex_t construct_regex(const std::string& pattern,
-                               bool full_string_match) {
-  std::string pattern_regex{pattern};
-  if (pattern_regex.empty())
-    pattern_regex = ".*";
-  else if (full_string_match)
-    pattern_regex = "^" + pattern_regex + "$";
+static std::string construct_pattern(const std::string& pattern,
+                                     bool full_string_match) {
+  if (pattern.empty()) return ".*";
+  if (full_string_match) return "^" + pattern + "$";
+  return pattern;
+}
 
-  regex_t reg;
-  if (regcomp(&reg, pattern_regex.c_str(),
-              REG_EXTENDED | REG_ICASE | REG_NOSUB)) {
-    // use input value in exception since we expect our code above evolving
-    // the regex to be accurate
-    EXCEPTION_RAISE("InvalidRegex", "The passed regex '" + pattern +
-                                        "' is not a valid regular expression.");
+/**
+ * Check if the pattern is a plain string without any regex special characters
+ *
+ * @param[in] pattern a regex pattern string
+ * @return true if pattern only matches itself
+ */
+static bool is_plain(const std::string& pattern) {
+  return pattern.find_first_of(".[]()*+?{}|^$\\") == std::string::npos;
+}
+
+std::size_t Event::CaseInsensitiveHash::operator()(
+    const std::string& str) const {
+  // FNV-1a over the lower case characters
+  std::size_t hash{14695981039346656037ull};
+  for (unsigned char c : str) {
+    hash ^= static_cast<std::size_t>(std::tolower(c));
+    hash *= 1099511628211ull;
   }
-  return reg;
+  return hash;
+}
+
+bool Event::CaseInsensitiveEqual::operator()(const std::string& lhs,
+                                             const std::string& rhs) const {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                    [](unsigned char l, unsigned char r) {
+                      return std::tolower(l) == std::tolower(r);
+                    });
 }
 
 std::vector<ProductTag> Event::searchProducts(const std::string& namematch,
@@ -68,31 +90,16 @@ std::vector<ProductTag> Event::searchProducts(const std::string& namematch,
                                               const std::string& typematch,
                                               bool full_string_match) const {
   std::vector<ProductTag> retval;
-  regex_t reg_name{construct_regex(namematch, full_string_match)},
-      reg_pass{construct_regex(passmatch, full_string_match)},
-      reg_type{construct_regex(typematch, full_string_match)};
-
-  // all passed expressions are valid regular expressions
-  const std::vector<ProductTag>& products = getProducts();
-  for (std::vector<ProductTag>::const_iterator i = products.begin();
-       i != products.end(); i++) {
-    if (!regexec(&reg_name, i->name().c_str(), 0, 0, 0) &&
-        !regexec(&reg_pass, i->passname().c_str(), 0, 0, 0) &&
-        !regexec(&reg_type, i->type().c_str(), 0, 0, 0))
-      retval.push_back(*i);
-  }
-
-  regfree(&reg_type);
-  regfree(&reg_pass);
-  regfree(&reg_name);
-
+  for (std::size_t i :
+       matchProducts(namematch, passmatch, typematch, full_string_match))
+    retval.push_back(products_.at(i));
   return retval;
 }
 
 bool Event::exists(const std::string& name, const std::string& passName,
                    bool unique) const {
   static const bool require_full_string_match = true;
-  auto matches = searchProducts(name, passName, "", require_full_string_match);
+  auto matches = matchProducts(name, passName, "", require_full_string_match);
   if (unique)
     return (matches.size() == 1);
   else
@@ -113,11 +120,13 @@ void Event::setInputTree(TTree* tree) {
   // in some cases, setInputTree is called more than once,
   // so reset branch listing before starting
   products_.clear();
+  productIndex_.clear();
   knownLookups_.clear();  // reset caching of empty pass requests
   bus_.everybodyOff();
+  busGeneration_++;
 
   // put in EventHeader (only one without pass name)
-  products_.emplace_back(ldmx::EventHeader::BRANCH, "", "ldmx::EventHeader");
+  addProduct(ldmx::EventHeader::BRANCH, "", "ldmx::EventHeader");
 
   // find the names of all the existing branches
   TObjArray* branches = inputTree_->GetListOfBranches();
@@ -140,10 +149,9 @@ void Event::setInputTree(TTree* tree) {
       //  the higher-level TBranchElement type
       // Only occurs if the type on the bus is one of:
       //  bool, short, int, long, float, double (BSILFD)
-      products_.emplace_back(
-          brname.substr(0, j),   // collection name is before '_'
-          brname.substr(j + 1),  // pass name is after
-          br ? br->GetClassName() : "BSILFD");
+      addProduct(brname.substr(0, j),   // collection name is before '_'
+                 brname.substr(j + 1),  // pass name is after
+                 br ? br->GetClassName() : "BSILFD");
     }
   }
 }
@@ -162,6 +170,53 @@ void Event::beforeFill() {
   }
 }
 
+void Event::merge(Event& other) {
+  eventHeader_ = other.eventHeader_;
+  for (const std::string& branchName : other.branchesFilled_) {
+    // the event header is put in separately by beforeFill
+    if (branchName == ldmx::EventHeader::BRANCH) continue;
+
+    if (branchesFilled_.find(branchName) != branchesFilled_.end()) {
+      EXCEPTION_RAISE("ProductExists",
+                      "A product with the branch name '" + branchName +
+                          "' already exists in the event.");
+    }
+    branchesFilled_.insert(branchName);
+
+    bool already_on_board{bus_.isOnBoard(branchName)};
+    try {
+      bus_.transfer(branchName, other.bus_);
+    } catch (const std::bad_cast&) {
+      EXCEPTION_RAISE("TypeMismatch",
+                      "Attempting to merge a product into '" + branchName +
+                          "' whose type doesn't match the type stored in the "
+                          "collection.");
+    }
+    if (already_on_board) continue;
+
+    // new passenger, add it to the list of products and attach it
+    // to the output tree just like in add
+    std::string collectionName{branchName.substr(0, branchName.find('_'))};
+    auto tag{std::find_if(other.products_.begin(), other.products_.end(),
+                          [&](const ProductTag& t) {
+                            return t.name() == collectionName and
+                                   t.passname() == passName_;
+                          })};
+    std::string tname{tag != other.products_.end() ? tag->type() : ""};
+    if (outputTree_ and not shouldDrop(branchName)) {
+      TBranch* outBranch = bus_.attach(outputTree_, branchName, true);
+      std::string class_name{outBranch->GetClassName()};
+      if (not class_name.empty()) tname = class_name;
+    }
+
+    auto it_known{knownLookups_.find(collectionName)};
+    if (it_known != knownLookups_.end()) knownLookups_.erase(it_known);
+
+    addProduct(collectionName, passName_, tname);
+    busGeneration_++;
+  }
+}
+
 void Event::Clear() {
   branchesFilled_.clear();  // forget names of branches we filled
   bus_.clear();  // clear the event objects individually but leave them on bus
@@ -176,6 +231,64 @@ void Event::onEndOfFile() {
     inputTree_ = nullptr;  // detach old inputTree (owned by EventFile)
   knownLookups_.clear();   // reset caching of empty pass requests
   bus_.everybodyOff();     // delete buffer objects
+  busGeneration_++;        // invalidate cached references to the bus
+  lazyReadTime_ = 0.;      // reset read timing for the next file
+}
+
+void Event::addProduct(const std::string& name, const std::string& pass,
+                       const std::string& type) {
+  productIndex_[name].push_back(products_.size());
+  products_.emplace_back(name, pass, type);
+}
+
+std::vector<std::size_t> Event::matchProducts(const std::string& namematch,
+                                              const std::string& passmatch,
+                                              const std::string& typematch,
+                                              bool full_string_match) const {
+  std::vector<std::size_t> retval;
+  auto check = [&](std::size_t i) {
+    const ProductTag& tag{products_.at(i)};
+    if (matches(passmatch, tag.passname(), full_string_match) and
+        matches(typematch, tag.type(), full_string_match))
+      retval.push_back(i);
+  };
+
+  if (full_string_match and not namematch.empty() and is_plain(namematch)) {
+    // only the products with this exact name can match
+    auto candidates{productIndex_.find(namematch)};
+    if (candidates == productIndex_.end()) return retval;
+    for (std::size_t i : candidates->second) check(i);
+  } else {
+    for (std::size_t i{0}; i < products_.size(); i++) {
+      if (matches(namematch, products_.at(i).name(), full_string_match))
+        check(i);
+    }
+  }
+
+  return retval;
+}
+
+bool Event::matches(const std::string& pattern, const std::string& value,
+                    bool full_string_match) const {
+  if (pattern.empty()) return true;
+  if (full_string_match and is_plain(pattern))
+    return CaseInsensitiveEqual()(pattern, value);
+
+  std::string pattern_regex{construct_pattern(pattern, full_string_match)};
+  auto cached{searchRegex_.find(pattern_regex)};
+  if (cached == searchRegex_.end()) {
+    regex_t reg;
+    if (regcomp(&reg, pattern_regex.c_str(),
+                REG_EXTENDED | REG_ICASE | REG_NOSUB)) {
+      // use input value in exception since we expect our code above evolving
+      // the regex to be accurate
+      EXCEPTION_RAISE("InvalidRegex",
+                      "The passed regex '" + pattern +
+                          "' is not a valid regular expression.");
+    }
+    cached = searchRegex_.emplace(pattern_regex, reg).first;
+  }
+  return !regexec(&cached->second, value.c_str(), 0, 0, 0);
 }
 
 bool Event::shouldDrop(const std::string& branchName) const {
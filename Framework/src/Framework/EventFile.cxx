@@ -1,10 +1,14 @@
+#include <algorithm>
+#include <chrono>
 #include <ctime>
+#include <tuple>
 
 #include "TTreeReader.h"
 
 // LDMX
 #include "Framework/Event.h"
 #include "Framework/EventFile.h"
+#include "Framework/EventHeader.h"
 #include "Framework/Exception/Exception.h"
 #include "Framework/RunHeader.h"
 
@@ -85,6 +89,22 @@ EventFile::EventFile(const framework::config::Parameters &params,
       return;
     }
     entries_ = tree_->GetEntriesFast();
+
+    /**
+     * Size the TTreeCache so that it holds the compressed baskets for the
+     * next prefetchDepth entries. ROOT reads these baskets in one go and,
+     * if parallel unzipping is enabled, decompresses them on background
+     * threads while the current entry is being processed.
+     *
+     * The cache learns which branches are actually read during the
+     * first few entries, so branches that are never accessed are not
+     * prefetched.
+     */
+    int prefetch_depth{params.getParameter<int>("prefetchDepth", 0)};
+    if (prefetch_depth > 0 and entries_ > 0) {
+      Long64_t bytes_per_entry{tree_->GetZipBytes() / entries_ + 1};
+      tree_->SetCacheSize(prefetch_depth * bytes_per_entry);
+    }
   }
 
   importRunHeaders();
@@ -245,15 +265,25 @@ bool EventFile::nextEvent(bool storeCurrentEvent) {
     // we don't have a parent and
     //  we aren't an output file
     // try to load another entry from our tree
-    if (ientry_ + 1 >= entries_) {
-      if (isLoopable_) {
-        // reset the event counter: reuse events from start of pileup tree
-        ientry_ = -1;
-      } else
-        return false;
+    if (selectedEntries_) {
+      // jump straight to the next selected entry
+      if (iselected_ >= selectedEntries_->size()) return false;
+      ientry_ = (*selectedEntries_)[iselected_++];
+    } else {
+      if (ientry_ + 1 >= entries_) {
+        if (isLoopable_) {
+          // reset the event counter: reuse events from start of pileup tree
+          ientry_ = -1;
+        } else
+          return false;
+      }
+      ientry_++;
     }
-    ientry_++;
+    auto start{std::chrono::steady_clock::now()};
     tree_->GetEntry(ientry_);
+    readTime_ += std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
   }
 
   // if we have an event_
@@ -295,6 +325,71 @@ int EventFile::skipToEvent(int offset) {
   return ientry_;
 }
 
+std::vector<Long64_t> EventFile::findEntries(int event,
+                                             std::optional<int> run) {
+  if (!indexed_) buildEventIndex();
+  auto it{std::lower_bound(
+      eventIndex_.begin(), eventIndex_.end(), event,
+      [](const EventLocation &loc, int ev) { return loc.event < ev; })};
+  std::vector<Long64_t> entries;
+  for (; it != eventIndex_.end() and it->event == event; ++it) {
+    if (!run or it->run == *run) entries.push_back(it->entry);
+  }
+  return entries;
+}
+
+void EventFile::selectEntries(std::vector<Long64_t> entries) {
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  for (Long64_t entry : entries) {
+    if (entry < 0 or entry >= entries_) {
+      EXCEPTION_RAISE("EventFile", "Entry " + std::to_string(entry) +
+                                       " is not in the input file '" +
+                                       fileName_ + "'.");
+    }
+  }
+  selectedEntries_ = std::move(entries);
+  iselected_ = 0;
+}
+
+void EventFile::buildEventIndex() {
+  if (isOutputFile_ or !tree_) {
+    EXCEPTION_RAISE("EventFile", "Can only index the events of input file '" +
+                                     fileName_ + "'.");
+  }
+  if (event_ or ientry_ >= 0) {
+    EXCEPTION_RAISE("EventFile", "The events of '" + fileName_ +
+                                     "' must be indexed before reading them.");
+  }
+  TBranch *branch{tree_->GetBranch(ldmx::EventHeader::BRANCH.c_str())};
+  if (!branch) {
+    EXCEPTION_RAISE("EventFile", "Input file '" + fileName_ +
+                                     "' does not have an EventHeader branch.");
+  }
+
+  ldmx::EventHeader header;
+  ldmx::EventHeader *address{&header};
+  branch->SetAddress(&address);
+  eventIndex_.clear();
+  eventIndex_.reserve(entries_);
+  auto start{std::chrono::steady_clock::now()};
+  for (Long64_t entry{0}; entry < entries_; entry++) {
+    branch->GetEntry(entry);
+    eventIndex_.push_back({header.getEventNumber(), header.getRun(), entry});
+  }
+  readTime_ += std::chrono::duration<double>(
+                   std::chrono::steady_clock::now() - start)
+                   .count();
+  branch->ResetAddress();
+
+  std::sort(eventIndex_.begin(), eventIndex_.end(),
+            [](const EventLocation &lhs, const EventLocation &rhs) {
+              return std::tie(lhs.event, lhs.run, lhs.entry) <
+                     std::tie(rhs.event, rhs.run, rhs.entry);
+            });
+  indexed_ = true;
+}
+
 void EventFile::updateParent(EventFile *parent) {
   parent_ = parent;
 
@@ -41,6 +41,10 @@ int EventProcessor::getLogFrequency() const {
 
 int EventProcessor::getRunNumber() const { return process_.getRunNumber(); }
 
+int EventProcessor::getTryNumber() const { return process_.getTryNumber(); }
+
+int EventProcessor::getEventLimit() const { return process_.getEventLimit(); }
+
 void EventProcessor::declare(const std::string &classname, int classtype,
                              EventProcessorMaker *maker) {
   PluginFactory::getInstance().registerEventProcessor(classname, classtype,
@@ -0,0 +1,291 @@
+#include "Framework/Performance/Profiler.h"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <fstream>
+#include <tuple>
+#include <utility>
+
+#include "Framework/Exception/Exception.h"
+#include "TTree.h"
+
+namespace framework::performance {
+
+/**
+ * Get the CPU time and minor page faults of the calling thread
+ *
+ * @return pair of CPU time in nanoseconds and number of minor page faults
+ */
+static std::pair<long int, long int> thread_usage() {
+  struct rusage usage;
+  getrusage(RUSAGE_THREAD, &usage);
+  long int cpu{(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000L +
+               (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000L};
+  return {cpu, usage.ru_minflt};
+}
+
+/**
+ * Get the current time in nanoseconds since UNIX epoch
+ */
+static long int now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::high_resolution_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Escape the input string so that it can be put into a JSON string
+ *
+ * @param[in] str string to escape
+ * @return escaped string
+ */
+static std::string json_escape(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (char c : str) {
+    if (c == '"' or c == '\\') escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+/**
+ * Open the output file for writing
+ *
+ * @param[in] filename name of file to open
+ * @return open output file stream
+ */
+static std::ofstream open_output(const std::string& filename) {
+  std::ofstream out{filename};
+  if (not out.is_open()) {
+    EXCEPTION_RAISE("PerfFile",
+                    "Unable to open '" + filename + "' for performance data.");
+  }
+  return out;
+}
+
+Profiler& Profiler::get() {
+  static Profiler the_profiler;
+  return the_profiler;
+}
+
+void Profiler::enable(bool trace, bool usage, std::size_t max_trace_regions) {
+  trace_ = trace;
+  usage_ = usage;
+  max_trace_regions_ = max_trace_regions;
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+Profiler::RegionId Profiler::intern(const std::string& name) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto [it, inserted] = ids_.try_emplace(name, names_.size());
+  if (inserted) names_.push_back(name);
+  return it->second;
+}
+
+std::string Profiler::name(RegionId id) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return names_.at(id);
+}
+
+Profiler::Buffer& Profiler::buffer() {
+  thread_local Buffer* the_buffer{nullptr};
+  if (the_buffer == nullptr) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    buffers_.push_back(std::make_unique<Buffer>());
+    the_buffer = buffers_.back().get();
+    the_buffer->thread = buffers_.size() - 1;
+  }
+  return *the_buffer;
+}
+
+void Profiler::begin(RegionId id) {
+  Buffer& buf{buffer()};
+
+  // find this region within the one we are in, adding it if it's new
+  std::size_t parent{buf.open.empty() ? std::string::npos
+                                      : buf.open.back().node};
+  auto& siblings{parent == std::string::npos ? buf.roots
+                                             : buf.nodes[parent].children};
+  std::size_t node{std::string::npos};
+  for (std::size_t sibling : siblings) {
+    if (buf.nodes[sibling].id == id) {
+      node = sibling;
+      break;
+    }
+  }
+  if (node == std::string::npos) {
+    node = buf.nodes.size();
+    siblings.push_back(node);
+    buf.nodes.push_back({id, parent, {}, {}});
+  }
+
+  std::size_t index{std::string::npos};
+  if (trace_) {
+    if (max_trace_regions_ == 0 or buf.regions.size() < max_trace_regions_) {
+      index = buf.regions.size();
+      buf.regions.push_back({id, 0, 0, 0, 0});
+    } else {
+      buf.dropped++;
+    }
+  }
+
+  long int cpu{0}, faults{0};
+  if (usage_) std::tie(cpu, faults) = thread_usage();
+  buf.open.push_back({node, index, now(), cpu, faults});
+}
+
+void Profiler::begin(const char* name) {
+  // interned once per thread for each name, keyed by its address
+  thread_local std::unordered_map<const char*, RegionId> ids;
+  auto id{ids.find(name)};
+  if (id == ids.end()) id = ids.emplace(name, intern(name)).first;
+  begin(id->second);
+}
+
+void Profiler::end() {
+  Buffer& buf{buffer()};
+  if (buf.open.empty()) return;
+  long int stop{now()};
+  long int cpu{0}, faults{0};
+  if (usage_) std::tie(cpu, faults) = thread_usage();
+  const Open& open{buf.open.back()};
+  long int wall{stop - open.start};
+
+  Node& node{buf.nodes[open.node]};
+  node.total.calls++;
+  node.total.wall += wall;
+  node.total.cpu += cpu - open.cpu;
+  node.total.faults += faults - open.faults;
+  node.total.self += wall;
+  // time within us is not self time of our parent
+  if (node.parent != std::string::npos) {
+    buf.nodes[node.parent].total.self -= wall;
+  }
+
+  if (open.index != std::string::npos) {
+    Region& region{buf.regions[open.index]};
+    region.start = open.start;
+    region.wall = wall;
+    region.cpu = cpu - open.cpu;
+    region.faults = faults - open.faults;
+  }
+
+  buf.open.pop_back();
+}
+
+void Profiler::reset() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (auto& buf : buffers_) {
+    buf->regions.clear();
+    buf->dropped = 0;
+    buf->open.clear();
+    buf->nodes.clear();
+    buf->roots.clear();
+  }
+}
+
+std::map<std::string, Profiler::Total> Profiler::combine() const {
+  std::map<std::string, Total> totals;
+  for (const auto& buf : buffers_) {
+    // the stacks of the parents come before their children
+    std::vector<std::string> stacks(buf->nodes.size());
+    for (std::size_t i{0}; i < buf->nodes.size(); i++) {
+      const Node& node{buf->nodes[i]};
+      stacks[i] = (node.parent == std::string::npos)
+                      ? names_[node.id]
+                      : stacks[node.parent] + ";" + names_[node.id];
+      Total& total{totals[stacks[i]]};
+      total.calls += node.total.calls;
+      total.wall += node.total.wall;
+      total.cpu += node.total.cpu;
+      total.faults += node.total.faults;
+      total.self += node.total.self;
+    }
+  }
+  return totals;
+}
+
+void Profiler::writeSummary(TDirectory* location) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  location->cd();
+  TTree* summary = new TTree("by_region", "by_region");
+  std::string name;
+  long int calls, faults;
+  double wall, cpu;
+  summary->Branch("name", &name);
+  summary->Branch("calls", &calls);
+  summary->Branch("wall", &wall);
+  summary->Branch("cpu", &cpu);
+  summary->Branch("faults", &faults);
+  for (const auto& [stack, total] : combine()) {
+    name = stack;
+    calls = total.calls;
+    wall = total.wall * 1e-9;
+    cpu = total.cpu * 1e-9;
+    faults = total.faults;
+    summary->Fill();
+  }
+  summary->Write();
+}
+
+void Profiler::writeChromeTrace(std::ostream& out) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  out << "{\"traceEvents\":[";
+  bool first{true};
+  long int dropped{0};
+  for (const auto& buf : buffers_) {
+    dropped += buf->dropped;
+    for (const Region& region : buf->regions) {
+      if (not first) out << ",";
+      first = false;
+      // complete events with times in microseconds
+      out << "\n{\"name\":\"" << json_escape(names_[region.id])
+          << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buf->thread
+          << ",\"ts\":" << region.start / 1000
+          << ",\"dur\":" << region.wall / 1000.;
+      if (usage_) {
+        out << ",\"args\":{\"cpu_us\":" << region.cpu / 1000.
+            << ",\"minor_faults\":" << region.faults << "}";
+      }
+      out << "}";
+    }
+  }
+  out << "\n],\"otherData\":{\"dropped_regions\":" << dropped << "}}"
+      << std::endl;
+}
+
+void Profiler::writeChromeTrace(const std::string& filename) const {
+  std::ofstream out{open_output(filename)};
+  writeChromeTrace(out);
+}
+
+void Profiler::writeFoldedStacks(std::ostream& out) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (const auto& [stack, total] : combine()) {
+    if (total.self > 0) out << stack << " " << total.self / 1000 << "\n";
+  }
+}
+
+void Profiler::writeFoldedStacks(const std::string& filename) const {
+  std::ofstream out{open_output(filename)};
+  writeFoldedStacks(out);
+}
+
+ScopedTimer::ScopedTimer(const char* name)
+    : active_{Profiler::get().enabled()} {
+  if (active_) Profiler::get().begin(name);
+}
+
+ScopedTimer::~ScopedTimer() {
+  if (active_) Profiler::get().end();
+}
+
+void ScopedTimer::next(const char* name) {
+  if (not active_) return;
+  Profiler::get().end();
+  Profiler::get().begin(name);
+}
+
+}  // namespace framework::performance
@@ -5,8 +5,12 @@ namespace framework::performance {
 const std::string Tracker::ALL = "__ALL__";
 
 Tracker::Tracker(TDirectory* storage_directory,
-                 const std::vector<std::string>& names)
-    : storage_directory_{storage_directory} {
+                 const std::vector<std::string>& names,
+                 const std::string& trace_file, const std::string& folded_file,
+                 bool thread_usage, std::size_t max_trace_regions)
+    : storage_directory_{storage_directory},
+      trace_file_{trace_file},
+      folded_file_{folded_file} {
   /**
    * Create the event-by-event data TTree while within
    * the storage directory. This means the event data TTree
@@ -37,6 +41,25 @@ Tracker::Tracker(TDirectory* storage_directory,
     timer_set.resize(names_.size());
   }
 
+  /**
+   * Intern the names of the profiler regions ahead of time so we
+   * don't need to do it while processing. The callback of all the
+   * processors is just named after the callback and the processors
+   * are nested within it.
+   */
+  Profiler& profiler{Profiler::get()};
+  profiler.reset();
+  run_region_ = profiler.intern("run");
+  regions_.resize(processor_timers_.size());
+  for (std::size_t i_cb{0}; i_cb < regions_.size(); i_cb++) {
+    std::string cb_name{to_name(static_cast<Callback>(i_cb))};
+    regions_[i_cb].push_back(profiler.intern(cb_name));
+    for (std::size_t i{1}; i < names_.size(); i++) {
+      regions_[i_cb].push_back(profiler.intern(names_[i] + "::" + cb_name));
+    }
+  }
+  profiler.enable(not trace_file_.empty(), thread_usage, max_trace_regions);
+
   /**
    * Attach the processor timers to the event-by-event data
    * TTree as branches
@@ -65,6 +88,11 @@ Tracker::~Tracker() {
   storage_directory_->cd();
   absolute_.write(storage_directory_, "absolute");
 
+  Profiler::get().writeSummary(storage_directory_);
+  if (not trace_file_.empty()) Profiler::get().writeChromeTrace(trace_file_);
+  if (not folded_file_.empty()) Profiler::get().writeFoldedStacks(folded_file_);
+  storage_directory_->cd();
+
   /**
    * Write the non-event callbacks in their own directories,
    * this data is then accessible as single data-points instead
@@ -83,15 +111,23 @@ Tracker::~Tracker() {
   }
 }
 
-void Tracker::absolute_start() { absolute_.start(); }
+void Tracker::absolute_start() {
+  absolute_.start();
+  Profiler::get().begin(run_region_);
+}
 
-void Tracker::absolute_stop() { absolute_.stop(); }
+void Tracker::absolute_stop() {
+  Profiler::get().end();
+  absolute_.stop();
+}
 
 void Tracker::start(Callback callback, std::size_t i_proc) {
   processor_timers_[to_index(callback)][i_proc].start();
+  Profiler::get().begin(regions_[to_index(callback)][i_proc]);
 }
 
 void Tracker::stop(Callback callback, std::size_t i_proc) {
+  Profiler::get().end();
   processor_timers_[to_index(callback)][i_proc].stop();
 }
 
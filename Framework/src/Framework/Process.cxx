@@ -5,6 +5,7 @@
 
 #include "Framework/Process.h"
 
+#include <future>
 #include <iostream>
 
 #include "Framework/Event.h"
@@ -17,9 +18,43 @@
 #include "Framework/RunHeader.h"
 #include "TFile.h"
 #include "TROOT.h"
+#include "TTreeCacheUnzip.h"
 
 namespace framework {
 
+/**
+ * An independent stream of events
+ *
+ * Each stream has its own event bus, storage control unit,
+ * and sequence of processors so that streams can process
+ * separate events at the same time.
+ */
+struct Process::Stream {
+  /**
+   * Create the stream
+   * @param[in] pass name of pass for the stream's event
+   * @param[in] storage storage control unit with rules to copy
+   */
+  Stream(const std::string &pass, const StorageControl &storage)
+      : event{pass}, storage{storage} {}
+  /// event this stream is processing
+  Event event;
+  /// storage control unit collecting hints for this stream's event
+  StorageControl storage;
+  /// processors run on the event in this stream
+  std::vector<EventProcessor *> sequence;
+  /// input file this stream is reading from (if any)
+  EventFile *input{nullptr};
+  /// did the event in this stream complete processing?
+  bool completed{false};
+  /// index of the try this stream is processing
+  int try_number{0};
+  /// event number the try of this stream was processed with
+  int event_number{0};
+};
+
+thread_local Process::Stream *Process::current_stream_{nullptr};
+
 Process::Process(const framework::config::Parameters &configuration)
     : conditions_{*this} {
   config_ = configuration;
@@ -42,9 +77,23 @@ Process::Process(const framework::config::Parameters &configuration)
       configuration.getParameter<std::vector<std::string>>("outputFiles", {});
   dropKeepRules_ =
       configuration.getParameter<std::vector<std::string>>("keep", {});
+  numThreads_ = configuration.getParameter<int>("numThreads", 1);
+  if (numThreads_ < 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "The number of threads must be at least one, not " +
+                        std::to_string(numThreads_) + ".");
+  }
 
   eventHeader_ = 0;
 
+  // allow ROOT to decompress the baskets prefetched into the TTreeCache
+  // of the input files on a pool of background threads
+  auto unzipThreads{configuration.getParameter<int>("unzipThreads", 0)};
+  if (unzipThreads > 0) {
+    ROOT::EnableImplicitMT(unzipThreads);
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  }
+
   // set up the logging for this run
   logging::open(
       configuration.getParameter<framework::config::Parameters>("logger", {}));
@@ -66,6 +115,12 @@ Process::Process(const framework::config::Parameters &configuration)
     storageController_.addRule(skimRules[i], skimRules[i + 1]);
   }
 
+  if (numThreads_ > 1) {
+    for (int i_stream{0}; i_stream < numThreads_; i_stream++) {
+      streams_.push_back(new Stream(passname_, storageController_));
+    }
+  }
+
   auto sequence{
       configuration.getParameter<std::vector<framework::config::Parameters>>(
           "sequence", {})};
@@ -97,6 +152,31 @@ Process::Process(const framework::config::Parameters &configuration)
     }
     ep->configure(proc);
     sequence_.push_back(ep);
+
+    if (numThreads_ > 1) {
+      if (not ep->isClonable()) {
+        EXCEPTION_RAISE("NotClonable",
+                        "The processor '" + instanceName + "' of class '" +
+                            className +
+                            "' has not declared that it can be cloned into "
+                            "separate event streams, so it cannot be run "
+                            "with more than one thread.");
+      }
+      if (!histograms.empty()) {
+        EXCEPTION_RAISE("NotClonable",
+                        "The processor '" + instanceName +
+                            "' has histograms configured which cannot be "
+                            "filled from more than one thread.");
+      }
+      streams_[0]->sequence.push_back(ep);
+      for (std::size_t i_stream{1}; i_stream < streams_.size(); i_stream++) {
+        EventProcessor *clone =
+            PluginFactory::getInstance().createEventProcessor(
+                className, instanceName, *this);
+        clone->configure(proc);
+        streams_[i_stream]->sequence.push_back(clone);
+      }
+    }
   }
 
   auto conditionsObjectProviders{
@@ -113,13 +193,22 @@ Process::Process(const framework::config::Parameters &configuration)
 
   bool logPerformance =
       configuration.getParameter<bool>("logPerformance", false);
+  if (logPerformance and numThreads_ > 1) {
+    EXCEPTION_RAISE("InvalidConfig",
+                    "Performance logging is not supported when running with "
+                    "more than one thread.");
+  }
   if (logPerformance) {
     std::vector<std::string> names{sequence_.size()};
     for (std::size_t i{0}; i < sequence_.size(); i++) {
       names[i] = sequence_[i]->getName();
     }
-    performance_ =
-        new performance::Tracker(makeHistoDirectory("performance"), names);
+    performance_ = new performance::Tracker(
+        makeHistoDirectory("performance"), names,
+        configuration.getParameter<std::string>("performanceTraceFile", ""),
+        configuration.getParameter<std::string>("performanceFoldedFile", ""),
+        configuration.getParameter<bool>("performanceThreadUsage", false),
+        configuration.getParameter<int>("performanceTraceLimit", 0));
   }
 }
 
@@ -130,6 +219,13 @@ Process::~Process() {
   for (EventProcessor *ep : sequence_) {
     delete ep;
   }
+  // the first stream uses the primary sequence deleted above
+  for (std::size_t i_stream{0}; i_stream < streams_.size(); i_stream++) {
+    if (i_stream > 0) {
+      for (EventProcessor *ep : streams_[i_stream]->sequence) delete ep;
+    }
+    delete streams_[i_stream];
+  }
   if (histoTFile_) {
     histoTFile_->Write();
     delete histoTFile_;
@@ -170,10 +266,16 @@ void Process::run() {
   }
   if (performance_)
     performance_->stop(performance::Callback::onProcessStart, 0);
+  for (std::size_t i_stream{1}; i_stream < streams_.size(); i_stream++) {
+    for (auto module : streams_[i_stream]->sequence) module->onProcessStart();
+  }
 
-  // If we have no input files, but do have an event number, run for
-  // that number of events and generate an output file.
-  if (inputFiles_.empty() && eventLimit_ > 0) {
+  if (numThreads_ > 1) {
+    // the event streams handle both generating events and input files
+    runStreams(theEvent);
+  } else if (inputFiles_.empty() && eventLimit_ > 0) {
+    // If we have no input files, but do have an event number, run for
+    // that number of events and generate an output file.
     if (outputFiles_.empty()) {
       EXCEPTION_RAISE("InvalidConfig",
                       "No input files or output files were given.");
@@ -210,6 +312,7 @@ void Process::run() {
       event_limit = totalEvents_;
     }
     while (n_events_processed < event_limit) {
+      tryNumber_ = totalTries;
       totalTries++;
       numTries++;
 
@@ -353,6 +456,7 @@ void Process::run() {
           }
         }
 
+        tryNumber_ = n_events_processed;
         event_completed = process(n_events_processed, 1, theEvent);
 
         if (event_completed) NtupleManager::getInstance().fill();
@@ -372,6 +476,9 @@ void Process::run() {
         leave_early = true;
       }
 
+      ldmx_log(info) << "Spent " << inFile.getReadTime()
+                     << "s reading entries and " << theEvent.getLazyReadTime()
+                     << "s loading branches on demand from " << infilename;
       ldmx_log(info) << "Closing file " << infilename;
       onFileClose(inFile);
 
@@ -411,14 +518,337 @@ void Process::run() {
       performance_->stop(performance::Callback::onProcessEnd, i_proc);
   }
   if (performance_) performance_->stop(performance::Callback::onProcessEnd, 0);
+  for (std::size_t i_stream{1}; i_stream < streams_.size(); i_stream++) {
+    for (auto module : streams_[i_stream]->sequence) module->onProcessEnd();
+  }
 
   // we're done so let's close up the logging
   logging::close();
   if (performance_) performance_->absolute_stop();
 }
 
+void Process::runStreams(Event &theEvent) {
+  // the streams read and write ROOT objects on separate threads
+  ROOT::EnableThreadSafety();
+
+  int n_events_processed{0};
+
+  if (inputFiles_.empty() && eventLimit_ > 0) {
+    // generate events in each stream and merge them into the output file
+    if (outputFiles_.empty()) {
+      EXCEPTION_RAISE("InvalidConfig",
+                      "No input files or output files were given.");
+    } else if (outputFiles_.size() > 1) {
+      ldmx_log(warn) << "Several output files given with no input files. "
+                     << "Only the first output file '" << outputFiles_.at(0)
+                     << "' will be used.";
+    }
+
+    EventFile outFile(config_, outputFiles_.at(0), nullptr, true, true, false);
+    onFileOpen(outFile);
+    outFile.setupEvent(&theEvent);
+
+    for (auto rule : dropKeepRules_) outFile.addDrop(rule);
+
+    ldmx::RunHeader runHeader(runForGeneration_);
+    runHeader.setRunStart(std::time(nullptr));
+    runHeader_ = &runHeader;
+    outFile.writeRunHeader(runHeader);
+
+    newRun(runHeader);
+
+    int totalTries = 0;  // total number of tries for entire run
+    int numTries = 0;    // number of tries for the current event number
+    int event_limit = eventLimit_;
+    if (totalEvents_ > 0) {
+      ldmx_log(warn) << "The totalEvents was set, so maxEvents and "
+                        "maxTriesPerEvent will be ignored!";
+      event_limit = totalEvents_;
+    }
+    // the streams guess that their tries end like the last merged one
+    bool predict_completed{true};
+    while (n_events_processed < event_limit) {
+      // each stream speculatively attempts the try after the ones of the
+      // streams before it, with the event number it would be given if those
+      // tries end as predicted
+      int n_predicted{n_events_processed}, n_tries_predicted{numTries};
+      for (std::size_t i_stream{0}; i_stream < streams_.size(); i_stream++) {
+        Stream *stream{streams_[i_stream]};
+        stream->try_number = totalTries + static_cast<int>(i_stream);
+        stream->event_number = n_predicted + 1;
+        ldmx::EventHeader &eh = stream->event.getEventHeader();
+        eh.setRun(runForGeneration_);
+        eh.setEventNumber(stream->event_number);
+        eh.setTimestamp(TTimeStamp());
+
+        n_tries_predicted++;
+        if (predict_completed) n_tries_predicted = 0;
+        if (predict_completed or
+            (totalEvents_ < 0 and n_tries_predicted % maxTries_ == 0)) {
+          n_predicted++;
+        }
+      }
+
+      processStreams(n_events_processed, numTries + 1, streams_.size());
+
+      // merge the tries in order so the output doesn't depend on
+      // which thread finished first
+      for (Stream *stream : streams_) {
+        if (n_events_processed >= event_limit) break;
+        // a try processed with the wrong event number is dropped along with
+        //  the ones after it, they are attempted again in the next batch
+        //  with the same try numbers
+        if (stream->event_number != n_events_processed + 1) break;
+        predict_completed = stream->completed;
+        totalTries++;
+        numTries++;
+
+        if (stream->completed) theEvent.merge(stream->event);
+        theEvent.getEventHeader().setEventNumber(stream->event_number);
+        logging::Formatter::set(theEvent.getEventNumber());
+
+        outFile.nextEvent(stream->storage.keepEvent(stream->completed));
+
+        if (stream->completed) numTries = 0;
+
+        if (stream->completed or
+            (totalEvents_ < 0 and numTries % maxTries_ == 0)) {
+          n_events_processed++;
+          NtupleManager::getInstance().fill();
+        }
+
+        NtupleManager::getInstance().clear();
+      }
+
+      for (Stream *stream : streams_) stream->event.Clear();
+    }
+
+    onFileClose(outFile);
+
+    runHeader.setRunEnd(std::time(nullptr));
+    runHeader.setNumTries(totalTries);
+    ldmx_log(info) << runHeader;
+    outFile.writeRunTree();
+
+    if (n_events_processed < totalTries / 10000) {  // integer division is okay
+      ldmx_log(warn)
+          << "Less than 1 event out of every 10k events tried was accepted!";
+      ldmx_log(warn)
+          << "This could be an issue with your filtering and biasing procedure "
+             "since this is incredibly inefficient.";
+    }
+
+  } else {
+    // there are input files
+    EventFile *outFile(0);
+
+    bool singleOutput = false;
+    if (outputFiles_.size() == 1) {
+      singleOutput = true;
+    } else if (!outputFiles_.empty() and
+               outputFiles_.size() != inputFiles_.size()) {
+      EXCEPTION_RAISE("Process",
+                      "Unable to handle case of different number of input and "
+                      "output files (other than zero/one ouput file).");
+    }
+
+    int ifile = 0;
+    int wasRun = -1;
+    for (auto infilename : inputFiles_) {
+      EventFile inFile(config_, infilename);
+      if (inFile.isCorrupted()) {
+        if (skipCorruptedInputFiles_) {
+          ldmx_log(warn) << "Input file '" << infilename
+                         << "' was found to be corrupted. Skipping.";
+          continue;
+        } else {
+          EXCEPTION_RAISE(
+              "BadCode",
+              "We should never get here. "
+              "EventFile is corrupted but we aren't skipping corrupted inputs. "
+              "EventFile should be throwing its own exceptions in this case.");
+        }
+      }
+
+      ldmx_log(info) << "Opening file " << infilename;
+      onFileOpen(inFile);
+
+      // each stream reads the events it processes from its own
+      // handle on the input file
+      for (Stream *stream : streams_) {
+        stream->input = new EventFile(config_, infilename);
+        stream->input->setupEvent(&stream->event);
+      }
+
+      // the input file is only read by theEvent if there is an output
+      // file to copy the input branches into
+      EventFile *masterFile{&inFile};
+      if (!outputFiles_.empty()) {
+        if (!singleOutput or ifile == 0) {
+          outFile = new EventFile(config_, outputFiles_[ifile], &inFile,
+                                  singleOutput);
+          ifile++;
+          outFile->setupEvent(&theEvent);
+          for (auto rule : dropKeepRules_) outFile->addDrop(rule);
+        } else {
+          outFile->updateParent(&inFile);
+        }
+        masterFile = outFile;
+      }
+
+      const long int n_entries{inFile.getNumEntries()};
+      long int entry{0};
+      bool keep_previous{true};
+      while (entry < n_entries and
+             (eventLimit_ < 0 || n_events_processed < eventLimit_)) {
+        // load the next entries into the streams, stopping at the end
+        // of the file, the event limit, or the start of a new run
+        std::size_t n_loaded{0};
+        for (Stream *stream : streams_) {
+          int n_events{n_events_processed + static_cast<int>(n_loaded)};
+          long int stream_entry{entry + static_cast<long int>(n_loaded)};
+          if (stream_entry >= n_entries or
+              (eventLimit_ >= 0 and n_events >= eventLimit_)) {
+            break;
+          }
+          stream->try_number = n_events;
+          stream->input->skipToEvent(stream_entry);
+          stream->input->nextEvent();
+          int run{stream->event.getEventHeader().getRun()};
+          if (run != wasRun) {
+            // finish the events from the previous run before starting
+            // the new one, this entry is read again in the next batch
+            if (n_loaded > 0) break;
+            wasRun = run;
+            // make the header available to the conditions system
+            theEvent.getEventHeader() = stream->event.getEventHeader();
+            ldmx::RunHeader *rh{masterFile->getRunHeaderPtr(wasRun)};
+            if (rh != nullptr) {
+              runHeader_ = rh;
+              ldmx_log(info) << "Got new run header from '"
+                             << masterFile->getFileName() << "' ...\n"
+                             << *runHeader_;
+              newRun(*runHeader_);
+            } else {
+              ldmx_log(warn)
+                  << "Run header for run " << wasRun << " was not found!";
+            }
+          }
+          n_loaded++;
+        }
+
+        processStreams(n_events_processed, 1, n_loaded);
+
+        // merge the streams in order so the output follows the input
+        for (std::size_t i_stream{0}; i_stream < n_loaded; i_stream++) {
+          Stream *stream{streams_[i_stream]};
+          if (outFile) {
+            outFile->nextEvent(keep_previous);
+            if (stream->completed) theEvent.merge(stream->event);
+            keep_previous = stream->storage.keepEvent(stream->completed);
+          }
+          logging::Formatter::set(stream->event.getEventNumber());
+
+          if (stream->completed) NtupleManager::getInstance().fill();
+          NtupleManager::getInstance().clear();
+
+          stream->event.Clear();
+          n_events_processed++;
+        }
+        entry += n_loaded;
+      }  // loop through events
+
+      // store the last event merged from this file
+      if (outFile and entry > 0) outFile->nextEvent(keep_previous);
+
+      bool leave_early{false};
+      if (eventLimit_ > 0 && n_events_processed == eventLimit_) {
+        ldmx_log(info) << "Reached event limit of " << eventLimit_ << " events";
+        leave_early = true;
+      }
+
+      if (eventLimit_ == 0 && n_events_processed > eventLimit_) {
+        ldmx_log(warn) << "Processing interrupted";
+        leave_early = true;
+      }
+
+      double read_time{0.}, lazy_read_time{0.};
+      for (Stream *stream : streams_) {
+        read_time += stream->input->getReadTime();
+        lazy_read_time += stream->event.getLazyReadTime();
+      }
+      ldmx_log(info) << "Spent " << read_time << "s reading entries and "
+                     << lazy_read_time
+                     << "s loading branches on demand from " << infilename
+                     << " summed over all streams";
+      ldmx_log(info) << "Closing file " << infilename;
+      onFileClose(inFile);
+
+      theEvent.onEndOfFile();
+      for (Stream *stream : streams_) {
+        stream->event.onEndOfFile();
+        delete stream->input;
+        stream->input = nullptr;
+      }
+
+      if (outFile and !singleOutput) {
+        outFile->writeRunTree();
+        delete outFile;
+        outFile = nullptr;
+      }
+
+      if (leave_early) {
+        break;
+      }
+    }  // loop through input files
+
+    if (outFile) {
+      outFile->writeRunTree();
+      delete outFile;
+      outFile = nullptr;
+    }
+  }  // are there input files? if-else tree
+}
+
+void Process::processStreams(int n, int n_try, std::size_t n_streams) {
+  std::vector<std::future<void>> threads;
+  threads.reserve(n_streams);
+  for (std::size_t i_stream{0}; i_stream < n_streams; i_stream++) {
+    Stream *stream{streams_[i_stream]};
+    int i_event{n + static_cast<int>(i_stream)};
+    threads.push_back(std::async(std::launch::async, [this, stream, i_event,
+                                                      n_try]() {
+      current_stream_ = stream;
+      stream->storage.resetEventState();
+      stream->completed =
+          process(i_event, n_try, stream->event, stream->sequence);
+      current_stream_ = nullptr;
+    }));
+  }
+  // wait for every stream to finish before re-throwing any exception
+  // so that none of the threads are left using the streams
+  for (auto &thread : threads) thread.wait();
+  for (auto &thread : threads) thread.get();
+}
+
+const ldmx::EventHeader *Process::getEventHeader() const {
+  if (current_stream_) return current_stream_->event.getEventHeaderPtr();
+  return eventHeader_;
+}
+
+int Process::getTryNumber() const {
+  if (current_stream_) return current_stream_->try_number;
+  return tryNumber_;
+}
+
+StorageControl &Process::getStorageController() {
+  if (current_stream_) return current_stream_->storage;
+  return storageController_;
+}
+
 int Process::getRunNumber() const {
-  return (eventHeader_) ? (eventHeader_->getRun()) : (runForGeneration_);
+  const ldmx::EventHeader *header{getEventHeader()};
+  return (header) ? (header->getRun()) : (runForGeneration_);
 }
 
 TDirectory *Process::makeHistoDirectory(const std::string &dirName) {
@@ -479,9 +909,17 @@ void Process::newRun(ldmx::RunHeader &header) {
       performance_->stop(performance::Callback::onNewRun, i_proc);
   }
   if (performance_) performance_->stop(performance::Callback::onNewRun, 0);
+  for (std::size_t i_stream{1}; i_stream < streams_.size(); i_stream++) {
+    for (auto module : streams_[i_stream]->sequence) module->onNewRun(header);
+  }
 }
 
 bool Process::process(int n, int n_try, Event &event) const {
+  return process(n, n_try, event, sequence_);
+}
+
+bool Process::process(int n, int n_try, Event &event,
+                      const std::vector<EventProcessor *> &sequence) const {
   if ((logFrequency_ != -1) && ((n + 1) % logFrequency_ == 0) && (n_try < 2)) {
     // only printout event counter if we've enabled log frequency, the event
     // matches the frequency and we are on the first try
@@ -495,7 +933,7 @@ bool Process::process(int n, int n_try, Event &event) const {
   if (performance_) performance_->start(performance::Callback::process, 0);
   std::size_t i_proc{0};
   try {
-    for (auto module : sequence_) {
+    for (auto module : sequence) {
       i_proc++;
       if (performance_)
         performance_->start(performance::Callback::process, i_proc);
@@ -534,6 +972,9 @@ void Process::onFileOpen(EventFile &file) const {
       performance_->stop(performance::Callback::onFileOpen, i_proc);
   }
   if (performance_) performance_->stop(performance::Callback::onFileOpen, 0);
+  for (std::size_t i_stream{1}; i_stream < streams_.size(); i_stream++) {
+    for (auto module : streams_[i_stream]->sequence) module->onFileOpen(file);
+  }
 }
 
 void Process::onFileClose(EventFile &file) const {
@@ -548,6 +989,9 @@ void Process::onFileClose(EventFile &file) const {
       performance_->stop(performance::Callback::onFileClose, i_proc);
   }
   if (performance_) performance_->stop(performance::Callback::onFileClose, 0);
+  for (std::size_t i_stream{1}; i_stream < streams_.size(); i_stream++) {
+    for (auto module : streams_[i_stream]->sequence) module->onFileClose(file);
+  }
 }
 
 }  // namespace framework
@@ -56,6 +56,7 @@ void RandomNumberSeedService::onNewRun(ldmx::RunHeader& rh) {
 }
 
 uint64_t RandomNumberSeedService::getSeed(const std::string& name) const {
+  std::lock_guard<std::mutex> lock{seeds_mutex_};
   uint64_t seed(0);
   std::map<std::string, uint64_t>::const_iterator i = seeds_.find(name);
   if (i == seeds_.end()) {
@@ -70,7 +71,17 @@ uint64_t RandomNumberSeedService::getSeed(const std::string& name) const {
   return seed;
 }
 
+uint64_t RandomNumberSeedService::getSeed(const std::string& name,
+                                          uint64_t substream) const {
+  // splitmix64 finalizer of the named seed offset by the substream
+  uint64_t seed = getSeed(name) + (substream + 1) * 0x9E3779B97F4A7C15ull;
+  seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+  seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+  return seed ^ (seed >> 31);
+}
+
 std::vector<std::string> RandomNumberSeedService::getSeedNames() const {
+  std::lock_guard<std::mutex> lock{seeds_mutex_};
   std::vector<std::string> rv;
   for (auto i : seeds_) {
     rv.push_back(i.first);
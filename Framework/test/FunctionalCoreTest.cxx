@@ -6,6 +6,7 @@
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
 #include "Framework/Process.h"
+#include "Framework/ProductHandle.h"
 #include "Framework/RunHeader.h"
 #include "Hcal/Event/HcalHit.h"
 #include "Hcal/Event/HcalVetoResult.h"
@@ -103,6 +104,7 @@ class TestProducer : public Producer {
  * - the correct number and contents following the pattern produced by
  * TestProducer.
  * - Event::getCollection and Event::getObject don't throw errors.
+ * - ProductHandle refers to the same object as Event::getCollection.
  */
 class TestAnalyzer : public Analyzer {
  public:
@@ -147,12 +149,20 @@ class TestAnalyzer : public Analyzer {
     CHECK(i_event_from_bus.at(0) == i_event);
     CHECK(i_event_from_bus.at(1) == i_event);
 
+    const std::vector<int>* from_handle{nullptr};
+    REQUIRE_NOTHROW(from_handle = &event_index_.get(event));
+    CHECK(from_handle == &i_event_from_bus);
+    CHECK(event_index_.isResolved(event));
+
     return;
   }
 
  private:
   /// test histogram filled with event indices
   TH1F* test_hist_;
+
+  /// handle to the event indices on the bus
+  ProductHandle<std::vector<int>> event_index_{"EventIndex"};
 };  // TestAnalyzer
 
 /**
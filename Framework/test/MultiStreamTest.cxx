@@ -0,0 +1,481 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>  //for remove
+#include <memory>
+#include <thread>
+
+#include "Framework/ConditionsObjectProvider.h"
+#include "Framework/EventProcessor.h"
+#include "Framework/Exception/Exception.h"
+#include "Framework/Process.h"
+#include "Framework/RandomNumberSeedService.h"
+#include "Framework/RunHeader.h"
+#include "TFile.h"        //to open and check root files
+#include "TTreeReader.h"  //to check output event files
+
+namespace framework {
+namespace test {
+
+/**
+ * @class StreamProducer
+ * Producer that can be cloned into the event streams.
+ *
+ * The collection it puts on the bus for each event is
+ * {event number, run number from onNewRun, event number squared}
+ * so that the output does not depend on which stream processed
+ * the event. Even events are marked as ones to keep for skimming.
+ */
+class StreamProducer : public Producer {
+ public:
+  StreamProducer(const std::string& name, Process& p) : Producer(name, p) {}
+
+  void onNewRun(const ldmx::RunHeader& header) final override {
+    run_ = header.getRunNumber();
+  }
+
+  void produce(framework::Event& event) final override {
+    int i_event = event.getEventNumber();
+    std::vector<int> collection = {i_event, run_, i_event * i_event};
+    event.add("StreamCollection", collection);
+    if (i_event % 2 == 0) setStorageHint(StorageControl::Hint::MustKeep);
+  }
+
+  bool isClonable() const final override { return true; }
+
+ private:
+  /// run number given to onNewRun
+  int run_{-1};
+};  // StreamProducer
+
+/**
+ * @class StreamAnalyzer
+ * Analyzer that can be cloned into the event streams.
+ *
+ * Catch2 assertions cannot be made from more than one thread, so the
+ * analyzer throws if the collection from the StreamProducer does not
+ * belong to the event it is looking at. The exception is re-thrown on
+ * the main thread by Process::run.
+ */
+class StreamAnalyzer : public Analyzer {
+ public:
+  StreamAnalyzer(const std::string& name, Process& p) : Analyzer(name, p) {}
+
+  void configure(framework::config::Parameters& p) final override {
+    pass_ = p.getParameter<std::string>("pass");
+  }
+
+  void analyze(const framework::Event& event) final override {
+    const auto& collection{event.getCollection<int>("StreamCollection", pass_)};
+    int i_event = event.getEventNumber();
+    if (collection.size() != 3 or collection.at(0) != i_event or
+        collection.at(2) != i_event * i_event) {
+      EXCEPTION_RAISE("BadEvent", "Event " + std::to_string(i_event) +
+                                      " does not have its own collection.");
+    }
+  }
+
+  bool isClonable() const final override { return true; }
+
+ private:
+  /// pass the collection was produced in
+  std::string pass_;
+};  // StreamAnalyzer
+
+/**
+ * @class TryProducer
+ * Producer that aborts some of its tries and can be cloned into the streams.
+ *
+ * Whether a try is aborted only depends on the seed for the try, so the
+ * same tries are aborted no matter how many threads there are. The
+ * collection it puts on the bus for the tries that are not aborted is
+ * {event number, try number, seed for the try cut down to an int}.
+ */
+class TryProducer : public Producer {
+ public:
+  TryProducer(const std::string& name, Process& p) : Producer(name, p) {}
+
+  void produce(framework::Event& event) final override {
+    const auto& rseed{getCondition<RandomNumberSeedService>(
+        RandomNumberSeedService::CONDITIONS_OBJECT_NAME)};
+    uint64_t seed{rseed.getSeed("TryProducer", getTryNumber())};
+    if (seed % 3 == 0) abortEvent();
+    std::vector<int> collection = {event.getEventNumber(), getTryNumber(),
+                                   static_cast<int>(seed % 1000000)};
+    event.add("TryCollection", collection);
+  }
+
+  bool isClonable() const final override { return true; }
+};  // TryProducer
+
+/**
+ * @class RunCondition
+ * Condition holding the run it was made for.
+ */
+class RunCondition : public ConditionsObject {
+ public:
+  RunCondition(int run) : ConditionsObject("RunCondition"), run_{run} {}
+  /// run the condition was made for
+  int run_;
+  /// set once the conditions system is done with the condition
+  mutable std::atomic<bool> released_{false};
+};  // RunCondition
+
+/**
+ * @class RunConditionProvider
+ * Provider making a new RunCondition for every run.
+ *
+ * The released conditions are only marked as such and kept around
+ * so that using one after it was released can be caught.
+ */
+class RunConditionProvider : public ConditionsObjectProvider {
+ public:
+  RunConditionProvider(const std::string& name, const std::string& tagname,
+                       const framework::config::Parameters& parameters,
+                       Process& process)
+      : ConditionsObjectProvider(name, tagname, parameters, process) {}
+
+  std::pair<const ConditionsObject*, ConditionsIOV> getCondition(
+      const ldmx::EventHeader& context) final override {
+    conditions_.push_back(std::make_unique<RunCondition>(context.getRun()));
+    return {conditions_.back().get(),
+            ConditionsIOV(context.getRun(), context.getRun(), true, true)};
+  }
+
+  void releaseConditionsObject(const ConditionsObject* co) final override {
+    dynamic_cast<const RunCondition*>(co)->released_ = true;
+  }
+
+ private:
+  /// all of the conditions that were made
+  std::vector<std::unique_ptr<RunCondition>> conditions_;
+};  // RunConditionProvider
+
+/**
+ * @class RunConditionProducer
+ * Producer using the RunCondition for the whole event.
+ *
+ * The producer waits after getting the condition so that the other
+ * streams can get theirs in the mean time. It throws if the condition
+ * is not for the run of its event or was released before it was done.
+ */
+class RunConditionProducer : public Producer {
+ public:
+  RunConditionProducer(const std::string& name, Process& p)
+      : Producer(name, p) {}
+
+  void produce(framework::Event& event) final override {
+    const auto& condition{getCondition<RunCondition>("RunCondition")};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (condition.released_ or
+        condition.run_ != event.getEventHeader().getRun()) {
+      EXCEPTION_RAISE("BadCondition",
+                      "Event " + std::to_string(event.getEventNumber()) +
+                          " does not have the condition for its run.");
+    }
+  }
+
+  bool isClonable() const final override { return true; }
+};  // RunConditionProducer
+
+/**
+ * @class UnclonableProducer
+ * Producer that has not declared it can be cloned.
+ */
+class UnclonableProducer : public Producer {
+ public:
+  UnclonableProducer(const std::string& name, Process& p)
+      : Producer(name, p) {}
+  void produce(framework::Event&) final override {}
+};  // UnclonableProducer
+
+/**
+ * @func readEvents
+ * Read the events in an event file in the order they were written
+ *
+ * Each event is its number and run followed by the contents of the
+ * collection in the input branch.
+ */
+static std::vector<std::vector<int>> readEvents(const std::string& filename,
+                                                const std::string& branch) {
+  std::vector<std::vector<int>> events;
+  TFile* f = TFile::Open(filename.c_str());
+  if (!f) return events;
+  TTreeReader reader("LDMX_Events", f);
+  TTreeReaderValue<ldmx::EventHeader> header(reader, "EventHeader");
+  TTreeReaderValue<std::vector<int>> collection(reader, branch.c_str());
+  while (reader.Next()) {
+    std::vector<int> event = {header->getEventNumber(), header->getRun()};
+    event.insert(event.end(), collection->begin(), collection->end());
+    events.push_back(event);
+  }
+  f->Close();
+  return events;
+}
+
+/**
+ * @func runWithThreads
+ * Run the process for the input parameters with the number of threads
+ */
+static void runWithThreads(std::map<std::string, std::any> parameters,
+                           int n_threads) {
+  parameters["numThreads"] = n_threads;
+  framework::config::Parameters configuration;
+  configuration.setParameters(parameters);
+  Process p(configuration);
+  p.run();
+}
+
+}  // namespace test
+}  // namespace framework
+
+DECLARE_PRODUCER_NS(framework::test, StreamProducer)
+DECLARE_ANALYZER_NS(framework::test, StreamAnalyzer)
+DECLARE_PRODUCER_NS(framework::test, TryProducer)
+DECLARE_PRODUCER_NS(framework::test, RunConditionProducer)
+DECLARE_CONDITIONS_PROVIDER_NS(framework::test, RunConditionProvider)
+DECLARE_PRODUCER_NS(framework::test, UnclonableProducer)
+
+/**
+ * Test for processing events in several streams.
+ *
+ * The same sequence is run with one thread and with several, and the
+ * output files have to have the same events in the same order.
+ *
+ * What does this test?
+ *  - Production Mode with a number of events that does not fill the
+ *    last batch of streams
+ *  - skimming with storage hints set in the streams
+ *  - Production Mode with aborted tries, the events are numbered and
+ *    seeded by their try like they are with one thread
+ *  - reading several input files with different runs into one output file
+ *  - stopping at the event limit in the middle of an input file
+ *  - streams processing events of different runs at the same time each
+ *    keep the conditions for their own run
+ *  - rejecting processors that are not clonable
+ */
+TEST_CASE("Multi-Stream Processing", "[Framework][functionality]") {
+  std::map<std::string, std::any> process;
+  process["passName"] = std::string("make");
+  process["compressionSetting"] = 9;
+  process["maxTriesPerEvent"] = 1;
+  process["logFrequency"] = -1;
+  process["termLogLevel"] = 4;
+  process["fileLogLevel"] = 4;
+  process["logFileName"] = std::string();
+  process["tree_name"] = std::string("LDMX_Events");
+  process["histogramFile"] = std::string("");
+  process["skimDefaultIsKeep"] = true;
+  process["run"] = 5;
+
+  std::map<std::string, std::any> producerParameters;
+  producerParameters["className"] =
+      std::string("framework::test::StreamProducer");
+  producerParameters["instanceName"] = std::string("StreamProducer");
+
+  std::map<std::string, std::any> analyzerParameters;
+  analyzerParameters["className"] =
+      std::string("framework::test::StreamAnalyzer");
+  analyzerParameters["instanceName"] = std::string("StreamAnalyzer");
+  analyzerParameters["pass"] = std::string("make");
+
+  framework::config::Parameters producerConfig, analyzerConfig;
+  producerConfig.setParameters(producerParameters);
+  analyzerConfig.setParameters(analyzerParameters);
+  std::vector<framework::config::Parameters> sequence = {producerConfig,
+                                                         analyzerConfig};
+  process["sequence"] = sequence;
+
+  SECTION("Production Mode") {
+    process["maxEvents"] = 10;
+    std::size_t n_expected{10};
+
+    SECTION("keep all events") {}
+
+    SECTION("skim for even events") {
+      process["skimDefaultIsKeep"] = false;
+      std::vector<std::string> rules = {"StreamProducer", ""};
+      process["skimRules"] = rules;
+      n_expected = 5;
+    }
+
+    std::vector<std::string> outputFiles = {"test_streams_production_1.root"};
+    process["outputFiles"] = outputFiles;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 1));
+    auto expected{framework::test::readEvents(outputFiles.at(0),
+                                              "StreamCollection_make")};
+    CHECK(remove(outputFiles.at(0).c_str()) == 0);
+
+    REQUIRE(expected.size() == n_expected);
+    for (std::size_t i{0}; i < n_expected; i++) {
+      int i_event = (n_expected == 10) ? (i + 1) : (2 * i + 2);
+      CHECK(expected.at(i).at(0) == i_event);
+    }
+
+    outputFiles = {"test_streams_production_4.root"};
+    process["outputFiles"] = outputFiles;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 4));
+    CHECK(framework::test::readEvents(outputFiles.at(0),
+                                      "StreamCollection_make") == expected);
+    CHECK(remove(outputFiles.at(0).c_str()) == 0);
+  }  // Production Mode
+
+  SECTION("Production Mode with aborted tries") {
+    std::map<std::string, std::any> tryParameters;
+    tryParameters["className"] = std::string("framework::test::TryProducer");
+    tryParameters["instanceName"] = std::string("TryProducer");
+    framework::config::Parameters tryConfig;
+    tryConfig.setParameters(tryParameters);
+    process["sequence"] = std::vector<framework::config::Parameters>{tryConfig};
+
+    std::map<std::string, std::any> seedParameters;
+    seedParameters["className"] =
+        std::string("framework::RandomNumberSeedService");
+    seedParameters["objectName"] = std::string("RandomNumberSeedService");
+    seedParameters["tagName"] = std::string("");
+    seedParameters["seedMode"] = std::string("external");
+    seedParameters["masterSeed"] = 7;
+    framework::config::Parameters seedConfig;
+    seedConfig.setParameters(seedParameters);
+    process["conditionsObjectProviders"] =
+        std::vector<framework::config::Parameters>{seedConfig};
+
+    // some event numbers are given up on after two aborted tries
+    process["maxEvents"] = 20;
+    process["maxTriesPerEvent"] = 2;
+
+    std::vector<std::string> outputFiles = {"test_streams_tries_1.root"};
+    process["outputFiles"] = outputFiles;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 1));
+    auto expected{framework::test::readEvents(outputFiles.at(0),
+                                              "TryCollection_make")};
+    CHECK(remove(outputFiles.at(0).c_str()) == 0);
+
+    REQUIRE(expected.size() > 1);
+    bool aborted{false};
+    for (std::size_t i{0}; i < expected.size(); i++) {
+      // the event was processed with the number it was written with
+      CHECK(expected.at(i).at(2) == expected.at(i).at(0));
+      if (i > 0 and expected.at(i).at(3) > expected.at(i - 1).at(3) + 1) {
+        aborted = true;
+      }
+    }
+    REQUIRE(aborted);
+
+    for (int n_threads : {2, 4}) {
+      outputFiles = {"test_streams_tries_" + std::to_string(n_threads) +
+                     ".root"};
+      process["outputFiles"] = outputFiles;
+      REQUIRE_NOTHROW(framework::test::runWithThreads(process, n_threads));
+      CHECK(framework::test::readEvents(outputFiles.at(0),
+                                        "TryCollection_make") == expected);
+      CHECK(remove(outputFiles.at(0).c_str()) == 0);
+    }
+  }  // Production Mode with aborted tries
+
+  SECTION("Need Input Files") {
+    std::vector<std::string> inputFiles = {"test_streams_input_run1.root",
+                                           "test_streams_input_run2.root"};
+
+    std::vector<std::string> outputFiles = {inputFiles.at(0)};
+    process["outputFiles"] = outputFiles;
+    process["maxEvents"] = 5;
+    process["run"] = 1;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 1));
+
+    outputFiles = {inputFiles.at(1)};
+    process["outputFiles"] = outputFiles;
+    process["maxEvents"] = 6;
+    process["run"] = 2;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 1));
+
+    // re-process the inputs into one output file in a new pass
+    process["passName"] = std::string("copy");
+    process["inputFiles"] = inputFiles;
+    process["maxEvents"] = -1;
+    process["run"] = -1;
+    std::size_t n_expected{5 + 6};
+
+    SECTION("all events") {}
+
+    SECTION("stop in the second file") {
+      process["maxEvents"] = 8;
+      n_expected = 8;
+    }
+
+    outputFiles = {"test_streams_copy_1.root"};
+    process["outputFiles"] = outputFiles;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 1));
+    auto expected{framework::test::readEvents(outputFiles.at(0),
+                                              "StreamCollection_copy")};
+    auto expected_input{framework::test::readEvents(outputFiles.at(0),
+                                                    "StreamCollection_make")};
+    CHECK(remove(outputFiles.at(0).c_str()) == 0);
+
+    REQUIRE(expected.size() == n_expected);
+    CHECK(expected == expected_input);
+    // the producer was told about the run of each event before it
+    for (const auto& event : expected) CHECK(event.at(3) == event.at(1));
+    CHECK(expected.at(4).at(1) == 1);
+    CHECK(expected.at(5).at(1) == 2);
+
+    outputFiles = {"test_streams_copy_3.root"};
+    process["outputFiles"] = outputFiles;
+    REQUIRE_NOTHROW(framework::test::runWithThreads(process, 3));
+    CHECK(framework::test::readEvents(outputFiles.at(0),
+                                      "StreamCollection_copy") == expected);
+    CHECK(framework::test::readEvents(outputFiles.at(0),
+                                      "StreamCollection_make") == expected);
+
+    // the copy has both runs in one file, so some batches of the streams
+    //  hold events from both runs
+    std::map<std::string, std::any> conditionParameters;
+    conditionParameters["className"] =
+        std::string("framework::test::RunConditionProducer");
+    conditionParameters["instanceName"] = std::string("RunConditionProducer");
+    std::map<std::string, std::any> providerParameters;
+    providerParameters["className"] =
+        std::string("framework::test::RunConditionProvider");
+    providerParameters["objectName"] = std::string("RunCondition");
+    providerParameters["tagName"] = std::string("");
+    framework::config::Parameters conditionConfig, providerConfig;
+    conditionConfig.setParameters(conditionParameters);
+    providerConfig.setParameters(providerParameters);
+    process["passName"] = std::string("conditions");
+    process["sequence"] =
+        std::vector<framework::config::Parameters>{conditionConfig};
+    process["conditionsObjectProviders"] =
+        std::vector<framework::config::Parameters>{providerConfig};
+    process["inputFiles"] = outputFiles;
+    process["outputFiles"] = std::vector<std::string>();
+    process["maxEvents"] = -1;
+    CHECK_NOTHROW(framework::test::runWithThreads(process, 3));
+    CHECK(remove(outputFiles.at(0).c_str()) == 0);
+
+    for (const auto& f : inputFiles) CHECK(remove(f.c_str()) == 0);
+  }  // Need Input Files
+
+  SECTION("Processors have to be clonable") {
+    std::map<std::string, std::any> unclonableParameters;
+    unclonableParameters["className"] =
+        std::string("framework::test::UnclonableProducer");
+    unclonableParameters["instanceName"] = std::string("UnclonableProducer");
+    framework::config::Parameters unclonableConfig;
+    unclonableConfig.setParameters(unclonableParameters);
+    sequence.push_back(unclonableConfig);
+    process["sequence"] = sequence;
+    process["maxEvents"] = 1;
+    std::vector<std::string> outputFiles = {"test_streams_unclonable.root"};
+    process["outputFiles"] = outputFiles;
+    framework::config::Parameters configuration;
+
+    process["numThreads"] = 1;
+    configuration.setParameters(process);
+    CHECK_NOTHROW(framework::Process(configuration));
+
+    process["numThreads"] = 2;
+    configuration.setParameters(process);
+    CHECK_THROWS_AS(framework::Process(configuration),
+                    framework::exception::Exception);
+  }
+}  // multi-stream test
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Framework/Event.h"
+#include "Framework/Exception/Exception.h"
+
+/**
+ * Test for searching the products of an event.
+ *
+ * What does this test?
+ *  - full-string matches of plain names go through the name index and
+ *    ignore the case of the letters like the regex search does
+ *  - sub-string and regex searches are still case-insensitive
+ *  - products added after a search are found by the next search
+ *  - invalid regex are reported
+ */
+TEST_CASE("Product Search", "[Framework][functionality]") {
+  framework::Event event("test");
+  event.add("EcalRecHits", std::vector<int>{1, 2, 3});
+  event.add("HcalRecHits", std::vector<int>{4, 5});
+  event.add("EcalVeto", 0.5f);
+
+  SECTION("full-string matches of plain names") {
+    CHECK(event.exists("EcalRecHits"));
+    CHECK(event.exists("ecalrechits"));
+    CHECK(event.exists("ECALRECHITS", "TEST"));
+    CHECK_FALSE(event.exists("EcalRecHits", "other"));
+    CHECK_FALSE(event.exists("EcalRec"));
+    CHECK_FALSE(event.exists("EcalRecHitsAndMore"));
+    CHECK(event.searchProducts("hcalrechits", "", "", true).size() == 1);
+    CHECK(event.searchProducts("ecalveto", "TeSt", "", true).size() == 1);
+  }
+
+  SECTION("sub-string and regex matches") {
+    CHECK(event.searchProducts("rechits", "", "", false).size() == 2);
+    CHECK(event.searchProducts("^ecal", "", "", false).size() == 2);
+    CHECK(event.searchProducts("ecal.*", "", "", true).size() == 2);
+    CHECK(event.searchProducts("", "Te", "", false).size() == 3);
+    CHECK(event.searchProducts("", "Te", "", true).empty());
+  }
+
+  SECTION("products added after a search") {
+    CHECK_FALSE(event.exists("TrigScintHits"));
+    event.add("TrigScintHits", std::vector<int>{6});
+    CHECK(event.exists("trigscinthits"));
+    CHECK(event.searchProducts("hits", "", "", false).size() == 3);
+  }
+
+  SECTION("invalid regex") {
+    CHECK_THROWS_AS(event.searchProducts("(", "", "", false),
+                    framework::exception::Exception);
+  }
+}
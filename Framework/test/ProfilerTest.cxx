@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include "Framework/Performance/Profiler.h"
+
+namespace framework {
+namespace test {
+
+/**
+ * @func readFolded
+ * Read the folded stacks into a map from the stack to its time
+ */
+static std::map<std::string, long int> readFolded(
+    const performance::Profiler& profiler) {
+  std::stringstream folded;
+  profiler.writeFoldedStacks(folded);
+  std::map<std::string, long int> stacks;
+  std::string stack;
+  long int time;
+  while (folded >> stack >> time) stacks[stack] = time;
+  return stacks;
+}
+
+/**
+ * @func countOf
+ * Count the number of times a sub-string appears in a string
+ */
+static std::size_t countOf(const std::string& str, const std::string& sub) {
+  std::size_t count{0};
+  for (auto pos{str.find(sub)}; pos != std::string::npos;
+       pos = str.find(sub, pos + sub.size())) {
+    count++;
+  }
+  return count;
+}
+
+/// sleep long enough that a region has a measurable self time
+static void work() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+}  // namespace test
+}  // namespace framework
+
+/**
+ * Test for the region profiler and its exporters.
+ *
+ * What does this test?
+ *  - names are interned to the same identifier
+ *  - nested regions are folded into stacks with their self time
+ *  - regions opened by name and by identifier are the same region
+ *  - regions from several threads are combined
+ *  - Chrome trace has one event per region, escaped names and only has
+ *    the usage of the regions if it was measured
+ *  - regions beyond the trace limit are counted instead of kept
+ */
+TEST_CASE("Profiler", "[Framework][performance]") {
+  using framework::performance::Profiler;
+  using framework::performance::ScopedTimer;
+  Profiler& profiler{Profiler::get()};
+  profiler.reset();
+
+  auto outer{profiler.intern("outer")};
+  auto inner{profiler.intern("inner")};
+  CHECK(profiler.intern("outer") == outer);
+  CHECK(profiler.intern("inner") != outer);
+  CHECK(profiler.name(inner) == "inner");
+
+  SECTION("folded stacks") {
+    profiler.enable();
+    profiler.begin(outer);
+    framework::test::work();
+    for (int i{0}; i < 2; i++) {
+      profiler.begin(inner);
+      framework::test::work();
+      profiler.end();
+    }
+    profiler.end();
+    {
+      ScopedTimer timer{"outer"};
+      timer.next("inner");
+      framework::test::work();
+    }
+
+    std::thread other([&profiler, outer]() {
+      profiler.begin(outer);
+      framework::test::work();
+      profiler.end();
+    });
+    other.join();
+
+    auto stacks{framework::test::readFolded(profiler)};
+    REQUIRE(stacks.size() == 3);
+    REQUIRE(stacks.count("outer") == 1);
+    REQUIRE(stacks.count("outer;inner") == 1);
+    REQUIRE(stacks.count("inner") == 1);
+    // two threads each spent time directly within outer
+    CHECK(stacks.at("outer") >= 2 * 2000);
+    CHECK(stacks.at("outer;inner") >= 2 * 2000);
+    CHECK(stacks.at("inner") >= 2000);
+
+    std::stringstream trace;
+    profiler.writeChromeTrace(trace);
+    // trace is not kept unless asked for
+    CHECK(framework::test::countOf(trace.str(), "\"ph\":\"X\"") == 0);
+  }
+
+  SECTION("chrome trace") {
+    auto quoted{profiler.intern("say \"hi\"")};
+    profiler.enable(true, false, 0);
+    profiler.begin(outer);
+    profiler.begin(quoted);
+    profiler.end();
+    profiler.end();
+    profiler.begin(inner);
+    profiler.end();
+
+    std::stringstream trace;
+    profiler.writeChromeTrace(trace);
+    std::string json{trace.str()};
+    CHECK(json.rfind("{\"traceEvents\":[", 0) == 0);
+    CHECK(framework::test::countOf(json, "\"ph\":\"X\"") == 3);
+    CHECK(framework::test::countOf(json, "\"name\":\"outer\"") == 1);
+    CHECK(framework::test::countOf(json, "\"name\":\"say \\\"hi\\\"\"") == 1);
+    CHECK(framework::test::countOf(json, "\"args\"") == 0);
+    CHECK(framework::test::countOf(json, "\"dropped_regions\":0}") == 1);
+
+    SECTION("with usage") {
+      profiler.reset();
+      profiler.enable(true, true, 0);
+      profiler.begin(outer);
+      profiler.end();
+      std::stringstream with_usage;
+      profiler.writeChromeTrace(with_usage);
+      CHECK(framework::test::countOf(with_usage.str(), "\"cpu_us\"") == 1);
+      CHECK(framework::test::countOf(with_usage.str(), "\"minor_faults\"") ==
+            1);
+    }
+
+    SECTION("limited") {
+      profiler.reset();
+      profiler.enable(true, false, 2);
+      for (int i{0}; i < 5; i++) {
+        profiler.begin(outer);
+        profiler.end();
+      }
+      std::stringstream limited;
+      profiler.writeChromeTrace(limited);
+      CHECK(framework::test::countOf(limited.str(), "\"ph\":\"X\"") == 2);
+      CHECK(framework::test::countOf(limited.str(),
+                                     "\"dropped_regions\":3}") == 1);
+    }
+  }
+
+  profiler.reset();
+}
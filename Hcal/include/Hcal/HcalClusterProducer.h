@@ -46,6 +46,9 @@ class HcalClusterProducer : public framework::Producer {
 
   void produce(framework::Event& event) override;
 
+  /// the clusters are built from scratch for each event
+  bool isClonable() const override { return true; }
+
  private:
   // double     EminSeed_{0.};
   double EnoiseCut_{0.};
@@ -59,9 +59,14 @@ class HcalRecProducer : public framework::Producer {
 
   /**
    * Gets Time of Arrival with respect to the SOI.
+   *
+   * @param[in] decoded samples of the digi collection
+   * @param[in] i_digi index of digi in the collection
+   * @param[in] pedestal ADC pedestal of the digi's channel
+   * @param[in] iSOI index of the sample of interest
    */
-  double getTOA(const ldmx::HgcrocDigiCollection::HgcrocDigi digi,
-                double pedestal, unsigned int iSOI) const;
+  double getTOA(const ldmx::HgcrocDigiCollection::DecodedSamples& decoded,
+                std::size_t i_digi, double pedestal, unsigned int iSOI) const;
 
   /**
    * Produce HcalHits and put them into the event bus using the
@@ -73,6 +78,9 @@ class HcalRecProducer : public framework::Producer {
    */
   void produce(framework::Event& event) override;
 
+  /// each hit is reconstructed from its digi and the conditions alone
+  bool isClonable() const override { return true; }
+
  private:
   /// Digi Collection Name to use as input
   std::string digiCollName_;
@@ -149,6 +157,9 @@ class HcalRecProducer : public framework::Producer {
 
   /// Time of Peak relative to pulse shape fit [ns]
   double timePeak_;
+
+  /// Buffer for the decoded digi samples, re-used each event
+  ldmx::HgcrocDigiCollection::DecodedSamples decoded_;
 };
 }  // namespace hcal
 
@@ -45,6 +45,9 @@ class HcalVetoProcessor : public framework::Producer {
    */
   void produce(framework::Event &event) override;
 
+  /// the veto only looks at the hits of the event it is deciding
+  bool isClonable() const override { return true; }
+
  private:
   /** Total PE threshold. */
   double totalPEThreshold_{5};
@@ -2,6 +2,8 @@
 #ifndef HCAL_MYCLUSTERWEIGHT_H_
 #define HCAL_MYCLUSTERWEIGHT_H_
 
+#include <array>
+#include <cmath>
 #include <iostream>
 
 #include "Hcal/WorkingCluster.h"
@@ -10,14 +12,31 @@ namespace hcal {
 
 class MyClusterWeight {
  public:
+  // Moliere radius of detector, roughly. In mm TODO
+  static constexpr double rmol = 10.00;
+  // lateral shower development in mm TODO
+  static constexpr double dzchar = 100.0;
+
+  /**
+   * Largest transverse and longitudinal distance between the centroids of
+   * two clusters with a weight below the cutoff
+   *
+   * This is padded so that the rounding in the weight never puts a pair
+   * outside of it.
+   *
+   * @param[in] cutoff weight cutoff
+   * @return transverse and longitudinal distance in mm
+   */
+  std::array<double, 2> reach(double cutoff) const {
+    return {1.001 * rmol * std::sqrt(std::log1p(cutoff)) + 0.01,
+            1.001 * dzchar * std::log1p(cutoff) + 1.};
+  }
+
   double operator()(
       const WorkingCluster& a,
       const WorkingCluster& b) {  // returns weighting function, where smallest
                                   // weights will be combined first
 
-    double rmol = 10.00;    // Moliere radius of detector, roughly. In mm TODO
-    double dzchar = 100.0;  // lateral shower development in mm TODO
-
     double aE = a.centroid().E();
     double aX = a.centroid().Px();
     double aY = a.centroid().Py();
@@ -1,10 +1,18 @@
-
 #ifndef HCAL_TEMPLATEDCLUSTERFINDER_H_
 #define HCAL_TEMPLATEDCLUSTERFINDER_H_
 
 #include <math.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "Hcal/WorkingCluster.h"
 #include "TH2F.h"
@@ -23,44 +31,74 @@ class TemplatedClusterFinder {
     return a.centroid().E() > b.centroid().E();
   }
 
+  /**
+   * Merge the pair of clusters with the smallest weight until no pair
+   * has a weight below the cutoff.
+   *
+   * Only the clusters above the seed threshold (which are in front after
+   * sorting) start a pair, and of two pairs with the same weight the one
+   * whose clusters come first is merged.
+   *
+   * The weights of the pairs below the cutoff are kept in a queue and
+   * only the pairs with the merged cluster are re-weighted after a merge.
+   * If the WeightClass knows how far apart two clusters with a weight
+   * below the cutoff can be, only the clusters that close are paired.
+   * The smallest weight of all pairs is only searched for once no pair
+   * below the cutoff is left, so that it is recorded as before.
+   */
   void cluster(double seed_threshold, double cutoff, double deltaTime) {
     int ncluster = clusters_.size();
     double minwgt = cutoff;
+
     std::sort(clusters_.begin(), clusters_.end(), compClusters);
+
+    // the clusters below the seed threshold never gain any energy, so only
+    // the clusters in front of them are seeds
+    const std::size_t nprefix =
+        std::find_if(clusters_.begin(), clusters_.end(),
+                     [seed_threshold](const WorkingCluster& c) {
+                       return c.centroid().E() < seed_threshold;
+                     }) -
+        clusters_.begin();
+    int nseeds = nprefix;
+
+    buildIndex(cutoff);
+    for (std::size_t i = 0; i < nprefix; i++) {
+      forNeighbors(i, [&](std::size_t j) {
+        if (j > i) queuePair(i, j, cutoff);
+      });
+    }
+
     do {
       bool any = false;
-      unsigned int mi(0), mj(0);
-
-      int nseeds = 0;
-      // loop over all clusters:
-      for (unsigned int i = 0; i < clusters_.size(); i++) {
-        // skip if empty
-        if (clusters_[i].empty()) continue;
-        // check if cluster might be a seed minimum seed:
-        bool iseed = (clusters_[i].centroid().E() >= seed_threshold);
-        if (iseed) {
-          nseeds++;
-
-        } else {
-          // Since we sorted initially if we find a hit below seed threshold
-          // it is guaranteed that there will be no seeds after.
-          break;
-        }
-        // loop over the rest of the clusters:
-        for (unsigned int j = i + 1; j < clusters_.size(); j++) {
-          if (clusters_[j].empty() or
-              (!iseed and clusters_[j].centroid().E() < seed_threshold))
-            continue;
-          // calculate weights between the two clusters:
-          double wgt = wgt_(clusters_[i], clusters_[j]);  // TODO
-          if (!any or
-              wgt < minwgt) {  // minwgt begins at cut-off, this probably wants
-                               // to tell us if these can physically be part of
-                               // same shower (deltaT, and R cuts)
-            any = true;
-            minwgt = wgt;
-            mi = i;
-            mj = j;
+      size_t mi(0), mj(0);
+
+      // drop the pairs with a cluster that changed since they were weighed
+      while (!pairs_.empty() &&
+             (pairs_.top().i_version != versions_[pairs_.top().i] ||
+              pairs_.top().j_version != versions_[pairs_.top().j])) {
+        pairs_.pop();
+      }
+
+      if (!pairs_.empty()) {
+        any = true;
+        minwgt = pairs_.top().weight;
+        mi = pairs_.top().i;
+        mj = pairs_.top().j;
+        pairs_.pop();
+      } else {
+        // no pair below the cutoff left, find the smallest weight of all
+        for (size_t i = 0; i < nprefix; i++) {
+          if (clusters_[i].empty()) continue;
+          for (size_t j = i + 1; j < clusters_.size(); j++) {
+            if (clusters_[j].empty()) continue;
+            double wgt = wgt_(clusters_[i], clusters_[j]);
+            if (!any || wgt < minwgt) {
+              any = true;
+              minwgt = wgt;
+              mi = i;
+              mj = j;
+            }
           }
         }
       }
@@ -70,36 +108,148 @@ class TemplatedClusterFinder {
 
       nseeds_ = nseeds;
       transitionWeights_.insert(std::pair<int, double>(ncluster, minwgt));
-      if (any and minwgt < cutoff) {
+
+      if (any && minwgt < cutoff) {
         // put the bigger one in mi
         if (clusters_[mi].centroid().E() < clusters_[mj].centroid().E()) {
           std::swap(mi, mj);
         }
         // now we have the smallest, merge
+        removeFromIndex(mi);
+        removeFromIndex(mj);
         clusters_[mi].add(clusters_[mj]);
         clusters_[mj].clear();
+        versions_[mi]++;
+        versions_[mj]++;
+        if (mj < nprefix) nseeds--;
+        // the bigger one is always a seed, so it pairs with all neighbors
+        insertIntoIndex(mi);
+        forNeighbors(mi, [&](std::size_t k) {
+          if (k != mi) queuePair(std::min(mi, k), std::max(mi, k), cutoff);
+        });
         // decrement cluster count
         ncluster--;
       }
 
-    } while (minwgt < cutoff and ncluster > 1);
+    } while (minwgt < cutoff && ncluster > 1);
     finalwgt_ = minwgt;
+
+    pairs_ = {};
+    cells_.clear();
   }
 
   double getYMax() const { return finalwgt_; }
 
   int getNSeeds() const { return nseeds_; }
 
-  std::map<int, double> getWeights() const { return transitionWeights_; }
+  const std::map<int, double>& getWeights() const {
+    return transitionWeights_;
+  }
 
-  std::vector<WorkingCluster> getClusters() const { return clusters_; }
+  const std::vector<WorkingCluster>& getClusters() const { return clusters_; }
 
  private:
+  /// weight of a pair of clusters, ordered by weight and then position
+  struct WeightedPair {
+    double weight;
+    std::size_t i, j;
+    unsigned int i_version, j_version;
+    bool operator>(const WeightedPair& other) const {
+      return std::tie(weight, i, j) > std::tie(other.weight, other.i, other.j);
+    }
+  };
+
+  /// queue the pair i < j if its weight is below the cutoff
+  void queuePair(std::size_t i, std::size_t j, double cutoff) {
+    double wgt = wgt_(clusters_[i], clusters_[j]);
+    if (wgt < cutoff) pairs_.push({wgt, i, j, versions_[i], versions_[j]});
+  }
+
+  /**
+   * Put the clusters into cells as large as the distance two clusters
+   * with a weight below the cutoff can be apart
+   *
+   * Without that distance (or if it is not finite) all the clusters are
+   * put into one cell.
+   */
+  void buildIndex(double cutoff) {
+    cell_size_ = {0., 0.};
+    if constexpr (requires(WeightClass w, double c) { w.reach(c); }) {
+      auto reach = wgt_.reach(cutoff);
+      if (std::isfinite(reach[0]) && std::isfinite(reach[1]) &&
+          reach[0] > 0 && reach[1] > 0) {
+        cell_size_ = reach;
+      }
+    }
+    versions_.assign(clusters_.size(), 0);
+    cell_of_.assign(clusters_.size(), 0);
+    cells_.clear();
+    for (std::size_t i = 0; i < clusters_.size(); i++) insertIntoIndex(i);
+  }
+
+  /// key of the cell with the offsets (in cells) from the cell of a point
+  std::int64_t cellKey(const TLorentzVector& point, int dx = 0, int dy = 0,
+                       int dz = 0) const {
+    if (cell_size_[0] == 0.) return 0;
+    auto bin = [](double v, double size, int offset) -> std::int64_t {
+      return static_cast<std::int64_t>(std::floor(v / size)) + offset +
+             (1 << 20);
+    };
+    return (bin(point.Px(), cell_size_[0], dx) << 42) |
+           (bin(point.Py(), cell_size_[0], dy) << 21) |
+           bin(point.Pz(), cell_size_[1], dz);
+  }
+
+  /// put a cluster into the cell of its centroid
+  void insertIntoIndex(std::size_t i) {
+    cell_of_[i] = cellKey(clusters_[i].centroid());
+    cells_[cell_of_[i]].push_back(i);
+  }
+
+  /// take a cluster out of its cell
+  void removeFromIndex(std::size_t i) {
+    auto& cell = cells_[cell_of_[i]];
+    *std::find(cell.begin(), cell.end(), i) = cell.back();
+    cell.pop_back();
+  }
+
+  /// call f with every cluster in the cells around the cell of cluster i
+  template <typename F>
+  void forNeighbors(std::size_t i, F f) const {
+    if (cell_size_[0] == 0.) {
+      for (std::size_t k : cells_.at(0)) f(k);
+      return;
+    }
+    const TLorentzVector& centroid = clusters_[i].centroid();
+    for (int dx = -1; dx <= 1; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        for (int dz = -1; dz <= 1; dz++) {
+          auto cell = cells_.find(cellKey(centroid, dx, dy, dz));
+          if (cell == cells_.end()) continue;
+          for (std::size_t k : cell->second) f(k);
+        }
+      }
+    }
+  }
+
   WeightClass wgt_;
   double finalwgt_;
   int nseeds_;
   std::map<int, double> transitionWeights_;
   std::vector<WorkingCluster> clusters_;
+
+  /// pairs below the cutoff, smallest weight on top
+  std::priority_queue<WeightedPair, std::vector<WeightedPair>,
+                      std::greater<WeightedPair>>
+      pairs_;
+  /// number of times each cluster changed, to recognize outdated pairs
+  std::vector<unsigned int> versions_;
+  /// transverse and longitudinal size of the cells, zero for one cell
+  std::array<double, 2> cell_size_{0., 0.};
+  /// key of the cell each cluster is in
+  std::vector<std::int64_t> cell_of_;
+  /// clusters in each cell
+  std::unordered_map<std::int64_t, std::vector<std::size_t>> cells_;
 };
 }  // namespace hcal
 
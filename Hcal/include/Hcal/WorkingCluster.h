@@ -33,7 +33,7 @@ class WorkingCluster {
 
   void SetTime(double t) { time_ = t; }
 
-  std::vector<const ldmx::HcalHit*> getHits() const { return hits_; }
+  const std::vector<const ldmx::HcalHit*>& getHits() const { return hits_; }
 
   void addHit(const ldmx::HcalHit* eh) { hits_.push_back(eh); }
 
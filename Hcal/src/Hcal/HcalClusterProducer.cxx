@@ -55,7 +55,7 @@ void HcalClusterProducer::produce(framework::Event& event) {
   // a->getEnergy() > b->getEnergy();});
   finder.cluster(EminCluster_, cutOff_, deltaTime_);
 
-  std::vector<WorkingCluster> wcVec = finder.getClusters();
+  const std::vector<WorkingCluster>& wcVec = finder.getClusters();
   for (unsigned int c = 0; c < wcVec.size(); c++) {
     if (wcVec[c].empty()) continue;
     ldmx::HcalCluster cluster;
@@ -83,7 +83,8 @@ void HcalDigiProducer::produce(framework::Event& event) {
 
   // Get the Hgcroc Conditions
   hgcroc_->condition(
-      getCondition<conditions::DoubleTableCondition>("HcalHgcrocConditions"));
+      getCondition<conditions::DoubleTableCondition>("HcalHgcrocConditions"),
+      getConditionIOV("HcalHgcrocConditions"));
 
   // Get the Hcal Geometry
   const auto& hcalGeometry = getCondition<ldmx::HcalGeometry>(
@@ -333,10 +334,9 @@ void HcalDigiProducer::produce(framework::Event& event) {
 
       // noise generator gives the amplitude above the readout threshold
       // we need to convert it to the amplitude above the pedestal
-      double gain = hgcroc_->gain(noiseID);
-      fake_pulse[0].first = noiseHit +
-                            gain * hgcroc_->readoutThreshold(noiseID) -
-                            gain * hgcroc_->pedestal(noiseID);
+      const auto& conds{hgcroc_->channelConditions(noiseID)};
+      fake_pulse[0].first = noiseHit + conds.gain * conds.readoutThreshold -
+                            conds.gain * conds.pedestal;
 
       if (sectionID == ldmx::HcalID::HcalSection::BACK) {
         std::vector<ldmx::HgcrocDigiCollection::Sample> digiToAddPosend,
@@ -357,7 +357,7 @@ void HcalDigiProducer::produce(framework::Event& event) {
     }  // loop over noise amplitudes
   }    // if we should add noise
 
-  event.add(digiCollName_, hcalDigis);
+  event.add(digiCollName_, std::move(hcalDigis));
 
   return;
 }  // produce
@@ -156,7 +156,7 @@ void HcalDoubleEndRecProducer::produce(framework::Event& event) {
   }
 
   // add collection to event bus
-  event.add(rec_coll_name_, doubleHcalRecHits);
+  event.add(rec_coll_name_, std::move(doubleHcalRecHits));
 }
 
 }  // namespace hcal
@@ -174,7 +174,7 @@ void HcalRawDecoder::produce(framework::Event& event) {
             << digis.getNumSamplesPerDigi() << " samples to event bus"
             << std::endl;
 #endif
-  event.add(output_name_, digis);
+  event.add(output_name_, std::move(digis));
   return;
 }  // produce
 
@@ -84,23 +84,22 @@ void HcalRecProducer::configure(framework::config::Parameters& ps) {
 }
 
 double HcalRecProducer::getTOA(
-    const ldmx::HgcrocDigiCollection::HgcrocDigi digi, double pedestal,
-    unsigned int iSOI) const {
+    const ldmx::HgcrocDigiCollection::DecodedSamples& decoded,
+    std::size_t i_digi, double pedestal, unsigned int iSOI) const {
   // get toa relative to the startBX
   double toaRelStartBX(0.), maxMeas{0.};
-  int toaSample(0), maxSample(0), iADC(0);
-  for (int i_sample{0}; i_sample < digi.size(); i_sample++) {
-    auto sample{digi.at(i_sample)};
-    if (sample.toa() > 0) {
-      toaRelStartBX = sample.toa() * (clock_cycle_ / 1024);  // ns
+  int toaSample(0), maxSample(0);
+  for (unsigned int iADC{0}; iADC < decoded.samples_per_digi; iADC++) {
+    std::size_t i_sample{decoded.index(i_digi, iADC)};
+    if (decoded.toa[i_sample] > 0) {
+      toaRelStartBX = decoded.toa[i_sample] * (clock_cycle_ / 1024);  // ns
       // find in which ADC sample the TOA was taken
       toaSample = iADC;
     }
-    if ((sample.adc_t() - pedestal) > maxMeas) {
-      maxMeas = (sample.adc_t() - pedestal);
+    if ((decoded.adc_t[i_sample] - pedestal) > maxMeas) {
+      maxMeas = (decoded.adc_t[i_sample] - pedestal);
       maxSample = iADC;
     }
-    iADC++;
   }
 
   // time w.r.t to the peak
@@ -122,9 +121,10 @@ void HcalRecProducer::produce(framework::Event& event) {
       getCondition<HcalReconConditions>(HcalReconConditions::CONDITIONS_NAME)};
 
   std::vector<ldmx::HcalHit> hcalRecHits;
-  auto hcalDigis =
+  const auto& hcalDigis =
       event.getObject<ldmx::HgcrocDigiCollection>(digiCollName_, digiPassName_);
-  int numDigiHits = hcalDigis.getNumDigis();
+  hcalDigis.decode(decoded_);
+  int numDigiHits = decoded_.size();
 
   // get sample of interest index
   unsigned int iSOI = hcalDigis.getSampleOfInterestIndex();
@@ -132,10 +132,11 @@ void HcalRecProducer::produce(framework::Event& event) {
   // loop through digis
   int iDigi = 0;
   while (iDigi < numDigiHits) {
-    auto digi_posend = hcalDigis.getDigi(iDigi);
+    std::size_t digi_posend = iDigi;
+    std::size_t soi_posend = decoded_.soi(digi_posend);
 
     // ID from first digi sample (which should be in positive end)
-    ldmx::HcalDigiID id_posend(digi_posend.id());
+    ldmx::HcalDigiID id_posend(decoded_.id[digi_posend]);
     ldmx::HcalID id(id_posend.section(), id_posend.layer(), id_posend.strip());
 
     // position from ID
@@ -174,26 +175,27 @@ void HcalRecProducer::produce(framework::Event& event) {
 
     // double readout
     if (id.section() == ldmx::HcalID::HcalSection::BACK) {
-      auto digi_negend = hcalDigis.getDigi(iDigi + 1);
-      ldmx::HcalDigiID id_negend(digi_negend.id());
+      std::size_t digi_negend = iDigi + 1;
+      std::size_t soi_negend = decoded_.soi(digi_negend);
+      ldmx::HcalDigiID id_negend(decoded_.id[digi_negend]);
 
       double voltage_posend, voltage_negend;
-      if (digi_posend.isTOT()) {
-        voltage_posend =
-            (digi_posend.tot() - the_conditions.totCalib(id_posend, 0)) *
-            the_conditions.totCalib(id_posend, 1);
-        voltage_negend =
-            (digi_negend.tot() - the_conditions.totCalib(id_negend, 0)) *
-            the_conditions.totCalib(id_negend, 1);
+      if (decoded_.isTOT(digi_posend)) {
+        voltage_posend = (decoded_.digiTOT(digi_posend) -
+                          the_conditions.totCalib(id_posend, 0)) *
+                         the_conditions.totCalib(id_posend, 1);
+        voltage_negend = (decoded_.digiTOT(digi_negend) -
+                          the_conditions.totCalib(id_negend, 0)) *
+                         the_conditions.totCalib(id_negend, 1);
       } else {
-        amplT_posend =
-            digi_posend.soi().adc_t() - the_conditions.adcPedestal(id_posend);
-        amplTm1_posend =
-            digi_posend.soi().adc_tm1() - the_conditions.adcPedestal(id_posend);
-        amplT_negend =
-            digi_negend.soi().adc_t() - the_conditions.adcPedestal(id_negend);
-        amplTm1_negend =
-            digi_negend.soi().adc_tm1() - the_conditions.adcPedestal(id_negend);
+        amplT_posend = decoded_.adc_t[soi_posend] -
+                       the_conditions.adcPedestal(id_posend);
+        amplTm1_posend = decoded_.adc_tm1[soi_posend] -
+                         the_conditions.adcPedestal(id_posend);
+        amplT_negend = decoded_.adc_t[soi_negend] -
+                       the_conditions.adcPedestal(id_negend);
+        amplTm1_negend = decoded_.adc_tm1[soi_negend] -
+                         the_conditions.adcPedestal(id_negend);
 
         // correct amplitude (amplitude fractions from both ends need to be
         // above the boundary of the correction)
@@ -209,10 +211,10 @@ void HcalRecProducer::produce(framework::Event& event) {
       }
 
       // get TOA
-      double TOA_posend =
-          getTOA(digi_posend, the_conditions.adcPedestal(id_posend), iSOI);
-      double TOA_negend =
-          getTOA(digi_negend, the_conditions.adcPedestal(id_negend), iSOI);
+      double TOA_posend = getTOA(decoded_, digi_posend,
+                                 the_conditions.adcPedestal(id_posend), iSOI);
+      double TOA_negend = getTOA(decoded_, digi_negend,
+                                 the_conditions.adcPedestal(id_negend), iSOI);
 
       // get sign of position along the bar
       int position_bar_sign = (TOA_posend - TOA_negend) > 0 ? 1 : -1;
@@ -269,7 +271,7 @@ void HcalRecProducer::produce(framework::Event& event) {
     else {  // single readout
 
       double voltage_i;
-      if (digi_posend.isTOT()) {
+      if (decoded_.isTOT(digi_posend)) {
         // TOT - number of clock ticks that pulse was over threshold
         // this is related to the amplitude of the pulse approximately through a
         // linear drain rate the amplitude of the pulse is related to the energy
@@ -278,16 +280,17 @@ void HcalRecProducer::produce(framework::Event& event) {
         // convert the time over threshold into a total energy deposited in the
         // bar (time over threshold [ns] - pedestal) * gain
 
-        voltage_i = (digi_posend.tot() - the_conditions.totCalib(id_posend)) *
+        voltage_i = (decoded_.digiTOT(digi_posend) -
+                     the_conditions.totCalib(id_posend)) *
                     the_conditions.totCalib(id_posend);
 
       } else {
         // ADC mode of readout
         // ADC - voltage measurement at a specific time of the pulse
-        amplT_posend =
-            digi_posend.soi().adc_t() - the_conditions.adcPedestal(id_posend);
-        amplTm1_posend =
-            digi_posend.soi().adc_tm1() - the_conditions.adcPedestal(id_posend);
+        amplT_posend = decoded_.adc_t[soi_posend] -
+                       the_conditions.adcPedestal(id_posend);
+        amplTm1_posend = decoded_.adc_tm1[soi_posend] -
+                         the_conditions.adcPedestal(id_posend);
         voltage_i = amplT_posend * the_conditions.adcGain(id_posend);
       }
 
@@ -306,8 +309,8 @@ void HcalRecProducer::produce(framework::Event& event) {
       amplT = amplT_posend / att;
 
       // get TOA
-      double TOA =
-          getTOA(digi_posend, the_conditions.adcPedestal(id_posend), iSOI);
+      double TOA = getTOA(decoded_, digi_posend,
+                          the_conditions.adcPedestal(id_posend), iSOI);
 
       // correct TOA
       TOA = correctionTOA_.Eval(amplT) - TOA;
@@ -373,7 +376,7 @@ void HcalRecProducer::produce(framework::Event& event) {
   }
 
   // add collection to event bus
-  event.add(recHitCollName_, hcalRecHits);
+  event.add(recHitCollName_, std::move(hcalRecHits));
 }
 
 }  // namespace hcal
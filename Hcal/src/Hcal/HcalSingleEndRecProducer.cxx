@@ -127,7 +127,7 @@ void HcalSingleEndRecProducer::produce(framework::Event& event) {
   }
 
   // add collection to event bus
-  event.add(rec_coll_name_, hcalRecHits);
+  event.add(rec_coll_name_, std::move(hcalRecHits));
 }
 
 }  // namespace hcal
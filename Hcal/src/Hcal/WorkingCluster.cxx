@@ -50,7 +50,7 @@ void WorkingCluster::add(const WorkingCluster& wc) {
       time_ = wc.GetTime();
   }*/
 
-  std::vector<const ldmx::HcalHit*> clusterHits = wc.getHits();
+  const std::vector<const ldmx::HcalHit*>& clusterHits = wc.getHits();
 
   for (unsigned int i = 0; i < clusterHits.size(); i++) {
     hits_.push_back(clusterHits[i]);
@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "DetDescr/HcalGeometry.h"
+#include "Framework/Configure/Parameters.h"
+#include "Hcal/MyClusterWeight.h"
+#include "Hcal/TemplatedClusterFinder.h"
+
+namespace hcal {
+namespace test {
+
+/// number of layers in the back Hcal
+static const int N_LAYERS{96};
+
+/// number of strips in each layer of the back Hcal
+static const int N_STRIPS{40};
+
+/**
+ * Make the parameters of the back Hcal of the v14 geometry
+ *
+ * These are copied from the python configuration, leaving out the
+ * side Hcal.
+ */
+static framework::config::Parameters geometryParameters() {
+  framework::config::Parameters params;
+  params.addParameter("scint_thickness", 20.);
+  params.addParameter("scint_width", 50.);
+  params.addParameter("zero_layer", std::vector<double>{869.});
+  params.addParameter("layer_thickness", std::vector<double>{49.});
+  params.addParameter("num_layers", std::vector<int>{N_LAYERS});
+  params.addParameter("num_sections", 1);
+  params.addParameter("ecal_dx", 880.6815);
+  params.addParameter("ecal_dy", 600.);
+  params.addParameter("verbose", 0);
+  params.addParameter("back_horizontal_parity", 1);
+  params.addParameter("side_3d_readout", 1);
+  params.addParameter("y_offset", 19.05);
+  params.addParameter("detectors_valid",
+                      std::vector<std::string>{"ldmx-det-v14"});
+  params.addParameter("num_strips", std::vector<std::vector<int>>{
+                                        std::vector<int>(N_LAYERS, N_STRIPS)});
+  params.addParameter("half_total_width",
+                      std::vector<std::vector<double>>{
+                          std::vector<double>(N_LAYERS, 1000.)});
+  params.addParameter("zero_strip", std::vector<std::vector<double>>{
+                                        std::vector<double>(N_LAYERS, 1000.)});
+  params.addParameter("scint_length",
+                      std::vector<std::vector<double>>{
+                          std::vector<double>(N_LAYERS, 2000.)});
+  return params;
+}
+
+/**
+ * The clustering as it was done before the weights were queued,
+ * weighing every pair of clusters for every merge.
+ *
+ * This is the reference the queued version has to reproduce exactly.
+ */
+class ScanClusterFinder {
+ public:
+  void add(const ldmx::HcalHit* eh, const ldmx::HcalGeometry& hex) {
+    clusters_.push_back(WorkingCluster(eh, hex));
+  }
+
+  void cluster(double seed_threshold, double cutoff) {
+    int ncluster = clusters_.size();
+    double minwgt = cutoff;
+
+    std::sort(clusters_.begin(), clusters_.end(),
+              TemplatedClusterFinder<MyClusterWeight>::compClusters);
+    do {
+      bool any = false;
+      size_t mi(0), mj(0);
+
+      int nseeds = 0;
+
+      for (size_t i = 0; i < clusters_.size(); i++) {
+        if (clusters_[i].empty()) continue;
+
+        bool iseed = (clusters_[i].centroid().E() >= seed_threshold);
+        if (iseed) {
+          nseeds++;
+        } else {
+          break;
+        }
+
+        for (size_t j = i + 1; j < clusters_.size(); j++) {
+          if (clusters_[j].empty() ||
+              (!iseed && clusters_[j].centroid().E() < seed_threshold))
+            continue;
+          double wgt = wgt_(clusters_[i], clusters_[j]);
+          if (!any || wgt < minwgt) {
+            any = true;
+            minwgt = wgt;
+            mi = i;
+            mj = j;
+          }
+        }
+      }
+
+      nseeds_ = nseeds;
+      transitionWeights_.insert(std::pair<int, double>(ncluster, minwgt));
+
+      if (any && minwgt < cutoff) {
+        if (clusters_[mi].centroid().E() < clusters_[mj].centroid().E()) {
+          std::swap(mi, mj);
+        }
+        clusters_[mi].add(clusters_[mj]);
+        clusters_[mj].clear();
+        ncluster--;
+      }
+
+    } while (minwgt < cutoff && ncluster > 1);
+    finalwgt_ = minwgt;
+  }
+
+  MyClusterWeight wgt_;
+  double finalwgt_;
+  int nseeds_;
+  std::map<int, double> transitionWeights_;
+  std::vector<WorkingCluster> clusters_;
+};
+
+/**
+ * Make the hits of a fake event
+ *
+ * A few showers are spread over neighboring layers and strips with noise
+ * hits everywhere. Energies are drawn from a few values so that some
+ * clusters have exactly the same energy and weight.
+ */
+static std::vector<ldmx::HcalHit> makeHits(unsigned int seed) {
+  std::mt19937 rng{seed};
+  std::vector<ldmx::HcalHit> hits;
+  auto addHit = [&](int layer, int strip, double energy) {
+    if (layer < 1 || layer > N_LAYERS || strip < 0 || strip >= N_STRIPS) {
+      return;
+    }
+    ldmx::HcalHit hit;
+    hit.setID(ldmx::HcalID(0, layer, strip).raw());
+    hit.setEnergy(energy);
+    hits.push_back(hit);
+  };
+  int nShowers = 1 + rng() % 4;
+  for (int iShower = 0; iShower < nShowers; iShower++) {
+    int layer0 = 1 + rng() % N_LAYERS, strip0 = rng() % N_STRIPS;
+    int nHits = 5 + rng() % 40;
+    for (int iHit = 0; iHit < nHits; iHit++) {
+      addHit(layer0 + int(rng() % 9) - 4, strip0 + int(rng() % 3) - 1,
+             (1 + rng() % 8) * 0.25);
+    }
+  }
+  int nNoise = rng() % 40;
+  for (int iNoise = 0; iNoise < nNoise; iNoise++) {
+    addHit(1 + rng() % N_LAYERS, rng() % N_STRIPS, (1 + rng() % 4) * 0.1);
+  }
+  return hits;
+}
+
+}  // namespace test
+}  // namespace hcal
+
+/**
+ * The queued clustering has to make the same clusters and record the
+ * same weights as weighing all the pairs for every merge did.
+ */
+TEST_CASE("TemplatedClusterFinder", "[Hcal][functionality]") {
+  using namespace hcal::test;
+  std::unique_ptr<ldmx::HcalGeometry> geometry{
+      ldmx::HcalGeometry::debugMake(geometryParameters())};
+
+  // cutoffs from the python configuration and with more and fewer merges
+  for (double cutoff : {10., 0.5, 100.}) {
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+      std::vector<ldmx::HcalHit> hits{makeHits(seed)};
+
+      hcal::TemplatedClusterFinder<hcal::MyClusterWeight> finder;
+      ScanClusterFinder reference;
+      for (const auto& hit : hits) {
+        finder.add(&hit, *geometry);
+        reference.add(&hit, *geometry);
+      }
+      finder.cluster(0.5, cutoff, 10.);
+      reference.cluster(0.5, cutoff);
+
+      CHECK(finder.getNSeeds() == reference.nseeds_);
+      CHECK(finder.getYMax() == reference.finalwgt_);
+      CHECK(finder.getWeights() == reference.transitionWeights_);
+      const auto& clusters{finder.getClusters()};
+      REQUIRE(clusters.size() == reference.clusters_.size());
+      for (std::size_t i = 0; i < clusters.size(); i++) {
+        CHECK(clusters[i].getHits() == reference.clusters_[i].getHits());
+        CHECK(clusters[i].centroid() == reference.clusters_[i].centroid());
+      }
+    }
+  }
+}
@@ -51,6 +51,9 @@ class ElectronCounter : public framework::Producer {
    */
   void produce(framework::Event &event) override;
 
+  /// the count only depends on the collection in the event
+  bool isClonable() const override { return true; }
+
  private:
   /**
    * The name of the input collection used for counting electrons
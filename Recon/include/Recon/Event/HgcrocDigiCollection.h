@@ -314,6 +314,78 @@ class HgcrocDigiCollection {
   };  // HgcrocDigi
 
  public:
+  /**
+   * @struct DecodedSamples
+   * The measurements of all the samples in a collection unpacked into
+   * separate arrays
+   *
+   * Decoding the samples one at a time through HgcrocDigi and Sample
+   * is convenient but slow for code that looks at every digi in the
+   * collection. HgcrocDigiCollection::decode unpacks all of the samples
+   * at once into these arrays so that reconstruction can simply look up
+   * the measurements it needs.
+   *
+   * The per-sample arrays have numSamplesPerDigi entries for each digi
+   * in the same order as the digis in the collection, use index (or soi)
+   * to get the position of a specific sample. The same caveats about
+   * which measurements are valid apply as for Sample.
+   *
+   * Keep one of these around and re-use it for each event to avoid
+   * re-allocating the arrays.
+   */
+  struct DecodedSamples {
+    /// channel ID of each digi
+    std::vector<unsigned int> id;
+    /// ADC of each sample (Sample::adc_t)
+    std::vector<int> adc_t;
+    /// ADC of the previous sample for each sample (Sample::adc_tm1)
+    std::vector<int> adc_tm1;
+    /// TOA of each sample (Sample::toa)
+    std::vector<int> toa;
+    /// TOT of each sample (Sample::tot)
+    std::vector<int> tot;
+    /// TOT in progress flag of each sample (Sample::isTOTinProgress)
+    std::vector<uint8_t> tot_progress;
+    /// TOT complete flag of each sample (Sample::isTOTComplete)
+    std::vector<uint8_t> tot_complete;
+    /// number of samples for each digi
+    unsigned int samples_per_digi{0};
+    /// index of the sample of interest within each digi
+    unsigned int sample_of_interest{0};
+
+    /// number of digis that were decoded
+    std::size_t size() const { return id.size(); }
+
+    /// index of a sample in the per-sample arrays
+    std::size_t index(std::size_t i_digi, unsigned int i_sample) const {
+      return i_digi * samples_per_digi + i_sample;
+    }
+
+    /// index of the sample of interest of a digi in the per-sample arrays
+    std::size_t soi(std::size_t i_digi) const {
+      return index(i_digi, sample_of_interest);
+    }
+
+    /**
+     * Check if a digi is a TOT measurement
+     * @see HgcrocDigi::isTOT
+     */
+    bool isTOT(std::size_t i_digi) const {
+      std::size_t i{soi(i_digi)};
+      return tot_progress[i] or tot_complete[i];
+    }
+
+    /**
+     * Get the TOT measurement of a digi
+     * @see HgcrocDigi::tot for the meaning of negative values
+     */
+    int digiTOT(std::size_t i_digi) const {
+      if (not isTOT(i_digi)) return -1;
+      if (tot_progress[soi(i_digi)]) return -2;
+      return tot[soi(i_digi)];
+    }
+  };
+
   /**
    * Class constructor.
    */
@@ -403,6 +475,18 @@ class HgcrocDigiCollection {
    */
   const HgcrocDigi getDigi(unsigned int digiIndex) const;
 
+  /**
+   * Decode all of the samples in this collection at once
+   *
+   * The arrays in the output are resized to fit this collection,
+   * so they are only re-allocated when a larger collection is decoded.
+   *
+   * @sa DecodedSamples for how to access the decoded measurements
+   *
+   * @param[out] decoded arrays to fill with the decoded measurements
+   */
+  void decode(DecodedSamples& decoded) const;
+
   /**
    * Get total number of digis
    * @return unsigned int number of digis
@@ -4,6 +4,7 @@
 //---< C++ StdLib >---//
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 //---< ROOT >---//
@@ -15,6 +16,10 @@
 #include "Framework/EventFile.h"
 #include "Framework/EventProcessor.h"
 
+//---< SimCore >---//
+#include "SimCore/Event/SimCalorimeterHit.h"
+#include "SimCore/Event/SimTrackerHit.h"
+
 namespace recon {
 
 /**
@@ -36,6 +41,9 @@ class OverlayProducer : public framework::Producer {
   /**
    * At the start of the run, the pileup overlay file is set up, and the
    * starting event number is chosen, using the RNSS.
+   *
+   * If a pileup pool is requested, the pool is loaded from the overlay file
+   * starting from this event at the first run.
    */
   void onNewRun(const ldmx::RunHeader &) override;  // );    //
 
@@ -64,6 +72,52 @@ class OverlayProducer : public framework::Producer {
   void onProcessStart() override;
 
  private:
+  /**
+   * Hits of one collection for all of the events in the pileup pool
+   *
+   * The hits of all the pool events are stored one after the other,
+   * the hits of pool event i are [offsets[i], offsets[i+1]).
+   */
+  template <typename Hit>
+  struct PoolCollection {
+    /// hits of all the events in the pool
+    std::vector<Hit> hits;
+    /// index of the first hit of each event, and one past the last hit
+    std::vector<std::size_t> offsets{0};
+  };
+
+  /**
+   * Read the overlay events of the pileup pool into memory
+   *
+   * The events are read from the current position of the overlay file.
+   * If the file has fewer events than the requested pool size, the pool
+   * holds each event in the file once.
+   */
+  void loadPool();
+
+  /**
+   * Get the hits of a collection in the current overlay event
+   *
+   * @param[in] pool pool collections, parallel to the list of collection names
+   * @param[in] iColl index of the collection in the list of collection names
+   * @param[in] collName name of the collection
+   * @param[in] poolEvent index of event in the pool, < 0 for the overlay file
+   * @return pointers to the first hit and past the last hit
+   */
+  template <typename Hit>
+  std::pair<const Hit *, const Hit *> overlayHits(
+      const std::vector<PoolCollection<Hit>> &pool, std::size_t iColl,
+      const std::string &collName, int poolEvent) const {
+    if (poolEvent < 0) {
+      const auto &hits{
+          overlayEvent_.getCollection<Hit>(collName, overlayPassName_)};
+      return {hits.data(), hits.data() + hits.size()};
+    }
+    const auto &coll{pool[iColl]};
+    return {coll.hits.data() + coll.offsets[poolEvent],
+            coll.hits.data() + coll.offsets[poolEvent + 1]};
+  }
+
   /// The parameters used to configure this producer
   framework::config::Parameters params_;
 
@@ -135,6 +189,35 @@ class OverlayProducer : public framework::Producer {
    */
   std::unique_ptr<TRandom2> rndmTime_;
 
+  /**
+   * Number of overlay events to hold in memory and sample from.
+   * Defaults to 0 --> the overlay events are read from the file one after the
+   * other as they are needed.
+   */
+  int poolSize_{0};
+
+  /**
+   * SimCalorimeterHits of the pool events, parallel to caloCollections_
+   */
+  std::vector<PoolCollection<ldmx::SimCalorimeterHit>> caloPool_;
+
+  /**
+   * SimTrackerHits of the pool events, parallel to trackerCollections_
+   */
+  std::vector<PoolCollection<ldmx::SimTrackerHit>> trackerPool_;
+
+  /**
+   * Event numbers of the pool events in the overlay file, for printouts
+   */
+  std::vector<int> poolEventNumbers_;
+
+  /**
+   * Random number generator for picking the pool event to overlay.
+   * Separate from rndm_ so that the number of overlaid events does not depend
+   * on using a pool.
+   */
+  std::unique_ptr<TRandom2> rndmPool_;
+
   /**
    * Width of pileup bunch spread in time (in [ns]), specified as a sigma of a
    * Gaussian distribution
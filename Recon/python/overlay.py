@@ -40,6 +40,11 @@ nLatererBunchesToSample : int
     while the sim event is always in bunch m = 0. 
 bunchSpacing : float
     The spacing in time between bunches [ns]
+pileupPoolSize : int
+    The number of pileup events to read into memory at the start of the job.
+    The events to overlay are then picked at random from this pool instead of reading
+    the next events from the pileup file, which removes the file reading from the
+    per-event cost. The default of 0 reads the pileup events from the file as they are needed.
 verbosity : int
     Sets the producer specific level of verbosity, up to 3 for the most verbose step-by-step debug printouts.
 
@@ -76,6 +81,7 @@ class OverlayProducer(ldmxcfg.Producer) :
         self.nEarlierBunchesToSample = 0
         self.nLaterBunchesToSample = 0
         self.bunchSpacing = 26.88   # [ns]
+        self.pileupPoolSize = 0
         self.verbosity = 1	
         self.tree_name = 'LDMX_Events'
         self.compressionSetting = 9
@@ -65,6 +65,53 @@ ClassImp(ldmx::HgcrocDigiCollection)
         samples_.begin() + digiIndex * getNumSamplesPerDigi(), *this);
   }
 
+  void HgcrocDigiCollection::decode(DecodedSamples &decoded) const {
+    decoded.id = channelIDs_;
+    decoded.samples_per_digi = numSamplesPerDigi_;
+    decoded.sample_of_interest = sampleOfInterest_;
+
+    const std::size_t n{samples_.size()};
+    decoded.adc_t.resize(n);
+    decoded.adc_tm1.resize(n);
+    decoded.toa.resize(n);
+    decoded.tot.resize(n);
+    decoded.tot_progress.resize(n);
+    decoded.tot_complete.resize(n);
+
+    // plain loops over the raw arrays without calls or early exits
+    // so the compiler is able to vectorize them
+    const uint32_t *word{samples_.data()};
+    int *adc_t{decoded.adc_t.data()}, *adc_tm1{decoded.adc_tm1.data()},
+        *toa{decoded.toa.data()}, *tot{decoded.tot.data()};
+    uint8_t *progress{decoded.tot_progress.data()},
+        *complete{decoded.tot_complete.data()};
+
+    for (std::size_t i = 0; i < n; i++) {
+      progress[i] = ONE_BIT_MASK & (word[i] >> FIRSTFLAG_POS);
+      complete[i] = ONE_BIT_MASK & (word[i] >> SECONFLAG_POS);
+      adc_tm1[i] = TEN_BIT_MASK & (word[i] >> FIRSTMEAS_POS);
+    }
+
+    if (version_ == 2) {
+      for (std::size_t i = 0; i < n; i++) {
+        adc_t[i] = TEN_BIT_MASK & word[i];
+        toa[i] = TEN_BIT_MASK & (word[i] >> SECONMEAS_POS);
+        tot[i] = 0xfff & (word[i] >> FIRSTMEAS_POS);
+      }
+    } else {
+      for (std::size_t i = 0; i < n; i++) {
+        int first = TEN_BIT_MASK & (word[i] >> FIRSTMEAS_POS);
+        int secon = TEN_BIT_MASK & (word[i] >> SECONMEAS_POS);
+        // calibration mode puts the current ADC into the first position
+        adc_t[i] = complete[i] ? first : secon;
+        toa[i] = TEN_BIT_MASK & word[i];
+        tot[i] = secon > 512 ? (secon - 512) * 8 : secon;
+      }
+    }
+
+    return;
+  }
+
   void HgcrocDigiCollection::addDigi(
       unsigned int id, const std::vector<HgcrocDigiCollection::Sample> &digi) {
     if (digi.size() != this->getNumSamplesPerDigi()) {
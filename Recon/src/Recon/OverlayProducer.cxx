@@ -1,8 +1,8 @@
 #include "Recon/OverlayProducer.h"
 
+#include <algorithm>
+
 #include "Framework/RandomNumberSeedService.h"
-#include "SimCore/Event/SimCalorimeterHit.h"
-#include "SimCore/Event/SimTrackerHit.h"
 
 namespace recon {
 
@@ -29,6 +29,7 @@ void OverlayProducer::configure(framework::config::Parameters &parameters) {
   nEarlier_ = parameters.getParameter<int>("nEarlierBunchesToSample");
   nLater_ = parameters.getParameter<int>("nLaterBunchesToSample");
   bunchSpacing_ = parameters.getParameter<double>("bunchSpacing");
+  poolSize_ = parameters.getParameter<int>("pileupPoolSize", 0);
   verbosity_ = parameters.getParameter<int>("verbosity");
 
   /// Print the parameters actually set. Helpful in case of typos.
@@ -52,6 +53,7 @@ void OverlayProducer::configure(framework::config::Parameters &parameters) {
                    << "\n\t doPoissonOutoftime = " << doPoissonOOT_
                    << "\n\t timeSpread = " << timeSigma_
                    << "\n\t timeMean = " << timeMean_
+                   << "\n\t pileupPoolSize = " << poolSize_
                    << "\n\t verbosity = " << verbosity_;
   }
   return;
@@ -64,6 +66,10 @@ void OverlayProducer::onNewRun(const ldmx::RunHeader &) {
     const auto &rnss = getCondition<framework::RandomNumberSeedService>(
         framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME);
     rndm_ = std::make_unique<TRandom2>(rnss.getSeed("OverlayProducer::rndm"));
+    if (poolSize_ > 0) {
+      rndmPool_ =
+          std::make_unique<TRandom2>(rnss.getSeed("OverlayProducer::rndmPool"));
+    }
   }
 
   int start_event = rndm_->Uniform(20., 1e4);
@@ -75,6 +81,51 @@ void OverlayProducer::onNewRun(const ldmx::RunHeader &) {
   overlayEvent_.getEventHeader().setEventNumber(evNb);
   ldmx_log(info) << "Starting overlay process with pileup event number " << evNb
                  << " (random event number picked was " << start_event << ").";
+
+  // the pool is kept for the whole job once it is loaded
+  if (poolSize_ > 0 and poolEventNumbers_.empty()) loadPool();
+}
+
+void OverlayProducer::loadPool() {
+  const long int nEvents{
+      std::min<long int>(poolSize_, overlayFile_->getNumEntries())};
+  if (nEvents <= 0) {
+    EXCEPTION_RAISE("BadConf", "No overlay events to load into the pileup "
+                               "pool, is the overlay file empty?");
+  }
+  caloPool_.assign(caloCollections_.size(), {});
+  trackerPool_.assign(trackerCollections_.size(), {});
+  poolEventNumbers_.reserve(nEvents);
+  for (long int iEv{0}; iEv < nEvents; iEv++) {
+    if (!overlayFile_->nextEvent()) {
+      EXCEPTION_RAISE("BadRead", "Couldn't read overlay event " +
+                                     std::to_string(iEv) +
+                                     " into the pileup pool.");
+    }
+    poolEventNumbers_.push_back(
+        overlayEvent_.getEventHeader().getEventNumber());
+
+    for (std::size_t iColl{0}; iColl < caloCollections_.size(); iColl++) {
+      const auto &hits{overlayEvent_.getCollection<ldmx::SimCalorimeterHit>(
+          caloCollections_[iColl], overlayPassName_)};
+      auto &coll{caloPool_[iColl]};
+      coll.hits.insert(coll.hits.end(), hits.begin(), hits.end());
+      coll.offsets.push_back(coll.hits.size());
+    }
+
+    for (std::size_t iColl{0}; iColl < trackerCollections_.size(); iColl++) {
+      const auto &hits{overlayEvent_.getCollection<ldmx::SimTrackerHit>(
+          trackerCollections_[iColl], overlayPassName_)};
+      auto &coll{trackerPool_[iColl]};
+      coll.hits.insert(coll.hits.end(), hits.begin(), hits.end());
+      coll.offsets.push_back(coll.hits.size());
+    }
+  }
+
+  ldmx_log(info) << "Loaded " << nEvents
+                 << " overlay events into the pileup pool, starting from "
+                    "pileup event number "
+                 << poolEventNumbers_.front() << ".";
 }
 
 void OverlayProducer::produce(framework::Event &event) {
@@ -213,13 +264,19 @@ void OverlayProducer::produce(framework::Event &event) {
     float bunchTimeOffset = bunchSpacing_ * bunchOffset;
 
     for (int iEv = 0; iEv < nEvsOverlay; iEv++) {
-      /** Go to next overlay event
+      // index of the overlay event in the pool, -1 if read from the file
+      int poolEvent{-1};
+      if (poolSize_ > 0) {
+        // pick any event in the pool, no need to touch the overlay file
+        poolEvent = rndmPool_->Integer(poolEventNumbers_.size());
+      }
+      /** Otherwise go to next overlay event
        * This overlay file has been configured to loop back to the beginning
        * of the TTree when it reaches the end. This means nextEvent() will only
        * return false if an error is occurred or if the overlay file is
        * mis-configured.
        */
-      if (!overlayFile_->nextEvent()) {
+      else if (!overlayFile_->nextEvent()) {
         ldmx_log(error) << "At sim event "
                         << event.getEventHeader().getEventNumber()
                         << ": couldn't read next overlay event!";
@@ -232,7 +289,9 @@ void OverlayProducer::produce(framework::Event &event) {
 
       if (verbosity_ > 2) {
         ldmx_log(debug) << "in overlay loop: overlaying event "
-                        << overlayEvent_.getEventHeader().getEventNumber()
+                        << (poolEvent < 0 ? overlayEvent_.getEventHeader()
+                                                .getEventNumber()
+                                          : poolEventNumbers_[poolEvent])
                         << "which is " << iEv + 1 << " out of " << nEvsOverlay
                         << "\n\thit time offset is " << timeOffset << " ns"
                         << "\n\tbunch position offset is " << bunchOffset
@@ -249,12 +308,11 @@ void OverlayProducer::produce(framework::Event &event) {
         if (strstr(caloCollections_[iColl].c_str(), "Ecal"))
           needsContribsAdded = true;
 
-        std::vector<ldmx::SimCalorimeterHit> overlayHits =
-            overlayEvent_.getCollection<ldmx::SimCalorimeterHit>(
-                caloCollections_[iColl], overlayPassName_);
+        auto [firstHit, endHit] = overlayHits(
+            caloPool_, iColl, caloCollections_[iColl], poolEvent);
 
         ldmx_log(debug) << "in loop: size of overlay hits vector is "
-                        << overlayHits.size();
+                        << endHit - firstHit;
 
         std::string outCollName = caloCollections_[iColl] + "Overlay";
 
@@ -262,11 +320,11 @@ void OverlayProducer::produce(framework::Event &event) {
           ldmx_log(debug) << "in loop: printing overlay event: ";
         }
 
-        for (ldmx::SimCalorimeterHit &overlayHit : overlayHits) {
+        for (auto hit{firstHit}; hit != endHit; ++hit) {
+          const ldmx::SimCalorimeterHit &overlayHit{*hit};
           if (verbosity_ > 2) overlayHit.Print();
 
           const float overlayTime = overlayHit.getTime() + timeOffset;
-          overlayHit.setTime(overlayTime);
 
           if (needsContribsAdded) {  // special treatment for (for now only)
                                      // ecal
@@ -287,6 +345,7 @@ void OverlayProducer::produce(framework::Event &event) {
           }  // if add overlay as contribs
           else {
             caloCollectionMap[outCollName].push_back(overlayHit);
+            caloCollectionMap[outCollName].back().setTime(overlayTime);
             if (verbosity_ > 2)
               ldmx_log(debug) << "Adding non-Ecal overlay hit to outhit vector "
                               << outCollName;
@@ -302,13 +361,13 @@ void OverlayProducer::produce(framework::Event &event) {
       /* ----------- now do simtracker hits overlay ----------- */
 
       // get the SimTrackerHit collections that we want to overlay
-      for (const auto &coll : trackerCollections_) {
-        auto overlayTrackerHits{
-            overlayEvent_.getCollection<ldmx::SimTrackerHit>(coll,
-                                                             overlayPassName_)};
+      for (uint iColl = 0; iColl < trackerCollections_.size(); iColl++) {
+        const auto &coll{trackerCollections_[iColl]};
+        auto [firstHit, endHit] =
+            overlayHits(trackerPool_, iColl, coll, poolEvent);
 
         ldmx_log(debug) << "in loop: size of overlay hits vector is "
-                        << overlayTrackerHits.size();
+                        << endHit - firstHit;
 
         auto outCollName{coll + "Overlay"};
 
@@ -316,10 +375,11 @@ void OverlayProducer::produce(framework::Event &event) {
           ldmx_log(debug) << "in loop: printing overlay event: ";
         }
 
-        for (auto &overlayHit : overlayTrackerHits) {
-          auto overlayTime{overlayHit.getTime() + timeOffset};
+        for (auto hit{firstHit}; hit != endHit; ++hit) {
+          auto overlayTime{hit->getTime() + timeOffset};
+          auto &overlayHit{
+              trackerCollectionMap[outCollName].emplace_back(*hit)};
           overlayHit.setTime(overlayTime);
-          trackerCollectionMap[outCollName].push_back(overlayHit);
 
           if (verbosity_ > 2) {
             overlayHit.Print();
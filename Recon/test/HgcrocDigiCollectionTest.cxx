@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+#include "Recon/Event/HgcrocDigiCollection.h"
+
+namespace ldmx {
+namespace test {
+
+/**
+ * Fill a collection with digis covering the edge cases of the samples
+ *
+ * Each of the combinations of the TOT flags is encoded with the
+ * smallest and largest measurements (including a TOT past the 10 bits
+ * that is packed when encoded). Raw words with all bits off or on and
+ * random raw words fill the rest.
+ */
+static HgcrocDigiCollection makeDigis(int version, unsigned int n_random) {
+  HgcrocDigiCollection digis;
+  digis.setVersion(version);
+  digis.setNumSamplesPerDigi(4);
+  digis.setSampleOfInterestIndex(2);
+
+  unsigned int id{0x14000000};
+  for (bool progress : {false, true}) {
+    for (bool complete : {false, true}) {
+      for (int tot : {0, 1, 512, 513, 1023, 4095}) {
+        std::vector<HgcrocDigiCollection::Sample> digi;
+        digi.emplace_back(false, false, 0, 0, 0, version);
+        digi.emplace_back(progress, complete, 1023, tot, 1023, version);
+        digi.emplace_back(progress, complete, 1023, tot, 0, version);
+        digi.emplace_back(progress, complete, 7, tot, 1023, version);
+        digis.addDigi(id++, digi);
+      }
+    }
+  }
+  digis.addDigi(id++, std::vector<uint32_t>(4, 0));
+  digis.addDigi(id++, std::vector<uint32_t>(4, 0xffffffff));
+
+  std::mt19937 rng{42};
+  std::vector<uint32_t> words(4);
+  for (unsigned int i{0}; i < n_random; i++) {
+    for (auto& word : words) word = rng();
+    digis.addDigi(id++, words);
+  }
+  return digis;
+}
+
+/// check the decoded arrays against decoding each sample on its own
+static void checkDecoded(const HgcrocDigiCollection& digis,
+                         const HgcrocDigiCollection::DecodedSamples& decoded) {
+  REQUIRE(decoded.size() == digis.getNumDigis());
+  REQUIRE(decoded.samples_per_digi == digis.getNumSamplesPerDigi());
+  REQUIRE(decoded.sample_of_interest == digis.getSampleOfInterestIndex());
+  REQUIRE(decoded.adc_t.size() == digis.getNumDigis() * 4);
+  for (unsigned int i_digi{0}; i_digi < digis.getNumDigis(); i_digi++) {
+    auto digi{digis.getDigi(i_digi)};
+    CHECK(decoded.id[i_digi] == digi.id());
+    CHECK(decoded.isTOT(i_digi) == digi.isTOT());
+    CHECK(decoded.digiTOT(i_digi) == digi.tot());
+    for (unsigned int i_sample{0}; i_sample < digi.size(); i_sample++) {
+      auto sample{digi.at(i_sample)};
+      std::size_t i{decoded.index(i_digi, i_sample)};
+      CHECK(decoded.adc_t[i] == sample.adc_t());
+      CHECK(decoded.adc_tm1[i] == sample.adc_tm1());
+      CHECK(decoded.toa[i] == sample.toa());
+      CHECK(decoded.tot[i] == sample.tot());
+      CHECK(bool(decoded.tot_progress[i]) == sample.isTOTinProgress());
+      CHECK(bool(decoded.tot_complete[i]) == sample.isTOTComplete());
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace ldmx
+
+/**
+ * Test for decoding all of the samples of a collection at once
+ *
+ * What does this test?
+ *  - each decoded measurement is the same as the one from the Sample
+ *    for both versions of the HGCROC
+ *  - the TOT of a digi is the same as the one from the HgcrocDigi
+ *  - re-using the arrays for a smaller collection shrinks them
+ */
+TEST_CASE("HgcrocDigiCollection", "[Recon][HgcrocDigiCollection]") {
+  for (int version : {2, 3}) {
+    ldmx::HgcrocDigiCollection::DecodedSamples decoded;
+    auto digis{ldmx::test::makeDigis(version, 100)};
+    digis.decode(decoded);
+    ldmx::test::checkDecoded(digis, decoded);
+
+    auto fewer{ldmx::test::makeDigis(version, 0)};
+    fewer.decode(decoded);
+    ldmx::test::checkDecoded(fewer, decoded);
+  }
+}
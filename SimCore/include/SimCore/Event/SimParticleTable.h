@@ -0,0 +1,283 @@
+#ifndef SIMCORE_EVENT_SIMPARTICLETABLE_H
+#define SIMCORE_EVENT_SIMPARTICLETABLE_H
+
+/*~~~~~~~~~~*/
+/*   ROOT   */
+/*~~~~~~~~~~*/
+#include "TObject.h"
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/Event/SimParticle.h"
+
+namespace ldmx {
+
+/**
+ * Columnar table of simulated particles.
+ *
+ * This holds the same information as the map of SimParticles keyed
+ * by track ID, but each quantity is stored in its own contiguous
+ * column and the daughters and parents of all particles are stored
+ * in two flat arrays indexed by offsets (compressed sparse rows).
+ * Writing, reading and walking the ancestry of the particles does
+ * not need any allocations per particle.
+ *
+ * The particles are stored in order of increasing track ID, so the
+ * row of a track ID can be found with a binary search.
+ *
+ * ```cpp
+ * const auto& table{event.getObject<ldmx::SimParticleTable>(
+ *     "SimParticleTable")};
+ * for (std::size_t i{0}; i < table.size(); i++) {
+ *   for (int daughter : table.getDaughters(i)) {
+ *     int row{table.find(daughter)};
+ *     ...
+ *   }
+ * }
+ * ```
+ *
+ * getParticle and getMap construct the SimParticle objects for code
+ * that has not been moved to the table yet.
+ */
+class SimParticleTable {
+ public:
+  /**
+   * View into one row of a flat index array.
+   */
+  class Range {
+   public:
+    /// Constructor
+    Range(const int* begin, const int* end) : begin_{begin}, end_{end} {}
+    /// @return pointer to first element
+    const int* begin() const { return begin_; }
+    /// @return pointer past the last element
+    const int* end() const { return end_; }
+    /// @return number of elements
+    std::size_t size() const { return end_ - begin_; }
+    /// @return true if there are no elements
+    bool empty() const { return begin_ == end_; }
+    /// @return i'th element
+    int operator[](std::size_t i) const { return begin_[i]; }
+
+   private:
+    /// first element
+    const int* begin_;
+    /// past the last element
+    const int* end_;
+  };
+
+  /// Constructor
+  SimParticleTable() = default;
+
+  /**
+   * Construct the table from a map of SimParticles
+   *
+   * @param[in] particles map of track ID to SimParticle
+   */
+  explicit SimParticleTable(const std::map<int, SimParticle>& particles);
+
+  /// Destructor
+  virtual ~SimParticleTable() = default;
+
+  /// Reset the table by removing all of the particles.
+  void Clear();
+
+  /// Print a summary of the table.
+  void Print() const;
+
+  /**
+   * Add a particle to the end of the table
+   *
+   * Particles must be added in order of increasing track ID.
+   * The parents and daughters of the particle are copied and more
+   * can be attached with addParent and addDaughter until the next
+   * particle is added.
+   *
+   * @param[in] trackID track ID of the particle
+   * @param[in] particle the particle to add
+   * @return row of the new particle
+   */
+  std::size_t add(int trackID, const SimParticle& particle);
+
+  /**
+   * Add a parent to the last particle that was added
+   *
+   * @param[in] trackID track ID of the parent
+   */
+  void addParent(int trackID);
+
+  /**
+   * Add a daughter to the last particle that was added
+   *
+   * @param[in] trackID track ID of the daughter
+   */
+  void addDaughter(int trackID);
+
+  /// @return number of particles in the table
+  std::size_t size() const { return trackIDs_.size(); }
+
+  /// @return true if the table has no particles
+  bool empty() const { return trackIDs_.empty(); }
+
+  /**
+   * Find the row of a particle
+   *
+   * @param[in] trackID track ID of the particle
+   * @return row of the particle, -1 if it is not in the table
+   */
+  int find(int trackID) const;
+
+  /// @return true if the particle with the track ID is in the table
+  bool contains(int trackID) const { return find(trackID) >= 0; }
+
+  /// @return track ID of the particle in row i
+  int getTrackID(std::size_t i) const { return trackIDs_[i]; }
+
+  /// @return PDG ID of the particle in row i
+  int getPdgID(std::size_t i) const { return pdgIDs_[i]; }
+
+  /// @return generator status of the particle in row i
+  int getGenStatus(std::size_t i) const { return genStatus_[i]; }
+
+  /// @return process type of the particle in row i
+  int getProcessType(std::size_t i) const { return processTypes_[i]; }
+
+  /// @return energy [MeV] of the particle in row i
+  double getEnergy(std::size_t i) const { return energies_[i]; }
+
+  /// @return kinetic energy [MeV] of the particle in row i
+  double getKineticEnergy(std::size_t i) const {
+    return energies_[i] - masses_[i];
+  }
+
+  /// @return global creation time [ns] of the particle in row i
+  double getTime(std::size_t i) const { return times_[i]; }
+
+  /// @return mass [MeV] of the particle in row i
+  double getMass(std::size_t i) const { return masses_[i]; }
+
+  /// @return charge of the particle in row i
+  double getCharge(std::size_t i) const { return charges_[i]; }
+
+  /// @return vertex [mm] of the particle in row i
+  std::array<double, 3> getVertex(std::size_t i) const {
+    return triplet(vertices_, i);
+  }
+
+  /// @return end point [mm] of the particle in row i
+  std::array<double, 3> getEndPoint(std::size_t i) const {
+    return triplet(endPoints_, i);
+  }
+
+  /// @return momentum [MeV] at the vertex of the particle in row i
+  std::array<double, 3> getMomentum(std::size_t i) const {
+    return triplet(momenta_, i);
+  }
+
+  /// @return momentum [MeV] at the end point of the particle in row i
+  std::array<double, 3> getEndPointMomentum(std::size_t i) const {
+    return triplet(endPointMomenta_, i);
+  }
+
+  /// @return name of the volume the particle in row i was created in
+  const std::string& getVertexVolume(std::size_t i) const {
+    return volumes_[vertexVolumes_[i]];
+  }
+
+  /// @return track IDs of the daughters of the particle in row i
+  Range getDaughters(std::size_t i) const {
+    return row(daughters_, daughterOffsets_, i);
+  }
+
+  /// @return track IDs of the parents of the particle in row i
+  Range getParents(std::size_t i) const {
+    return row(parents_, parentOffsets_, i);
+  }
+
+  /**
+   * Construct the SimParticle for a track ID
+   *
+   * @param[in] trackID track ID of the particle
+   * @return the particle
+   * @throws std::out_of_range if the track ID is not in the table
+   */
+  SimParticle getParticle(int trackID) const;
+
+  /**
+   * Construct the map of SimParticles keyed by track ID
+   *
+   * @return map holding all of the particles in the table
+   */
+  std::map<int, SimParticle> getMap() const;
+
+ private:
+  /// get the three values for row i from a flattened column
+  static std::array<double, 3> triplet(const std::vector<double>& column,
+                                       std::size_t i) {
+    return {column[3 * i], column[3 * i + 1], column[3 * i + 2]};
+  }
+
+  /// get the elements of row i from a flat index array
+  static Range row(const std::vector<int>& values,
+                   const std::vector<int>& offsets, std::size_t i) {
+    return Range(values.data() + offsets[i], values.data() + offsets[i + 1]);
+  }
+
+  /// construct the particle in row i
+  SimParticle particle(std::size_t i) const;
+
+  /// track IDs in increasing order
+  std::vector<int> trackIDs_;
+  /// PDG IDs
+  std::vector<int> pdgIDs_;
+  /// generator status
+  std::vector<int> genStatus_;
+  /// process types
+  std::vector<int> processTypes_;
+  /// energies [MeV]
+  std::vector<double> energies_;
+  /// global creation times [ns]
+  std::vector<double> times_;
+  /// masses [MeV]
+  std::vector<double> masses_;
+  /// charges
+  std::vector<double> charges_;
+  /// vertices [mm], three values per particle
+  std::vector<double> vertices_;
+  /// end points [mm], three values per particle
+  std::vector<double> endPoints_;
+  /// momenta [MeV] at the vertex, three values per particle
+  std::vector<double> momenta_;
+  /// momenta [MeV] at the end point, three values per particle
+  std::vector<double> endPointMomenta_;
+  /// index into volumes_ of the vertex volume
+  std::vector<int> vertexVolumes_;
+  /// names of the vertex volumes, each stored once
+  std::vector<std::string> volumes_;
+  /// daughters of all the particles
+  std::vector<int> daughters_;
+  /// daughters of row i are [daughterOffsets_[i], daughterOffsets_[i+1])
+  std::vector<int> daughterOffsets_{0};
+  /// parents of all the particles
+  std::vector<int> parents_;
+  /// parents of row i are [parentOffsets_[i], parentOffsets_[i+1])
+  std::vector<int> parentOffsets_{0};
+  /// index of each name in volumes_ while filling, not persisted
+  std::map<std::string, int> volumeIndex_;  //!
+
+  ClassDef(SimParticleTable, 1);
+};  // SimParticleTable
+
+}  // namespace ldmx
+
+#endif  // SIMCORE_EVENT_SIMPARTICLETABLE_H
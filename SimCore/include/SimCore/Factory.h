@@ -6,6 +6,7 @@
 #include <memory>                   // for the unique_ptr default
 #include <string>                   // for the keys in the library map
 #include <unordered_map>            // for the library of prototypes
+#include <vector>                   // for the warehouse of objects
 
 #include "Framework/Exception/Exception.h"
 
@@ -191,6 +192,15 @@ namespace simcore {
  * $ fave-things library::DoesNotExist
  * ERROR: An object named library::DoesNotExist has not been declared.
  * ```
+ *
+ * ## Threads
+ *
+ * The library of declared objects is shared by all threads, but each
+ * thread has its own warehouse of created objects. When Geant4 runs
+ * with several worker threads, each worker creates its own sensitive
+ * detectors, user actions, etc. and apply only visits the objects
+ * created by the calling thread. Running on one thread, this is the
+ * same as having a single warehouse.
  */
 template <typename Prototype, typename PrototypePtr,
           typename... PrototypeConstructorArgs>
@@ -269,19 +279,21 @@ class Factory {
       EXCEPTION_RAISE("SimFactory", "An object named " + full_name +
                                         " has not been declared.");
     }
-    warehouse_.emplace_back(lib_it->second(maker_args...));
-    return warehouse_.back();
+    warehouse().emplace_back(lib_it->second(maker_args...));
+    return warehouse().back();
   }
 
   /**
    * Apply the input UnaryFunction to each entry in the inventory
    *
+   * Only the objects created by the calling thread are in its inventory.
+   *
    * UnaryFunction is simply passed dirctly to std::for_each so
    * look there for requirements upon it.
    */
   template <class UnaryFunction>
   void apply(UnaryFunction f) const {
-    std::for_each(warehouse_.begin(), warehouse_.end(), f);
+    std::for_each(warehouse().begin(), warehouse().end(), f);
   }
 
   /// delete the copy constructor
@@ -322,8 +334,15 @@ class Factory {
   /// library of possible objects to create
   std::unordered_map<std::string, PrototypeMaker> library_;
 
-  /// warehouse of objects that have already been created
-  std::vector<PrototypePtr> warehouse_;
+  /**
+   * warehouse of objects that have already been created by this thread
+   *
+   * @returns reference to the warehouse of the calling thread
+   */
+  static std::vector<PrototypePtr>& warehouse() {
+    thread_local std::vector<PrototypePtr> the_warehouse;
+    return the_warehouse;
+  }
 };  // Factory
 
 }  // namespace simcore
@@ -0,0 +1,82 @@
+/**
+ * @file ActionInitialization.h
+ * @brief Class which creates the Geant4 user actions
+ */
+
+#ifndef SIMCORE_G4USER_ACTIONINITIALIZATION_H
+#define SIMCORE_G4USER_ACTIONINITIALIZATION_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <vector>
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4VUserActionInitialization.hh"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/UserAction.h"
+
+namespace simcore {
+namespace g4user {
+
+/**
+ * @class ActionInitialization
+ * @brief Create our G4User actions and the configured UserActions
+ *
+ * Running sequentially, Geant4 calls Build once when this is given
+ * to the run manager. Running with several threads, Geant4 calls Build
+ * on each worker thread so that every worker has its own actions and
+ * BuildForMaster on the master thread.
+ */
+class ActionInitialization : public G4VUserActionInitialization {
+ public:
+  /**
+   * Class constructor.
+   *
+   * @param parameters The parameters used to configure the simulation.
+   * @param extra_actions Actions to register after the configured
+   *  UserActions. These are shared by all threads.
+   */
+  ActionInitialization(const framework::config::Parameters& parameters,
+                       std::vector<UserAction*> extra_actions = {});
+
+  /**
+   * Class destructor.
+   */
+  virtual ~ActionInitialization() = default;
+
+  /**
+   * Create the actions for the master thread
+   *
+   * The master only processes runs, so it only gets a run action.
+   */
+  void BuildForMaster() const override;
+
+  /**
+   * Create the actions for the calling thread and register them
+   * with its run manager.
+   */
+  void Build() const override;
+
+ private:
+  /// The set of parameters used to configure the simulation
+  framework::config::Parameters parameters_;
+
+  /// Actions to register after the configured UserActions
+  std::vector<UserAction*> extra_actions_;
+};  // ActionInitialization
+
+}  // namespace g4user
+}  // namespace simcore
+
+#endif  // SIMCORE_G4USER_ACTIONINITIALIZATION_H
@@ -19,6 +19,7 @@
 /*~~~~~~~~~~~~~*/
 /*   SimCore   */
 /*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
 #include "SimCore/UserAction.h"
 
 namespace simcore {
@@ -53,6 +54,14 @@ class SteppingAction : public G4UserSteppingAction {
   /// Collection of user stepping actions
   std::vector<UserAction*> steppingActions_;
 
+  /// photon-nuclear processes (biased or not)
+  NameRegistry::ProcessHandle photonNuclear_{
+      NameRegistry::get().process("photonNuclear")};
+
+  /// electron-nuclear processes (biased or not)
+  NameRegistry::ProcessHandle electronNuclear_{
+      NameRegistry::get().process("electronNuclear")};
+
 };  // SteppingAction
 
 }  // namespace g4user
@@ -57,6 +57,9 @@ class ParticleGun : public simcore::PrimaryGenerator {
 
   void RecordConfig(const std::string& id, ldmx::RunHeader& rh) override;
 
+  /// each gun only depends on its configuration and the G4 random engine
+  bool isClonable() const override { return true; }
+
  private:
   /**
    * The actual Geant4 implementation of the ParticleGun
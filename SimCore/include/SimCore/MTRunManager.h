@@ -0,0 +1,216 @@
+/**
+ * @file MTRunManager.h
+ * @brief Class providing a multi-threaded Geant4 run manager implementation.
+ */
+
+#ifndef SIMCORE_MTRUNMANAGER_H
+#define SIMCORE_MTRUNMANAGER_H
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------//
+//   Geant4   //
+//------------//
+#include "G4TaskRunManager.hh"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+#include "Framework/Event.h"
+#include "SimCore/UserAction.h"
+#include "SimCore/UserEventInformation.h"
+
+namespace simcore {
+
+namespace g4user {
+class PrimaryGeneratorAction;
+}
+
+/**
+ * @class MTRunManager
+ * @brief Extension of the Geant4 tasking run manager
+ *
+ * Instead of simulating one event each time the Simulator is asked
+ * to produce one, we simulate a batch of events at once with one
+ * Geant4 run (BeamOn) spread across the worker threads.
+ * At the end of each event, the worker thread saves the tracks and
+ * hits into its own framework::Event (see Collector).
+ * Each event has its own slot for its results, so the workers do not
+ * need to lock anything to hand them over, and the Simulator takes
+ * them once the whole batch is done. The Simulator then hands these
+ * events to the output one at a time in order of their Geant4 event ID,
+ * so the output does not depend on which worker happened to simulate
+ * which event.
+ *
+ * The seeds for each event are either given by the Simulator or drawn
+ * from the engine of the master thread, so the output is reproducible
+ * for a given set of seeds independent of the number of threads.
+ */
+class MTRunManager : public G4TaskRunManager {
+ public:
+  /// Function saving the tracks and hits of the current worker event
+  using SaveFunction = std::function<void(framework::Event&)>;
+
+  /// The results of simulating one event on a worker thread
+  struct SimulatedEvent {
+    /// Geant4 ID of the event within its batch
+    int id{-1};
+    /// was this event aborted?
+    bool aborted{false};
+    /// state of the random engine before the event was simulated
+    std::string seed;
+    /// copy of the event information (nullptr if aborted)
+    std::unique_ptr<UserEventInformation> info;
+    /// products saved from the event (nullptr if aborted)
+    std::unique_ptr<framework::Event> products;
+  };
+
+  /**
+   * Class constructor.
+   *
+   * @param parameters The parameters used to configure the simulation.
+   * @param num_threads Number of worker threads to simulate with.
+   * @param save Function saving the products of an event on a worker.
+   */
+  MTRunManager(framework::config::Parameters& parameters, int num_threads,
+               SaveFunction save);
+
+  /**
+   * Class destructor.
+   */
+  virtual ~MTRunManager();
+
+  /**
+   * Perform application initialization.
+   *
+   * The physics list and the actions are given to Geant4 here, the
+   * workers build their own copies of them from these.
+   *
+   * @throws Exception if the configuration cannot be run on several threads
+   */
+  void Initialize() override;
+
+  /**
+   * Give the seeds for the events of the next batch to the workers
+   *
+   * If seeds were given to simulate, Geant4 is told to use them instead
+   * of drawing the seeds for each event from the master engine.
+   * Either way, the workers seed each event with its own seeds.
+   *
+   * @throws Exception if Geant4 was told to seed once per group of
+   *  events instead of once per event
+   *
+   * @param num_events Number of events in the batch.
+   * @return true if we filled the seeds for the events
+   */
+  G4bool InitializeSeeds(G4int num_events) override;
+
+  /**
+   * Simulate a batch of events
+   *
+   * This blocks until all of the events in the batch are done.
+   *
+   * @param num_events Number of events to simulate.
+   * @param pass_name Pass name for the events holding the products.
+   * @param seeds Two seeds for each event in the batch, if empty
+   *  the seeds for each event are drawn from the master engine.
+   */
+  void simulate(int num_events, const std::string& pass_name,
+                std::vector<long> seeds = {});
+
+  /**
+   * Are there any simulated events left?
+   *
+   * @return true if all simulated events have been taken
+   */
+  bool empty() const;
+
+  /**
+   * Take the next simulated event
+   *
+   * @return the simulated event with the lowest Geant4 ID
+   */
+  SimulatedEvent next();
+
+  /**
+   * Drop any simulated events that have not been taken.
+   */
+  void clear();
+
+ private:
+  /// Number of events handed to a worker at a time
+  static constexpr G4int EVENT_MODULO{1};
+
+  /**
+   * @class Collector
+   * @brief UserAction storing the results of each event on the workers
+   *
+   * This is registered after all of the configured UserActions so that
+   * it sees the final state of each event.
+   */
+  class Collector : public UserAction {
+   public:
+    /**
+     * Constructor.
+     *
+     * @param parameters Unused parameters for the UserAction.
+     * @param manager The run manager storing the results.
+     */
+    Collector(framework::config::Parameters& parameters,
+              MTRunManager& manager);
+
+    /**
+     * Save the products of the event and hand them to the manager.
+     *
+     * @param event The event that was just simulated.
+     */
+    void EndOfEventAction(const G4Event* event) override;
+
+    /// only an event action
+    std::vector<TYPE> getTypes() override { return {TYPE::EVENT}; }
+
+   private:
+    /// the run manager storing the results
+    MTRunManager& manager_;
+  };
+
+  /// The set of parameters used to configure the MTRunManager
+  framework::config::Parameters parameters_;
+
+  /// Function saving the tracks and hits of the current worker event
+  SaveFunction save_;
+
+  /// Action storing the results of each event
+  std::unique_ptr<Collector> collector_;
+
+  /// Generator action of the master so that it knows the generators
+  std::unique_ptr<g4user::PrimaryGeneratorAction> master_generators_;
+
+  /// Pass name for the events holding the products
+  std::string pass_name_;
+
+  /// Seeds for the events of the current batch
+  std::vector<long> seeds_;
+
+  /**
+   * Simulated events of the current batch indexed by their Geant4 ID
+   *
+   * This is sized before the batch starts and each worker only fills
+   * the slots of the events it simulates, so no locking is needed.
+   * It is only read once BeamOn has waited for all of the workers.
+   */
+  std::vector<SimulatedEvent> results_;
+
+  /// Index of the next simulated event to take
+  std::size_t next_{0};
+};  // MTRunManager
+}  // namespace simcore
+
+#endif  // SIMCORE_MTRUNMANAGER_H
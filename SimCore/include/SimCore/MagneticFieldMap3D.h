@@ -12,8 +12,10 @@
 #include "G4MagneticField.hh"
 
 // STL
-#include <vector>
-using std::vector;
+#include <memory>
+
+// LDMX
+#include "DetDescr/FieldMap.h"
 
 namespace simcore {
 
@@ -55,6 +57,10 @@ namespace simcore {
  *
  * x y z B_x B_y B_z
  *
+ * The map can also be a binary file written by `convert-field-map`,
+ * see ldmx::FieldMap. The grid is shared with any other user of the same
+ * file in this process (e.g. the tracking).
+ *
  * Original PurgMagTabulatedField3D code developed by: S.Larsson and J.
  * Generowicz.
  */
@@ -81,9 +87,7 @@ class MagneticFieldMap3D : public G4MagneticField {
   /*
    * Storage space for the table.
    */
-  vector<vector<vector<double>>> xField_;
-  vector<vector<vector<double>>> yField_;
-  vector<vector<vector<double>>> zField_;
+  std::shared_ptr<const ldmx::FieldMap> map_;
 
   /*
    * The dimensions of the table.
@@ -7,8 +7,17 @@
 #ifndef SIMCORE_MAGNETICFIELDSTORE_H_
 #define SIMCORE_MAGNETICFIELDSTORE_H_
 
+// STL
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 // Geant4
+#include "G4FieldManager.hh"
+#include "G4LogicalVolume.hh"
 #include "G4MagneticField.hh"
+#include "G4TransportationManager.hh"
 
 namespace simcore {
 
@@ -61,11 +70,53 @@ class MagneticFieldStore {
     magFields_[name] = magField;
   }
 
+  /**
+   * Remember that a field was attached to a volume and its daughters.
+   * @param volume The logical volume the field was attached to.
+   * @param magField The magnetic field attached to it.
+   */
+  void addVolumeField(G4LogicalVolume* volume, G4MagneticField* magField) {
+    volumeFields_.emplace_back(volume, magField);
+  }
+
+  /**
+   * Remember that a field was assigned as the global field.
+   * @param magField The global magnetic field.
+   */
+  void setGlobalField(G4MagneticField* magField) { globalField_ = magField; }
+
+  /**
+   * Attach the fields to the geometry for the calling thread
+   *
+   * In multi-threaded mode, the field managers (and their chord finders)
+   * are per thread while the fields and the geometry are shared.
+   * The fields are attached to the geometry on the master thread
+   * while the geometry is read, so each worker thread needs to create
+   * its own field managers for the same volumes.
+   */
+  void constructFieldManagers() const {
+    for (const auto& [volume, magField] : volumeFields_) {
+      volume->SetFieldManager(new G4FieldManager(magField), true);
+    }
+    if (globalField_) {
+      auto transport{G4TransportationManager::GetTransportationManager()};
+      G4FieldManager* fieldMgr = transport->GetFieldManager();
+      fieldMgr->SetDetectorField(globalField_);
+      fieldMgr->CreateChordFinder(globalField_);
+    }
+  }
+
  private:
   /**
    * Map of names to magnetic fields.
    */
   MagFieldMap magFields_;
+
+  /// volumes with a field attached to them and their daughters
+  std::vector<std::pair<G4LogicalVolume*, G4MagneticField*>> volumeFields_;
+
+  /// the global field (if there is one)
+  G4MagneticField* globalField_{nullptr};
 };
 
 }  // namespace simcore
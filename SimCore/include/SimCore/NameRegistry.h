@@ -0,0 +1,213 @@
+/**
+ * @file NameRegistry.h
+ * @brief Class resolving the names of regions, volumes and processes once
+ */
+
+#ifndef SIMCORE_NAMEREGISTRY_H_
+#define SIMCORE_NAMEREGISTRY_H_
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4String.hh"
+
+class G4Region;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+class G4VProcess;
+
+namespace simcore {
+
+/**
+ * @class NameRegistry
+ * @brief Resolve names of Geant4 objects to pointers once per run
+ *
+ * Many of our filters check which region or volume a track is in or
+ * which process created a secondary on every step. Comparing the names
+ * of these objects is much slower than comparing pointers, so the
+ * filters intern the names they care about when they are created and
+ * compare the objects against the returned handles while stepping.
+ *
+ * ```cpp
+ * // when the filter is constructed
+ * target_ = simcore::NameRegistry::get().region("target");
+ * // while stepping
+ * if (!simcore::NameRegistry::get().matches(region, target_)) return;
+ * ```
+ *
+ * The names are resolved into the objects they select at the beginning
+ * of each run (see g4user::RunAction) since that is the first time we
+ * know the geometry and physics are fully constructed.
+ * A handle can select more than one object (e.g. the processes with
+ * a name containing "eBrem" are attached to both electrons and positrons)
+ * or none if the name does not exist in the current geometry or physics.
+ *
+ * Each thread has its own registry since the processes are created
+ * separately for each worker thread when running with several threads.
+ */
+class NameRegistry {
+ public:
+  /**
+   * Handle to an interned name for a type of Geant4 object
+   *
+   * The type parameter makes sure that handles are only matched
+   * against the type of object they were interned for.
+   */
+  template <typename T>
+  struct Handle {
+    /// index of the name in the registry
+    std::size_t index;
+  };
+
+  /// handle to selection of regions
+  using RegionHandle = Handle<G4Region>;
+  /// handle to selection of logical volumes
+  using LogicalVolumeHandle = Handle<G4LogicalVolume>;
+  /// handle to selection of physical volumes
+  using PhysicalVolumeHandle = Handle<G4VPhysicalVolume>;
+  /// handle to selection of processes
+  using ProcessHandle = Handle<G4VProcess>;
+
+  /// function selecting objects by their name
+  using Selector = std::function<bool(const G4String&)>;
+
+  /**
+   * Get the registry for the calling thread
+   *
+   * @return reference to the registry
+   */
+  static NameRegistry& get() {
+    thread_local NameRegistry the_registry;
+    return the_registry;
+  }
+
+  /**
+   * Intern the name of a region
+   *
+   * @param[in] name exact name of region
+   * @return handle to region with that name
+   */
+  RegionHandle region(const std::string& name);
+
+  /**
+   * Intern the name of a physical volume
+   *
+   * @param[in] name exact name of physical volume (e.g. recoil_PV)
+   * @return handle to physical volumes with that name
+   */
+  PhysicalVolumeHandle physicalVolume(const std::string& name);
+
+  /**
+   * Intern a selection of logical volumes
+   *
+   * @param[in] select function returning true for names of volumes to select
+   * @return handle to selected logical volumes
+   */
+  LogicalVolumeHandle logicalVolumes(Selector select);
+
+  /**
+   * Intern the name of a process
+   *
+   * Biased processes are wrapped into a process whose name contains the
+   * name of the original process, so we default to selecting all of the
+   * processes whose name contains the input name.
+   *
+   * @param[in] name name of process
+   * @param[in] exact only select processes with exactly this name
+   * @return handle to processes with that name
+   */
+  ProcessHandle process(const std::string& name, bool exact = false);
+
+  /**
+   * Resolve all of the interned names into the objects they select
+   *
+   * This is called at the beginning of each run. Names interned after
+   * the first call are resolved immediately.
+   */
+  void resolve();
+
+  /**
+   * Check if an object is selected by a handle
+   *
+   * @param[in] object pointer to object to check (may be nullptr)
+   * @param[in] handle interned name to check against
+   * @return true if the handle selects the object
+   */
+  template <typename T>
+  bool matches(const T* object, Handle<T> handle) const {
+    const auto& selected{table<T>()[handle.index].selected};
+    return std::binary_search(selected.begin(), selected.end(), object);
+  }
+
+ private:
+  /// an interned name and the objects it currently selects
+  struct Entry {
+    /// function selecting objects by name
+    Selector select;
+    /// sorted pointers to the selected objects
+    std::vector<const void*> selected;
+  };
+
+  /// only get can create the registry
+  NameRegistry() = default;
+
+  /**
+   * Get the table of interned names for a type of object
+   */
+  template <typename T>
+  const std::vector<Entry>& table() const {
+    if constexpr (std::is_same_v<T, G4Region>) {
+      return regions_;
+    } else if constexpr (std::is_same_v<T, G4LogicalVolume>) {
+      return logical_volumes_;
+    } else if constexpr (std::is_same_v<T, G4VPhysicalVolume>) {
+      return physical_volumes_;
+    } else {
+      static_assert(std::is_same_v<T, G4VProcess>,
+                    "NameRegistry only knows regions, volumes and processes");
+      return processes_;
+    }
+  }
+
+  /**
+   * Add an entry to a table and resolve it if we already have resolved
+   *
+   * @param[in] table table to add entry to
+   * @param[in] select selector for the entry
+   * @return index of new entry in table
+   */
+  std::size_t intern(std::vector<Entry>& table, Selector select);
+
+  /// resolve the entries for regions
+  void resolveRegions(Entry& entry) const;
+  /// resolve the entries for logical volumes
+  void resolveLogicalVolumes(Entry& entry) const;
+  /// resolve the entries for physical volumes
+  void resolvePhysicalVolumes(Entry& entry) const;
+  /// resolve the entries for processes
+  void resolveProcesses(Entry& entry) const;
+
+  /// interned region names
+  std::vector<Entry> regions_;
+  /// interned logical volume selections
+  std::vector<Entry> logical_volumes_;
+  /// interned physical volume names
+  std::vector<Entry> physical_volumes_;
+  /// interned process names
+  std::vector<Entry> processes_;
+  /// have we resolved the names yet?
+  bool resolved_{false};
+};  // NameRegistry
+
+}  // namespace simcore
+
+#endif  // SIMCORE_NAMEREGISTRY_H_
@@ -69,6 +69,18 @@ class PrimaryGenerator : public G4VPrimaryGenerator {
    */
   virtual void RecordConfig(const std::string& id, ldmx::RunHeader& rh) = 0;
 
+  /**
+   * Can this generator be used on several threads at once?
+   *
+   * When Geant4 runs with several worker threads, each worker creates its
+   * own copy of the generator. This is only safe if a copy does not share
+   * state with the others (e.g. an input file) and only draws random
+   * numbers from the Geant4 engine of its thread. Generators must opt in.
+   *
+   * @return true if each worker can have its own copy of this generator
+   */
+  virtual bool isClonable() const { return false; }
+
  protected:
   /// Name of the PrimaryGenerator
   std::string name_{""};
@@ -18,21 +18,26 @@ class ReSimulator : public SimulatorBase {
    */
   void configure(framework::config::Parameters& parameters) override;
   /**
-   * Run resimulation if the event is part of the requested sets of events to
-   * resimulate
+   * Only read the requested events from the input file
    *
-   * @param event The event to process.
+   * The entries holding the requested events are looked up in an index
+   * of the file so that the other events are never read or processed.
+   *
+   * @param file The input file that was just opened.
    */
-  void produce(framework::Event& event) override;
+  void onFileOpen(framework::EventFile& file) override;
 
- private:
   /**
-   * Check if an event should be skipped during resimulation
+   * Resimulate the event
    *
-   * @param[in] event handle to the current event being processed
+   * Only the requested events are read from the input files,
+   * so every event given to us is resimulated.
+   *
+   * @param event The event to process.
    */
-  bool skip(framework::Event& event) const;
+  void produce(framework::Event& event) override;
 
+ private:
   /**
    * List of events in the input files that should be resimulated if
    * `resimulate_all_events` is false.
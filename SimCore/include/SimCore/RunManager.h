@@ -17,7 +17,6 @@
 //------------//
 //   Geant4   //
 //------------//
-#include "G4PhysListFactory.hh"
 #include "G4RunManager.hh"
 
 /*~~~~~~~~~~~~~~~*/
@@ -26,6 +25,9 @@
 #include "Framework/Configure/Parameters.h"
 #include "SimCore/KaonPhysics.h"
 
+// Forward declare to avoid including physics list headers
+class G4VModularPhysicsList;
+
 namespace simcore {
 
 // Forward declare to avoid circular dependency in headers
@@ -55,6 +57,29 @@ class RunManager : public G4RunManager {
    */
   void setupPhysics();
 
+  /**
+   * Build the physics list for the simulation
+   *
+   * This also creates the configured biasing operators on the calling
+   * thread so that the biasing physics knows which particles to bias.
+   *
+   * @param parameters The parameters used to configure the simulation.
+   * @return new physics list, the run manager takes ownership of it
+   */
+  static G4VModularPhysicsList* buildPhysicsList(
+      framework::config::Parameters& parameters);
+
+  /**
+   * Reactivate the dark brem process for the next event
+   *
+   * Some filters deactivate the dark brem process once it has occurred.
+   * This goes through the processes attached to the electron on the
+   * calling thread and reactivates any process that contains the
+   * G4DarkBremmstrahlung name. This covers both cases where the
+   * process is biased and not.
+   */
+  static void reactivateDarkBrem();
+
   /**
    * Perform application initialization.
    */
@@ -89,11 +114,6 @@ class RunManager : public G4RunManager {
   /// The set of parameters used to configure the RunManager
   framework::config::Parameters parameters_;
 
-  /**
-   * Factory class for instantiating the physics list.
-   */
-  G4PhysListFactory physicsListFactory_;
-
   /**
    * Flag indicating whether a parallel world should be
    * registered
@@ -8,6 +8,9 @@
 #ifndef SIMCORE_ECALSD_H_
 #define SIMCORE_ECALSD_H_
 
+// STL
+#include <vector>
+
 // LDMX
 #include "DetDescr/EcalID.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
@@ -72,13 +75,75 @@ class EcalSD : public SensitiveDetector {
   virtual void saveHits(framework::Event& event) override;
 
   /**
-   * Clear the map of hits we have accumulated
+   * Clear the hits we have accumulated
    */
-  virtual void OnFinishedEvent() override { hits_.clear(); }
+  virtual void OnFinishedEvent() override;
 
  private:
-  /// map of hits to add to the event (will be squashed)
-  std::map<ldmx::EcalID, ldmx::SimCalorimeterHit> hits_;
+  /**
+   * Entry in the table of hit contributions
+   *
+   * The entry is only in use if its generation is the current one,
+   * so the table can be emptied by moving to the next generation.
+   */
+  struct ContribSlot {
+    /// index of hit in hits_
+    int hit{-1};
+    /// track ID of contributor
+    int track_id{-1};
+    /// PDG ID of contributor
+    int pdg{0};
+    /// index of contrib in the hit
+    int contrib{-1};
+    /// generation this entry was filled in
+    unsigned int generation{0};
+  };
+
+  /**
+   * Dense index of a cell in hit_index_
+   *
+   * @param[in] id EcalID of the cell
+   * @return index of the cell
+   */
+  std::size_t cellIndex(ldmx::EcalID id) const {
+    return (id.layer() * num_modules_ + id.module()) * num_cells_ + id.cell();
+  }
+
+  /**
+   * Get the index of the contrib of a track to a hit
+   *
+   * If the track with this PDG ID has not contributed to this hit yet,
+   * a new entry is made with an index of -1 which should be set
+   * to the index of the new contrib.
+   *
+   * @param[in] hit index of hit in hits_
+   * @param[in] track_id track ID of contributor
+   * @param[in] pdg PDG ID of contributor
+   * @return reference to the index of the contrib in the hit
+   */
+  int& contribIndex(int hit, int track_id, int pdg);
+
+  /**
+   * Reset the cell and contrib lookups for the next event
+   *
+   * Only the cells that were hit are visited.
+   */
+  void resetLookups();
+
+  /// hits to add to the event in the order the cells were first hit
+  std::vector<ldmx::SimCalorimeterHit> hits_;
+  /// index of the hit in hits_ for each cell, -1 if the cell was not hit
+  std::vector<int> hit_index_;
+  /// number of modules in a layer for the dense cell index
+  int num_modules_{0};
+  /// number of cells in a module for the dense cell index
+  int num_cells_{0};
+  /// open addressing hash table of contribs to hits
+  std::vector<ContribSlot> contrib_table_;
+  /// number of entries in use in the contrib table
+  std::size_t num_contribs_{0};
+  /// current generation of the contrib table
+  unsigned int contrib_generation_{1};
   /// enable hit contribs
   bool enableHitContribs_;
   /// compress hit contribs
@@ -84,7 +84,7 @@ class HcalSD : public SensitiveDetector {
    * Add our hits to the event bus and then reset the container
    */
   virtual void saveHits(framework::Event& event) override {
-    event.add(COLLECTION_NAME, hits_);
+    event.add(COLLECTION_NAME, std::move(hits_));
   }
 
   virtual void OnFinishedEvent() override { hits_.clear(); }
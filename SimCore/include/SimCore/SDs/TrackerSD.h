@@ -48,7 +48,7 @@ class TrackerSD : public SensitiveDetector {
    * Add the hits to the event and then reset the container
    */
   virtual void saveHits(framework::Event& event) override {
-    event.add(collection_name_, hits_);
+    event.add(collection_name_, std::move(hits_));
   }
 
   virtual void OnFinishedEvent() override { hits_.clear(); }
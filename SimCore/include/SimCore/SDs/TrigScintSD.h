@@ -51,7 +51,7 @@ class TrigScintSD : public SensitiveDetector {
    * Save our hits collection into the event bus and reset it.
    */
   virtual void saveHits(framework::Event& event) override {
-    event.add(collection_name_, hits_);
+    event.add(collection_name_, std::move(hits_));
   }
 
   virtual void OnFinishedEvent() override { hits_.clear(); }
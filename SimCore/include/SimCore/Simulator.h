@@ -12,6 +12,7 @@
 /*   C++ StdLib   */
 /*~~~~~~~~~~~~~~~~*/
 #include <any>
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -108,10 +109,43 @@ class Simulator : public SimulatorBase {
    */
   void setSeeds(std::vector<int> seeds);
 
+  /**
+   * Export the next event simulated with several threads
+   *
+   * If all of the simulated events have been taken, the next batch of
+   * events is simulated first. The events of a batch are seeded for
+   * the tries following the current one, so the batch is dropped if
+   * we did not see one of those tries (e.g. it was aborted by an
+   * earlier processor). The batch is no larger than the number
+   * of events the process still has to complete, so events are only
+   * left unused at the end if a later processor aborts some of them.
+   * The events are taken in the order they were started, independent
+   * of the thread that simulated them.
+   *
+   * @param event The event to put the simulated event into.
+   */
+  void produceFromBatch(framework::Event& event);
+
+  /**
+   * Get the seeds for the Geant4 engine for an event
+   *
+   * The seeds are drawn from the substream of the seed service given
+   * by the try the event is simulated for (see Process::getTryNumber).
+   * An event gets the same seeds whether it is simulated on its own or
+   * on one of the worker threads.
+   *
+   * @param[in] try_number index of the try the event is simulated for
+   * @returns the two seeds for the Geant4 engine
+   */
+  std::array<long, 2> eventSeeds(int try_number);
+
  private:
   /// Number of events started
   int numEventsBegan_{0};
 
+  /// Try that the next event simulated with several threads is for
+  int nextTry_{-1};
+
   /// Number of events completed
   int numEventsCompleted_{0};
 
@@ -15,6 +15,7 @@
 #include "SimCore/G4Session.h"
 #include "SimCore/G4User/TrackingAction.h"
 #include "SimCore/Geo/ParserFactory.h"
+#include "SimCore/MTRunManager.h"
 #include "SimCore/RunManager.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/UserEventInformation.h"
@@ -46,6 +47,13 @@ class SimulatorBase : public framework::Producer {
   /// Manager controlling G4 simulation run
   std::unique_ptr<RunManager> runManager_;
 
+  /// Manager controlling G4 simulation run with several threads
+  ///   only one of runManager_ and mtRunManager_ is created
+  std::unique_ptr<MTRunManager> mtRunManager_;
+
+  /// Construction of the detector, owned by the run manager
+  DetectorConstruction* detector_{nullptr};
+
   /// Handle to the G4Session -> how to deal with G4cout and G4cerr
   std::unique_ptr<G4UIsession> sessionHandle_;
 
@@ -59,6 +67,14 @@ class SimulatorBase : public framework::Producer {
 
   /// Vebosity for the simulation
   int verbosity_{1};
+  /// Number of threads to simulate with, more than one uses mtRunManager_
+  int num_threads_{1};
+  /// Number of events to simulate at once when using several threads
+  int events_per_batch_{64};
+  /// Seed each event from its own substream of the seed service
+  bool seed_each_event_{false};
+  /// Save the SimParticles as a columnar SimParticleTable
+  bool sim_particle_table_{false};
   /// The parameters used to configure the simulation
   framework::config::Parameters parameters_;
 
@@ -74,6 +90,13 @@ class SimulatorBase : public framework::Producer {
    */
   virtual void updateEventHeader(ldmx::EventHeader& eventHeader) const;
 
+  /*
+   * Update the event header from the information of an event that
+   * was simulated on a worker thread.
+   */
+  virtual void updateEventHeader(ldmx::EventHeader& eventHeader,
+                                 UserEventInformation& eventInfo) const;
+
   /*
    * Save all tracks from the event that are marked for saving
    */
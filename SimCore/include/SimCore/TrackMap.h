@@ -2,7 +2,7 @@
 #define SIMCORE_TRACKMAP_H_
 
 // STL
-#include <unordered_map>
+#include <vector>
 
 // Geant4
 #include "G4Event.hh"
@@ -10,6 +10,7 @@
 
 // LDMX
 #include "SimCore/Event/SimParticle.h"
+#include "SimCore/Event/SimParticleTable.h"
 #include "SimCore/UserPrimaryParticleInformation.h"
 #include "SimCore/UserTrackInformation.h"
 
@@ -33,12 +34,37 @@ class TrackMap {
    */
   void insert(const G4Track* track);
 
+  /**
+   * Add a record in the map for a track
+   *
+   * The incident track of the new track is resolved here so that
+   * findIncident does not need to walk the ancestry. This relies on
+   * parents being inserted before their children, which is the case
+   * since Geant4 creates the children while tracking the parent.
+   * If the parent has not been inserted, the parent is used as the
+   * incident track of a child originating in the calorimeter region.
+   *
+   * @param trackID ID of track to insert
+   * @param parentID ID of parent of track (0 for primaries)
+   * @param inCalRegion true if the track originated in the calorimeter region
+   */
+  void insert(int trackID, int parentID, bool inCalRegion);
+
   /**
    * Check if the passed track has already been inserted
    * into the track map.
    */
   inline bool contains(const G4Track* track) const {
-    return ancestry_.find(track->GetTrackID()) != ancestry_.end();
+    return contains(track->GetTrackID());
+  }
+
+  /**
+   * Check if the track with the given ID has already been inserted
+   * into the track map.
+   */
+  inline bool contains(int trackID) const {
+    return trackID >= 0 and trackID < int(ancestry_.size()) and
+           ancestry_[trackID].parent >= 0;
   }
 
   /**
@@ -54,6 +80,11 @@ class TrackMap {
    * If this track ID does not have such a trajectory, then the
    * track ID of the primary in its parentage is returned.
    *
+   * The incident is resolved when the track is inserted, so this is
+   * a single lookup no matter how deep the track is in a shower.
+   *
+   * @throws Exception if the track has not been inserted
+   *
    * @param trackID The track ID to search its parentage for the incident
    */
   int findIncident(int trackID) const;
@@ -86,6 +117,17 @@ class TrackMap {
    */
   void traceAncestry();
 
+  /**
+   * Build the columnar table of the particles that will be stored.
+   *
+   * The ancestry of the particles is written directly into the flat
+   * index arrays of the table, so traceAncestry does not need to be
+   * called before.
+   *
+   * @return table of particles to be stored in output event
+   */
+  ldmx::SimParticleTable buildParticleTable() const;
+
   /**
    * Clear the internal maps.
    *
@@ -112,27 +154,59 @@ class TrackMap {
 
  private:
   /**
-   * ancestry map of particles in event (child -> parent)
+   * Ancestry of a single track
+   */
+  struct Ancestry {
+    /// ID of parent track, -1 if the track has not been inserted
+    int parent{-1};
+    /// ID of the nearest ancestor incident on the calorimeter region
+    int incident{-1};
+    /// ID of the first child, 0 if there are no children
+    int first_child{0};
+    /// ID of the last child, 0 if there are no children
+    int last_child{0};
+    /// ID of the next child of our parent, 0 if we are the last one
+    int next_sibling{0};
+  };
+
+  /**
+   * Call a function on each child of a track
+   *
+   * @param[in] trackID ID of track whose children to visit
+   * @param[in] visit function called with the ID of each child
+   */
+  template <typename Visitor>
+  void forEachChild(int trackID, Visitor visit) const {
+    if (trackID < 0 or trackID >= int(ancestry_.size())) return;
+    for (int child{ancestry_[trackID].first_child}; child != 0;
+         child = ancestry_[child].next_sibling) {
+      visit(child);
+    }
+  }
+
+  /**
+   * ancestry of particles in event indexed by track ID (child -> parent)
+   *
+   * Geant4 numbers the tracks in an event consecutively starting from 1,
+   * so a vector indexed by the track ID is dense.
    *
    * Primary particles are given a "parent" ID of 0 to reflect
    * that they don't have a parent. This is the default in Geant4
    * and we assume that holds here.
    *
-   * This is helpful for the findIncident method which looks
-   * up through a track's history to find the first ancestor
-   * which originated outside of the calorimeter region.
+   * We also store the incident track for the findIncident method,
+   * the first ancestor (including the track itself) which originated
+   * outside of the calorimeter region.
    *
-   * The key value is a pair where the first entry
-   * is the parent track ID and the second entry is
-   * whether **the child track** is in the calorimeter region.
+   * The children of each track (parent -> children) are kept as a
+   * list linked through the entries of their siblings, so recording
+   * the descendents of all tracks does not allocate anything beyond
+   * this vector. A parent may have children before it is inserted.
    *
    * @see isInCalorimeterRegion for how we check if a track
    * originated in the calorimeter region.
    */
-  std::unordered_map<int, std::pair<int, bool>> ancestry_;
-
-  /// descendents map of particles in event (parent -> children)
-  std::unordered_map<int, std::vector<int>> descendents_;
+  std::vector<Ancestry> ancestry_;
 
   /// map of SimParticles that will be stored
   std::map<int, ldmx::SimParticle> particle_map_;
@@ -76,6 +76,22 @@ class simulator(Producer):
         Use the seed stored in the EventHeader for random generation
     verbosity : int, optional
         Verbosity level to print
+    num_threads : int, optional
+        Number of Geant4 worker threads, more than one simulates events in batches
+    events_per_batch : int, optional
+        Number of events to simulate at once when using more than one thread.
+        The last batch is cut short at the number of events still to be produced,
+        only events aborted by later processors lead to extra simulated events.
+    seed_each_event : bool, optional
+        Seed each event from the substream of the RandomNumberSeedService for its try.
+        Always done with more than one thread, so turning this on with one thread
+        reproduces the events simulated with several threads.
+    sim_particle_table : bool, optional
+        Save the particles as a columnar ldmx::SimParticleTable named
+        'SimParticleTable' instead of the map of ldmx::SimParticle named 'SimParticles'.
+        The table is faster to write and read for events with many saved particles.
+        The tracking truth matching and the SimObjects DQM read either one, other
+        readers of the particles still need the map.
     """
 
     def __init__(self, instance_name ) :
@@ -101,6 +117,10 @@ class simulator(Producer):
         self.rootPrimaryGenUseSeed = False
         self.validate_detector = False
         self.verbosity = 0
+        self.num_threads = 1
+        self.events_per_batch = 64
+        self.seed_each_event = False
+        self.sim_particle_table = False
 
 
         #Dark Brem stuff
@@ -174,7 +194,9 @@ class simulator(Producer):
             resimulate all events.
 
             Events that are not present in any of the input files will be
-            ignored.
+            ignored. The requested events are looked up in an index of each
+            input file and only they are read, so the other events in the
+            input files are never processed (or counted towards maxEvents).
 
             For multiple input files, if an event number is present within more
             than one input file all versions will be resimulated unless the which_runs
@@ -194,6 +216,8 @@ class simulator(Producer):
         """
         resimulator = self
         resimulator.className = 'simcore::ReSimulator'
+        # events are re-simulated one at a time from their own seeds
+        resimulator.num_threads = 1
         if which_events is None:
             resimulator.resimulate_all_events = True
             resimulator.care_about_run = False
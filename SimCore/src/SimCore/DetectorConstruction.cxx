@@ -1,6 +1,8 @@
 #include "SimCore/DetectorConstruction.h"
 
 #include "Framework/Exception/Exception.h"
+#include "G4Threading.hh"
+#include "SimCore/MagneticFieldStore.h"
 #include "SimCore/SensitiveDetector.h"
 #include "SimCore/XsecBiasingOperator.h"
 
@@ -126,6 +128,21 @@ G4VPhysicalVolume* DetectorConstruction::Construct() {
 }
 
 void DetectorConstruction::ConstructSDandField() {
+  // Running with several threads, this is called on each worker thread.
+  //  The geometry is shared with the master, but the field managers and
+  //  the biasing operators need to be created for each worker.
+  if (G4Threading::IsWorkerThread()) {
+    MagneticFieldStore::getInstance()->constructFieldManagers();
+    auto biasing_operators{
+        parameters_.getParameter<std::vector<framework::config::Parameters>>(
+            "biasing_operators", {})};
+    for (framework::config::Parameters& bop : biasing_operators) {
+      simcore::XsecBiasingOperator::Factory::get().make(
+          bop.getParameter<std::string>("class_name"),
+          bop.getParameter<std::string>("instance_name"), bop);
+    }
+  }
+
   auto sens_dets{
       parameters_.getParameter<std::vector<framework::config::Parameters>>(
           "sensitive_detectors", {})};
@@ -147,7 +164,8 @@ void DetectorConstruction::ConstructSDandField() {
 
   // Biasing operators were created in RunManager::setupPhysics
   //  which is called before G4RunManager::Initialize
-  //  which is where this method ends up being called.
+  //  which is where this method ends up being called
+  //  (or above if we are on a worker thread).
   simcore::XsecBiasingOperator::Factory::get().apply([&](auto bop) {
     logical_volume_tests::Test includeVolumeTest{nullptr};
     if (bop->getVolumeToBias().compare("ecal") == 0) {
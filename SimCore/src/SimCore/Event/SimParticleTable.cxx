@@ -0,0 +1,143 @@
+#include "SimCore/Event/SimParticleTable.h"
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+ClassImp(ldmx::SimParticleTable)
+
+namespace ldmx {
+
+SimParticleTable::SimParticleTable(
+    const std::map<int, SimParticle>& particles) {
+  for (const auto& [track_id, particle] : particles) add(track_id, particle);
+}
+
+void SimParticleTable::Clear() {
+  trackIDs_.clear();
+  pdgIDs_.clear();
+  genStatus_.clear();
+  processTypes_.clear();
+  energies_.clear();
+  times_.clear();
+  masses_.clear();
+  charges_.clear();
+  vertices_.clear();
+  endPoints_.clear();
+  momenta_.clear();
+  endPointMomenta_.clear();
+  vertexVolumes_.clear();
+  volumes_.clear();
+  volumeIndex_.clear();
+  daughters_.clear();
+  daughterOffsets_.assign(1, 0);
+  parents_.clear();
+  parentOffsets_.assign(1, 0);
+}
+
+void SimParticleTable::Print() const {
+  std::cout << "SimParticleTable { "
+            << "nParticles: " << size() << ", "
+            << "nDaughters: " << daughters_.size() << ", "
+            << "nParents: " << parents_.size() << ", "
+            << "nVolumes: " << volumes_.size() << " }" << std::endl;
+}
+
+std::size_t SimParticleTable::add(int trackID, const SimParticle& particle) {
+  if (not trackIDs_.empty() and trackID <= trackIDs_.back()) {
+    throw std::invalid_argument(
+        "SimParticleTable: particles must be added in order of increasing "
+        "track ID.");
+  }
+  trackIDs_.push_back(trackID);
+  pdgIDs_.push_back(particle.getPdgID());
+  genStatus_.push_back(particle.getGenStatus());
+  processTypes_.push_back(particle.getProcessType());
+  energies_.push_back(particle.getEnergy());
+  times_.push_back(particle.getTime());
+  masses_.push_back(particle.getMass());
+  charges_.push_back(particle.getCharge());
+  for (double x : particle.getVertex()) vertices_.push_back(x);
+  for (double x : particle.getEndPoint()) endPoints_.push_back(x);
+  for (double p : particle.getMomentum()) momenta_.push_back(p);
+  for (double p : particle.getEndPointMomentum()) endPointMomenta_.push_back(p);
+
+  // the index is not persisted, rebuild it if we were read from a file
+  if (volumeIndex_.size() != volumes_.size()) {
+    volumeIndex_.clear();
+    for (std::size_t i{0}; i < volumes_.size(); i++)
+      volumeIndex_[volumes_[i]] = i;
+  }
+  auto [volume, inserted] =
+      volumeIndex_.emplace(particle.getVertexVolume(), volumes_.size());
+  if (inserted) volumes_.push_back(volume->first);
+  vertexVolumes_.push_back(volume->second);
+
+  daughterOffsets_.push_back(daughterOffsets_.back());
+  parentOffsets_.push_back(parentOffsets_.back());
+  for (int daughter : particle.getDaughters()) addDaughter(daughter);
+  for (int parent : particle.getParents()) addParent(parent);
+  return trackIDs_.size() - 1;
+}
+
+void SimParticleTable::addParent(int trackID) {
+  parents_.push_back(trackID);
+  parentOffsets_.back()++;
+}
+
+void SimParticleTable::addDaughter(int trackID) {
+  daughters_.push_back(trackID);
+  daughterOffsets_.back()++;
+}
+
+int SimParticleTable::find(int trackID) const {
+  auto it{std::lower_bound(trackIDs_.begin(), trackIDs_.end(), trackID)};
+  if (it == trackIDs_.end() or *it != trackID) return -1;
+  return it - trackIDs_.begin();
+}
+
+SimParticle SimParticleTable::getParticle(int trackID) const {
+  int i{find(trackID)};
+  if (i < 0) {
+    throw std::out_of_range("SimParticleTable: track " +
+                            std::to_string(trackID) + " is not in the table.");
+  }
+  return particle(i);
+}
+
+std::map<int, SimParticle> SimParticleTable::getMap() const {
+  std::map<int, SimParticle> particles;
+  for (std::size_t i{0}; i < size(); i++) {
+    // rows are in order of track ID so each one is put at the end
+    particles.emplace_hint(particles.end(), trackIDs_[i], particle(i));
+  }
+  return particles;
+}
+
+SimParticle SimParticleTable::particle(std::size_t i) const {
+  SimParticle p;
+  p.setPdgID(pdgIDs_[i]);
+  p.setGenStatus(genStatus_[i]);
+  p.setProcessType(processTypes_[i]);
+  p.setEnergy(energies_[i]);
+  p.setTime(times_[i]);
+  p.setMass(masses_[i]);
+  p.setCharge(charges_[i]);
+  auto [x, y, z] = getVertex(i);
+  p.setVertex(x, y, z);
+  auto [end_x, end_y, end_z] = getEndPoint(i);
+  p.setEndPoint(end_x, end_y, end_z);
+  auto [px, py, pz] = getMomentum(i);
+  p.setMomentum(px, py, pz);
+  auto [end_px, end_py, end_pz] = getEndPointMomentum(i);
+  p.setEndPointMomentum(end_px, end_py, end_pz);
+  p.setVertexVolume(getVertexVolume(i));
+  for (int daughter : getDaughters(i)) p.addDaughter(daughter);
+  for (int parent : getParents(i)) p.addParent(parent);
+  return p;
+}
+
+}  // namespace ldmx
@@ -0,0 +1,79 @@
+/**
+ * @file ActionInitialization.cxx
+ * @brief Class which creates the Geant4 user actions
+ */
+
+#include "SimCore/G4User/ActionInitialization.h"
+
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/G4User/EventAction.h"
+#include "SimCore/G4User/PrimaryGeneratorAction.h"
+#include "SimCore/G4User/RunAction.h"
+#include "SimCore/G4User/StackingAction.h"
+#include "SimCore/G4User/SteppingAction.h"
+#include "SimCore/G4User/TrackingAction.h"
+
+namespace simcore {
+namespace g4user {
+
+ActionInitialization::ActionInitialization(
+    const framework::config::Parameters& parameters,
+    std::vector<UserAction*> extra_actions)
+    : parameters_{parameters}, extra_actions_{extra_actions} {}
+
+void ActionInitialization::BuildForMaster() const {
+  SetUserAction(new RunAction);
+}
+
+void ActionInitialization::Build() const {
+  // create our G4User actions
+  auto primary_action{new PrimaryGeneratorAction(parameters_)};
+  auto run_action{new RunAction};
+  auto event_action{new EventAction};
+  auto tracking_action{new TrackingAction};
+  auto stepping_action{new SteppingAction};
+  auto stacking_action{new StackingAction};
+  // ...and register them with G4
+  SetUserAction(primary_action);
+  SetUserAction(run_action);
+  SetUserAction(event_action);
+  SetUserAction(tracking_action);
+  SetUserAction(stepping_action);
+  SetUserAction(stacking_action);
+
+  // Create all user actions and attch them to the corresponding G4 actions
+  std::vector<UserAction*> actions;
+  auto user_actions{
+      parameters_.getParameter<std::vector<framework::config::Parameters>>(
+          "actions", {})};
+  for (auto& user_action : user_actions) {
+    auto ua = UserAction::Factory::get().make(
+        user_action.getParameter<std::string>("class_name"),
+        user_action.getParameter<std::string>("instance_name"), user_action);
+    actions.push_back(ua.get());
+  }
+  actions.insert(actions.end(), extra_actions_.begin(), extra_actions_.end());
+
+  for (auto& ua : actions) {
+    for (auto& type : ua->getTypes()) {
+      if (type == simcore::TYPE::RUN) {
+        run_action->registerAction(ua);
+      } else if (type == simcore::TYPE::EVENT) {
+        event_action->registerAction(ua);
+      } else if (type == simcore::TYPE::TRACKING) {
+        tracking_action->registerAction(ua);
+      } else if (type == simcore::TYPE::STEPPING) {
+        stepping_action->registerAction(ua);
+      } else if (type == simcore::TYPE::STACKING) {
+        stacking_action->registerAction(ua);
+      } else {
+        EXCEPTION_RAISE("ActionType", "Action type does not exist.");
+      }
+    }
+  }
+}
+
+}  // namespace g4user
+}  // namespace simcore
@@ -11,10 +11,19 @@
 /*~~~~~~~~~~~~*/
 #include "G4Run.hh"
 
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "SimCore/NameRegistry.h"
+
 namespace simcore {
 namespace g4user {
 
 void RunAction::BeginOfRunAction(const G4Run* run) {
+  // the geometry and physics are constructed, so we can look up
+  // the objects the user actions are interested in
+  NameRegistry::get().resolve();
+
   // Call user run action
   for (auto& runAction : runActions_) {
     runAction->BeginOfRunAction(run);
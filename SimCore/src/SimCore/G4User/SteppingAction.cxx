@@ -31,22 +31,22 @@ void SteppingAction::UserSteppingAction(const G4Step* step) {
   event_info->lastStepWasPN(false);
   event_info->lastStepWasEN(false);
   if (secondaries) {
+    const auto& names{NameRegistry::get()};
     double delta_energy = step->GetPreStepPoint()->GetKineticEnergy() -
                           step->GetPostStepPoint()->GetKineticEnergy();
     for (const G4Track* secondary : *secondaries) {
       const G4VProcess* creator{secondary->GetCreatorProcess()};
       if (creator) {
-        const G4String& creator_name{creator->GetProcessName()};
-        if (creator_name.contains("photonNuclear")) {
+        if (names.matches(creator, photonNuclear_)) {
           event_info->addPNEnergy(delta_energy);
           event_info->lastStepWasPN(true);
           break;  // done <- assumes first match determines step process
         }
-        if (creator_name.contains("electronNuclear")) {
+        if (names.matches(creator, electronNuclear_)) {
           event_info->addENEnergy(delta_energy);
           event_info->lastStepWasEN(true);
           break;  // done <- assumes first match determines step process
-        }         // creator name matches PN or EN
+        }         // creator matches PN or EN
       }           // creator exists
     }             // loop over secondaries
   }               // secondaries list was created
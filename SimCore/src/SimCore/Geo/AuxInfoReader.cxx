@@ -80,6 +80,7 @@ void AuxInfoReader::assignAuxInfoToVolumes() {
           lv->SetFieldManager(
               mgr,
               true /* FIXME: hard-coded to force field manager to daughters */);
+          MagneticFieldStore::getInstance()->addVolumeField(lv, magField);
           // G4cout << "Assigned magnetic field " << magFieldName << " to
           // volume " << lv->GetName() << G4endl;
         } else {
@@ -205,6 +206,7 @@ void AuxInfoReader::createMagneticField(const G4String& magFieldName,
     }
     fieldMgr->SetDetectorField(magField);
     fieldMgr->CreateChordFinder(magField);
+    MagneticFieldStore::getInstance()->setGlobalField(magField);
 
   } else {
     EXCEPTION_RAISE("UnknownType", "Unknown MagFieldType '" +
@@ -0,0 +1,147 @@
+/**
+ * @file MTRunManager.cxx
+ * @brief Class providing a multi-threaded Geant4 run manager implementation.
+ */
+
+#include "SimCore/MTRunManager.h"
+
+/*~~~~~~~~~~~~~*/
+/*   SimCore   */
+/*~~~~~~~~~~~~~*/
+#include "Framework/Exception/Exception.h"
+#include "SimCore/G4User/ActionInitialization.h"
+#include "SimCore/G4User/PrimaryGeneratorAction.h"
+#include "SimCore/PrimaryGenerator.h"
+#include "SimCore/RunManager.h"
+#include "SimCore/SensitiveDetector.h"
+
+//------------//
+//   Geant4   //
+//------------//
+#include "G4Event.hh"
+#include "G4RNGHelper.hh"
+#include "G4VModularPhysicsList.hh"
+
+namespace simcore {
+
+MTRunManager::MTRunManager(framework::config::Parameters& parameters,
+                           int num_threads, SaveFunction save)
+    : G4TaskRunManager(),
+      parameters_{parameters},
+      save_{std::move(save)},
+      collector_{std::make_unique<Collector>(parameters_, *this)} {
+  SetNumberOfThreads(num_threads);
+  // seed each event on its own so that its random numbers do not depend
+  //  on which worker simulates it or which events it is handed out with
+  SetSeedOncePerCommunication(0);
+  SetEventModulo(EVENT_MODULO);
+  // store the state of the worker engine before each event is generated
+  //  so we can put it in the event header for re-simulation
+  StoreRandomNumberStatusToG4Event(1);
+}
+
+MTRunManager::~MTRunManager() = default;
+
+void MTRunManager::Initialize() {
+  if (!parameters_.getParameter<std::string>("scoringPlanes").empty()) {
+    EXCEPTION_RAISE("MTConfig",
+                    "Scoring planes cannot be simulated with more than one "
+                    "thread. Set num_threads to 1 to use them.");
+  }
+
+  // the master needs its own generators to record their configuration,
+  //  the workers each create their own when they build their actions
+  master_generators_ =
+      std::make_unique<g4user::PrimaryGeneratorAction>(parameters_);
+  PrimaryGenerator::Factory::get().apply([](auto gen) {
+    if (!gen->isClonable()) {
+      EXCEPTION_RAISE("MTConfig",
+                      "One of the generators cannot be run on more than one "
+                      "thread. Set num_threads to 1 to use it.");
+    }
+  });
+
+  SetUserInitialization(RunManager::buildPhysicsList(parameters_));
+  SetUserInitialization(
+      new g4user::ActionInitialization(parameters_, {collector_.get()}));
+
+  G4TaskRunManager::Initialize();
+}
+
+G4bool MTRunManager::InitializeSeeds(G4int num_events) {
+  // Geant4 commands (e.g. /run/eventModulo) can change these after we set them
+  if (SeedOncePerCommunication() != 0 or eventModuloDef != EVENT_MODULO) {
+    EXCEPTION_RAISE(
+        "MTSeeds",
+        "The workers have to seed each event on their own for the events to "
+        "be reproducible, but the seeding mode is " +
+            std::to_string(SeedOncePerCommunication()) +
+            " instead of 0 and the event modulo is " +
+            std::to_string(eventModuloDef) + " instead of " +
+            std::to_string(EVENT_MODULO) + ".");
+  }
+  if (seeds_.empty()) return false;
+  if (seeds_.size() != std::size_t(nSeedsPerEvent * num_events)) {
+    EXCEPTION_RAISE("MTSeeds", "Given " + std::to_string(seeds_.size()) +
+                                   " seeds for " + std::to_string(num_events) +
+                                   " events.");
+  }
+  G4RNGHelper* helper = G4RNGHelper::GetInstance();
+  helper->Clear();
+  for (long seed : seeds_) helper->AddOneSeed(seed);
+  // all of the seeds for the batch are given at once
+  nSeedsFilled = num_events;
+  return true;
+}
+
+void MTRunManager::simulate(int num_events, const std::string& pass_name,
+                            std::vector<long> seeds) {
+  pass_name_ = pass_name;
+  seeds_ = std::move(seeds);
+  results_.clear();
+  results_.resize(num_events);
+  next_ = 0;
+  BeamOn(num_events);
+}
+
+bool MTRunManager::empty() const { return next_ == results_.size(); }
+
+MTRunManager::SimulatedEvent MTRunManager::next() {
+  if (empty()) {
+    EXCEPTION_RAISE("MTEmpty", "No simulated events left to take.");
+  }
+  return std::move(results_[next_++]);
+}
+
+void MTRunManager::clear() {
+  results_.clear();
+  next_ = 0;
+}
+
+MTRunManager::Collector::Collector(framework::config::Parameters& parameters,
+                                   MTRunManager& manager)
+    : UserAction("MTRunManagerCollector", parameters), manager_{manager} {}
+
+void MTRunManager::Collector::EndOfEventAction(const G4Event* event) {
+  SimulatedEvent result;
+  result.id = event->GetEventID();
+  result.aborted = event->IsAborted();
+  result.seed = event->GetRandomNumberStatus();
+  if (result.aborted) {
+    SensitiveDetector::Factory::get().apply(
+        [](auto sd) { sd->OnFinishedEvent(); });
+  } else {
+    result.info = std::make_unique<UserEventInformation>(
+        *static_cast<UserEventInformation*>(event->GetUserInformation()));
+    result.products = std::make_unique<framework::Event>(manager_.pass_name_);
+    manager_.save_(*result.products);
+  }
+
+  // this is done when each event is terminated on a single thread
+  RunManager::reactivateDarkBrem();
+
+  // the slot of each event is only filled by the worker simulating it
+  manager_.results_.at(result.id) = std::move(result);
+}
+
+}  // namespace simcore
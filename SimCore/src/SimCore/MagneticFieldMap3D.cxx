@@ -4,7 +4,6 @@
 
 // STL
 #include <cmath>
-#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -26,14 +25,6 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
       invertX_(false),
       invertY_(false),
       invertZ_(false) {
-  ifstream file(filename);  // Open the file for reading.
-
-  // Throw an error if file does not exist.
-  if (!file.good()) {
-    EXCEPTION_RAISE("FileDNE", "The field map file '" + std::string(filename) +
-                                   "' does not exist!");
-  }
-
   G4cout << "-----------------------------------------------------------"
          << G4endl;
   G4cout << "    Magnetic Field Map 3D" << G4endl;
@@ -44,60 +35,20 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char* filename, double xOffset,
   G4cout << "  Offsets: " << xOffset << " " << yOffset << " " << zOffset
          << G4endl;
 
-  // Ignore first blank line
-  char buffer[256];
-  file.getline(buffer, 256);
-
-  // Read table dimensions
-  file >> nx_ >> ny_ >> nz_;  // Note dodgy order
+  // Throws an error if file does not exist.
+  map_ = ldmx::FieldMap::load(filename);
+  nx_ = map_->nx();
+  ny_ = map_->ny();
+  nz_ = map_->nz();
 
   G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
 
-  // Set up storage space for table
-  xField_.resize(nx_);
-  yField_.resize(nx_);
-  zField_.resize(nx_);
-  int ix, iy, iz;
-  for (ix = 0; ix < nx_; ix++) {
-    xField_[ix].resize(ny_);
-    yField_[ix].resize(ny_);
-    zField_[ix].resize(ny_);
-    for (iy = 0; iy < ny_; iy++) {
-      xField_[ix][iy].resize(nz_);
-      yField_[ix][iy].resize(nz_);
-      zField_[ix][iy].resize(nz_);
-    }
-  }
-
-  // Ignore other header information
-  // The first line whose second character is '0' is considered to
-  // be the last line of the header.
-  do {
-    file.getline(buffer, 256);
-  } while (buffer[1] != '0');
-
-  // Read in the data
-  double xval, yval, zval, bx, by, bz;
-  for (ix = 0; ix < nx_; ix++) {
-    for (iy = 0; iy < ny_; iy++) {
-      for (iz = 0; iz < nz_; iz++) {
-        file >> xval >> yval >> zval >> bx >> by >> bz;
-        if (ix == 0 && iy == 0 && iz == 0) {
-          minx_ = xval;
-          miny_ = yval;
-          minz_ = zval;
-        }
-        xField_[ix][iy][iz] = bx;
-        yField_[ix][iy][iz] = by;
-        zField_[ix][iy][iz] = bz;
-      }
-    }
-  }
-  file.close();
-
-  maxx_ = xval;
-  maxy_ = yval;
-  maxz_ = zval;
+  minx_ = map_->first()[0];
+  miny_ = map_->first()[1];
+  minz_ = map_->first()[2];
+  maxx_ = map_->last()[0];
+  maxy_ = map_->last()[1];
+  maxz_ = map_->last()[2];
 
   G4cout << "  ... done reading " << G4endl << G4endl;
   G4cout << "Read values of field from file " << filename << G4endl;
@@ -200,55 +151,27 @@ void MagneticFieldMap3D::GetFieldValue(const double point[4],
     mulx1z1 = xlocal * zlocal;
 #endif
 
+    // Field at the corners of the cuboid
+    const double* b000 = map_->at(xindex, yindex, zindex);
+    const double* b001 = map_->at(xindex, yindex, zindex + 1);
+    const double* b010 = map_->at(xindex, yindex + 1, zindex);
+    const double* b011 = map_->at(xindex, yindex + 1, zindex + 1);
+    const double* b100 = map_->at(xindex + 1, yindex, zindex);
+    const double* b101 = map_->at(xindex + 1, yindex, zindex + 1);
+    const double* b110 = map_->at(xindex + 1, yindex + 1, zindex);
+    const double* b111 = map_->at(xindex + 1, yindex + 1, zindex + 1);
+
     // Full 3-dimensional version
-    bfield[0] =
-        xField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        xField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        xField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        xField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        xField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[1] =
-        yField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        yField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        yField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        yField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        yField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[2] =
-        zField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        zField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        zField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        zField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        zField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
+    for (int i = 0; i < 3; i++) {
+      bfield[i] = b000[i] * (1 - xlocal) * (1 - ylocal) * (1 - zlocal) +
+                  b001[i] * (1 - xlocal) * (1 - ylocal) * zlocal +
+                  b010[i] * (1 - xlocal) * ylocal * (1 - zlocal) +
+                  b011[i] * (1 - xlocal) * ylocal * zlocal +
+                  b100[i] * xlocal * (1 - ylocal) * (1 - zlocal) +
+                  b101[i] * xlocal * (1 - ylocal) * zlocal +
+                  b110[i] * xlocal * ylocal * (1 - zlocal) +
+                  b111[i] * xlocal * ylocal * zlocal;
+    }
 
   } else {
     bfield[0] = 0.0;
@@ -0,0 +1,111 @@
+#include "SimCore/NameRegistry.h"
+
+/*~~~~~~~~~~~~*/
+/*   Geant4   */
+/*~~~~~~~~~~~~*/
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4ProcessTable.hh"
+#include "G4ProcessVector.hh"
+#include "G4RegionStore.hh"
+
+namespace simcore {
+
+/**
+ * Select the objects in a store whose names are selected by an entry
+ *
+ * @param[in] store iterable collection of pointers to objects with names
+ * @param[in] select function selecting objects by name
+ * @return sorted pointers to selected objects
+ */
+template <typename Store>
+static std::vector<const void*> selectFrom(
+    const Store& store, const NameRegistry::Selector& select) {
+  std::vector<const void*> selected;
+  for (const auto& object : store) {
+    if (object and select(object->GetName())) selected.push_back(object);
+  }
+  std::sort(selected.begin(), selected.end());
+  return selected;
+}
+
+NameRegistry::RegionHandle NameRegistry::region(const std::string& name) {
+  return {intern(regions_,
+                 [name](const G4String& other) { return other == name; })};
+}
+
+NameRegistry::PhysicalVolumeHandle NameRegistry::physicalVolume(
+    const std::string& name) {
+  return {intern(physical_volumes_,
+                 [name](const G4String& other) { return other == name; })};
+}
+
+NameRegistry::LogicalVolumeHandle NameRegistry::logicalVolumes(
+    Selector select) {
+  return {intern(logical_volumes_, std::move(select))};
+}
+
+NameRegistry::ProcessHandle NameRegistry::process(const std::string& name,
+                                                  bool exact) {
+  if (exact) {
+    return {intern(processes_,
+                   [name](const G4String& other) { return other == name; })};
+  }
+  return {intern(processes_, [name](const G4String& other) {
+    return other.find(name) != std::string::npos;
+  })};
+}
+
+void NameRegistry::resolve() {
+  for (auto& entry : regions_) resolveRegions(entry);
+  for (auto& entry : logical_volumes_) resolveLogicalVolumes(entry);
+  for (auto& entry : physical_volumes_) resolvePhysicalVolumes(entry);
+  for (auto& entry : processes_) resolveProcesses(entry);
+  resolved_ = true;
+}
+
+std::size_t NameRegistry::intern(std::vector<Entry>& table, Selector select) {
+  table.push_back({std::move(select), {}});
+  if (resolved_) {
+    if (&table == &regions_) resolveRegions(table.back());
+    if (&table == &logical_volumes_) resolveLogicalVolumes(table.back());
+    if (&table == &physical_volumes_) resolvePhysicalVolumes(table.back());
+    if (&table == &processes_) resolveProcesses(table.back());
+  }
+  return table.size() - 1;
+}
+
+void NameRegistry::resolveRegions(Entry& entry) const {
+  entry.selected = selectFrom(*G4RegionStore::GetInstance(), entry.select);
+}
+
+void NameRegistry::resolveLogicalVolumes(Entry& entry) const {
+  entry.selected =
+      selectFrom(*G4LogicalVolumeStore::GetInstance(), entry.select);
+}
+
+void NameRegistry::resolvePhysicalVolumes(Entry& entry) const {
+  entry.selected =
+      selectFrom(*G4PhysicalVolumeStore::GetInstance(), entry.select);
+}
+
+void NameRegistry::resolveProcesses(Entry& entry) const {
+  // the process table gives us a copy of its list of processes
+  G4ProcessVector* processes{
+      G4ProcessTable::GetProcessTable()->FindProcesses()};
+  std::vector<const G4VProcess*> all;
+  for (std::size_t i{0}; i < processes->size(); i++) {
+    all.push_back((*processes)[i]);
+  }
+  delete processes;
+  // processes are shared between particles, only keep each one once
+  std::sort(all.begin(), all.end());
+  all.erase(std::unique(all.begin(), all.end()), all.end());
+  entry.selected.clear();
+  for (const G4VProcess* process : all) {
+    if (entry.select(process->GetProcessName()))
+      entry.selected.push_back(process);
+  }
+}
+
+}  // namespace simcore
@@ -3,6 +3,11 @@
 namespace simcore {
 
 void ReSimulator::configure(framework::config::Parameters& parameters) {
+  // each event is re-simulated from its own seed one at a time
+  if (parameters.getParameter<int>("num_threads", 1) > 1) {
+    EXCEPTION_RAISE("InvalidParam",
+                    "The ReSimulator can only be run with one thread.");
+  }
   SimulatorBase::configure(parameters);
   resimulate_all_events_ =
       parameters.getParameter<bool>("resimulate_all_events");
@@ -25,19 +30,34 @@ void ReSimulator::configure(framework::config::Parameters& parameters) {
   }
 }
 
+void ReSimulator::onFileOpen(framework::EventFile& file) {
+  /**
+   * If we are configured to simply resimulate all events,
+   * we read the whole file.
+   */
+  if (resimulate_all_events_) return;
+  /**
+   * Otherwise, we look up the event number
+   * (and also its run number if we care_about_run_)
+   * of the run/event pairs that we are interested in re-simulating.
+   */
+  std::vector<Long64_t> entries;
+  for (const auto& [run, event] : events_to_resimulate_) {
+    auto found{care_about_run_ ? file.findEntries(event, run)
+                               : file.findEntries(event)};
+    entries.insert(entries.end(), found.begin(), found.end());
+  }
+  if (verbosity_ > 0) {
+    std::cout << "Found " << entries.size() << " of the requested events in "
+              << file.getFileName() << std::endl;
+  }
+  file.selectEntries(entries);
+}
+
 void ReSimulator::produce(framework::Event& event) {
   /* numEventsBegan_++; */
   auto& eventHeader{event.getEventHeader()};
   const auto eventNumber{eventHeader.getEventNumber()};
-  if (skip(event)) {
-    if (verbosity_ > 1) {
-      std::cout << "Skipping event: " << eventNumber
-                << " since it wasn't part of the requested events..."
-                << std::endl;
-    }
-    this->abortEvent();  // get out of processors loop
-    return;
-  }
   if (verbosity_ > 0) {
     std::cout << "Resimulating " << eventNumber << std::endl;
   }
@@ -68,28 +88,5 @@ void ReSimulator::produce(framework::Event& event) {
   runManager_->TerminateOneEvent();
 }
 
-bool ReSimulator::skip(framework::Event& event) const {
-  /**
-   * If we are configured to simply resimulate all events, this
-   * function always returns false.
-   */
-  if (resimulate_all_events_) return false;
-  /**
-   * Otherwise, we check the event number
-   * (and also its run number if we care_about_run_)
-   * against the list of run/event pairs that we are
-   * interested in re-simulating.
-   */
-  auto found_event_to_resim = std::find_if(
-      std::begin(events_to_resimulate_), std::end(events_to_resimulate_),
-      [&](const std::pair<int, int>& run_event) -> bool {
-        bool runs_match = true;
-        if (care_about_run_)
-          runs_match = (event.getEventHeader().getRun() == run_event.first);
-        return event.getEventNumber() == run_event.second and runs_match;
-      });
-  return (found_event_to_resim == std::end(events_to_resimulate_));
-}
-
 }  // namespace simcore
 DECLARE_PRODUCER_NS(simcore, ReSimulator)
@@ -1,5 +1,9 @@
 #include "SimCore/SDs/EcalSD.h"
 
+// STL
+#include <algorithm>
+#include <cstdint>
+
 // Geant4
 #include "G4Polyhedron.hh"
 #include "G4Step.hh"
@@ -92,9 +96,22 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   //    is inside of the configured SD volumes from Geant4's point of view
   // ldmx::EcalID id = geometry.getID(position[0], position[1], position[2]);
 
-  if (hits_.find(id) == hits_.end()) {
+  // the layers and modules are checked by getID, so the cell index
+  // is within the geometry it was sized for
+  std::size_t num_cells = geometry.getNumLayers() *
+                          geometry.getNumModulesPerLayer() *
+                          geometry.getNumCellsPerModule();
+  if (hit_index_.size() != num_cells) {
+    hit_index_.assign(num_cells, -1);
+    num_modules_ = geometry.getNumModulesPerLayer();
+    num_cells_ = geometry.getNumCellsPerModule();
+  }
+
+  int& hit_index{hit_index_[cellIndex(id)]};
+  if (hit_index < 0) {
     // hit in empty cell
-    auto& hit = hits_[id];
+    hit_index = hits_.size();
+    auto& hit = hits_.emplace_back();
     hit.setID(id.raw());
     /**
      * convert position to center of cell position
@@ -109,7 +126,7 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
     hit.setPosition(x, y, z);
   }
 
-  auto& hit = hits_[id];
+  auto& hit = hits_[hit_index];
 
   // hit variables
   auto track = aStep->GetTrack();
@@ -118,9 +135,15 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   auto pdg = track->GetParticleDefinition()->GetPDGEncoding();
 
   if (enableHitContribs_) {
-    int contrib_i = hit.findContribIndex(track_id, pdg);
-    if (compressHitContribs_ and contrib_i != -1) {
-      hit.updateContrib(contrib_i, edep, time);
+    if (compressHitContribs_) {
+      int& contrib_i{contribIndex(hit_index, track_id, pdg)};
+      if (contrib_i != -1) {
+        hit.updateContrib(contrib_i, edep, time);
+      } else {
+        contrib_i = hit.getNumberOfContribs();
+        hit.addContrib(getTrackMap().findIncident(track_id), track_id, pdg,
+                       edep, time);
+      }
     } else {
       hit.addContrib(getTrackMap().findIncident(track_id), track_id, pdg, edep,
                      time);
@@ -137,11 +160,61 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
 }
 
 void EcalSD::saveHits(framework::Event& event) {
-  // squash hits into list
-  std::vector<ldmx::SimCalorimeterHit> hits;
-  hits.reserve(hits_.size());
-  for (const auto& [id, hit] : hits_) hits.push_back(hit);
-  event.add(COLLECTION_NAME, hits);
+  resetLookups();
+  // hits are saved in order of their IDs
+  std::sort(hits_.begin(), hits_.end(), [](const auto& lhs, const auto& rhs) {
+    return static_cast<unsigned int>(lhs.getID()) <
+           static_cast<unsigned int>(rhs.getID());
+  });
+  event.add(COLLECTION_NAME, std::move(hits_));
+  hits_.clear();
+}
+
+void EcalSD::OnFinishedEvent() {
+  resetLookups();
+  hits_.clear();
+}
+
+int& EcalSD::contribIndex(int hit, int track_id, int pdg) {
+  // keep the table at most half full
+  if (2 * (num_contribs_ + 1) > contrib_table_.size()) {
+    std::vector<ContribSlot> old_table;
+    old_table.swap(contrib_table_);
+    contrib_table_.resize(std::max<std::size_t>(1024, 2 * old_table.size()));
+    num_contribs_ = 0;
+    for (const auto& slot : old_table) {
+      if (slot.generation == contrib_generation_)
+        contribIndex(slot.hit, slot.track_id, slot.pdg) = slot.contrib;
+    }
+  }
+
+  uint64_t key = (uint64_t(uint32_t(hit)) << 32 | uint32_t(track_id)) ^
+                 uint64_t(uint32_t(pdg)) * 0xC2B2AE3D27D4EB4Full;
+  key *= 0x9E3779B97F4A7C15ull;
+  std::size_t mask = contrib_table_.size() - 1;
+  std::size_t i = (key ^ (key >> 32)) & mask;
+  while (true) {
+    auto& slot{contrib_table_[i]};
+    if (slot.generation != contrib_generation_) {
+      slot = {hit, track_id, pdg, -1, contrib_generation_};
+      num_contribs_++;
+      return slot.contrib;
+    }
+    if (slot.hit == hit and slot.track_id == track_id and slot.pdg == pdg)
+      return slot.contrib;
+    i = (i + 1) & mask;
+  }
+}
+
+void EcalSD::resetLookups() {
+  for (const auto& hit : hits_)
+    hit_index_[cellIndex(ldmx::EcalID(hit.getID()))] = -1;
+  num_contribs_ = 0;
+  if (++contrib_generation_ == 0) {
+    // generation wrapped around, entries from old events could look valid
+    for (auto& slot : contrib_table_) slot.generation = 0;
+    contrib_generation_ = 1;
+  }
 }
 
 }  // namespace simcore
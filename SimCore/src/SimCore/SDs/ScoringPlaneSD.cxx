@@ -79,7 +79,7 @@ G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
 }
 
 void ScoringPlaneSD::saveHits(framework::Event& event) {
-  event.add(collection_name_, hits_);
+  event.add(collection_name_, std::move(hits_));
 }
 
 }  // namespace simcore
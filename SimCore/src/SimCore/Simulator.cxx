@@ -7,6 +7,11 @@
 
 #include "SimCore/Simulator.h"
 
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <algorithm>
+
 /*~~~~~~~~~~~~~~~*/
 /*   Framework   */
 /*~~~~~~~~~~~~~~~*/
@@ -51,11 +56,7 @@ void Simulator::configure(framework::config::Parameters& parameters) {
 
 void Simulator::beforeNewRun(ldmx::RunHeader& header) {
   // Get the detector header from the user detector construction
-  DetectorConstruction* detector =
-      dynamic_cast<RunManager*>(RunManager::GetRunManager())
-          ->getDetectorConstruction();
-
-  header.setDetectorName(detector->getDetectorName());
+  header.setDetectorName(detector_->getDetectorName());
   header.setDescription(parameters_.getParameter<std::string>("description"));
   header.setIntParameter(
       "Included Scoring Planes",
@@ -126,9 +127,24 @@ void Simulator::onNewRun(const ldmx::RunHeader& runHeader) {
   setSeeds(seeds);
 
   run_ = runHeader.getRunNumber();
+
+  // events simulated with the seeds of a previous run are not used
+  if (mtRunManager_) mtRunManager_->clear();
 }
 
 void Simulator::produce(framework::Event& event) {
+  if (mtRunManager_) {
+    produceFromBatch(event);
+    return;
+  }
+
+  if (seed_each_event_) {
+    // same seeding as done on the worker threads
+    auto seeds{eventSeeds(getTryNumber())};
+    long seed_array[3] = {seeds[0], seeds[1], 0};
+    G4Random::setTheSeeds(seed_array, -1);
+  }
+
   // Generate and process a Geant4 event.
   numEventsBegan_++;
   // Save the state of the random engine to an output stream. A string
@@ -166,6 +182,56 @@ void Simulator::produce(framework::Event& event) {
   return;
 }
 
+void Simulator::produceFromBatch(framework::Event& event) {
+  int try_number{getTryNumber()};
+  // the simulated events are only used for the tries they were seeded for
+  if (try_number != nextTry_) mtRunManager_->clear();
+  nextTry_ = try_number + 1;
+
+  if (mtRunManager_->empty()) {
+    // don't simulate more events than can still be used, if some of
+    //  them are aborted the missing events are simulated in another batch
+    int num_events{events_per_batch_};
+    int event_limit{getEventLimit()};
+    if (event_limit >= 0) {
+      num_events = std::clamp(event_limit - numEventsCompleted_, 1, num_events);
+    }
+    // the batch starts with the event for this try
+    std::vector<long> seeds;
+    for (int i_event{0}; i_event < num_events; i_event++) {
+      auto event_seeds{eventSeeds(try_number + i_event)};
+      seeds.insert(seeds.end(), event_seeds.begin(), event_seeds.end());
+    }
+    mtRunManager_->simulate(num_events, event.getPassName(), seeds);
+  }
+
+  numEventsBegan_++;
+  auto result{mtRunManager_->next()};
+  if (result.aborted) {
+    this->abortEvent();  // get out of processors loop
+  }
+
+  numEventsCompleted_++;
+
+  // store event-wide information in EventHeader
+  auto& event_header = event.getEventHeader();
+  updateEventHeader(event_header, *result.info);
+
+  event_header.setStringParameter("eventSeed", result.seed);
+
+  // merging copies the header of the simulated event as well
+  result.products->getEventHeader() = event_header;
+  event.merge(*result.products);
+}
+
+std::array<long, 2> Simulator::eventSeeds(int try_number) {
+  const auto& rseed{getCondition<framework::RandomNumberSeedService>(
+      framework::RandomNumberSeedService::CONDITIONS_OBJECT_NAME)};
+  // keep the seeds positive and within the range of a 32-bit int
+  return {static_cast<long>(rseed.getSeed("Simulator[0]", try_number) >> 33),
+          static_cast<long>(rseed.getSeed("Simulator[1]", try_number) >> 33)};
+}
+
 void Simulator::onProcessEnd() {
   SimulatorBase::onProcessEnd();
   std::cout << "[ Simulator ] : "
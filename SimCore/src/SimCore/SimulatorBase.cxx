@@ -18,18 +18,25 @@ SimulatorBase::SimulatorBase(const std::string& name,
 void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader) const {
   auto event_info = static_cast<UserEventInformation*>(
       runManager_->GetCurrentEvent()->GetUserInformation());
-
-  eventHeader.setWeight(event_info->getWeight());
+  updateEventHeader(eventHeader, *event_info);
+}
+void SimulatorBase::updateEventHeader(ldmx::EventHeader& eventHeader,
+                                      UserEventInformation& eventInfo) const {
+  eventHeader.setWeight(eventInfo.getWeight());
   eventHeader.setFloatParameter("total_photonuclear_energy",
-                                event_info->getPNEnergy());
+                                eventInfo.getPNEnergy());
   eventHeader.setFloatParameter("total_electronuclear_energy",
-                                event_info->getENEnergy());
+                                eventInfo.getENEnergy());
   eventHeader.setFloatParameter("db_material_z",
-                                event_info->getDarkBremMaterialZ());
+                                eventInfo.getDarkBremMaterialZ());
 }
 void SimulatorBase::onProcessEnd() {
-  runManager_->TerminateEventLoop();
-  runManager_->RunTermination();
+  // with several threads, each batch of events is its own run
+  //  which has already been terminated
+  if (runManager_) {
+    runManager_->TerminateEventLoop();
+    runManager_->RunTermination();
+  }
   // Delete Run Manager
   // From Geant4 Basic Example B01:
   //      Job termination
@@ -42,6 +49,8 @@ void SimulatorBase::onProcessEnd() {
   //  processing are put there because ROOT)
   //  2. When Simulator is deleted because runManager_ is a unique_ptr
   runManager_.reset(nullptr);
+  mtRunManager_.reset(nullptr);
+  detector_ = nullptr;
 
   // Delete the G4UIsession
   // I don't think this needs to happen here, but since we are cleaning up
@@ -50,7 +59,11 @@ void SimulatorBase::onProcessEnd() {
 };
 void SimulatorBase::onProcessStart() {
   // initialize run
-  runManager_->Initialize();
+  if (mtRunManager_) {
+    mtRunManager_->Initialize();
+  } else {
+    runManager_->Initialize();
+  }
 
   for (const std::string& cmd : postInitCommands_) {
     int g4Ret = uiManager_->ApplyCommand(cmd);
@@ -62,6 +75,10 @@ void SimulatorBase::onProcessStart() {
     }
   }
 
+  // with several threads, BeamOn does the rest of the setup
+  //  for each batch of events
+  if (mtRunManager_) return;
+
   // Instantiate the scoring worlds including any parallel worlds.
   runManager_->ConstructScoringWorlds();
 
@@ -119,7 +136,7 @@ void SimulatorBase::configure(framework::config::Parameters& parameters) {
       "postInitCommands", {});
 
   verifyParameters();
-  if (runManager_) {
+  if (runManager_ or mtRunManager_) {
     // TODO: This won't work, need to think of a better solution
     EXCEPTION_RAISE(
         "MultipleSimulators",
@@ -130,7 +147,35 @@ void SimulatorBase::configure(framework::config::Parameters& parameters) {
   // Set up logging before creating the run manager so that output from the
   // creation of the runManager goes to the appropriate place.
   createLogging();
-  runManager_ = std::make_unique<RunManager>(parameters_, conditionsIntf_);
+  num_threads_ = parameters_.getParameter<int>("num_threads", 1);
+  events_per_batch_ = parameters_.getParameter<int>("events_per_batch", 64);
+  // with several threads, the events are tried speculatively in batches
+  //  so each event needs its own seeds to be independent of the batching
+  seed_each_event_ =
+      parameters_.getParameter<bool>("seed_each_event", false) or
+      num_threads_ > 1;
+  sim_particle_table_ =
+      parameters_.getParameter<bool>("sim_particle_table", false);
+  if (num_threads_ > 1) {
+#ifdef G4MULTITHREADED
+    if (events_per_batch_ < 1) {
+      EXCEPTION_RAISE("InvalidParam",
+                      "Need to simulate at least one event per batch.");
+    }
+    // the workers save into their own events while the master waits
+    mtRunManager_ = std::make_unique<MTRunManager>(
+        parameters_, num_threads_, [this](framework::Event& event) {
+          saveTracks(event);
+          saveSDHits(event);
+        });
+#else
+    EXCEPTION_RAISE("InvalidParam",
+                    "Geant4 was built without multi-threading support, so "
+                    "the simulation can only be run with one thread.");
+#endif
+  } else {
+    runManager_ = std::make_unique<RunManager>(parameters_, conditionsIntf_);
+  }
   // Instantiate the class so cascade parameters can be set.
   // TODO: Are we actually using this?
   G4CascadeParameters::Instance();
@@ -164,8 +209,12 @@ void SimulatorBase::createLogging() {
 
 void SimulatorBase::saveTracks(framework::Event& event) {
   TrackMap& tracks{g4user::TrackingAction::get()->getTrackMap()};
+  if (sim_particle_table_) {
+    event.add("SimParticleTable", tracks.buildParticleTable());
+    return;
+  }
   tracks.traceAncestry();
-  event.add("SimParticles", tracks.getParticleMap());
+  event.add("SimParticles", std::move(tracks.getParticleMap()));
 }
 void SimulatorBase::saveSDHits(framework::Event& event) {
   // Copy hit objects from SD hit collections into the output event.
@@ -183,8 +232,10 @@ void SimulatorBase::buildGeometry() {
 
   // Set the DetectorConstruction instance used to build the detector
   // from the GDML description.
-  runManager_->SetUserInitialization(
-      new DetectorConstruction(parser, parameters_, conditionsIntf_));
+  G4RunManager* run_manager{runManager_.get()};
+  if (mtRunManager_) run_manager = mtRunManager_.get();
+  detector_ = new DetectorConstruction(parser, parameters_, conditionsIntf_);
+  run_manager->SetUserInitialization(detector_);
 
   // Parse the detector geometry and validate if specified.
   auto detectorPath{parameters_.getParameter<std::string>("detector")};
@@ -194,6 +245,6 @@ void SimulatorBase::buildGeometry() {
   }
   G4GeometryManager::GetInstance()->OpenGeometry();
   parser->read();
-  runManager_->DefineWorldVolume(parser->GetWorldVolume());
+  run_manager->DefineWorldVolume(parser->GetWorldVolume());
 }
 }  // namespace simcore
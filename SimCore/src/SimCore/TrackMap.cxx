@@ -1,5 +1,11 @@
 #include "SimCore/TrackMap.h"
 
+// STL
+#include <algorithm>
+
+// LDMX
+#include "Framework/Exception/Exception.h"
+
 // Geant4
 #include "G4Event.hh"
 #include "G4EventManager.hh"
@@ -12,12 +18,9 @@ bool TrackMap::isDescendant(int trackID, int ancestorID,
   int current_track{trackID};
   // Walk the tree until we either no longer have a parent or we reach the
   // desired depth
-  while (current_depth < maximum_depth &&
-         (ancestry_.find(current_track) != ancestry_.end())) {
+  while (current_depth < maximum_depth && contains(current_track)) {
     // See if we have encountered the parent of the current track
-    //
-    // operator[] is not const, so we need to use at()
-    current_track = ancestry_.at(current_track).first;
+    current_track = ancestry_[current_track].parent;
     if (current_track == ancestorID) {
       // If one of the parents is the track of interest, we are done!
       return true;
@@ -26,28 +29,44 @@ bool TrackMap::isDescendant(int trackID, int ancestorID,
   }
   return false;
 }
+
 void TrackMap::insert(const G4Track* track) {
-  ancestry_[track->GetTrackID()] =
-      std::make_pair(track->GetParentID(), isInCalorimeterRegion(track));
-  descendents_[track->GetParentID()].push_back(track->GetTrackID());
+  insert(track->GetTrackID(), track->GetParentID(),
+         isInCalorimeterRegion(track));
+}
+
+void TrackMap::insert(int trackID, int parentID, bool inCalRegion) {
+  if (int last{std::max(trackID, parentID)}; last >= int(ancestry_.size())) {
+    // grow geometrically so showers don't resize for every new track
+    ancestry_.resize(std::max<std::size_t>(2 * ancestry_.size(), last + 1));
+  }
+  Ancestry& ancestry{ancestry_[trackID]};
+  ancestry.parent = parentID;
+  if (not inCalRegion or parentID == 0) {
+    // track originated outside cal region or is a primary particle
+    ancestry.incident = trackID;
+  } else if (contains(parentID)) {
+    // still in cal region, the parent's incident is ours as well
+    ancestry.incident = ancestry_[parentID].incident;
+  } else {
+    ancestry.incident = parentID;
+  }
+  // append to the children of the parent to keep them in order
+  Ancestry& parent{ancestry_[parentID]};
+  if (parent.last_child == 0) {
+    parent.first_child = trackID;
+  } else {
+    ancestry_[parent.last_child].next_sibling = trackID;
+  }
+  parent.last_child = trackID;
 }
 
 int TrackMap::findIncident(G4int trackID) const {
-  int currTrackID = trackID;
-  bool foundIncident{false};
-  while (not foundIncident) {
-    auto& [parentID, inCalRegion] = ancestry_.at(currTrackID);
-    if (not inCalRegion or parentID == 0) {
-      // current track ID is nearest ancestor
-      // originating outside cal region
-      // or is a primary particle
-      foundIncident = true;
-    } else {
-      // still in cal region, keep going
-      currTrackID = parentID;
-    }
+  if (not contains(trackID)) {
+    EXCEPTION_RAISE("TrackMap", "Track " + std::to_string(trackID) +
+                                    " has not been inserted into the map.");
   }
-  return currTrackID;
+  return ancestry_[trackID].incident;
 }
 
 void TrackMap::save(const G4Track* track) {
@@ -109,23 +128,23 @@ void TrackMap::save(const G4Track* track) {
 
 void TrackMap::traceAncestry() {
   for (auto& [id, particle] : particle_map_) {
-    particle.addParent(ancestry_.at(id).first);
-
-    /**
-     * Use [] instead of at() for descendents_
-     * so that if it wasn't previously created,
-     * we will just silently create an empty
-     * vector and move on.
-     */
-    for (auto& child : descendents_[id]) {
-      particle.addDaughter(child);
-    }
+    particle.addParent(ancestry_.at(id).parent);
+    forEachChild(id, [&particle](int child) { particle.addDaughter(child); });
+  }
+}
+
+ldmx::SimParticleTable TrackMap::buildParticleTable() const {
+  ldmx::SimParticleTable table;
+  for (const auto& [id, particle] : particle_map_) {
+    table.add(id, particle);
+    table.addParent(ancestry_.at(id).parent);
+    forEachChild(id, [&table](int child) { table.addDaughter(child); });
   }
+  return table;
 }
 
 void TrackMap::clear() {
   ancestry_.clear();
-  descendents_.clear();
   particle_map_.clear();
 }
 
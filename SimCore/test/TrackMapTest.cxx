@@ -0,0 +1,160 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "SimCore/TrackMap.h"
+
+namespace simcore {
+namespace test {
+
+/// number of tracks in the synthetic shower
+static const int N_TRACKS = 100000;
+
+/// number of primaries starting the shower outside of the calorimeter
+static const int N_PRIMARIES = 2;
+
+/**
+ * A track in the synthetic shower
+ */
+struct Track {
+  int id;
+  int parent;
+  bool in_cal_region;
+};
+
+/**
+ * Build a synthetic shower
+ *
+ * Each track is created by one of the more recent tracks so that the
+ * shower gets deep (around forty generations) like a hadronic shower.
+ * A few percent of the secondaries are made outside of the calorimeter
+ * region, the rest are made inside of it.
+ */
+static std::vector<Track> shower() {
+  std::mt19937 rng{42};
+  std::vector<Track> tracks;
+  for (int id{1}; id <= N_PRIMARIES; id++) tracks.push_back({id, 0, false});
+  for (int id{N_PRIMARIES + 1}; id <= N_TRACKS; id++) {
+    std::uniform_int_distribution<int> parent(id / 2, id - 1);
+    tracks.push_back({id, parent(rng), rng() % 32 != 0});
+  }
+  return tracks;
+}
+
+/**
+ * Find the incident track by walking the ancestry
+ *
+ * This is how TrackMap::findIncident used to resolve the incident
+ * track for every contribution to a calorimeter hit.
+ */
+static int walk(const std::unordered_map<int, std::pair<int, bool>>& ancestry,
+                int track_id) {
+  while (true) {
+    auto& [parent, in_cal_region] = ancestry.at(track_id);
+    if (not in_cal_region or parent == 0) return track_id;
+    track_id = parent;
+  }
+}
+
+/**
+ * Build the ancestry walked by walk from the tracks
+ */
+static std::unordered_map<int, std::pair<int, bool>> ancestryOf(
+    const std::vector<Track>& tracks) {
+  std::unordered_map<int, std::pair<int, bool>> ancestry;
+  for (const auto& track : tracks)
+    ancestry[track.id] = std::make_pair(track.parent, track.in_cal_region);
+  return ancestry;
+}
+
+}  // namespace test
+}  // namespace simcore
+
+/**
+ * Test the incident resolution of the TrackMap
+ *
+ * We check that the incident resolved on insertion matches walking
+ * the ancestry for a synthetic shower.
+ */
+TEST_CASE("TrackMap", "[SimCore][TrackMap]") {
+  using namespace simcore::test;
+  std::vector<Track> tracks{shower()};
+  auto ancestry{ancestryOf(tracks)};
+
+  simcore::TrackMap track_map;
+  for (const auto& track : tracks)
+    track_map.insert(track.id, track.parent, track.in_cal_region);
+
+  SECTION("Incident matches walking ancestry") {
+    for (const auto& track : tracks) {
+      CHECK(track_map.contains(track.id));
+      CHECK(track_map.findIncident(track.id) == walk(ancestry, track.id));
+    }
+    CHECK_FALSE(track_map.contains(N_TRACKS + 1));
+  }
+
+  SECTION("Descendants") {
+    const Track& track{tracks.back()};
+    CHECK(track_map.isDescendant(track.id, track.parent, 1));
+    CHECK_FALSE(track_map.isDescendant(track.id, track.id, 100));
+  }
+
+  SECTION("Particle table matches traced particles") {
+    // save every tenth track
+    for (const auto& track : tracks) {
+      if (track.id % 10 != 0) continue;
+      auto& particle{track_map.getParticleMap()[track.id]};
+      particle.setPdgID(track.in_cal_region ? 22 : 11);
+      particle.setVertexVolume(track.in_cal_region ? "ecal" : "target");
+    }
+    ldmx::SimParticleTable table{track_map.buildParticleTable()};
+    track_map.traceAncestry();
+    const auto& particles{track_map.getParticleMap()};
+    REQUIRE(table.size() == particles.size());
+    auto from_table{table.getMap()};
+    for (const auto& [id, particle] : particles) {
+      int row{table.find(id)};
+      REQUIRE(row >= 0);
+      CHECK(table.getPdgID(row) == particle.getPdgID());
+      CHECK(table.getVertexVolume(row) == particle.getVertexVolume());
+      auto daughters{table.getDaughters(row)};
+      CHECK(std::vector<int>(daughters.begin(), daughters.end()) ==
+            particle.getDaughters());
+      CHECK(from_table.at(id).getParents() == particle.getParents());
+      CHECK(from_table.at(id).getDaughters() == particle.getDaughters());
+    }
+    CHECK_FALSE(table.contains(1));
+  }
+}
+
+/**
+ * Benchmark walking the ancestry against resolving the incident on
+ * insertion for a synthetic shower with a contribution from each track
+ *
+ * Hidden so that it isn't run with the tests, run it with
+ * `run_test "[.benchmark]"`.
+ */
+TEST_CASE("TrackMap benchmark", "[.benchmark][TrackMap]") {
+  using namespace simcore::test;
+  std::vector<Track> tracks{shower()};
+  auto ancestry{ancestryOf(tracks)};
+
+  BENCHMARK("Walk ancestry") {
+    long int sum{0};
+    for (const auto& track : tracks) sum += walk(ancestry, track.id);
+    return sum;
+  };
+
+  BENCHMARK("Insert and find incident") {
+    simcore::TrackMap map;
+    long int sum{0};
+    for (const auto& track : tracks) {
+      map.insert(track.id, track.parent, track.in_cal_region);
+      sum += map.findIncident(track.id);
+    }
+    return sum;
+  };
+}
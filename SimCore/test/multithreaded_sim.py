@@ -0,0 +1,81 @@
+"""Check that simulating with several threads gives the same events as one
+
+Without any arguments, this config runs itself with one and with two
+Geant4 worker threads (in separate fire processes) and compares the
+simulated particles and hits of each event in their output files.
+The events are seeded from their own substreams, so they should be the
+same no matter which thread simulated them. Only the event headers differ
+since they hold time stamps.
+
+    fire multithreaded_sim.py [num_threads]
+"""
+
+import sys
+import subprocess
+from LDMX.Framework import ldmxcfg
+
+def output_file(num_threads) :
+    return f'multithreaded_sim_{num_threads}_threads.root'
+
+def compare(reference, other) :
+    """Compare the simulated objects of each event in the two files"""
+    # loads the dictionary of our event objects
+    from LDMX.Framework import EventTree
+    import ROOT
+    # keep the files open while we read their trees
+    ref_file, other_file = ROOT.TFile(reference), ROOT.TFile(other)
+    ref_tree = ref_file.Get('LDMX_Events')
+    other_tree = other_file.Get('LDMX_Events')
+    if ref_tree.GetEntries() != other_tree.GetEntries() :
+        raise Exception(f'{other} has {other_tree.GetEntries()} events'
+                        f' but {reference} has {ref_tree.GetEntries()}')
+
+    branches = [ b.GetName() for b in ref_tree.GetListOfBranches()
+                 if b.GetName() != 'EventHeader' ]
+    if 'SimParticles_sim' not in branches :
+        raise Exception(f'No SimParticles in {reference}')
+
+    for i_entry in range(ref_tree.GetEntries()) :
+        ref_tree.GetEntry(i_entry)
+        other_tree.GetEntry(i_entry)
+        for branch in branches :
+            cl = ROOT.TClass.GetClass(ref_tree.GetBranch(branch).GetClassName())
+            ref = ROOT.TBufferJSON.ConvertToJSON(getattr(ref_tree, branch), cl)
+            obj = ROOT.TBufferJSON.ConvertToJSON(getattr(other_tree, branch), cl)
+            if str(ref) != str(obj) :
+                raise Exception(f'{branch} of entry {i_entry} differs between'
+                                f' {reference} and {other}')
+
+if len(sys.argv) < 2 :
+    for num_threads in [ 1, 2 ] :
+        subprocess.run([ 'fire', __file__, str(num_threads) ], check=True)
+    compare(output_file(1), output_file(2))
+
+    # nothing left to do but read the reference back in
+    p = ldmxcfg.Process( 'compare' )
+    p.inputFiles = [ output_file(1) ]
+    p.maxEvents = 1
+else :
+    num_threads = int(sys.argv[1])
+    p = ldmxcfg.Process( 'sim' )
+    p.maxEvents = 10
+    p.run = 9001
+    p.outputFiles = [ output_file(num_threads) ]
+    # fixed seeds for both runs
+    p.randomNumberSeedService.external(1234)
+
+    from LDMX.SimCore import simulator as sim
+    from LDMX.SimCore import generators as gen
+    import LDMX.Ecal.EcalGeometry
+    import LDMX.Hcal.HcalGeometry
+    mySim = sim.simulator( 'mySim' )
+    # scoring planes can't be simulated with more than one thread
+    mySim.setDetector( 'ldmx-det-v14' , False )
+    mySim.generators.append( gen.single_4gev_e_upstream_target() )
+    mySim.description = 'Multi-threaded test simulation'
+    mySim.num_threads = num_threads
+    # smaller than maxEvents so the last batch is cut short
+    mySim.events_per_batch = 4
+    # seed the same way as the worker threads
+    mySim.seed_each_event = True
+    p.sequence.append( mySim )
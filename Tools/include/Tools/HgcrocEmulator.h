@@ -3,15 +3,16 @@
 #define TOOLS_HGCROCEMULATOR_H
 
 #include "Conditions/SimpleTableCondition.h"
+#include "Framework/ConditionsIOV.h"
 #include "Framework/Configure/Parameters.h"
 #include "Recon/Event/HgcrocDigiCollection.h"
 #include "SimCore/Event/SimCalorimeterHit.h"
+#include "Tools/HgcrocPulseShape.h"
 #include "Tools/NoiseGenerator.h"
 
 //----------//
 //   ROOT   //
 //----------//
-#include "TF1.h"
 #include "TRandom3.h"
 
 namespace ldmx {
@@ -60,19 +61,81 @@ class HgcrocEmulator {
    */
   void seedGenerator(uint64_t seed);
 
+  /**
+   * Chip-dependent parameters for a single channel
+   *
+   * These are the columns of the conditions table that the
+   * emulator uses, copied out of the table once per IOV so that
+   * digitization only needs to look up the channel once.
+   */
+  struct ChannelConditions {
+    /// gain [mV / ADC count]
+    double gain;
+    /// pedestal [ADC counts]
+    double pedestal;
+    /// electronic noise [ADC counts]
+    double noise;
+    /// readout threshold [ADC counts]
+    double readoutThreshold;
+    /// TOA threshold [mV]
+    double toaThreshold;
+    /// TOT threshold [mV]
+    double totThreshold;
+    /// maximum TOT measurement [ns]
+    double totMax;
+    /// capacitance of the readout pad [pF]
+    double padCapacitance;
+    /// time in the BX where an in-time hit arrives [ns]
+    double measTime;
+    /// rate charge drains off the chip when in TOT mode [fC/ns]
+    double drainRate;
+  };
+
   /**
    * Set Conditions
    *
    * Passes the chips conditions to be cached here and
    * used later in digitization.
    *
+   * The parameters for all of the channels in the table are copied
+   * into a dense block indexed by the row of the table, but only
+   * if the table or its interval of validity changed since the last
+   * call, so this can be called on every event.
+   *
    * @param table conditions::DoubleTableConditions to be used for chip
    * parameters
+   * @param iov interval of validity of the table, optional
    */
-  void condition(const conditions::DoubleTableCondition& table) {
-    // reset cache of column numbers if table changes
-    if (&table != chipConditions_) conditionNamesToIndex_.clear();
+  void condition(
+      const conditions::DoubleTableCondition& table,
+      const framework::ConditionsIOV& iov = framework::ConditionsIOV()) {
+    if (&table == chipConditions_ and iov == chipConditionsIOV_) return;
     chipConditions_ = &table;
+    chipConditionsIOV_ = iov;
+    cacheConditions();
+  }
+
+  /**
+   * Get the chip-dependent parameters for the input channel
+   *
+   * @throws Exception if the emulator hasn't been given conditions
+   * or the channel is not in the conditions table
+   *
+   * @param[in] channelID raw integer ID for the readout channel
+   * @return parameters for the channel
+   */
+  const ChannelConditions& channelConditions(int channelID) const {
+    // check if emulator has been passed a table of conditions
+    if (!chipConditions_) {
+      EXCEPTION_RAISE("HgcrocCond",
+                      "HGC ROC Emulator was not given a conditions table.");
+    }
+    std::size_t irow = chipConditions_->getRowNumber(channelID);
+    if (irow >= channelConditions_.size()) {
+      EXCEPTION_RAISE("HgcrocCond", "No HGC ROC conditions for channel " +
+                                        std::to_string(channelID));
+    }
+    return channelConditions_[irow];
   }
 
   /**
@@ -183,46 +246,41 @@ class HgcrocEmulator {
    * @return electronic noise amplitude [mV] above pedestal
    */
   double noise(const int& channelID) const {
-    return noiseInjector_->Gaus(
-        0, getCondition(channelID, "NOISE") * gain(channelID));
+    return noise(channelConditions(channelID));
   };
 
   /// Gain for input channel
   double gain(const int& channelID) const {
-    return getCondition(channelID, "GAIN");
+    return channelConditions(channelID).gain;
   }
 
   /// Pedestal [ADC Counts] for input channel
-  double pedestal(const int& id) const { return getCondition(id, "PEDESTAL"); }
+  double pedestal(const int& id) const {
+    return channelConditions(id).pedestal;
+  }
 
   /// Readout Threshold (ADC Counts)
   double readoutThreshold(const int& id) const {
-    return getCondition(id, "READOUT_THRESHOLD");
+    return channelConditions(id).readoutThreshold;
   }
 
  private:
   /**
-   * Get condition for input chip ID, condition name, and default value
+   * Copy the parameters of all channels out of the conditions table
    *
-   * @param[in] id chip global integer ID used in condition table
-   * @param[in] name std::string name of chip parameter in table
-   * @param[in] def default value for parameter if not found in table (or table
-   * not set)
-   * @return value of chip parameter
+   * @throws Exception if the table is missing one of the columns
+   * in ChannelConditions
    */
-  double getCondition(int id, const std::string& name) const {
-    // check if emulator has been passed a table of conditions
-    if (!chipConditions_) {
-      EXCEPTION_RAISE("HgcrocCond",
-                      "HGC ROC Emulator was not given a conditions table.");
-    }
-
-    // cache column index for the input name
-    if (conditionNamesToIndex_.count(name) == 0)
-      conditionNamesToIndex_[name] = chipConditions_->getColumnNumber(name);
+  void cacheConditions();
 
-    // get condition
-    return chipConditions_->get(id, conditionNamesToIndex_.at(name));
+  /**
+   * Get random noise amplitude for a channel with the input conditions
+   *
+   * @param[in] conds parameters of the channel
+   * @return electronic noise amplitude [mV] above pedestal
+   */
+  double noise(const ChannelConditions& conds) const {
+    return noiseInjector_->Gaus(0, conds.noise * conds.gain);
   }
 
  private:
@@ -236,14 +294,14 @@ class HgcrocEmulator {
   class CompositePulse {
    public:
     /**
-     * Constructore
+     * Constructor
      *
      * Connect this pulse emulator with the pulse
-     * shape function already configured by the chip
-     * emulator.
+     * shape already configured by the chip emulator.
      */
-    CompositePulse(TF1& func, const double& g, const double& p)
-        : pulseFunc_{func}, gain_{g}, pedestal_{p} {}
+    CompositePulse(const HgcrocPulseShape& shape, const double& g,
+                   const double& p)
+        : pulseShape_{shape}, gain_{g}, pedestal_{p} {}
 
     /**
      * Put another hit into this composite pulse.
@@ -272,29 +330,35 @@ class HgcrocEmulator {
     /**
      * Find the time at which we cross the input level.
      *
-     * We use the midpoint algorithm, assuming the input low
-     * is below the threshold and hight is above.
+     * We use Newton's method with the analytic derivative of the pulse,
+     * assuming the input low is below the threshold and high is above.
+     * The bracket [low, high] is narrowed with each evaluation and we
+     * fall back to the midpoint whenever a Newton step would leave it,
+     * so this converges at least as reliably as bisection and usually
+     * within a few evaluations.
      *
-     * @param[in] low minimum value (below threshold) to start search at [mV]
-     * @param[in] high maximum value (above threshold) to start search at [mV]
+     * @param[in] low minimum time (below threshold) to start search at [ns]
+     * @param[in] high maximum time (above threshold) to start search at [ns]
      * @param[in] level threshold to look for time [mV]
-     * @param[in] prec precision with which to look [mV]
+     * @param[in] prec precision with which to look [ns]
      * @returns time [ns] at which the pulse cross level
      */
     double findCrossing(double low, double high, double level,
-                        double prec = 0.01) {
-      // use midpoint algorithm, assumes low is below and high is above
-      double step = high - low;
+                        double prec = 0.01) const {
       double pt = (high + low) / 2;
-      while (step > prec) {
-        double vmid = at(pt);
-        if (vmid < level) {
+      for (int iter = 0; iter < 100; iter++) {
+        double diff = at(pt) - level;
+        if (diff < 0) {
           low = pt;
         } else {
           high = pt;
         }
-        step = high - low;
-        pt = (high + low) / 2;
+        double next = pt - diff / derivative(pt);
+        // negated so that NaN steps also fall back to the midpoint
+        if (not(next > low and next < high)) next = (high + low) / 2;
+        double step = fabs(next - pt);
+        pt = next;
+        if (step < prec) break;
       }
       return pt;
     }
@@ -324,11 +388,42 @@ class HgcrocEmulator {
      */
     double at(double time) const {
       double signal = gain_ * pedestal_;
-      for (auto hit : hits_)
-        signal += hit.first * pulseFunc_.Eval(time - hit.second);
+      for (const auto& hit : hits_)
+        signal += hit.first * pulseShape_(time - hit.second);
       return signal;
     };
 
+    /**
+     * Measure the voltage at several times at once
+     *
+     * Gives the same result as calling at for each time,
+     * but goes through the hits once and evaluates each of them
+     * at all of the times in a vectorizable loop.
+     *
+     * @param[in] times times to measure [ns]
+     * @param[out] voltages voltages at those times [mV]
+     */
+    void sample(const std::vector<double>& times,
+                std::vector<double>& voltages) const {
+      voltages.assign(times.size(), gain_ * pedestal_);
+      for (const auto& hit : hits_)
+        pulseShape_.accumulate(hit.first, hit.second, times.data(),
+                               voltages.data(), times.size());
+    }
+
+    /**
+     * Time derivative of the voltage at the input time
+     *
+     * @param[in] time time to measure [ns]
+     * @return derivative of voltage at that time [mV/ns]
+     */
+    double derivative(double time) const {
+      double slope = 0.;
+      for (const auto& hit : hits_)
+        slope += hit.first * pulseShape_.derivative(time - hit.second);
+      return slope;
+    }
+
     /// Get list of individual pulses that are entering the chip
     const std::vector<std::pair<double, double>>& hits() const { return hits_; }
 
@@ -340,8 +435,8 @@ class HgcrocEmulator {
      */
     std::vector<std::pair<double, double>> hits_;
 
-    /// reference to pulse shape function shared by all pulses
-    TF1& pulseFunc_;
+    /// reference to pulse shape shared by all pulses
+    const HgcrocPulseShape& pulseShape_;
 
     /// gain for current chip we are emulating
     double gain_;
@@ -404,13 +499,15 @@ class HgcrocEmulator {
    */
   const conditions::DoubleTableCondition* chipConditions_{nullptr};
 
+  /// Interval of validity of the table of chip-dependent conditions
+  framework::ConditionsIOV chipConditionsIOV_;
+
   /**
-   * Map of condition names to column numbers
+   * Parameters of each channel in the table of chip-dependent conditions
    *
-   * mutable so that we can update the cached column values
-   * in getCondition during processing.
+   * Indexed by the row of the channel in the table.
    */
-  mutable std::map<std::string, int> conditionNamesToIndex_;
+  std::vector<ChannelConditions> channelConditions_;
 
   /**************************************************************************************
    * Helpful Member Objects
@@ -420,26 +517,31 @@ class HgcrocEmulator {
   std::unique_ptr<TRandom3> noiseInjector_;
 
   /**
-   * Functional shape of signal pulse in time
-   *
-   * Shape parameters are hardcoded into the function currently.
-   *  Pulse Shape:
-   *  [0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))
-   *   p[0] = amplitude (height of peak in mV)
-   *   p[1] = rate of up slope - rateUpSlope_
-   *   p[2] = time of up slope relative to shape fit - timeUpSlope_
-   *   p[3] = time of peak relative to shape fit - timePeak_
-   *   p[4] = peak time (related to time of hit [ns])
-   *   p[5] = rate of down slope - rateDnSlope_
-   *   p[6] = time of down slope relative to shape fit - timeDnSlope_
-   *
-   * @f[
-   *  V(t) =
-   *  p_0\frac{(1+\exp(p_1(-p_2+p_3)))(1+\exp(p_5*(-p_6+p_3)))}
-   *          {(1+\exp(p_1(t-p_2+p_3-p_4)))(1+\exp(p_5*(t-p_6+p_3-p_4)))}
-   * @f]
+   * Shape of signal pulse in time
+   *
+   * Configured from the up and down slope parameters above.
+   * @see HgcrocPulseShape for the functional form
+   */
+  HgcrocPulseShape pulseShape_;
+
+  /**
+   * Times at which we measure the pulse of a channel [ns]
+   *
+   * The first nADCs_ entries are the sampling times of each ADC,
+   * which are the same for all channels. The last nADCs_+1 entries
+   * are the boundaries of the BXs, which depend on the measurement
+   * time of the channel and are updated in digitize.
+   *
+   * mutable so that we can re-use the memory during processing.
+   */
+  mutable std::vector<double> pulseTimes_;
+
+  /**
+   * Voltages of the pulse at pulseTimes_ [mV]
+   *
+   * mutable so that we can re-use the memory during processing.
    */
-  mutable TF1 pulseFunc_;
+  mutable std::vector<double> pulseVoltages_;
 
 };  // HgcrocEmulator
 
@@ -0,0 +1,236 @@
+#ifndef TOOLS_INFERENCESERVICE_H
+#define TOOLS_INFERENCESERVICE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Framework/Configure/Parameters.h"
+#include "Tools/ONNXRuntime.h"
+
+namespace ldmx::Ort {
+
+/**
+ * @class InferenceService
+ * @brief Run one ONNX model for several processors and events
+ *
+ * All the instances of a processor (one per event stream when running
+ * with several threads) share the service for their model, so the model
+ * is only loaded once. Each instance makes its own Request, which holds
+ * the input and output arrays of one sample and the tensors bound to
+ * them, so running the model does not allocate any arrays.
+ *
+ * ```cpp
+ * // in configure
+ * service_ = ldmx::Ort::InferenceService::get(
+ *     model_path, {"input"}, {"probabilities"}, options);
+ * request_ = service_->makeRequest();
+ * // in produce
+ * std::copy(features.begin(), features.end(), request_.input(0).begin());
+ * service_->run(request_);
+ * float pred = request_.output(0)[1];
+ * ```
+ *
+ * When max_batch_size is larger than one, the requests made while the
+ * model is running on other events are gathered and run together as one
+ * batch. With max_batch_delay, the service also waits up to that long for
+ * more requests before starting a batch that is not full. The events are
+ * only processed concurrently when the Process runs with several threads,
+ * so batching does not help when running with one.
+ */
+class InferenceService {
+ public:
+  /**
+   * Options for the session running the model and the batching
+   */
+  struct Options {
+    /// number of threads used to run the operators
+    int intra_op_threads{1};
+    /// number of threads used to run independent operators in parallel
+    int inter_op_threads{0};
+    /// graph optimization level: "disable", "basic", "extended" or "all"
+    std::string graph_optimization{"all"};
+    /// maximum number of samples run at once
+    int max_batch_size{1};
+    /// maximum time to wait for more requests before running a batch [us]
+    int max_batch_delay{0};
+
+    /**
+     * Read the options from the python configuration
+     *
+     * Options that are not in the configuration keep their default.
+     *
+     * @param[in] parameters configuration of the service
+     * @return options
+     */
+    static Options fromParameters(
+        const framework::config::Parameters& parameters);
+  };
+
+  /**
+   * Input and output arrays of one sample
+   *
+   * The arrays have the shapes of the input and output nodes for a
+   * batch size of one and are re-used for every run of the request.
+   * The tensors point into the arrays, so a request can be moved (which
+   * keeps the arrays where they are) but not copied. It should not be
+   * moved while it is being run.
+   */
+  class Request {
+   public:
+    /// Constructor, use InferenceService::makeRequest
+    Request() = default;
+
+    /// moving keeps the arrays the tensors point into
+    Request(Request&&) = default;
+
+    /// moving keeps the arrays the tensors point into
+    Request& operator=(Request&&) = default;
+
+    /// not copyable since the tensors would point into the original arrays
+    Request(const Request&) = delete;
+
+    /// not copyable since the tensors would point into the original arrays
+    Request& operator=(const Request&) = delete;
+
+    /**
+     * Get the array for one input node
+     *
+     * @param[in] i index of the node in the input names of the service
+     * @return writable view of the input array
+     */
+    std::span<float> input(std::size_t i) { return inputs_.at(i); }
+
+    /**
+     * Get the array of one output node after the request was run
+     *
+     * @param[in] i index of the node in the output names of the service
+     * @return view of the output array
+     */
+    std::span<const float> output(std::size_t i) const {
+      return outputs_.at(i);
+    }
+
+   private:
+    friend class InferenceService;
+    /// input arrays
+    std::vector<std::vector<float>> inputs_;
+    /// output arrays
+    std::vector<std::vector<float>> outputs_;
+    /// tensors bound to the input arrays, for running without batching
+    std::vector<::Ort::Value> input_tensors_;
+    /// tensors bound to the output arrays, for running without batching
+    std::vector<::Ort::Value> output_tensors_;
+    /// have the outputs been filled?
+    bool done_{false};
+    /// error from running the batch this request was in
+    std::exception_ptr error_;
+  };
+
+  /**
+   * Get the service for a model
+   *
+   * Callers asking for the same model with the same input and output
+   * names and options get the same service.
+   *
+   * @param[in] model_path path to the ONNX model file
+   * @param[in] input_names names of the input nodes, must be all of them
+   * @param[in] output_names names of the output nodes to get, empty for all
+   * of them in the order of ONNXRuntime::getOutputNames
+   * @param[in] options session and batching options
+   * @return shared service
+   */
+  static std::shared_ptr<InferenceService> get(
+      const std::string& model_path,
+      const std::vector<std::string>& input_names,
+      const std::vector<std::string>& output_names, const Options& options);
+
+  /**
+   * Create the arrays for a new request
+   *
+   * @return request with its arrays and tensors
+   */
+  Request makeRequest() const;
+
+  /**
+   * Run the model on a request
+   *
+   * This blocks until the outputs of the request are filled, which may
+   * be done by another thread running the batch the request is in.
+   *
+   * @param[in,out] request request to run, its outputs are filled
+   */
+  void run(Request& request);
+
+  /// Use get to construct the service
+  InferenceService(const std::string& model_path,
+                   const std::vector<std::string>& input_names,
+                   const std::vector<std::string>& output_names,
+                   const Options& options);
+
+ private:
+  /**
+   * Run the requests in batch_ together
+   *
+   * The inputs are copied into the batch arrays and the outputs are
+   * copied back into each request.
+   */
+  void runBatch();
+
+  /// the model
+  std::unique_ptr<ONNXRuntime> rt_;
+  /// memory info for creating the tensors
+  ::Ort::MemoryInfo memory_info_;
+  /// names of the input nodes
+  std::vector<std::string> input_names_;
+  /// names of the input nodes passed to the model
+  std::vector<const char*> input_node_names_;
+  /// number of values in each input node for one sample
+  std::vector<std::size_t> input_sizes_;
+  /// shape of each input node for one sample
+  std::vector<std::vector<int64_t>> input_shapes_;
+  /// names of the output nodes
+  std::vector<std::string> output_names_;
+  /// names of the output nodes passed to the model
+  std::vector<const char*> output_node_names_;
+  /// number of values in each output node for one sample
+  std::vector<std::size_t> output_sizes_;
+  /// shape of each output node for one sample
+  std::vector<std::vector<int64_t>> output_shapes_;
+
+  /// maximum number of samples run at once
+  std::size_t max_batch_size_;
+  /// maximum time to wait for more requests
+  std::chrono::microseconds max_batch_delay_;
+  /// input arrays of the largest batch
+  std::vector<std::vector<float>> batch_inputs_;
+  /// output arrays of the largest batch
+  std::vector<std::vector<float>> batch_outputs_;
+  /// tensors bound to the batch arrays, per input node for each batch size
+  std::vector<std::vector<::Ort::Value>> batch_input_tensors_;
+  /// tensors bound to the batch arrays, per output node for each batch size
+  std::vector<std::vector<::Ort::Value>> batch_output_tensors_;
+
+  /// guard for the queue
+  std::mutex mutex_;
+  /// signal that a batch is done or a request was queued
+  std::condition_variable cv_;
+  /// requests waiting to be run
+  std::vector<Request*> queue_;
+  /// requests in the batch that is running
+  std::vector<Request*> batch_;
+  /// is a batch running?
+  bool busy_{false};
+  /// time when the oldest request in the queue should be run
+  std::chrono::steady_clock::time_point deadline_;
+};
+
+}  // namespace ldmx::Ort
+
+#endif  // TOOLS_INFERENCESERVICE_H
@@ -49,6 +49,46 @@ class ONNXRuntime {
                   const std::vector<std::string>& output_names = {},
                   int64_t batch_size = 1) const;
 
+  /**
+   * Run model inference on tensors that were already created.
+   *
+   * The tensors can be created once over buffers that are re-used for
+   * each call, so that running the model does not need to allocate any
+   * input or output arrays.
+   *
+   * @param input_names Names of the input nodes.
+   * @param inputs Tensors for each input node, in the order of `input_names`.
+   * @param n_inputs Number of input nodes.
+   * @param output_names Names of the output nodes to get outputs from.
+   * @param outputs Tensors the outputs are written into, in the order of
+   * `output_names`.
+   * @param n_outputs Number of output nodes.
+   */
+  void run(const char* const* input_names, const ::Ort::Value* inputs,
+           std::size_t n_inputs, const char* const* output_names,
+           ::Ort::Value* outputs, std::size_t n_outputs) const;
+
+  /**
+   * Get the names of all the input nodes.
+   * @return A list of names of all the input nodes.
+   */
+  const std::vector<std::string>& getInputNames() const;
+
+  /**
+   * Get the shape of a input node.
+   * The 0th dim is the batch size, which is set to 1.
+   * @param input_name Name of the input node.
+   * @return The shape of the input node as a vector of integers.
+   */
+  const std::vector<int64_t>& getInputShape(
+      const std::string& input_name) const;
+
+  /**
+   * Can the model be run on more than one sample at once?
+   * @return true if the 0th dim of all the input nodes is not fixed
+   */
+  bool hasDynamicBatch() const { return dynamic_batch_; }
+
   /**
    * Get the names of all the output nodes.
    * @return A list of names of all the output nodes.
@@ -75,6 +115,8 @@ class ONNXRuntime {
   std::vector<std::string> output_node_strings_;
   std::vector<const char*> output_node_names_;
   std::map<std::string, std::vector<int64_t>> output_node_dims_;
+
+  bool dynamic_batch_{true};
 };
 
 }  // namespace ldmx::Ort
@@ -0,0 +1,36 @@
+"""Configuration for running ONNX models"""
+
+class InferenceService() :
+    """Configuration for the service running an ONNX model
+
+    All the copies of a processor (one for each event stream when
+    running with more than one thread) share one service for their model.
+
+    Attributes
+    ----------
+    intra_op_threads : int
+        Number of threads used to run the operators of the model,
+        0 lets ONNXRuntime choose
+    inter_op_threads : int
+        Number of threads used to run independent operators in parallel,
+        0 lets ONNXRuntime choose
+    graph_optimization : str
+        Graph optimization level: 'disable', 'basic', 'extended' or 'all'
+    max_batch_size : int
+        Maximum number of events run through the model at once.
+        The events processed concurrently by the different event streams
+        (see Process.numThreads) are batched, so this does nothing when
+        running with one thread. The outputs of a batch can differ from
+        running each event on its own in the last bits of the floats.
+    max_batch_delay : int
+        Maximum time [us] to wait for more events before running a batch
+        that is not full, 0 only batches the events that are waiting
+        while the model is running
+    """
+
+    def __init__(self) :
+        self.intra_op_threads = 1
+        self.inter_op_threads = 0
+        self.graph_optimization = 'all'
+        self.max_batch_size = 1
+        self.max_batch_delay = 0
@@ -3,7 +3,12 @@
 
 namespace ldmx {
 
-HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps) {
+HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps)
+    : pulseShape_{ps.getParameter<double>("rateUpSlope"),
+                  ps.getParameter<double>("timeUpSlope"),
+                  ps.getParameter<double>("rateDnSlope"),
+                  ps.getParameter<double>("timeDnSlope"),
+                  ps.getParameter<double>("timePeak")} {
   // settings of readout chip that are the same for all chips
   //  used  in actual digitization
   noise_ = ps.getParameter<bool>("noise");
@@ -23,25 +28,50 @@ HgcrocEmulator::HgcrocEmulator(const framework::config::Parameters &ps) {
 
   hit_merge_ns_ = 0.05;  // combine at 50 ps level
 
-  // Configure the pulse shape function
-  pulseFunc_ =
-      TF1("pulseFunc",
-          "[0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/"
-          "((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))",
-          0.0, (double)nADCs_ * clockCycle_);
-  pulseFunc_.FixParameter(0, 1.0);  // amplitude is set externally
-  pulseFunc_.FixParameter(1, rateUpSlope_);
-  pulseFunc_.FixParameter(2, timeUpSlope_);
-  pulseFunc_.FixParameter(3, timePeak_);
-  pulseFunc_.FixParameter(4, 0);  // not using time offset in this way
-  pulseFunc_.FixParameter(5, rateDnSlope_);
-  pulseFunc_.FixParameter(6, timeDnSlope_);
+  // sampling times of each ADC followed by the BX boundaries,
+  //  the boundaries are set for each channel in digitize
+  pulseTimes_.resize(2 * nADCs_ + 1);
+  for (int iADC = 0; iADC < nADCs_; iADC++)
+    pulseTimes_[iADC] = (iADC - iSOI_) * clockCycle_;
 }
 
 void HgcrocEmulator::seedGenerator(uint64_t seed) {
   noiseInjector_ = std::make_unique<TRandom3>(seed);
 }
 
+void HgcrocEmulator::cacheConditions() {
+  const auto &table{*chipConditions_};
+  // column numbers in the order of the members of ChannelConditions
+  static const std::vector<std::string> names = {
+      "GAIN",          "PEDESTAL",        "NOISE",     "READOUT_THRESHOLD",
+      "TOA_THRESHOLD", "TOT_THRESHOLD",   "TOT_MAX",   "PAD_CAPACITANCE",
+      "MEAS_TIME",     "DRAIN_RATE"};
+  std::vector<unsigned int> columns;
+  for (const auto &name : names) {
+    columns.push_back(table.getColumnNumber(name));
+    if (columns.back() == table.getColumnCount()) {
+      EXCEPTION_RAISE("HgcrocCond", "Conditions table " + table.getName() +
+                                        " does not have a column " + name);
+    }
+  }
+
+  channelConditions_.resize(table.getRowCount());
+  for (std::size_t irow{0}; irow < table.getRowCount(); irow++) {
+    const auto values{table.getRow(irow).second};
+    auto &conds{channelConditions_[irow]};
+    conds.gain = values[columns[0]];
+    conds.pedestal = values[columns[1]];
+    conds.noise = values[columns[2]];
+    conds.readoutThreshold = values[columns[3]];
+    conds.toaThreshold = values[columns[4]];
+    conds.totThreshold = values[columns[5]];
+    conds.totMax = values[columns[6]];
+    conds.padCapacitance = values[columns[7]];
+    conds.measTime = values[columns[8]];
+    conds.drainRate = values[columns[9]];
+  }
+}
+
 bool HgcrocEmulator::digitize(
     const int &channelID,
     std::vector<std::pair<double, double>> &arriving_pulses,
@@ -51,19 +81,19 @@ bool HgcrocEmulator::digitize(
   digiToAdd.clear();  // make sure it is clean
 
   // Configure chip settings based off of table (that may have been passed)
-  double totMax = getCondition(channelID, "TOT_MAX");
-  double padCapacitance = getCondition(channelID, "PAD_CAPACITANCE");
-  double gain = this->gain(channelID);
-  double pedestal = this->pedestal(channelID);
-  double toaThreshold = getCondition(channelID, "TOA_THRESHOLD");
-  double totThreshold = getCondition(channelID, "TOT_THRESHOLD");
+  const ChannelConditions &conds{channelConditions(channelID)};
+  double totMax = conds.totMax;
+  double padCapacitance = conds.padCapacitance;
+  double gain = conds.gain;
+  double pedestal = conds.pedestal;
+  double toaThreshold = conds.toaThreshold;
+  double totThreshold = conds.totThreshold;
   // measTime defines the point in the BX where an in-time
   //  (time=0 in times vector) hit would arrive.
   // Used to determine BX boundaries and TOA behavior.
-  double measTime = getCondition(channelID, "MEAS_TIME");
-  double drainRate = getCondition(channelID, "DRAIN_RATE");
-  double readoutThresholdFloat = this->readoutThreshold(channelID);
-  int readoutThreshold = int(readoutThresholdFloat);
+  double measTime = conds.measTime;
+  double drainRate = conds.drainRate;
+  int readoutThreshold = int(conds.readoutThreshold);
 
   // sort by amplitude
   //  ==> makes sure that puleses are merged towards higher ones
@@ -74,10 +104,19 @@ bool HgcrocEmulator::digitize(
 
   // step 1: gather voltages into groups separated by (programmable) ns, single
   // pass
-  CompositePulse pulse(pulseFunc_, gain, pedestal);
+  CompositePulse pulse(pulseShape_, gain, pedestal);
 
   for (auto hit : arriving_pulses) pulse.addOrMerge(hit, hit_merge_ns_);
 
+  // measure the pulse at all sampling times and BX boundaries in one pass
+  //  sampleVolts[iADC] is the voltage at the sampling time of iADC
+  //  bxVolts[iADC] is the voltage at the start of the BX for iADC
+  for (int iBX = 0; iBX <= nADCs_; iBX++)
+    pulseTimes_[nADCs_ + iBX] = (iBX - iSOI_) * clockCycle_ - measTime;
+  pulse.sample(pulseTimes_, pulseVoltages_);
+  const double *sampleVolts = pulseVoltages_.data();
+  const double *bxVolts = sampleVolts + nADCs_;
+
   // TODO step 2: add timing jitter
   // if (noise_) pulse.jitter();
 
@@ -115,8 +154,8 @@ bool HgcrocEmulator::digitize(
     }  // loop over sim hits
 
     // check for the case of a TOA even though the peak is in the next BX
-    if (!overTOA && pulse(startBX + clockCycle_) > toaThreshold) {
-      if (pulse(startBX) < toaThreshold) {
+    if (!overTOA && bxVolts[iADC + 1] > toaThreshold) {
+      if (bxVolts[iADC] < toaThreshold) {
         // pulse crossed TOA threshold somewhere between the start of this
         // basket and the end
         overTOA = true;
@@ -182,9 +221,9 @@ bool HgcrocEmulator::digitize(
       return true;  // always readout
     } else {
       // determine the voltage at the sampling time
-      double bxvolts = pulse((iADC - iSOI_) * clockCycle_);
+      double bxvolts = sampleVolts[iADC];
       // add noise if requested
-      if (noise_) bxvolts += noise(channelID);
+      if (noise_) bxvolts += noise(conds);
       // convert to integer and keep in range (handle low and high saturation)
       int adc = bxvolts / gain;
       if (adc < 0) adc = 0;
@@ -192,7 +231,7 @@ bool HgcrocEmulator::digitize(
 
       // check for TOA
       int toa(0);
-      if (pulse(startBX) < toaThreshold && overTOA) {
+      if (bxVolts[iADC] < toaThreshold && overTOA) {
         double timecross = pulse.findCrossing(startBX, toverTOA, toaThreshold);
         toa = int((timecross - startBX) * ns_);
         // keep inside valid limits
@@ -221,8 +260,9 @@ bool HgcrocEmulator::digitize(
 std::vector<ldmx::HgcrocDigiCollection::Sample> HgcrocEmulator::noiseDigi(
     const int &channel, const double &soi_amplitude) const {
   // get chip conditions from emulator
-  double pedestal{this->pedestal(channel)};
-  double gain{this->gain(channel)};
+  const ChannelConditions &conds{channelConditions(channel)};
+  double pedestal{conds.pedestal};
+  double gain{conds.gain};
   // fill a digi with noise samples
   std::vector<ldmx::HgcrocDigiCollection::Sample> noise_digi;
   for (int iADC{0}; iADC < nADCs_; iADC++) {
@@ -231,8 +271,8 @@ std::vector<ldmx::HgcrocDigiCollection::Sample> HgcrocEmulator::noiseDigi(
     if (iADC > 0)
       adc_tm1 = noise_digi.at(iADC - 1).adc_t();
     else
-      adc_tm1 += noise(channel) / gain;
-    int adc_t{static_cast<int>(pedestal + noise(channel) / gain)};
+      adc_tm1 += noise(conds) / gain;
+    int adc_t{static_cast<int>(pedestal + noise(conds) / gain)};
 
     if (iADC == iSOI_) adc_t += soi_amplitude / gain;
 
@@ -0,0 +1,269 @@
+#include "Tools/InferenceService.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+
+#include "Framework/Exception/Exception.h"
+
+namespace ldmx::Ort {
+
+namespace {
+
+/// number of values in a tensor with the shape, ignoring the batch dim
+std::size_t sampleSize(const std::vector<int64_t>& shape) {
+  return std::accumulate(shape.begin() + 1, shape.end(), int64_t(1),
+                         std::multiplies<int64_t>());
+}
+
+/**
+ * Check that only the batch dim of a node depends on the inputs
+ *
+ * The arrays for one sample are made up front, so all of the other
+ * dims have to be fixed by the model.
+ *
+ * @param[in] node description of the node for the error message
+ * @param[in] shape shape of the node from the model
+ */
+void checkFixedShape(const std::string& node,
+                     const std::vector<int64_t>& shape) {
+  if (shape.empty()) {
+    EXCEPTION_RAISE("BadConf", node + " does not have a batch dimension.");
+  }
+  for (std::size_t i{1}; i < shape.size(); i++) {
+    if (shape[i] < 0) {
+      EXCEPTION_RAISE("BadConf", node + " does not have a fixed shape.");
+    }
+  }
+}
+
+/// convert the name of a graph optimization level to its enum
+GraphOptimizationLevel graphOptimizationLevel(const std::string& name) {
+  static const std::map<std::string, GraphOptimizationLevel> levels{
+      {"disable", ORT_DISABLE_ALL},
+      {"basic", ORT_ENABLE_BASIC},
+      {"extended", ORT_ENABLE_EXTENDED},
+      {"all", ORT_ENABLE_ALL}};
+  auto level{levels.find(name)};
+  if (level == levels.end()) {
+    EXCEPTION_RAISE("BadConf",
+                    "Unknown graph optimization level '" + name +
+                        "', use 'disable', 'basic', 'extended' or 'all'.");
+  }
+  return level->second;
+}
+
+}  // namespace
+
+InferenceService::Options InferenceService::Options::fromParameters(
+    const framework::config::Parameters& parameters) {
+  Options options;
+  options.intra_op_threads = parameters.getParameter<int>(
+      "intra_op_threads", options.intra_op_threads);
+  options.inter_op_threads = parameters.getParameter<int>(
+      "inter_op_threads", options.inter_op_threads);
+  options.graph_optimization = parameters.getParameter<std::string>(
+      "graph_optimization", options.graph_optimization);
+  options.max_batch_size =
+      parameters.getParameter<int>("max_batch_size", options.max_batch_size);
+  options.max_batch_delay =
+      parameters.getParameter<int>("max_batch_delay", options.max_batch_delay);
+  return options;
+}
+
+std::shared_ptr<InferenceService> InferenceService::get(
+    const std::string& model_path, const std::vector<std::string>& input_names,
+    const std::vector<std::string>& output_names, const Options& options) {
+  // the services are kept alive as long as one of their users is
+  static std::mutex services_mutex;
+  static std::map<std::string, std::weak_ptr<InferenceService>> services;
+
+  std::string key{model_path};
+  for (const auto& name : input_names) key += ";in:" + name;
+  for (const auto& name : output_names) key += ";out:" + name;
+  key += ";" + std::to_string(options.intra_op_threads) + ";" +
+         std::to_string(options.inter_op_threads) + ";" +
+         options.graph_optimization + ";" +
+         std::to_string(options.max_batch_size) + ";" +
+         std::to_string(options.max_batch_delay);
+
+  std::lock_guard<std::mutex> lock{services_mutex};
+  auto service{services[key].lock()};
+  if (not service) {
+    service = std::make_shared<InferenceService>(model_path, input_names,
+                                                 output_names, options);
+    services[key] = service;
+  }
+  return service;
+}
+
+InferenceService::InferenceService(const std::string& model_path,
+                                   const std::vector<std::string>& input_names,
+                                   const std::vector<std::string>& output_names,
+                                   const Options& options)
+    : memory_info_{::Ort::MemoryInfo::CreateCpu(OrtArenaAllocator,
+                                                OrtMemTypeDefault)},
+      input_names_{input_names},
+      output_names_{output_names},
+      max_batch_delay_{options.max_batch_delay} {
+  if (options.intra_op_threads < 0 or options.inter_op_threads < 0 or
+      options.max_batch_size < 1 or options.max_batch_delay < 0) {
+    EXCEPTION_RAISE("BadConf",
+                    "The numbers of threads and the batch delay cannot be "
+                    "negative and the batch size has to be at least one.");
+  }
+  ::Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(options.intra_op_threads);
+  session_options.SetInterOpNumThreads(options.inter_op_threads);
+  session_options.SetGraphOptimizationLevel(
+      graphOptimizationLevel(options.graph_optimization));
+  rt_ = std::make_unique<ONNXRuntime>(model_path, &session_options);
+
+  if (input_names_.size() != rt_->getInputNames().size()) {
+    EXCEPTION_RAISE("BadConf", "The model " + model_path + " has " +
+                                   std::to_string(rt_->getInputNames().size()) +
+                                   " inputs but " +
+                                   std::to_string(input_names_.size()) +
+                                   " were given.");
+  }
+  for (const auto& name : input_names_) {
+    // throws if the model does not have this input
+    input_shapes_.push_back(rt_->getInputShape(name));
+    checkFixedShape("Input " + name + " of the model " + model_path,
+                    input_shapes_.back());
+    input_sizes_.push_back(sampleSize(input_shapes_.back()));
+    input_node_names_.push_back(name.c_str());
+  }
+  if (output_names_.empty()) output_names_ = rt_->getOutputNames();
+  for (const auto& name : output_names_) {
+    output_shapes_.push_back(rt_->getOutputShape(name));
+    checkFixedShape("Output " + name + " of the model " + model_path,
+                    output_shapes_.back());
+    output_shapes_.back()[0] = 1;
+    output_sizes_.push_back(sampleSize(output_shapes_.back()));
+    output_node_names_.push_back(name.c_str());
+  }
+
+  // models with a fixed batch size can only be run one sample at a time
+  max_batch_size_ = rt_->hasDynamicBatch() ? options.max_batch_size : 1;
+  if (max_batch_size_ == 1) return;
+
+  // the arrays and tensors for all the batch sizes are made up front
+  auto bind = [this](std::vector<float>& values, std::size_t size,
+                     std::vector<int64_t> shape, std::size_t batch_size) {
+    shape[0] = batch_size;
+    return ::Ort::Value::CreateTensor<float>(memory_info_, values.data(),
+                                             batch_size * size, shape.data(),
+                                             shape.size());
+  };
+  for (std::size_t i{0}; i < input_sizes_.size(); i++) {
+    batch_inputs_.emplace_back(max_batch_size_ * input_sizes_[i], 0.);
+  }
+  for (std::size_t i{0}; i < output_sizes_.size(); i++) {
+    batch_outputs_.emplace_back(max_batch_size_ * output_sizes_[i], 0.);
+  }
+  for (std::size_t n{1}; n <= max_batch_size_; n++) {
+    auto& inputs{batch_input_tensors_.emplace_back()};
+    for (std::size_t i{0}; i < input_sizes_.size(); i++) {
+      inputs.push_back(
+          bind(batch_inputs_[i], input_sizes_[i], input_shapes_[i], n));
+    }
+    auto& outputs{batch_output_tensors_.emplace_back()};
+    for (std::size_t i{0}; i < output_sizes_.size(); i++) {
+      outputs.push_back(
+          bind(batch_outputs_[i], output_sizes_[i], output_shapes_[i], n));
+    }
+  }
+  queue_.reserve(max_batch_size_);
+  batch_.reserve(max_batch_size_);
+}
+
+InferenceService::Request InferenceService::makeRequest() const {
+  Request request;
+  for (std::size_t i{0}; i < input_sizes_.size(); i++) {
+    auto& values{request.inputs_.emplace_back(input_sizes_[i], 0.)};
+    request.input_tensors_.push_back(::Ort::Value::CreateTensor<float>(
+        memory_info_, values.data(), values.size(), input_shapes_[i].data(),
+        input_shapes_[i].size()));
+  }
+  for (std::size_t i{0}; i < output_sizes_.size(); i++) {
+    auto& values{request.outputs_.emplace_back(output_sizes_[i], 0.)};
+    request.output_tensors_.push_back(::Ort::Value::CreateTensor<float>(
+        memory_info_, values.data(), values.size(), output_shapes_[i].data(),
+        output_shapes_[i].size()));
+  }
+  return request;
+}
+
+void InferenceService::run(Request& request) {
+  if (max_batch_size_ == 1) {
+    // sessions can be run by several threads at once
+    rt_->run(input_node_names_.data(), request.input_tensors_.data(),
+             input_node_names_.size(), output_node_names_.data(),
+             request.output_tensors_.data(), output_node_names_.size());
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  request.done_ = false;
+  request.error_ = nullptr;
+  if (queue_.empty()) {
+    deadline_ = std::chrono::steady_clock::now() + max_batch_delay_;
+  }
+  queue_.push_back(&request);
+  cv_.notify_all();
+  while (not request.done_) {
+    if (busy_) {
+      // the requests queued up while a batch is running are run next
+      cv_.wait(lock);
+    } else if (queue_.size() < max_batch_size_ and
+               std::chrono::steady_clock::now() < deadline_) {
+      cv_.wait_until(lock, deadline_);
+    } else {
+      // this thread runs the oldest requests for everyone
+      busy_ = true;
+      std::size_t n{std::min(queue_.size(), max_batch_size_)};
+      batch_.assign(queue_.begin(), queue_.begin() + n);
+      queue_.erase(queue_.begin(), queue_.begin() + n);
+      deadline_ = std::chrono::steady_clock::now() + max_batch_delay_;
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        runBatch();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+      for (Request* done : batch_) {
+        done->done_ = true;
+        done->error_ = error;
+      }
+      busy_ = false;
+      cv_.notify_all();
+    }
+  }
+  if (request.error_) std::rethrow_exception(request.error_);
+}
+
+void InferenceService::runBatch() {
+  const std::size_t n{batch_.size()};
+  for (std::size_t i{0}; i < input_sizes_.size(); i++) {
+    for (std::size_t k{0}; k < n; k++) {
+      std::copy(batch_[k]->inputs_[i].begin(), batch_[k]->inputs_[i].end(),
+                batch_inputs_[i].begin() + k * input_sizes_[i]);
+    }
+  }
+  rt_->run(input_node_names_.data(), batch_input_tensors_[n - 1].data(),
+           input_node_names_.size(), output_node_names_.data(),
+           batch_output_tensors_[n - 1].data(), output_node_names_.size());
+  for (std::size_t i{0}; i < output_sizes_.size(); i++) {
+    for (std::size_t k{0}; k < n; k++) {
+      auto begin{batch_outputs_[i].begin() + k * output_sizes_[i]};
+      std::copy(begin, begin + output_sizes_[i],
+                batch_[k]->outputs_[i].begin());
+    }
+  }
+}
+
+}  // namespace ldmx::Ort
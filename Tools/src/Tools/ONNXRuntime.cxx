@@ -76,6 +76,9 @@ ONNXRuntime::ONNXRuntime(const std::string& model_path,
     std::copy(input_shape.begin(), input_shape.end(),
               input_node_dims_[input_name].begin());
 
+    // models exported with a fixed batch size can only run one sample
+    if (input_shape.at(0) > 0) dynamic_batch_ = false;
+
     // set the batch size to 1 by default
     input_node_dims_[input_name].at(0) = 1;
   }
@@ -174,6 +177,31 @@ FloatArrays ONNXRuntime::run(const std::vector<std::string>& input_names,
   return outputs;
 }
 
+void ONNXRuntime::run(const char* const* input_names, const Value* inputs,
+                      std::size_t n_inputs, const char* const* output_names,
+                      Value* outputs, std::size_t n_outputs) const {
+  session_->Run(RunOptions{nullptr}, input_names, inputs, n_inputs,
+                output_names, outputs, n_outputs);
+}
+
+const std::vector<std::string>& ONNXRuntime::getInputNames() const {
+  if (session_) {
+    return input_node_strings_;
+  } else {
+    throw std::runtime_error("ONNXRuntime session is not initialized!");
+  }
+}
+
+const std::vector<int64_t>& ONNXRuntime::getInputShape(
+    const std::string& input_name) const {
+  auto iter = input_node_dims_.find(input_name);
+  if (iter == input_node_dims_.end()) {
+    throw std::runtime_error("Input name " + input_name + " is invalid!");
+  } else {
+    return iter->second;
+  }
+}
+
 const std::vector<std::string>& ONNXRuntime::getOutputNames() const {
   if (session_) {
     return output_node_strings_;
@@ -0,0 +1,135 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "TF1.h"
+#include "Tools/HgcrocPulseShape.h"
+
+using Catch::Approx;
+
+namespace tools {
+namespace test {
+
+/// default pulse shape parameters from the python configuration
+static const double RATE_UP = -0.1141;
+static const double TIME_UP = -9.897;
+static const double RATE_DN = 0.0279;
+static const double TIME_DN = 45.037;
+static const double TIME_PEAK = 12.698;
+
+/// number of ADC samples and the clock cycle [ns]
+static const int N_ADCS = 10;
+static const double CLOCK_CYCLE = 25.;
+
+/**
+ * Build the TF1 formula the pulse shape used to be evaluated with
+ */
+static TF1 formula() {
+  TF1 func("pulseFunc",
+           "[0]*((1.0+exp([1]*(-[2]+[3])))*(1.0+exp([5]*(-[6]+[3]))))/"
+           "((1.0+exp([1]*(x-[2]+[3]-[4])))*(1.0+exp([5]*(x-[6]+[3]-[4]))))",
+           0.0, N_ADCS * CLOCK_CYCLE);
+  func.FixParameter(0, 1.0);
+  func.FixParameter(1, RATE_UP);
+  func.FixParameter(2, TIME_UP);
+  func.FixParameter(3, TIME_PEAK);
+  func.FixParameter(4, 0);
+  func.FixParameter(5, RATE_DN);
+  func.FixParameter(6, TIME_DN);
+  return func;
+}
+
+/**
+ * Times the pulse shape is evaluated at for one digitization
+ *
+ * These are the sampling times followed by the BX boundaries.
+ */
+static std::vector<double> samplingTimes() {
+  std::vector<double> times;
+  for (int i = 0; i < N_ADCS; i++) times.push_back((i - 2) * CLOCK_CYCLE);
+  for (int i = 0; i <= N_ADCS; i++)
+    times.push_back((i - 2) * CLOCK_CYCLE - 12.);
+  return times;
+}
+
+/// amplitudes and peak times of a few merged hits
+static const std::vector<std::pair<double, double>> HITS = {
+    {100., 0.}, {20., 13.}, {5., -31.}, {250., 47.}};
+
+}  // namespace test
+}  // namespace tools
+
+/**
+ * Test the native pulse shape against the TF1 formula
+ *
+ * We check the values, the derivative, and the batched accumulation
+ * for a typical digitization: a few merged hits each measured at all
+ * of the sampling times and BX boundaries.
+ */
+TEST_CASE("HgcrocPulseShape", "[Tools][HgcrocPulseShape]") {
+  using namespace tools::test;
+  TF1 func{formula()};
+  ldmx::HgcrocPulseShape shape(RATE_UP, TIME_UP, RATE_DN, TIME_DN, TIME_PEAK);
+
+  SECTION("Matches TF1 formula") {
+    CHECK(shape(0.) == Approx(1.));
+    for (double t = -100.; t < 250.; t += 0.37) {
+      CHECK(shape(t) == Approx(func.Eval(t)).epsilon(1e-12));
+    }
+  }
+
+  SECTION("Derivative matches finite difference") {
+    const double h = 1e-5;
+    for (double t = -100.; t < 250.; t += 1.13) {
+      double diff = (shape(t + h) - shape(t - h)) / (2 * h);
+      CHECK(shape.derivative(t) == Approx(diff).epsilon(1e-6).margin(1e-9));
+    }
+    // peak is at zero
+    CHECK(shape.derivative(0.) == Approx(0.).margin(1e-6));
+  }
+
+  SECTION("Batched accumulation matches single evaluations") {
+    std::vector<double> times{samplingTimes()};
+    std::vector<double> voltages(times.size(), 0.);
+    for (const auto& [amplitude, peak] : HITS)
+      shape.accumulate(amplitude, peak, times.data(), voltages.data(),
+                       times.size());
+    for (std::size_t i = 0; i < times.size(); i++) {
+      double expected = 0.;
+      for (const auto& [amplitude, peak] : HITS)
+        expected += amplitude * func.Eval(times[i] - peak);
+      CHECK(voltages[i] == Approx(expected).epsilon(1e-12));
+    }
+  }
+}
+
+/**
+ * Benchmark the TF1 against the native evaluation of the pulse shape
+ *
+ * Hidden so that it isn't run with the tests, run it with
+ * `run_test "[.benchmark]"`.
+ */
+TEST_CASE("HgcrocPulseShape benchmark", "[.benchmark][HgcrocPulseShape]") {
+  using namespace tools::test;
+  TF1 func{formula()};
+  ldmx::HgcrocPulseShape shape(RATE_UP, TIME_UP, RATE_DN, TIME_DN, TIME_PEAK);
+  std::vector<double> times{samplingTimes()};
+
+  BENCHMARK("TF1 formula") {
+    std::vector<double> voltages(times.size(), 0.);
+    for (const auto& [amplitude, peak] : HITS)
+      for (std::size_t i = 0; i < times.size(); i++)
+        voltages[i] += amplitude * func.Eval(times[i] - peak);
+    return voltages;
+  };
+
+  BENCHMARK("Native batched") {
+    std::vector<double> voltages(times.size(), 0.);
+    for (const auto& [amplitude, peak] : HITS)
+      shape.accumulate(amplitude, peak, times.data(), voltages.data(),
+                       times.size());
+    return voltages;
+  };
+}
@@ -0,0 +1,261 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Framework/Exception/Exception.h"
+#include "Tools/InferenceService.h"
+
+namespace ldmx::Ort::test {
+
+/**
+ * @class Message
+ * Write the few protobuf messages needed for a tiny ONNX model
+ *
+ * The field numbers are the ones in onnx.proto.
+ */
+class Message {
+ public:
+  /// add an integer field
+  Message& varint(int field, uint64_t value) {
+    key(field, 0);
+    raw(value);
+    return *this;
+  }
+
+  /// add a string field
+  Message& bytes(int field, const std::string& value) {
+    key(field, 2);
+    raw(value.size());
+    buffer_ += value;
+    return *this;
+  }
+
+  /// add a sub-message field
+  Message& message(int field, const Message& value) {
+    return bytes(field, value.buffer_);
+  }
+
+  /// add a packed repeated float field
+  Message& floats(int field, const std::vector<float>& values) {
+    std::string packed(values.size() * sizeof(float), '\0');
+    std::memcpy(packed.data(), values.data(), packed.size());
+    return bytes(field, packed);
+  }
+
+  /// the serialized message
+  const std::string& str() const { return buffer_; }
+
+ private:
+  void key(int field, int wire_type) { raw(uint64_t(field) << 3 | wire_type); }
+
+  void raw(uint64_t value) {
+    while (value >= 0x80) {
+      buffer_ += char((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    buffer_ += char(value);
+  }
+
+  std::string buffer_;
+};
+
+/**
+ * @func valueInfo
+ * Describe a float tensor with a dynamic batch dimension
+ *
+ * Negative dims after the batch dimension are dynamic as well.
+ */
+static Message valueInfo(const std::string& name,
+                         const std::vector<int64_t>& dims) {
+  Message shape;
+  shape.message(1, Message().bytes(2, "N"));
+  for (int64_t dim : dims) {
+    shape.message(1, dim < 0 ? Message().bytes(2, "M")
+                             : Message().varint(1, dim));
+  }
+  Message tensor;
+  tensor.varint(1, 1).message(2, shape);
+  return Message().bytes(1, name).message(2, Message().message(1, tensor));
+}
+
+/**
+ * @func node
+ * Describe an operator
+ */
+static Message node(const std::string& op,
+                    const std::vector<std::string>& inputs,
+                    const std::string& output) {
+  Message n;
+  for (const auto& input : inputs) n.bytes(1, input);
+  return n.bytes(2, output).bytes(4, op);
+}
+
+/**
+ * @func writeModel
+ * Write a model with its graph into a file
+ */
+static void writeModel(const std::string& filename, const Message& graph) {
+  Message model;
+  model.varint(1, 6).bytes(2, "ldmx-sw test");
+  model.message(7, graph);
+  model.message(8, Message().bytes(1, "").varint(2, 11));
+  std::ofstream f{filename, std::ios::binary};
+  f << model.str();
+}
+
+/// number of rows in the table of the lookup model
+static const int N_ROWS{4};
+
+/**
+ * @func lookupModel
+ * Write a model looking up a row of a table and adding an offset to it
+ *
+ * sum[n][0][j] = table[index[n][0]][j] + offset[n][0][j]
+ * with table[i][j] = 3*i + j, so an index outside of the table
+ * fails when the model is run.
+ */
+static void lookupModel(const std::string& filename) {
+  std::vector<float> table;
+  for (int i{0}; i < 3 * N_ROWS; i++) table.push_back(i);
+  Message graph;
+  graph.message(1, node("Cast", {"index"}, "index_int")
+                       .message(5, Message().bytes(1, "to").varint(3, 7)
+                                       .varint(20, 2)));
+  graph.message(1, node("Gather", {"table", "index_int"}, "rows"));
+  graph.message(1, node("Add", {"rows", "offset"}, "sum"));
+  graph.bytes(2, "lookup");
+  graph.message(5, Message().varint(1, N_ROWS).varint(1, 3).varint(2, 1)
+                       .floats(4, table).bytes(8, "table"));
+  graph.message(11, valueInfo("index", {1}));
+  graph.message(11, valueInfo("offset", {1, 3}));
+  graph.message(12, valueInfo("sum", {1, 3}));
+  writeModel(filename, graph);
+}
+
+/**
+ * @func dynamicModel
+ * Write a model whose input has a dynamic dimension besides the batch
+ */
+static void dynamicModel(const std::string& filename) {
+  Message graph;
+  graph.message(1, node("Identity", {"x"}, "y"));
+  graph.bytes(2, "dynamic");
+  graph.message(11, valueInfo("x", {-1}));
+  graph.message(12, valueInfo("y", {-1}));
+  writeModel(filename, graph);
+}
+
+/**
+ * @func runSamples
+ * Run the samples for one thread through the service
+ *
+ * @return outputs of each sample, empty for samples that failed
+ */
+static std::vector<std::vector<float>> runSamples(InferenceService& service,
+                                                  int thread, int n_samples) {
+  auto request{service.makeRequest()};
+  std::vector<std::vector<float>> outputs;
+  for (int i{0}; i < n_samples; i++) {
+    request.input(0)[0] = (thread + i) % N_ROWS;
+    for (int j{0}; j < 3; j++) request.input(1)[j] = 100. * thread + i + j;
+    service.run(request);
+    auto sum{request.output(0)};
+    outputs.emplace_back(sum.begin(), sum.end());
+  }
+  return outputs;
+}
+
+}  // namespace ldmx::Ort::test
+
+/**
+ * Test for the InferenceService
+ *
+ * The test writes a tiny model that looks up rows of a table, so each
+ * sample has its own outputs.
+ *
+ * What does this test?
+ *  - requests from several threads batched together get the same
+ *    outputs as when they are run one at a time
+ *  - an error running a batch is re-thrown for each request in it and
+ *    the service keeps running after it
+ *  - models with dynamic dims besides the batch dim are rejected
+ */
+TEST_CASE("InferenceService", "[Tools][InferenceService]") {
+  using ldmx::Ort::InferenceService;
+  const std::string model{"inference_service_test.onnx"};
+  ldmx::Ort::test::lookupModel(model);
+
+  InferenceService::Options unbatched;
+  auto single{InferenceService::get(model, {"index", "offset"}, {}, unbatched)};
+  InferenceService::Options batched;
+  batched.max_batch_size = 4;
+  batched.max_batch_delay = 200;
+  auto service{InferenceService::get(model, {"index", "offset"}, {}, batched)};
+  CHECK(service != single);
+  CHECK(InferenceService::get(model, {"index", "offset"}, {}, batched) ==
+        service);
+
+  SECTION("batched outputs match unbatched ones") {
+    const int n_threads{6}, n_samples{50};
+    std::vector<std::vector<std::vector<float>>> outputs(n_threads);
+    std::vector<std::thread> threads;
+    for (int t{0}; t < n_threads; t++) {
+      threads.emplace_back([&, t]() {
+        outputs[t] = ldmx::Ort::test::runSamples(*service, t, n_samples);
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (int t{0}; t < n_threads; t++) {
+      auto expected{ldmx::Ort::test::runSamples(*single, t, n_samples)};
+      CHECK(outputs[t] == expected);
+      // the unbatched outputs are the rows of the table plus the offset
+      for (int i{0}; i < n_samples; i++) {
+        int row{(t + i) % ldmx::Ort::test::N_ROWS};
+        for (int j{0}; j < 3; j++) {
+          CHECK(expected[i].at(j) == 3 * row + j + 100 * t + i + j);
+        }
+      }
+    }
+  }
+
+  SECTION("errors are passed to each request") {
+    const int n_threads{4};
+    std::vector<int> failed(n_threads, 0);
+    std::vector<std::thread> threads;
+    for (int t{0}; t < n_threads; t++) {
+      threads.emplace_back([&, t]() {
+        auto request{service->makeRequest()};
+        // outside of the table
+        request.input(0)[0] = ldmx::Ort::test::N_ROWS + t;
+        try {
+          service->run(request);
+        } catch (const std::exception&) {
+          failed[t] = 1;
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int t{0}; t < n_threads; t++) CHECK(failed[t] == 1);
+
+    // the service is still usable after the failed batches
+    auto outputs{ldmx::Ort::test::runSamples(*service, 1, 3)};
+    CHECK(outputs == ldmx::Ort::test::runSamples(*single, 1, 3));
+  }
+
+  SECTION("only the batch dim can be dynamic") {
+    const std::string dynamic{"inference_service_dynamic_test.onnx"};
+    ldmx::Ort::test::dynamicModel(dynamic);
+    CHECK_THROWS_AS(InferenceService::get(dynamic, {"x"}, {}, unbatched),
+                    framework::exception::Exception);
+    std::remove(dynamic.c_str());
+  }
+
+  std::remove(model.c_str());
+}
@@ -3,6 +3,7 @@
 //--- Framework ---//
 #include "Framework/Configure/Parameters.h"
 #include "Framework/EventProcessor.h"
+#include "Framework/Performance/Profiler.h"
 #include "Framework/RandomNumberSeedService.h"
 
 //--- C++ ---//
@@ -152,9 +153,6 @@ class CKFProcessor final : public TrackingGeometryUser {
   // Processing time counter
   double processing_time_{0.};
 
-  // time profiling
-  std::map<std::string, double> profiling_map_;
-
   bool debug_acts_{false};
 
   std::shared_ptr<Acts::PlaneSurface> target_surface;
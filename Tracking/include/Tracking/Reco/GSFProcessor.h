@@ -163,9 +163,6 @@ class GSFProcessor final : public TrackingGeometryUser {
   // Processing time counter
   // double processing_time_{0.};
 
-  // time profiling
-  std::map<std::string, double> profiling_map_;
-
   // refitting of tracks
   // bool kf_refit_{false};
   // bool gsf_refit_{false};
@@ -1,9 +1,9 @@
 #pragma once
 #include "Acts/EventData/VectorTrackContainer.hpp"
-#include "SimCore/Event/SimParticle.h"
 #include "Tracking/Event/Measurement.h"
 #include "Tracking/Event/Track.h"
 #include "Tracking/Reco/TruthMatchingTool.h"
+#include "Tracking/Sim/TruthParticles.h"
 
 namespace tracking {
 namespace sim {
@@ -21,20 +21,29 @@ class TruthMatchingTool {
   /**
    * Constructor.
    *
-   * @param particleMap The map of all the simulated particles in the event.
+   * @param particles All the simulated particles in the event.
    * @param measurements All the measurements in the event.
    */
 
-  TruthMatchingTool(const std::map<int, ldmx::SimParticle>& particleMap,
+  TruthMatchingTool(const TruthParticles& particles,
                     const std::vector<ldmx::Measurement>& measurements) {
-    setup(particleMap, measurements);
+    setup(particles, measurements);
   };
 
-  void setup(const std::map<int, ldmx::SimParticle>& particleMap,
+  /**
+   * Set up the matching for a new event
+   *
+   * The tool is only configured if the particles of the event are
+   * available.
+   *
+   * @param particles All the simulated particles in the event.
+   * @param measurements All the measurements in the event.
+   */
+  void setup(const TruthParticles& particles,
              const std::vector<ldmx::Measurement>& measurements) {
-    map_ = particleMap;
+    particles_ = particles;
     measurements_ = measurements;
-    configured_ = true;
+    configured_ = particles.available();
   }
 
   /**
@@ -52,7 +61,7 @@ class TruthMatchingTool {
   bool configured() { return configured_; }
 
  private:
-  std::map<int, ldmx::SimParticle> map_;
+  TruthParticles particles_;
   std::vector<ldmx::Measurement> measurements_;
   bool debug_{false};
   std::shared_ptr<tracking::sim::TruthMatchingTool> truthMatchingTool = nullptr;
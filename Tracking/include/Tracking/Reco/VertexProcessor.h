@@ -84,7 +84,7 @@ class VertexProcessor : public framework::Producer {
   int nevents_{0};
 
   // The interpolated bfield
-  std::shared_ptr<InterpolatedMagneticField3> sp_interpolated_bField_;
+  std::shared_ptr<const InterpolatedMagneticField3> sp_interpolated_bField_;
 
   /// Path to the magnetic field map.
   std::string field_map_{""};
@@ -68,7 +68,7 @@ class Vertexer : public framework::Producer {
   int nevents_{0};
   int nvertices_{0};
   int nreconstructable_{0};
-  std::shared_ptr<InterpolatedMagneticField3> sp_interpolated_bField_;
+  std::shared_ptr<const InterpolatedMagneticField3> sp_interpolated_bField_;
   std::shared_ptr<Acts::ConstantBField> bField_;
 
   /// Path to the magnetic field map.
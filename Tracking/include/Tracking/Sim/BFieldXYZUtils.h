@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include "Acts/Definitions/Algebra.hpp"
 #include "Acts/MagneticField/BFieldMapUtils.hpp"
@@ -12,6 +15,7 @@
 #include "Acts/Utilities/Grid.hpp"
 #include "Acts/Utilities/Interpolation.hpp"
 #include "Acts/Utilities/Result.hpp"
+#include "DetDescr/FieldMap.h"
 
 static const double DIPOLE_OFFSET = 400.;  // 400 mm
 
@@ -269,6 +273,64 @@ inline InterpolatedMagneticField3 makeMagneticFieldMapXyzFromText(
                              lengthUnit, BFieldUnit, firstOctant);
 }
 
+/**
+ * Build the interpolated field from a field map loaded into memory
+ *
+ * This creates the same grid as rotateFieldMapXYZ would from the positions
+ * and field values listed in the file without needing to parse the file
+ * into separate position and field vectors. The map is expected to list
+ * the grid points with z changing the fastest, as in the text field maps.
+ *
+ * @param[in] map field map to copy into the grid
+ * @param[in] transformPosition transformation from tracking to field space
+ * @param[in] transformMagneticField transformation from field to tracking
+ * space
+ * @param[in] lengthUnit unit of the grid positions in the map
+ * @param[in] BFieldUnit unit of the field values in the map
+ * @returns interpolated field map
+ */
+inline InterpolatedMagneticField3 makeMagneticFieldMapXyzFromFieldMap(
+    const ldmx::FieldMap& map, GenericTransformPos transformPosition,
+    GenericTransformBField transformMagneticField,
+    Acts::ActsScalar lengthUnit, Acts::ActsScalar BFieldUnit) {
+  std::array<size_t, 3> nBins = {{map.nx(), map.ny(), map.nz()}};
+  std::array<double, 3> min, max;
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    min[axis] = std::min(map.first()[axis], map.last()[axis]);
+    max[axis] = std::max(map.first()[axis], map.last()[axis]);
+    // add one last bin, because bin value always corresponds to left boundary
+    max[axis] += std::fabs(max[axis] - min[axis]) / (nBins[axis] - 1);
+  }
+
+  Acts::Axis<Acts::AxisType::Equidistant> xAxis(
+      min[0] * lengthUnit, max[0] * lengthUnit, nBins[0]);
+  Acts::Axis<Acts::AxisType::Equidistant> yAxis(
+      min[1] * lengthUnit, max[1] * lengthUnit, nBins[1]);
+  Acts::Axis<Acts::AxisType::Equidistant> zAxis(
+      min[2] * lengthUnit, max[2] * lengthUnit, nBins[2]);
+  using Grid_t =
+      Acts::Grid<Acts::Vector3, Acts::Axis<Acts::AxisType::Equidistant>,
+                 Acts::Axis<Acts::AxisType::Equidistant>,
+                 Acts::Axis<Acts::AxisType::Equidistant>>;
+  Grid_t grid(
+      std::make_tuple(std::move(xAxis), std::move(yAxis), std::move(zAxis)));
+
+  // local bins start at 1 since 0 is the underflow bin
+  for (size_t i = 1; i <= nBins[0]; ++i) {
+    for (size_t j = 1; j <= nBins[1]; ++j) {
+      for (size_t k = 1; k <= nBins[2]; ++k) {
+        const double* b = map.at(i - 1, j - 1, k - 1);
+        grid.atLocalBins({{i, j, k}}) =
+            Acts::Vector3(b[0], b[1], b[2]) * BFieldUnit;
+      }
+    }
+  }
+  grid.setExteriorBins(Acts::Vector3::Zero());
+
+  return Acts::InterpolatedBFieldMap<Grid_t>(
+      {transformPosition, transformMagneticField, std::move(grid)});
+}
+
 inline InterpolatedMagneticField3 loadDefaultBField(
     const std::string& fieldMapFile, GenericTransformPos transformPosition,
     GenericTransformBField transformMagneticField) {
@@ -276,16 +338,38 @@ inline InterpolatedMagneticField3 loadDefaultBField(
   // transformPosition, std::function<Acts::Vector3(const Acts::Vector3&,const
   // Acts::Vector3&)> transformMagneticField
 
-  return makeMagneticFieldMapXyzFromText(
-      std::move(localToGlobalBin_xyz), transformPosition,
-      transformMagneticField, fieldMapFile,
-      1. * Acts::UnitConstants::mm,    // default scale for axes length
-      1000. * Acts::UnitConstants::T,  // The map is in kT, so scale it to T
-      false,                           // not symmetrical
-      true                             // rotate the axes to tracking frame
+  // the map is only kept while it is in use,
+  // see sharedDefaultBField to share the field between processors
+  return makeMagneticFieldMapXyzFromFieldMap(
+      *ldmx::FieldMap::load(fieldMapFile), transformPosition,
+      transformMagneticField,
+      1. * Acts::UnitConstants::mm,   // default scale for axes length
+      1000. * Acts::UnitConstants::T  // The map is in kT, so scale it to T
   );
 }
 
+/**
+ * Get the interpolated field of a field map in the tracking frame
+ *
+ * The field uses the default transformations with the input offset
+ * added to the position in the field frame. Building the Acts grid
+ * copies every value of the map, so it is only done the first time a
+ * map is asked for with an offset. The field is then kept for the rest
+ * of the process and shared by all of the tracking processors that ask
+ * for the same map and offset. The field map is kept as well, so that
+ * asking for another offset does not read the file again.
+ *
+ * The field is not changed after it is built and each user makes its
+ * own cache to evaluate it, so it can be shared between threads.
+ *
+ * @param[in] fieldMapFile path to the field map
+ * @param[in] offset offset of the map in the field frame
+ * @returns shared interpolated field
+ */
+std::shared_ptr<const InterpolatedMagneticField3> sharedDefaultBField(
+    const std::string& fieldMapFile,
+    const std::array<double, 3>& offset = {0., 0., 0.});
+
 // R =
 //
 // 0   0   1
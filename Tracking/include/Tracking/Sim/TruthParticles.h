@@ -0,0 +1,87 @@
+#ifndef TRACKING_SIM_TRUTHPARTICLES_H
+#define TRACKING_SIM_TRUTHPARTICLES_H
+
+#include <map>
+
+//--- Framework ---//
+#include "Framework/Event.h"
+
+//--- SimCore ---//
+#include "SimCore/Event/SimParticle.h"
+#include "SimCore/Event/SimParticleTable.h"
+
+namespace tracking {
+namespace sim {
+
+/**
+ * Look up the simulated particles of an event by track ID
+ *
+ * The simulation saves the particles either as the columnar
+ * SimParticleTable or as the map of SimParticles. The table is used
+ * when it is in the event, otherwise this falls back to the map.
+ * Only the particles that are asked for are constructed from the table.
+ *
+ * The particles are read from the event bus, so this is only valid
+ * until the end of the event it was set up with.
+ */
+class TruthParticles {
+ public:
+  /// Constructor, without any particles
+  TruthParticles() = default;
+
+  /**
+   * Constructor
+   *
+   * @param[in] event event to get the particles from
+   */
+  explicit TruthParticles(const framework::Event& event) { setup(event); }
+
+  /**
+   * Get the particles of a new event
+   *
+   * @param[in] event event to get the particles from
+   * @return true if the event has either the table or the map
+   */
+  bool setup(const framework::Event& event);
+
+  /// @return true if the particles of the event are available
+  bool available() const { return table_ != nullptr || map_ != nullptr; }
+
+  /// @return true if the particle with the track ID was saved
+  bool contains(int trackID) const;
+
+  /**
+   * Get the charge of a particle
+   *
+   * @param[in] trackID track ID of the particle
+   * @return charge of the particle, 0 if it was not saved
+   */
+  double getCharge(int trackID) const;
+
+  /**
+   * Get the PDG ID of a particle
+   *
+   * @param[in] trackID track ID of the particle
+   * @return PDG ID of the particle, 0 if it was not saved
+   */
+  int getPdgID(int trackID) const;
+
+  /**
+   * Get a particle
+   *
+   * @param[in] trackID track ID of the particle
+   * @return the particle, a default one if it was not saved
+   */
+  ldmx::SimParticle getParticle(int trackID) const;
+
+ private:
+  /// table of particles, nullptr if the event does not have it
+  const ldmx::SimParticleTable* table_{nullptr};
+  /// map of particles, only used if there is no table
+  const std::map<int, ldmx::SimParticle>* map_{nullptr};
+};
+
+}  // namespace sim
+}  // namespace tracking
+
+#endif  // TRACKING_SIM_TRUTHPARTICLES_H
@@ -2,9 +2,9 @@
 
 #include "Acts/EventData/TrackContainer.hpp"
 #include "Acts/Utilities/TrackHelpers.hpp"
-#include "SimCore/Event/SimParticle.h"
 #include "Tracking/Reco/TruthMatchingTool.h"
 #include "Tracking/Sim/GeometryContainers.h"
+#include "Tracking/Sim/TruthParticles.h"
 
 //--- C++ StdLib ---//
 #include <algorithm>  //std::vector reverse
@@ -22,13 +22,6 @@ CKFProcessor::CKFProcessor(const std::string& name, framework::Process& process)
 CKFProcessor::~CKFProcessor() {}
 
 void CKFProcessor::onNewRun(const ldmx::RunHeader& rh) {
-  profiling_map_["setup"] = 0.;
-  profiling_map_["hits"] = 0.;
-  profiling_map_["seeds"] = 0.;
-  profiling_map_["ckf_setup"] = 0.;
-  profiling_map_["ckf_run"] = 0.;
-  profiling_map_["result_loop"] = 0.;
-
   // Generate a constant magnetic field
   Acts::Vector3 b_field(0., 0., bfield_ * Acts::UnitConstants::T);
 
@@ -57,69 +50,9 @@ void CKFProcessor::onNewRun(const ldmx::RunHeader& rh) {
   target_surface =
       Acts::Surface::makeShared<Acts::PlaneSurface>(target_transform);
 
-  // Custom transformation of the interpolated bfield map
-  bool debugTransform = false;
-  auto transformPos = [this, debugTransform](const Acts::Vector3& pos) {
-    Acts::Vector3 rot_pos;
-    rot_pos(0) = pos(1);
-    rot_pos(1) = pos(2);
-    rot_pos(2) = pos(0) + DIPOLE_OFFSET;
-
-    // Systematic effect
-    rot_pos(0) += this->map_offset_[0];
-    rot_pos(1) += this->map_offset_[1];
-    rot_pos(2) += this->map_offset_[2];
-
-    // Apply A rotation around the center of the magnet. (I guess offset first
-    // and then rotation)
-
-    if (debugTransform) {
-      std::cout << "PF::DEFAULT3 TRANSFORM" << std::endl;
-      std::cout << "PF::Check:: transforming Pos" << std::endl;
-      std::cout << pos << std::endl;
-      std::cout << "TO" << std::endl;
-      std::cout << rot_pos << std::endl;
-    }
-
-    return rot_pos;
-  };
-
-  Acts::RotationMatrix3 rotation = Acts::RotationMatrix3::Identity();
-  double scale = 1.;
-
-  auto transformBField = [rotation, scale, debugTransform](
-                             const Acts::Vector3& field,
-                             const Acts::Vector3& /*pos*/) {
-    // Rotate the field in tracking coordinates
-    Acts::Vector3 rot_field;
-    rot_field(0) = field(2);
-    rot_field(1) = field(0);
-    rot_field(2) = field(1);
-
-    // Scale the field
-    rot_field = scale * rot_field;
-
-    // Rotate the field
-    rot_field = rotation * rot_field;
-
-    // A distortion scaled by position.
-    if (debugTransform) {
-      std::cout << "PF::DEFAULT3 TRANSFORM" << std::endl;
-      std::cout << "PF::Check:: transforming" << std::endl;
-      std::cout << field << std::endl;
-      std::cout << "TO" << std::endl;
-      std::cout << rot_field << std::endl;
-    }
-
-    return rot_field;
-  };
-
-  // Setup a interpolated bfield map
-  const auto map = std::make_shared<InterpolatedMagneticField3>(
-      loadDefaultBField(field_map_,
-                        // default_transformPos,
-                        // default_transformBField));
-                        transformPos, transformBField));
+  // Setup a interpolated bfield map, shared with the other processors
+  const auto map = sharedDefaultBField(
+      field_map_, {map_offset_.at(0), map_offset_.at(1), map_offset_.at(2)});
 
   auto acts_loggingLevel = Acts::Logging::FATAL;
   if (debug_acts_) acts_loggingLevel = Acts::Logging::VERBOSE;
@@ -161,6 +94,7 @@ void CKFProcessor::produce(framework::Event& event) {
   std::vector<ldmx::Track> tracks;
 
   auto start = std::chrono::high_resolution_clock::now();
+  framework::performance::ScopedTimer timer{"setup"};
 
   nevents_++;
   if (nevents_ % 1000 == 0) ldmx_log(info) << "events processed:" << nevents_;
@@ -203,31 +137,26 @@ void CKFProcessor::produce(framework::Event& event) {
 
   // a) Loop over the sim Hits
 
-  auto setup = std::chrono::high_resolution_clock::now();
-  profiling_map_["setup"] +=
-      std::chrono::duration<double, std::milli>(setup - start).count();
+  timer.next("hits");
 
   const std::vector<ldmx::Measurement> measurements =
       event.getCollection<ldmx::Measurement>(measurement_collection_);
 
-  // check if SimParticleMap is available for truth matching
+  // check if the SimParticles are available for truth matching
   std::shared_ptr<tracking::sim::TruthMatchingTool> truthMatchingTool = nullptr;
-  std::map<int, ldmx::SimParticle> particleMap;
+  tracking::sim::TruthParticles particles;
 
-  if (event.exists("SimParticles")) {
+  if (particles.setup(event)) {
     ldmx_log(debug) << "Setting up track truth matching tool";
-    particleMap = event.getMap<int, ldmx::SimParticle>("SimParticles");
     truthMatchingTool = std::make_shared<tracking::sim::TruthMatchingTool>(
-        particleMap, measurements);
+        particles, measurements);
   }
 
   // The mapping between the geometry identifier
   // and the IndexsourceLink that points to the hit
   const auto geoId_sl_map = makeGeoIdSourceLinkMap(tg, measurements);
 
-  auto hits = std::chrono::high_resolution_clock::now();
-  profiling_map_["hits"] +=
-      std::chrono::duration<double, std::milli>(hits - setup).count();
+  timer.next("seeds");
 
   // ============   Setup the CKF  ============
 
@@ -283,9 +212,7 @@ void CKFProcessor::produce(framework::Event& event) {
     return;
   }
 
-  auto seeds = std::chrono::high_resolution_clock::now();
-  profiling_map_["seeds"] +=
-      std::chrono::duration<double, std::milli>(seeds - hits).count();
+  timer.next("ckf_setup");
 
   Acts::GainMatrixUpdater kfUpdater;
 
@@ -375,13 +302,7 @@ void CKFProcessor::produce(framework::Event& event) {
   ldmx_log(debug) << "About to run CKF..." << std::endl;
 
   // run the CKF for all initial track states
-  auto ckf_setup = std::chrono::high_resolution_clock::now();
-  profiling_map_["ckf_setup"] +=
-      std::chrono::duration<double, std::milli>(ckf_setup - seeds).count();
-
-  auto ckf_run = std::chrono::high_resolution_clock::now();
-  profiling_map_["ckf_run"] +=
-      std::chrono::duration<double, std::milli>(ckf_run - ckf_setup).count();
+  timer.next("result_loop");
 
   Acts::VectorTrackContainer vtc;
   Acts::VectorMultiTrajectory mtj;
@@ -609,9 +530,7 @@ void CKFProcessor::produce(framework::Event& event) {
     }
   }  // loop seed track parameters
 
-  auto result_loop = std::chrono::high_resolution_clock::now();
-  profiling_map_["result_loop"] +=
-      std::chrono::duration<double, std::milli>(result_loop - ckf_run).count();
+  timer.next("output");
 
   // Add the tracks to the event
   event.add(out_trk_collection_, tracks);
@@ -636,25 +555,6 @@ void CKFProcessor::onProcessEnd() {
                  << " nseeds";
   ldmx_log(info) << "AVG Time/Event: " << std::fixed << std::setprecision(1)
                  << processing_time_ / nevents_ << " ms";
-  ldmx_log(info) << "Breakdown::";
-  ldmx_log(info) << "setup       Avg Time/Event = " << std::fixed
-                 << std::setprecision(3) << profiling_map_["setup"] / nevents_
-                 << " ms";
-  ldmx_log(info) << "hits        Avg Time/Event = " << std::fixed
-                 << std::setprecision(2) << profiling_map_["hits"] / nevents_
-                 << " ms";
-  ldmx_log(info) << "seeds       Avg Time/Event = " << std::fixed
-                 << std::setprecision(3) << profiling_map_["seeds"] / nevents_
-                 << " ms";
-  ldmx_log(info) << "cf_setup    Avg Time/Event = " << std::fixed
-                 << std::setprecision(3)
-                 << profiling_map_["ckf_setup"] / nevents_ << " ms";
-  ldmx_log(info) << "ckf_run     Avg Time/Event = " << std::fixed
-                 << std::setprecision(3) << profiling_map_["ckf_run"] / nevents_
-                 << " ms";
-  ldmx_log(info) << "result_loop Avg Time/Event = " << std::fixed
-                 << std::setprecision(1)
-                 << profiling_map_["result_loop"] / nevents_ << " ms";
 }
 
 void CKFProcessor::configure(framework::config::Parameters& parameters) {
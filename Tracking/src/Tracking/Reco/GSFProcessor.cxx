@@ -11,65 +11,8 @@ GSFProcessor::GSFProcessor(const std::string& name, framework::Process& process)
     : TrackingGeometryUser(name, process) {}
 
 void GSFProcessor::onNewRun(const ldmx::RunHeader& rh) {
-  // Custom transformation of the interpolated bfield map
-  bool debugTransform = false;
-  auto transformPos = [debugTransform](const Acts::Vector3& pos) {
-    Acts::Vector3 rot_pos;
-    rot_pos(0) = pos(1);
-    rot_pos(1) = pos(2);
-    rot_pos(2) = pos(0) + DIPOLE_OFFSET;
-
-    // Apply A rotation around the center of the magnet. (I guess offset first
-    // and then rotation)
-
-    if (debugTransform) {
-      std::cout << "PF::DEFAULT3 TRANSFORM" << std::endl;
-      std::cout << "PF::Check:: transforming Pos" << std::endl;
-      std::cout << pos << std::endl;
-      std::cout << "TO" << std::endl;
-      std::cout << rot_pos << std::endl;
-    }
-
-    return rot_pos;
-  };
-
-  Acts::RotationMatrix3 rotation = Acts::RotationMatrix3::Identity();
-  double scale = 1.;
-
-  auto transformBField = [rotation, scale, debugTransform](
-                             const Acts::Vector3& field,
-                             const Acts::Vector3& /*pos*/) {
-    // Rotate the field in tracking coordinates
-    Acts::Vector3 rot_field;
-    rot_field(0) = field(2);
-    rot_field(1) = field(0);
-    rot_field(2) = field(1);
-
-    // Scale the field
-    rot_field = scale * rot_field;
-
-    // Rotate the field
-    rot_field = rotation * rot_field;
-
-    // A distortion scaled by position.
-
-    if (debugTransform) {
-      std::cout << "PF::DEFAULT3 TRANSFORM" << std::endl;
-      std::cout << "PF::Check:: transforming" << std::endl;
-      std::cout << field << std::endl;
-      std::cout << "TO" << std::endl;
-      std::cout << rot_field << std::endl;
-    }
-
-    return rot_field;
-  };
-
-  // Setup a interpolated bfield map
-  const auto map = std::make_shared<InterpolatedMagneticField3>(
-      loadDefaultBField(field_map_,
-                        // default_transformPos,
-                        // default_transformBField));
-                        transformPos, transformBField));
+  // Setup a interpolated bfield map, shared with the other processors
+  const auto map = sharedDefaultBField(field_map_);
 
   auto acts_loggingLevel = Acts::Logging::ERROR;
 
@@ -4,6 +4,7 @@
 #include "Acts/Seeding/EstimateTrackParamsFromSeed.hpp"
 #include "Eigen/Dense"
 #include "Tracking/Sim/TrackingUtils.h"
+#include "Tracking/Sim/TruthParticles.h"
 
 /* This processor takes in input a set of 3D space points and builds seedTracks
  * using the ACTS algorithm which is based on the ATLAS 3-space point conformal
@@ -92,9 +93,6 @@ void SeedFinderProcessor::produce(framework::Event& event) {
 
   nevents_++;
 
-  // check if SimParticleMap is available for truth matching
-  std::map<int, ldmx::SimParticle> particleMap;
-
   const std::vector<ldmx::Measurement> measurements =
       event.getCollection<ldmx::Measurement>(input_hits_collection_);
 
@@ -146,10 +144,9 @@ void SeedFinderProcessor::produce(framework::Event& event) {
     }
   }
 
-  if (event.exists("SimParticles")) {
-    particleMap = event.getMap<int, ldmx::SimParticle>("SimParticles");
-    truthMatchingTool_->setup(particleMap, measurements);
-  }
+  // truth matching is only configured if the SimParticles are available
+  truthMatchingTool_->setup(tracking::sim::TruthParticles(event),
+                            measurements);
 
   ldmx_log(debug) << "Preparing the strategies";
 
@@ -1,6 +1,7 @@
 #include "Tracking/Reco/TruthSeedProcessor.h"
 
 #include "Tracking/Sim/GeometryContainers.h"
+#include "Tracking/Sim/TruthParticles.h"
 
 namespace tracking::reco {
 
@@ -518,8 +519,12 @@ bool TruthSeedProcessor::scoringPlaneHitFilter(
 }
 
 void TruthSeedProcessor::produce(framework::Event& event) {
-  // Retrieve the particleMap
-  auto particleMap{event.getMap<int, ldmx::SimParticle>("SimParticles")};
+  // Retrieve the particles from the table or the map
+  tracking::sim::TruthParticles particles(event);
+  if (!particles.available()) {
+    EXCEPTION_RAISE("ProductNotFound",
+                    "No SimParticleTable or SimParticles in the event");
+  }
 
   // Retrieve the target scoring hits
   // Information is extracted using the
@@ -581,7 +586,7 @@ void TruthSeedProcessor::produce(framework::Event& event) {
       if (p_vec(2) < 0. || p_vec.norm() < p_cut_) continue;
 
       // Check that the hit was left by a charged particle
-      if (abs(particleMap[hit.getTrackID()].getCharge()) < 1e-8) continue;
+      if (abs(particles.getCharge(hit.getTrackID())) < 1e-8) continue;
 
       if (p_vec.norm() > tagger_p_max) {
         tagger_sh_count_map[hit.getTrackID()].push_back(i_sh);
@@ -595,7 +600,7 @@ void TruthSeedProcessor::produce(framework::Event& event) {
       if (p_vec(2) < 0. || p_vec.norm() < p_cut_) continue;
 
       // Check that the hit was left by a charged particle
-      if (abs(particleMap[hit.getTrackID()].getCharge()) < 1e-8) continue;
+      if (abs(particles.getCharge(hit.getTrackID())) < 1e-8) continue;
 
       recoil_sh_count_map[hit.getTrackID()].push_back(i_sh);
 
@@ -661,7 +666,7 @@ void TruthSeedProcessor::produce(framework::Event& event) {
   if (!skip_tagger_) {
     for (const auto& [track_id, hit_indices] : tagger_sh_count_map) {
       const ldmx::SimTrackerHit& hit = scoring_hits.at(hit_indices.at(0));
-      const ldmx::SimParticle& phit = particleMap[hit.getTrackID()];
+      const ldmx::SimParticle phit{particles.getParticle(hit.getTrackID())};
 
       if (hit_count_map_tagger[hit.getTrackID()].size() > n_min_hits_tagger_) {
         ldmx::Track truth_tagger_track;
@@ -672,8 +677,8 @@ void TruthSeedProcessor::produce(framework::Event& event) {
 
         if (hit.getPdgID() == 11 && hit.getTrackID() < max_track_id_) {
           ldmx::Track beamETruthSeed = TaggerFullSeed(
-              particleMap[hit.getTrackID()], hit.getTrackID(), hit,
-              hit_count_map_tagger, beamOriginSurface, targetUnboundSurface);
+              phit, hit.getTrackID(), hit, hit_count_map_tagger,
+              beamOriginSurface, targetUnboundSurface);
           beam_electrons.push_back(beamETruthSeed);
         }
       }
@@ -698,8 +703,6 @@ void TruthSeedProcessor::produce(framework::Event& event) {
     // Only take the first entry of the vector: it should be the scoring plane
     // hit with the highest momentum.
     const ldmx::SimTrackerHit& hit = scoring_hits.at(element.second.at(0));
-    [[maybe_unused]] const ldmx::SimParticle& phit =
-        particleMap[hit.getTrackID()];
     ldmx::SimTrackerHit ecal_hit;
 
     bool foundEcalHit = false;
@@ -714,10 +717,10 @@ void TruthSeedProcessor::produce(framework::Event& event) {
     // Findable particle selection
     if (hit_count_map_recoil[hit.getTrackID()].size() > n_min_hits_recoil_ &&
         foundEcalHit && !skip_recoil_) {
-      ldmx::Track truth_recoil_track =
-          RecoilFullSeed(particleMap[hit.getTrackID()], hit.getTrackID(), hit,
-                         ecal_hit, hit_count_map_recoil, targetSurface,
-                         targetUnboundSurface, ecalSurface);
+      ldmx::Track truth_recoil_track = RecoilFullSeed(
+          particles.getParticle(hit.getTrackID()), hit.getTrackID(), hit,
+          ecal_hit, hit_count_map_recoil, targetSurface, targetUnboundSurface,
+          ecalSurface);
       recoil_truth_tracks.push_back(truth_recoil_track);
     }
   }
@@ -726,7 +729,7 @@ void TruthSeedProcessor::produce(framework::Event& event) {
     for (std::pair<int,std::vector<int>> element : recoil_sh_count_map) {
 
     const ldmx::SimTrackerHit& hit  = scoring_hits.at(element.second.at(0));
-    const ldmx::SimParticle&   phit = particleMap[hit.getTrackID()];
+    const ldmx::SimParticle    phit = particles.getParticle(hit.getTrackID());
 
     if (hit_count_map_recoil[hit.getTrackID()].size() > n_min_hits_recoil_) {
     ldmx::Track truth_recoil_track;
@@ -32,10 +32,8 @@ void VertexProcessor::onProcessStart() {
   };
   */
 
-  // Setup a interpolated bfield map
-  sp_interpolated_bField_ =
-      std::make_shared<InterpolatedMagneticField3>(loadDefaultBField(
-          field_map_, default_transformPos, default_transformBField));
+  // Setup a interpolated bfield map, shared with the other processors
+  sp_interpolated_bField_ = sharedDefaultBField(field_map_);
 
   ldmx_log(info) << "Check if nullptr::" << sp_interpolated_bField_.get();
 }
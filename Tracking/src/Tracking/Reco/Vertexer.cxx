@@ -58,9 +58,7 @@ void Vertexer::onProcessStart() {
   };
   */
 
-  sp_interpolated_bField_ =
-      std::make_shared<InterpolatedMagneticField3>(loadDefaultBField(
-          field_map_, default_transformPos, default_transformBField));
+  sp_interpolated_bField_ = sharedDefaultBField(field_map_);
 
   // There is a sign issue between the vertexing and the perigee representation
   Acts::Vector3 b_field(0., 0., -1.5 * Acts::UnitConstants::T);
@@ -1,5 +1,9 @@
 #include "Tracking/Sim/BFieldXYZUtils.h"
 
+#include <map>
+#include <mutex>
+#include <utility>
+
 Acts::Vector3 default_transformPos(const Acts::Vector3& pos) {
   Acts::Vector3 rot_pos;
   rot_pos(0) = pos(1);
@@ -26,6 +30,39 @@ Acts::Vector3 default_transformBField(const Acts::Vector3& field,
   return rot_field;
 }
 
+std::shared_ptr<const InterpolatedMagneticField3> sharedDefaultBField(
+    const std::string& fieldMapFile, const std::array<double, 3>& offset) {
+  static std::mutex cache_mutex;
+  // strong references so that the maps are not freed between users
+  static std::map<std::string, std::shared_ptr<const ldmx::FieldMap>> maps;
+  static std::map<std::pair<std::string, std::array<double, 3>>,
+                  std::shared_ptr<const InterpolatedMagneticField3>>
+      fields;
+
+  std::lock_guard<std::mutex> lock{cache_mutex};
+  auto& field{fields[{fieldMapFile, offset}]};
+  if (field) return field;
+
+  auto& map{maps[fieldMapFile]};
+  if (!map) map = ldmx::FieldMap::load(fieldMapFile);
+
+  auto transformPos = [offset](const Acts::Vector3& pos) {
+    Acts::Vector3 rot_pos{default_transformPos(pos)};
+    rot_pos(0) += offset[0];
+    rot_pos(1) += offset[1];
+    rot_pos(2) += offset[2];
+    return rot_pos;
+  };
+
+  field = std::make_shared<const InterpolatedMagneticField3>(
+      makeMagneticFieldMapXyzFromFieldMap(
+          *map, transformPos, default_transformBField,
+          1. * Acts::UnitConstants::mm,   // default scale for axes length
+          1000. * Acts::UnitConstants::T  // The map is in kT, so scale it to T
+          ));
+  return field;
+}
+
 size_t localToGlobalBin_xyz(std::array<size_t, 3> bins,
                             std::array<size_t, 3> sizes) {
   return (bins[0] * (sizes[1] * sizes[2]) + bins[1] * sizes[2] +
@@ -21,7 +21,7 @@ TruthMatchingTool::TruthInfo TruthMatchingTool::Evaluate(
     }
   }
 
-  if (ti.trackID > 0) ti.pdgID = map_[ti.trackID].getPdgID();
+  if (ti.trackID > 0) ti.pdgID = particles_.getPdgID(ti.trackID);
 
   return ti;
 }
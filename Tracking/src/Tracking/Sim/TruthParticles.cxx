@@ -0,0 +1,58 @@
+#include "Tracking/Sim/TruthParticles.h"
+
+namespace tracking {
+namespace sim {
+
+bool TruthParticles::setup(const framework::Event& event) {
+  table_ = nullptr;
+  map_ = nullptr;
+  if (event.exists("SimParticleTable")) {
+    table_ = &event.getObject<ldmx::SimParticleTable>("SimParticleTable");
+  } else if (event.exists("SimParticles")) {
+    map_ = &event.getMap<int, ldmx::SimParticle>("SimParticles");
+  }
+  return available();
+}
+
+bool TruthParticles::contains(int trackID) const {
+  if (table_) return table_->contains(trackID);
+  if (map_) return map_->count(trackID) > 0;
+  return false;
+}
+
+double TruthParticles::getCharge(int trackID) const {
+  if (table_) {
+    int i{table_->find(trackID)};
+    return i < 0 ? 0. : table_->getCharge(i);
+  }
+  if (map_) {
+    auto it{map_->find(trackID)};
+    return it == map_->end() ? 0. : it->second.getCharge();
+  }
+  return 0.;
+}
+
+int TruthParticles::getPdgID(int trackID) const {
+  if (table_) {
+    int i{table_->find(trackID)};
+    return i < 0 ? 0 : table_->getPdgID(i);
+  }
+  if (map_) {
+    auto it{map_->find(trackID)};
+    return it == map_->end() ? 0 : it->second.getPdgID();
+  }
+  return 0;
+}
+
+ldmx::SimParticle TruthParticles::getParticle(int trackID) const {
+  if (table_) {
+    if (table_->contains(trackID)) return table_->getParticle(trackID);
+  } else if (map_) {
+    auto it{map_->find(trackID)};
+    if (it != map_->end()) return it->second;
+  }
+  return ldmx::SimParticle();
+}
+
+}  // namespace sim
+}  // namespace tracking